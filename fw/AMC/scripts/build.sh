@@ -68,7 +68,7 @@ function print_help() {
     echo "-clean_amc              : remove all AMC application build files (BSP untouched)"
     echo "-amc                    : only builds the AMC application (BSP untouched)"
     echo "-profile <profile_name> : set the profile to build AMC for (v70/v80/Linux, etc)"
-    echo "-os <os_name>           : set the OS (freertos10_xilinx, standalone, Linux, etc)"
+    echo "-os <os_name>           : set the OS (freertos10_xilinx, standalone, Linux, FreeRTOS_Sim, etc)"
     echo "-xsa <path_to_xsa>      : XSA to generate BSP from"
     echo "-freertos_debug         : sets FreeRTOSConfig.h stat debug flags"
     echo "-analysis               : triggers a static analysis check on AMC files"
@@ -84,6 +84,9 @@ function print_help() {
     echo "E.g.: To build application for Linux (profile will default to Linux):"
     echo " ./scripts/build.sh -os Linux -amc"
     echo
+    echo "E.g.: To build the FreeRTOS simulator (POSIX port, profile will default to Linux):"
+    echo " ./scripts/build.sh -os FreeRTOS_Sim -amc -DFREERTOS_KERNEL_PATH=/path/to/FreeRTOS-Kernel"
+    echo
     echo "========================================================================================="
 }
 
@@ -181,8 +184,8 @@ else
     echo "OS path set ==> $OS" |& tee -a $BUILD_LOG
 fi
 
-### handle os set to Linux ###
-if [ "$OS" == "Linux" ]; then
+### handle os set to Linux or the FreeRTOS simulator ###
+if [ "$OS" == "Linux" ] || [ "$OS" == "FreeRTOS_Sim" ]; then
     ### default profile to Linux ###
     PROFILE="Linux"
     echo "overwriting profile ==> $PROFILE" |& tee -a $BUILD_LOG
@@ -199,7 +202,7 @@ else
 fi
 
 ### handle xsa file path ###
-if [ "$OS" == "Linux" ]; then
+if [ "$OS" == "Linux" ] || [ "$OS" == "FreeRTOS_Sim" ]; then
     ### xsa not required on Linux ###
     echo "Building on Linux - skipping BSP step" |& tee -a $BUILD_LOG
     clean
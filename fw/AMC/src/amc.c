@@ -85,6 +85,9 @@
 #define AMC_TASK_SLEEP_MS             ( 100 )
 #define AMC_GET_PROJECT_INFO_SLEEP_MS ( 1000 )
 
+#define AMC_AMI_BULK_QUEUE_WEIGHT     ( 1 )
+#define AMC_AMI_NUM_QUEUES_WITH_BULK  ( 2 )
+
 
 /******************************************************************************/
 /* Enums                                                                      */
@@ -193,6 +196,14 @@ static void vTaskFuncMain( void );
  */
 static void vConfigurePartitionTable( void );
 
+/**
+ * @brief   Publish the number of GCQ queue pairs being serviced in the
+ *          partition table, for the AMI to pick up at start of day
+ * @param   ulNumQueues Number of queue pairs on offer
+ * @return  N/A
+ */
+static void vAdvertiseQueuePairs( uint32_t ulNumQueues );
+
 
 /******************************************************************************/
 /* Local variables                                                            */
@@ -607,6 +618,18 @@ static int iAmiCallback( EVL_SIGNAL *pxSignal )
             break;
         }
 
+        case AMI_PROXY_DRIVER_E_HEARTBEAT:
+        {
+            uint32_t ulProgress = 0;
+
+            /* Raised before the heartbeat response is built, so it carries the latest count */
+            if( OK == iAPC_GetProgress( &ulProgress ) )
+            {
+                iStatus = iAMI_SetProgress( ulProgress );
+            }
+            break;
+        }
+
         default:
             iStatus = OK;
             break;
@@ -869,6 +892,20 @@ static int iInitProxies( void )
             {
                 PLL_ERR( AMC_NAME, "Error binding to AMI Proxy Driver\r\n" );
             }
+
+            /* Only offer the bulk queue pair to the host once it is being serviced */
+            if( NULL != pxGcqBulkIf )
+            {
+                if( OK == iAMI_AttachQueue( pxGcqBulkIf, 0, AMC_AMI_BULK_QUEUE_WEIGHT ) )
+                {
+                    PLL_INF( AMC_NAME, "AMI bulk queue pair attached\r\n" );
+                    vAdvertiseQueuePairs( AMC_AMI_NUM_QUEUES_WITH_BULK );
+                }
+                else
+                {
+                    PLL_ERR( AMC_NAME, "Error attaching AMI bulk queue pair\r\n" );
+                }
+            }
         }
         else
         {
@@ -1048,7 +1085,8 @@ static void vConfigurePartitionTable( void )
     xPartTable.ulMagicNum                  = HAL_PARTITION_TABLE_MAGIC_NO;
     xPartTable.xRingBuffer.ulRingBufferOff = HAL_PARTITION_TABLE_SIZE;
     xPartTable.xRingBuffer.ulRingBufferLen = HAL_RPU_RING_BUFFER_LEN;
-    xPartTable.xStatus.ulStatusOff         = HAL_PARTITION_TABLE_SIZE + HAL_RPU_RING_BUFFER_LEN;
+    xPartTable.xStatus.ulStatusOff         = HAL_PARTITION_TABLE_SIZE + HAL_RPU_RING_BUFFER_LEN +
+                                             HAL_RPU_BULK_RING_BUFFER_LEN;
     xPartTable.xStatus.ulStatusLen         = sizeof( uint32_t );
     xPartTable.xLogMsg.ulLogMsgIndex       = 0;
     xPartTable.xLogMsg.ulLogMsgBufferOff   = xPartTable.xStatus.ulStatusOff + xPartTable.xStatus.ulStatusLen;
@@ -1057,6 +1095,12 @@ static void vConfigurePartitionTable( void )
                                              xPartTable.xLogMsg.ulLogMsgBufferLen;
     xPartTable.xData.ulDataEnd = HAL_RPU_SHARED_MEMORY_SIZE;
 
+    /* Single queue pair until the bulk pair is attached, see vAdvertiseQueuePairs */
+    xPartTable.xQueues.ulQueueMagicNum     = HAL_PARTITION_TABLE_QUEUE_MAGIC_NO;
+    xPartTable.xQueues.ulNumQueues         = 1;
+    xPartTable.xQueues.ulBulkRingBufferOff = HAL_PARTITION_TABLE_SIZE + HAL_RPU_RING_BUFFER_LEN;
+    xPartTable.xQueues.ulBulkRingBufferLen = HAL_RPU_BULK_RING_BUFFER_LEN;
+
     /* Copy the populated table into the start of shared memory */
     pucDestAdd = ( uint8_t* )( HAL_RPU_SHARED_MEMORY_BASE_ADDR );
     pvOSAL_MemCpy( pucDestAdd, ( uint8_t* )&xPartTable, sizeof( xPartTable ) );
@@ -1081,3 +1125,15 @@ static void vConfigurePartitionTable( void )
     HAL_FLUSH_CACHE_DATA( ( HAL_RPU_SHARED_MEMORY_BASE_ADDR + xPartTable.xStatus.ulStatusOff ),
                           xPartTable.xStatus.ulStatusLen );
 }
+
+/**
+ * @brief   Publish the number of GCQ queue pairs in the partition table
+ */
+static void vAdvertiseQueuePairs( uint32_t ulNumQueues )
+{
+    uintptr_t ulNumQueuesAddr = HAL_RPU_SHARED_MEMORY_BASE_ADDR +
+                                offsetof( HAL_PARTITION_TABLE, xQueues.ulNumQueues );
+
+    pvOSAL_MemCpy( ( void* )ulNumQueuesAddr, &ulNumQueues, sizeof( ulNumQueues ) );
+    HAL_FLUSH_CACHE_DATA( ulNumQueuesAddr, sizeof( ulNumQueues ) );
+}
@@ -40,6 +40,11 @@
 
 #define ASDM_NAME                               "ASDM"
 
+#define ASDM_ASC_EVENT_MASK                     ( EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPDATE_COMPLETE ) |  \
+                                                  EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPPER_WARNING ) |    \
+                                                  EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPPER_CRITICAL ) |   \
+                                                  EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPPER_FATAL ) )
+
 #define UPPER_FIREWALL                          ( 0xBABECAFE )
 #define LOWER_FIREWALL                          ( 0xDEADFACE )
 
@@ -996,7 +1001,7 @@ int iASDM_Initialise( uint8_t ucNumSensors )
         }
 
         /* Bind Callbacks */
-        if( OK == iASC_BindCallback( &iAscCallback ) )
+        if( OK == iASC_BindFilteredCallback( &iAscCallback, ASDM_ASC_EVENT_MASK ) )
         {
             PLL_DBG( ASDM_NAME, "ASC Proxy Driver bound\r\n" );
         }
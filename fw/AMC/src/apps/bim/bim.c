@@ -44,6 +44,11 @@
 
 #define BIM_NAME "BIM"
 
+/* Only threshold breaches need BIM to act */
+#define BIM_ASC_EVENT_MASK ( EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPPER_WARNING ) |  \
+                             EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPPER_CRITICAL ) | \
+                             EVL_EVENT_MASK( ASC_PROXY_DRIVER_E_SENSOR_UPPER_FATAL ) )
+
 /* Stat & Error definitions */
 #define BIM_STATS( DO )                                         \
         DO( BIM_STATS_INIT_OVERALL_COMPLETE )                   \
@@ -284,7 +289,7 @@ int iBIM_Initialise( BIM_MODULES *pxModuleData )
                 PLL_ERR( BIM_NAME, "Error binding to AMI Proxy Driver\r\n" );
             }
 
-            if( OK == iASC_BindCallback( &iAscCallback ) )
+            if( OK == iASC_BindFilteredCallback( &iAscCallback, BIM_ASC_EVENT_MASK ) )
             {
                 PLL_DBG( BIM_NAME, "ASC Proxy Driver bound\r\n" );
             }
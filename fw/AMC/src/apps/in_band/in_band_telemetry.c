@@ -59,6 +59,7 @@
         DO( IN_BAND_STATS_AMI_EEPROM_RW_REQUEST )       \
         DO( IN_BAND_STATS_AMI_MODULE_RW_REQUEST )       \
         DO( IN_BAND_STATS_AMI_DEBUG_VERBOSITY_REQUEST ) \
+        DO( IN_BAND_STATS_AMI_ECHO_REQUEST )            \
         DO( IN_BAND_STATS_INIT_MUTEX )                  \
         DO( IN_BAND_STATS_TAKE_MUTEX )                  \
         DO( IN_BAND_STATS_RELEASE_MUTEX )               \
@@ -79,6 +80,7 @@
         DO( IN_BAND_ERRORS_MUTEX_TAKE_FAILED )              \
         DO( IN_BAND_ERRORS_MALLOC_FAILED )                  \
         DO( IN_BAND_ERRORS_MAP_REQUEST_FAILED )             \
+        DO( IN_BAND_ERRORS_AMI_ECHO_INVALID_SIZE )          \
         DO( IN_BAND_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )  PLL_INF( IN_BAND_NAME,           \
@@ -597,6 +599,7 @@ static int iAmiCallback( EVL_SIGNAL *pxSignal )
                 PLL_DBG( IN_BAND_NAME, "PDI last packet      : 0x%x\r\n",   xDownloadRequest.iLastPacket );
                 PLL_DBG( IN_BAND_NAME, "PDI packet number    : 0x%hx\r\n",  xDownloadRequest.usPacketNum );
                 PLL_DBG( IN_BAND_NAME, "PDI packet size (KB) : 0x%hx\r\n",  xDownloadRequest.usPacketSize );
+                PLL_DBG( IN_BAND_NAME, "PDI packet codec     : 0x%x\r\n",   xDownloadRequest.ucCodec );
 
                 if( TRUE == xDownloadRequest.iUpdateFpt )
                 {
@@ -607,7 +610,8 @@ static int iAmiCallback( EVL_SIGNAL *pxSignal )
                                               xDownloadRequest.ulLength,
                                               xDownloadRequest.usPacketNum,
                                               xDownloadRequest.usPacketSize,
-                                              xDownloadRequest.iLastPacket );
+                                              xDownloadRequest.iLastPacket,
+                                              ( APC_IMAGE_CODECS )xDownloadRequest.ucCodec );
                 }
                 else
                 {
@@ -618,7 +622,8 @@ static int iAmiCallback( EVL_SIGNAL *pxSignal )
                                                   ( uint32_t )HAL_RPU_SHARED_MEMORY_BASE_ADDR,
                                                   xDownloadRequest.ulLength,
                                                   xDownloadRequest.usPacketNum,
-                                                  xDownloadRequest.usPacketSize );
+                                                  xDownloadRequest.usPacketSize,
+                                                  ( APC_IMAGE_CODECS )xDownloadRequest.ucCodec );
                 }
 
                 if( OK != iStatus )
@@ -745,6 +750,57 @@ static int iAmiCallback( EVL_SIGNAL *pxSignal )
             break;
         }
 
+        case AMI_PROXY_DRIVER_E_ECHO:
+        {
+            AMI_PROXY_ECHO_REQUEST xEchoRequest = { 0 };
+            INC_STAT_COUNTER( IN_BAND_STATS_AMI_ECHO_REQUEST )
+
+            iStatus = iAMI_GetEchoRequest( pxSignal, &xEchoRequest );
+            if( OK == iStatus )
+            {
+                AMI_PROXY_ECHO_RESPONSE xEchoResponse = { 0 };
+                AMI_PROXY_RESULT        xResult       = AMI_PROXY_RESULT_INVALID_VALUE;
+
+                xEchoResponse.ulCookie = xEchoRequest.ulCookie;
+
+                if( ( xEchoRequest.ullAddress < HAL_RPU_SHARED_MEMORY_SIZE ) &&
+                    ( xEchoRequest.ulLength <= ( HAL_RPU_SHARED_MEMORY_SIZE - xEchoRequest.ullAddress ) ) )
+                {
+                    uintptr_t ullDestAddr  = ( pxThis->ullSharedMemBaseAddr + xEchoRequest.ullAddress );
+                    uint8_t   *pucDestAddr = ( uint8_t* )( ullDestAddr );
+                    uint32_t  i            = 0;
+
+                    /* Flush shared memory so the host payload is visible to the RPU. */
+                    HAL_FLUSH_CACHE_DATA( ullDestAddr, xEchoRequest.ulLength );
+
+                    /*
+                     * Sum the payload as received and send it back inverted, so the host
+                     * can tell a real round trip from reading back its own stale buffer.
+                     */
+                    for( i = 0; i < xEchoRequest.ulLength; i++ )
+                    {
+                        xEchoResponse.ulChecksum += pucDestAddr[ i ];
+                        pucDestAddr[ i ] = ~pucDestAddr[ i ];
+                    }
+
+                    HAL_FLUSH_CACHE_DATA( ullDestAddr, xEchoRequest.ulLength );
+                    xResult = AMI_PROXY_RESULT_SUCCESS;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER( IN_BAND_ERRORS_AMI_ECHO_INVALID_SIZE )
+                }
+
+                iStatus = iAMI_SetEchoCompleteResponse( pxSignal, xResult, &xEchoResponse );
+            }
+
+            if( OK != iStatus )
+            {
+                PLL_ERR( IN_BAND_NAME, "Error handling echo request\r\n" );
+            }
+            break;
+        }
+
         case AMI_PROXY_DRIVER_E_GET_IDENTITY:
         case AMI_PROXY_DRIVER_E_HEARTBEAT:
         default:
@@ -39,6 +39,12 @@
 
 #define OUT_OF_BAND_NAME "AMC_OUT_OF_BAND"
 
+/* PLDM requests only - message arrival and invalid requests are handled by the BMC proxy */
+#define OUT_OF_BAND_BMC_EVENT_MASK ( EVL_EVENT_MASK( BMC_PROXY_DRIVER_E_GET_PDR ) |                 \
+                                     EVL_EVENT_MASK( BMC_PROXY_DRIVER_E_GET_PDR_REPOSITORY_INFO ) | \
+                                     EVL_EVENT_MASK( BMC_PROXY_DRIVER_E_GET_SENSOR_INFO ) |         \
+                                     EVL_EVENT_MASK( BMC_PROXY_DRIVER_E_ENABLE_SENSOR ) )
+
 #define UPPER_FIREWALL ( 0xBABECAFE )
 #define LOWER_FIREWALL ( 0xDEADFACE )
 
@@ -175,7 +181,7 @@ int iOUT_OF_BAND_TELEMETRY_Initialise( void )
         }
         else
         {
-            if( OK == iBMC_BindCallback( &iBmcProxyCallback ) )
+            if( OK == iBMC_BindFilteredCallback( &iBmcProxyCallback, OUT_OF_BAND_BMC_EVENT_MASK ) )
             {
                 PLL_DBG( OUT_OF_BAND_NAME, "BMC proxy bound\r\n" );
                 iStatus = OK;
@@ -32,6 +32,8 @@
     DO( EVL_STATS_RECORDS )                \
     DO( EVL_STATS_BINDINGS )               \
     DO( EVL_STATS_SIGNALS )                \
+    DO( EVL_STATS_SIGNALS_FILTERED )       \
+    DO( EVL_STATS_RECORD_STATS_RETRIEVED ) \
     DO (EVL_STATS_LOG_RETRIEVED )          \
     DO( EVL_STATS_LOG_MUTEX_CREATED )      \
     DO( EVL_STATS_LOG_MUTEX_GRABBED )      \
@@ -122,6 +124,11 @@ typedef struct EVL_PRIVATE_DATA
 typedef struct EVL_CALLBACK_NODE
 {
     EVL_CALLBACK             *pxCallback;
+    uint8_t                  ucModule;
+    uint32_t                 ulEventMask;
+    uint32_t                 ulDelivered;
+    uint32_t                 ulFiltered;
+    uint32_t                 ulFailed;
     struct EVL_CALLBACK_NODE *pxNext;
 
 } EVL_CALLBACK_NODE;
@@ -169,6 +176,22 @@ static EVL_PRIVATE_DATA *pxThis = &xLocalData;
 static int iEvlVerbosity = FALSE;
 
 
+/******************************************************************************/
+/* Local Function declarations                                                */
+/******************************************************************************/
+
+/**
+ * @brief   Check if a signal matches the filter of a binding
+ *
+ * @param   pxNode      Binding to check
+ * @param   pxSignal    Signal being raised
+ *
+ * @return  TRUE if the callback should be invoked
+ *          FALSE if the signal should be skipped
+ */
+static int iSignalMatches( EVL_CALLBACK_NODE *pxNode, EVL_SIGNAL *pxSignal );
+
+
 /******************************************************************************/
 /* Public function implementations                                            */
 /******************************************************************************/
@@ -251,6 +274,17 @@ int iEVL_CreateRecord( EVL_RECORD **ppxRecord )
  * @brief   Bind a callback into a module
  */
 int iEVL_BindCallback( EVL_RECORD *pxRecord, EVL_CALLBACK *pxNewCallback )
+{
+    return iEVL_BindFilteredCallback( pxRecord, pxNewCallback, EVL_MODULE_ANY, EVL_EVENT_MASK_ALL );
+}
+
+/**
+ * @brief   Bind a callback into a module, for a subset of its events only
+ */
+int iEVL_BindFilteredCallback( EVL_RECORD *pxRecord,
+                               EVL_CALLBACK *pxNewCallback,
+                               uint8_t ucModule,
+                               uint32_t ulEventMask )
 {
     int iStatus = ERROR;
 
@@ -258,7 +292,8 @@ int iEVL_BindCallback( EVL_RECORD *pxRecord, EVL_CALLBACK *pxNewCallback )
         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
         ( TRUE == pxThis->iIsInitialised ) &&
         ( NULL != pxRecord ) &&
-        ( NULL != pxNewCallback ) )
+        ( NULL != pxNewCallback ) &&
+        ( 0 != ulEventMask ) )
     {
         if( pxRecord->iNumBindings < EVL_MAX_BINDINGS )
         {
@@ -271,8 +306,11 @@ int iEVL_BindCallback( EVL_RECORD *pxRecord, EVL_CALLBACK *pxNewCallback )
                         ( EVL_CALLBACK_NODE * ) pvOSAL_MemAlloc( sizeof( EVL_CALLBACK_NODE ) );
                     if( NULL != pxNewNode )
                     {
-                        pxNewNode->pxCallback = pxNewCallback;
-                        pxNewNode->pxNext     = NULL;
+                        pvOSAL_MemSet( pxNewNode, 0, sizeof( EVL_CALLBACK_NODE ) );
+                        pxNewNode->pxCallback  = pxNewCallback;
+                        pxNewNode->ucModule    = ucModule;
+                        pxNewNode->ulEventMask = ulEventMask;
+                        pxNewNode->pxNext      = NULL;
                         INC_STAT_COUNTER( EVL_STATS_RECORDS );
                         pxRecord->pxFirstBinding = pxNewNode;
                         pxRecord->iNumBindings++;
@@ -292,8 +330,11 @@ int iEVL_BindCallback( EVL_RECORD *pxRecord, EVL_CALLBACK *pxNewCallback )
                             ( EVL_CALLBACK_NODE * ) pvOSAL_MemAlloc( sizeof( EVL_CALLBACK_NODE ) );
                         if( NULL != pxNewNode )
                         {
-                            pxNewNode->pxCallback = pxNewCallback;
-                            pxNewNode->pxNext     = NULL;
+                            pvOSAL_MemSet( pxNewNode, 0, sizeof( EVL_CALLBACK_NODE ) );
+                            pxNewNode->pxCallback  = pxNewCallback;
+                            pxNewNode->ucModule    = ucModule;
+                            pxNewNode->ulEventMask = ulEventMask;
+                            pxNewNode->pxNext      = NULL;
 
                             EVL_CALLBACK_NODE *pxLastBinding = pxRecord->pxFirstBinding;
                             while( NULL != pxLastBinding->pxNext )
@@ -377,11 +418,21 @@ int iEVL_RaiseEvent( EVL_RECORD *pxRecord, EVL_SIGNAL *pxSignal )
                     EVL_CALLBACK_NODE *pxCurrentNode = pxRecord->pxFirstBinding;
                     while( NULL != pxCurrentNode )
                     {
-                        INC_STAT_COUNTER( EVL_STATS_SIGNALS );
-                        if( OK != pxCurrentNode->pxCallback( pxSignal ) )
+                        if( TRUE == iSignalMatches( pxCurrentNode, pxSignal ) )
+                        {
+                            INC_STAT_COUNTER( EVL_STATS_SIGNALS );
+                            pxCurrentNode->ulDelivered++;
+                            if( OK != pxCurrentNode->pxCallback( pxSignal ) )
+                            {
+                                INC_ERROR_COUNTER( EVL_ERRORS_CALLBACKS );
+                                pxCurrentNode->ulFailed++;
+                                iStatus = ERROR;
+                            }
+                        }
+                        else
                         {
-                            INC_ERROR_COUNTER( EVL_ERRORS_CALLBACKS );
-                            iStatus = ERROR;
+                            INC_STAT_COUNTER( EVL_STATS_SIGNALS_FILTERED );
+                            pxCurrentNode->ulFiltered++;
                         }
                         pxCurrentNode = pxCurrentNode->pxNext;
                     }
@@ -428,6 +479,63 @@ int iEVL_RaiseEvent( EVL_RECORD *pxRecord, EVL_SIGNAL *pxSignal )
     return iStatus;
 }
 
+/**
+ * @brief   Print the per-subscriber delivery stats of a record
+ */
+int iEVL_GetStats( EVL_RECORD *pxRecord )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iIsInitialised ) &&
+        ( NULL != pxRecord ) )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxRecord->pxMtx, OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            EVL_CALLBACK_NODE *pxCurrentNode = pxRecord->pxFirstBinding;
+            int               iBinding       = 0;
+
+            INC_STAT_COUNTER( EVL_STATS_RECORD_MUTEX_GRABBED );
+
+            PLL_INF( EVL_NAME, "EVL subscribers ( %d ):\r\n", pxRecord->iNumBindings );
+            while( NULL != pxCurrentNode )
+            {
+                PLL_INF( EVL_NAME,
+                         "[%d] Module: 0x%02X | Mask: 0x%08X | Delivered: %d | Filtered: %d | Failed: %d\r\n",
+                         iBinding++,
+                         pxCurrentNode->ucModule,
+                         pxCurrentNode->ulEventMask,
+                         pxCurrentNode->ulDelivered,
+                         pxCurrentNode->ulFiltered,
+                         pxCurrentNode->ulFailed );
+                pxCurrentNode = pxCurrentNode->pxNext;
+            }
+
+            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Release( pxRecord->pxMtx ) )
+            {
+                INC_STAT_COUNTER( EVL_STATS_RECORD_MUTEX_RELEASED );
+                INC_STAT_COUNTER( EVL_STATS_RECORD_STATS_RETRIEVED );
+                iStatus = OK;
+            }
+            else
+            {
+                INC_ERROR_COUNTER( EVL_ERRORS_RECORD_MUTEX_RELEASED );
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER( EVL_ERRORS_RECORD_MUTEX_GRABBED );
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( EVL_ERRORS_VALIDATION )
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Display the current stats/errors
  */
@@ -561,3 +669,34 @@ void vEVL_SetVerbosity( int iVerbosity )
 {
     iEvlVerbosity = iVerbosity;
 }
+
+
+/******************************************************************************/
+/* Local Function implementations                                            */
+/******************************************************************************/
+
+/**
+ * @brief   Check if a signal matches the filter of a binding
+ */
+static int iSignalMatches( EVL_CALLBACK_NODE *pxNode, EVL_SIGNAL *pxSignal )
+{
+    int iMatches = FALSE;
+
+    if( ( EVL_MODULE_ANY == pxNode->ucModule ) ||
+        ( pxSignal->ucModule == pxNode->ucModule ) )
+    {
+        if( EVL_EVENT_MASK_ALL == pxNode->ulEventMask )
+        {
+            iMatches = TRUE;
+        }
+        else if( ( 8 * sizeof( pxNode->ulEventMask ) ) > pxSignal->ucEventType )
+        {
+            if( 0 != ( pxNode->ulEventMask & EVL_EVENT_MASK( pxSignal->ucEventType ) ) )
+            {
+                iMatches = TRUE;
+            }
+        }
+    }
+
+    return iMatches;
+}
@@ -28,6 +28,10 @@
 
 #define EVL_MAX_BINDINGS    ( 10 )
 
+#define EVL_MODULE_ANY          ( 0xFF )
+#define EVL_EVENT_MASK_ALL      ( 0xFFFFFFFF )
+#define EVL_EVENT_MASK( x )     ( ( uint32_t )1 << ( x ) )
+
 
 /******************************************************************************/
 /* Typedefs and strcuts                                                       */
@@ -101,6 +105,26 @@ int iEVL_CreateRecord( EVL_RECORD **ppxRecord );
  */
 int iEVL_BindCallback( EVL_RECORD *pxRecord, EVL_CALLBACK *pxNewCallback );
 
+/**
+ * @brief   Bind a callback into a module, for a subset of its events only
+ *
+ * @param   pxRecord        Record to bind callback to
+ * @param   pxNewCallback   New callback to bind
+ * @param   ucModule        Module ID to accept signals from, or EVL_MODULE_ANY
+ * @param   ulEventMask     Event types to accept, built with EVL_EVENT_MASK( x )
+ *
+ * @return  OK if callback bound successfully
+ *          ERROR if callback not bound
+ *
+ * @note    Signals that do not match are skipped without calling the callback.
+ *          Event types that do not fit in the mask are only delivered to
+ *          subscribers bound with EVL_EVENT_MASK_ALL.
+ */
+int iEVL_BindFilteredCallback( EVL_RECORD *pxRecord,
+                               EVL_CALLBACK *pxNewCallback,
+                               uint8_t ucModule,
+                               uint32_t ulEventMask );
+
 /**
  * @brief   Raise an event to each bound-in callback
  *
@@ -114,11 +138,11 @@ int iEVL_BindCallback( EVL_RECORD *pxRecord, EVL_CALLBACK *pxNewCallback );
 int iEVL_RaiseEvent( EVL_RECORD *pxRecord, EVL_SIGNAL *pxSignal );
 
 /**
- * @brief   Get event stats
+ * @brief   Print the per-subscriber delivery stats of a record
  *
  * @param   pxRecord        Record of bindings
  *
- * @return  OR if the stats were retrieved
+ * @return  OK if the stats were retrieved
  *          ERROR if the stats could not be retrieved
  *
  */
@@ -20,6 +20,7 @@
 #include "osal.h"
 #include "emmc.h"
 #include "profile_hal.h"
+#include "xsdps_core.h"
 
 
 /******************************************************************************/
@@ -36,6 +37,46 @@
 #define EMMC_ERASE_BLOCK_INCREMENT_MINUS_ONE    ( EMMC_ERASE_BLOCK_INCREMENT - 1 )
 #define EMMC_FINAL_BLOCK                        ( HAL_EMMC_MAX_BLOCKS - 1 )
 
+#define EMMC_EXT_CSD_SIZE                       ( 512 )
+#define EMMC_EXT_CSD_ALIGNMENT                  ( 32 )
+#define EMMC_MODE_NAME_LEGACY                   "Legacy"
+#define EMMC_MODE_NAME_UNKNOWN                  "Unknown"
+
+/* EXT_CSD capability fields that must read back the same in a new bus mode - BKOPS_STATUS onwards can change */
+#define EMMC_EXT_CSD_CHECK_START                ( 192 )
+#define EMMC_EXT_CSD_CHECK_END                  ( 246 )
+
+/* Transfers shorter than this (1MB) finish within a few ms ticks and are not timed */
+#define EMMC_THROUGHPUT_MIN_BLOCKS              ( 2048 )
+
+/* EXT_CSD fields used for erase handling */
+#define EMMC_EXT_CSD_SANITIZE_START             ( 165 )
+#define EMMC_EXT_CSD_ERASE_GROUP_DEF            ( 175 )
+#define EMMC_EXT_CSD_REV                        ( 192 )
+#define EMMC_EXT_CSD_HC_ERASE_GRP_SIZE          ( 224 )
+#define EMMC_EXT_CSD_SEC_FEATURE_SUPPORT        ( 231 )
+#define EMMC_ERASE_GROUP_DEF_ENABLE             ( 1 << 0 )
+#define EMMC_SEC_FEATURE_GB_CL_EN               ( 1 << 4 )
+#define EMMC_SEC_FEATURE_SANITIZE               ( 1 << 6 )
+#define EMMC_EXT_CSD_REV_4_5                    ( 6 )
+#define EMMC_HC_ERASE_GRP_UNIT_BLOCKS           ( 1024 )    /* 512KB */
+#define EMMC_DEFAULT_ERASE_GRP_BLOCKS           ( EMMC_HC_ERASE_GRP_UNIT_BLOCKS )
+
+/* CMD38 arguments */
+#define EMMC_ERASE_ARG                          ( 0x00000000 )
+#define EMMC_TRIM_ARG                           ( 0x00000001 )
+#define EMMC_DISCARD_ARG                        ( 0x00000003 )
+#define EMMC_DISCARD_NONE                       ( 0xFFFFFFFF )
+
+/* CMD6 switch: write byte, EXT_CSD index, value */
+#define EMMC_SWITCH_WRITE_BYTE                  ( 0x03 )
+#define EMMC_SWITCH_ARG( idx, val )             ( ( EMMC_SWITCH_WRITE_BYTE << 24 ) | ( ( idx ) << 16 ) | ( ( val ) << 8 ) )
+
+/* CMD13 R1 card status */
+#define EMMC_R1_SWITCH_ERROR                    ( 1 << 7 )
+#define EMMC_R1_STATE( resp )                   ( ( ( resp ) >> 9 ) & 0xF )
+#define EMMC_R1_STATE_TRAN                      ( 4 )
+
 /* Stat & Error definitions */
 #define EMMC_STATS( DO )                                     \
     DO( EMMC_STATS_INIT_COMPLETED )                          \
@@ -45,6 +86,11 @@
     DO( EMMC_STATS_EMMC_READ )                               \
     DO( EMMC_STATS_EMMC_WRITE )                              \
     DO( EMMC_STATS_EMMC_ERASE )                              \
+    DO( EMMC_STATS_BUS_MODE_SWITCH )                         \
+    DO( EMMC_STATS_BUS_MODE_FALLBACK )                       \
+    DO( EMMC_STATS_EMMC_DISCARD )                            \
+    DO( EMMC_STATS_EMMC_SANITISE )                           \
+    DO( EMMC_STATS_SANITISE_STARTED )                        \
     DO( EMMC_STATS_MAX )
 
 #define EMMC_ERRORS( DO )                                    \
@@ -57,6 +103,15 @@
     DO( EMMC_ERRORS_EMMC_READ_FAILED )                       \
     DO( EMMC_ERRORS_EMMC_WRITE_FAILED )                      \
     DO( EMMC_ERRORS_EMMC_ERASE_FAILED )                      \
+    DO( EMMC_ERRORS_EXT_CSD_READ_FAILED )                    \
+    DO( EMMC_ERRORS_BUS_WIDTH_FAILED )                       \
+    DO( EMMC_ERRORS_BUS_SPEED_FAILED )                       \
+    DO( EMMC_ERRORS_BUS_MODE_CHECK_FAILED )                  \
+    DO( EMMC_ERRORS_EMMC_DISCARD_FAILED )                    \
+    DO( EMMC_ERRORS_EMMC_SANITISE_FAILED )                   \
+    DO( EMMC_ERRORS_SANITISE_NOT_SUPPORTED )                 \
+    DO( EMMC_ERRORS_SANITISE_BUSY )                          \
+    DO( EMMC_ERRORS_ERASE_GROUP_DEF_FAILED )                 \
     DO( EMMC_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )         PLL_INF( EMMC_NAME, "%50s . . . . %d\r\n",          \
@@ -91,6 +146,20 @@ UTIL_MAKE_ENUM_AND_STRINGS( EMMC_ERRORS, EMMC_ERRORS, EMMC_ERRORS_STR )
 /* Structs                                                                    */
 /******************************************************************************/
 
+/**
+ * @struct  EMMC_BUS_MODE
+ * @brief   A bus timing mode the driver will try, and what it needs from the card and host
+ */
+typedef struct EMMC_BUS_MODE
+{
+    uint8_t         ucMode;             /* XSdPs bus speed mode */
+    uint8_t         ucDeviceTypeMask;   /* EXT_CSD DEVICE_TYPE bits advertising the mode */
+    int             iNeeds8Bit;         /* Mode is only defined on an 8 bit bus */
+    int             iNeedsHcV3;         /* Mode needs a v3 host controller (tuning) */
+    const char      *pcName;
+
+} EMMC_BUS_MODE;
+
 /**
  * @struct  EMMC_PRIVATE_DATA
  * @brief   Structure to hold ths driver's private data
@@ -106,6 +175,21 @@ typedef struct EMMC_PRIVATE_DATA
 
     void            *pvOsalMutexHdl;
 
+    uint8_t         pucExtCsd[ EMMC_EXT_CSD_SIZE ] __attribute__( ( aligned( EMMC_EXT_CSD_ALIGNMENT ) ) );
+    uint8_t         pucExtCsdCheck[ EMMC_EXT_CSD_SIZE ] __attribute__( ( aligned( EMMC_EXT_CSD_ALIGNMENT ) ) );
+    int             iModeFallback;
+
+    uint32_t        ulEraseGroupBlocks;
+    uint32_t        ulDiscardArg;
+    int             iSanitiseSupported;
+    int             iSanitiseBusy;
+    uint32_t        ulSanitiseStartMs;
+
+    uint64_t        ullReadBytes;
+    uint64_t        ullReadMs;
+    uint64_t        ullWriteBytes;
+    uint64_t        ullWriteMs;
+
     uint32_t        pulStatCounters[ EMMC_STATS_MAX ];
     uint32_t        pulErrorCounters[ EMMC_ERRORS_MAX ];
 
@@ -126,12 +210,35 @@ static EMMC_PRIVATE_DATA xLocalData =
     NULL,                                   /* pxEmmcConfig */
     FALSE,                                  /* iInitialised */
     NULL,                                   /* pvOsalMutexHdl */
+    { 0 },                                  /* pucExtCsd */
+    { 0 },                                  /* pucExtCsdCheck */
+    FALSE,                                  /* iModeFallback */
+    EMMC_DEFAULT_ERASE_GRP_BLOCKS,          /* ulEraseGroupBlocks */
+    EMMC_ERASE_ARG,                         /* ulDiscardArg */
+    FALSE,                                  /* iSanitiseSupported */
+    FALSE,                                  /* iSanitiseBusy */
+    0,                                      /* ulSanitiseStartMs */
+    0,                                      /* ullReadBytes */
+    0,                                      /* ullReadMs */
+    0,                                      /* ullWriteBytes */
+    0,                                      /* ullWriteMs */
     { 0 },                                  /* pulStatCounters */
     { 0 },                                  /* pulErrorCounters */
     LOWER_FIREWALL                          /* ulLowerFirewall */
 };
 static EMMC_PRIVATE_DATA *pxThis = &xLocalData;
 
+/* Fastest first - each entry is tried until one switches and tunes */
+static const EMMC_BUS_MODE pxBusModes[ ] =
+{
+#ifdef XSDPS_HS400_MODE
+    { XSDPS_HS400_MODE,        EXT_CSD_DEVICE_TYPE_DDR_1V8_HS400,       TRUE,  TRUE,  "HS400" },
+#endif
+    { XSDPS_HS200_MODE,        EXT_CSD_DEVICE_TYPE_SDR_1V8_HS200,       TRUE,  TRUE,  "HS200" },
+    { XSDPS_DDR52_MODE,        EXT_CSD_DEVICE_TYPE_DDR_1V8_HIGH_SPEED,  FALSE, FALSE, "DDR52" },
+    { XSDPS_HIGH_SPEED_MODE,   EXT_CSD_DEVICE_TYPE_HIGH_SPEED,          FALSE, FALSE, "HS52" }
+};
+
 
 /******************************************************************************/
 /* Private Function declarations                                              */
@@ -148,6 +255,85 @@ static EMMC_PRIVATE_DATA *pxThis = &xLocalData;
  */
 static int iValidateBlockCount( uint64_t ullBlockAddress, uint32_t ulBlockCount );
 
+/**
+ * @brief   Switch to the widest bus and fastest timing both the card and host support
+ *
+ * @return  OK                 The card is in a working bus mode
+ *          ERROR              No working bus mode could be set
+ *
+ * @note    A mode that fails to switch, tune or pass the readback check falls back
+ *          to the next slower one
+ */
+static int iNegotiateBusMode( void );
+
+/**
+ * @brief   Check data transfers work in the current bus mode
+ *
+ * @return  OK                 EXT_CSD read back and matched the copy read before the switch
+ *          ERROR              The read failed or returned different data
+ *
+ * @note    A switch or tuning can report success on a marginal link, so a mode is
+ *          only kept once a full 512 byte data block has come back intact.
+ */
+static int iCheckBusMode( void );
+
+/**
+ * @brief   Get the display name of a bus speed mode
+ *
+ * @param   ucMode             The XSdPs bus speed mode
+ *
+ * @return  The name of the mode
+ */
+static const char *pcBusModeName( uint8_t ucMode );
+
+/**
+ * @brief   Get the throughput from the bytes moved and the time taken
+ *
+ * @param   ullBytes           Total number of bytes transferred
+ * @param   ullMs              Total time spent in the transfers
+ *
+ * @return  The throughput in KB/s
+ *
+ * @note    Only transfers of at least EMMC_THROUGHPUT_MIN_BLOCKS are counted,
+ *          so the ms timer resolution is small next to each sample
+ */
+static uint32_t ulThroughputKBs( uint64_t ullBytes, uint64_t ullMs );
+
+/**
+ * @brief   Work out the erase group size and the best release command from EXT_CSD
+ */
+static void vParseEraseFeatures( void );
+
+/**
+ * @brief   Issue an erase class command over a block range
+ *
+ * @param   ulStartBlock       The first block of the range
+ * @param   ulEndBlock         The last block of the range
+ * @param   ulArg              CMD38 argument - erase, trim or discard
+ *
+ * @return  OK                 Command completed
+ *          ERROR              Command failed
+ */
+static int iSendEraseCmd( uint32_t ulStartBlock, uint32_t ulEndBlock, uint32_t ulArg );
+
+/**
+ * @brief   Update iSanitiseBusy from the card status if a sanitise was started
+ *
+ * @return  OK                 iSanitiseBusy is up to date
+ *          ERROR              The card could not be queried
+ *
+ * @note    Must be called with the driver mutex held
+ */
+static int iPollSanitise( void );
+
+/**
+ * @brief   Take the driver mutex once no sanitise is running on the card
+ *
+ * @return  OK                 Mutex taken and the card is free
+ *          ERROR              Mutex not taken - timed out or the card is still sanitising
+ */
+static int iTakeIdleCard( void );
+
 
 /******************************************************************************/
 /* Public Function implementations                                            */
@@ -182,6 +368,11 @@ int iEMMC_Initialise( uint32_t ulBaseAddr )
                 PLL_ERR( EMMC_NAME, "Error XSdPs_CardInitialize( ) failed: %d\r\n", iStatus );
                 INC_ERROR_COUNTER( EMMC_ERRORS_XSDPS_CARDINIIALIZE_FAILED )
             }
+            else
+            {
+                iStatus = iNegotiateBusMode();
+                vParseEraseFeatures();
+            }
         }
         else
         {
@@ -227,16 +418,21 @@ int iEMMC_Read( uint64_t ullAddress, uint32_t ulBlockCount , uint8_t *pucReadBuf
         ( NULL != pucReadBuff ) &&
         ( OK == iValidateBlockCount( ullAddress, ulBlockCount ) ) )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  EMMC_WAIT_TIMEOUT_MS ) )
+        if( OK == iTakeIdleCard() )
         {
             INC_STAT_COUNTER( EMMC_STATS_TAKE_MUTEX )
 
             uint32_t ulBlockAddress = ullAddress >> EMMC_BLOCK_BITSHIFT;
+            uint32_t ulStartMs = ulOSAL_GetUptimeMs();
 
             iStatus = XSdPs_ReadPolled( &( pxThis->xSdInstance ), ulBlockAddress, ulBlockCount, pucReadBuff );
             if( OK == iStatus )
             {
+                if( EMMC_THROUGHPUT_MIN_BLOCKS <= ulBlockCount )
+                {
+                    pxThis->ullReadBytes += ( ( uint64_t )ulBlockCount << EMMC_BLOCK_BITSHIFT );
+                    pxThis->ullReadMs += ( ulOSAL_GetUptimeMs() - ulStartMs );
+                }
                 INC_STAT_COUNTER( EMMC_STATS_EMMC_READ )
             }
             else
@@ -254,10 +450,6 @@ int iEMMC_Read( uint64_t ullAddress, uint32_t ulBlockCount , uint8_t *pucReadBuf
                 INC_STAT_COUNTER( EMMC_STATS_RELEASE_MUTEX )
             }
         }
-        else
-        {
-            INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_TAKE_FAILED )
-        }
     }
     return iStatus;
 }
@@ -273,16 +465,21 @@ int iEMMC_Write( uint64_t ullAddress, uint32_t ulBlockCount , const uint8_t *puc
         ( NULL != pucWriteBuff ) &&
         ( OK == iValidateBlockCount( ullAddress, ulBlockCount ) ) )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  EMMC_WAIT_TIMEOUT_MS ) )
+        if( OK == iTakeIdleCard() )
         {
             INC_STAT_COUNTER( EMMC_STATS_TAKE_MUTEX )
 
             uint32_t ulBlockAddress = ullAddress >> EMMC_BLOCK_BITSHIFT;
+            uint32_t ulStartMs = ulOSAL_GetUptimeMs();
 
             iStatus = XSdPs_WritePolled( &( pxThis->xSdInstance ), ulBlockAddress, ulBlockCount, pucWriteBuff );
             if( OK == iStatus )
             {
+                if( EMMC_THROUGHPUT_MIN_BLOCKS <= ulBlockCount )
+                {
+                    pxThis->ullWriteBytes += ( ( uint64_t )ulBlockCount << EMMC_BLOCK_BITSHIFT );
+                    pxThis->ullWriteMs += ( ulOSAL_GetUptimeMs() - ulStartMs );
+                }
                 INC_STAT_COUNTER( EMMC_STATS_EMMC_WRITE )
             }
             else
@@ -300,10 +497,6 @@ int iEMMC_Write( uint64_t ullAddress, uint32_t ulBlockCount , const uint8_t *puc
                 INC_STAT_COUNTER( EMMC_STATS_RELEASE_MUTEX )
             }
         }
-        else
-        {
-            INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_TAKE_FAILED )
-        }
     }
     return iStatus;
 }
@@ -323,8 +516,7 @@ int iEMMC_Erase( uint64_t ullStartBlockAddress, uint64_t ullEndBlockAddress )
         ( pxThis->xSdInstance.BlkSize > ( ullEndBlockAddress >> EMMC_BLOCK_BITSHIFT ) ) &&
         ( ullEndBlockAddress >= ullStartBlockAddress ) )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  EMMC_WAIT_TIMEOUT_MS ) )
+        if( OK == iTakeIdleCard() )
         {
             INC_STAT_COUNTER( EMMC_STATS_TAKE_MUTEX )
 
@@ -351,10 +543,6 @@ int iEMMC_Erase( uint64_t ullStartBlockAddress, uint64_t ullEndBlockAddress )
                 INC_STAT_COUNTER( EMMC_STATS_RELEASE_MUTEX )
             }
         }
-        else
-        {
-            INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_TAKE_FAILED )
-        }
     }
     return iStatus;
 }
@@ -368,8 +556,7 @@ int iEMMC_EraseAll( void )
 
     if( TRUE == pxThis->iInitialised )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  EMMC_WAIT_TIMEOUT_MS ) )
+        if( OK == iTakeIdleCard() )
         {
             uint32_t ulStartBlock = 0;
             uint32_t ulEndBlock = 0;
@@ -396,6 +583,166 @@ int iEMMC_EraseAll( void )
                 }
             }
 
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( EMMC_STATS_RELEASE_MUTEX )
+            }
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Release a range of blocks back to the EMMC's free pool.
+ */
+int iEMMC_Discard( uint64_t ullAddress, uint32_t ulBlockCount )
+{
+    int iStatus = ERROR;
+
+    if( ( TRUE == pxThis->iInitialised ) &&
+        ( 0 != ulBlockCount ) &&
+        ( OK == iValidateBlockCount( ullAddress, ulBlockCount ) ) )
+    {
+        if( OK == iTakeIdleCard() )
+        {
+            uint32_t ulGroup      = pxThis->ulEraseGroupBlocks;
+            uint32_t ulStartBlock = ( uint32_t )( ullAddress >> EMMC_BLOCK_BITSHIFT );
+            uint32_t ulEndBlock   = ulStartBlock + ulBlockCount;
+            uint32_t ulChunkEnd   = 0;
+
+            INC_STAT_COUNTER( EMMC_STATS_TAKE_MUTEX )
+
+            /* A plain erase acts on whole groups - only touch those fully inside the range */
+            if( EMMC_ERASE_ARG == pxThis->ulDiscardArg )
+            {
+                ulStartBlock = ( ( ulStartBlock + ulGroup - 1 ) / ulGroup ) * ulGroup;
+                ulEndBlock   = ( ulEndBlock / ulGroup ) * ulGroup;
+            }
+            else if( EMMC_DISCARD_NONE == pxThis->ulDiscardArg )
+            {
+                /* No safe way to release the range - leave it to be overwritten */
+                ulEndBlock = ulStartBlock;
+            }
+
+            iStatus = OK;
+            while( ( OK == iStatus ) && ( ulStartBlock < ulEndBlock ) )
+            {
+                /* Chunks end on erase group boundaries so whole groups are released */
+                ulChunkEnd = ( ( ulStartBlock / ulGroup ) * ulGroup ) + EMMC_ERASE_BLOCK_INCREMENT;
+                if( ulChunkEnd > ulEndBlock )
+                {
+                    ulChunkEnd = ulEndBlock;
+                }
+
+                iStatus = iSendEraseCmd( ulStartBlock, ulChunkEnd - 1, pxThis->ulDiscardArg );
+                ulStartBlock = ulChunkEnd;
+            }
+
+            if( OK == iStatus )
+            {
+                INC_STAT_COUNTER( EMMC_STATS_EMMC_DISCARD )
+            }
+            else
+            {
+                INC_ERROR_COUNTER( EMMC_ERRORS_EMMC_DISCARD_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( EMMC_STATS_RELEASE_MUTEX )
+            }
+        }
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Start physically purging all unmapped blocks on the EMMC.
+ */
+int iEMMC_Sanitise( void )
+{
+    int iStatus = ERROR;
+
+    if( ( TRUE == pxThis->iInitialised ) &&
+        ( TRUE == pxThis->iSanitiseSupported ) )
+    {
+        if( OK == iTakeIdleCard() )
+        {
+            INC_STAT_COUNTER( EMMC_STATS_TAKE_MUTEX )
+
+            /*
+             * Only wait for the command response - the card then holds DAT0 busy
+             * until the purge is done, which can run for minutes. Completion is
+             * picked up by iPollSanitise( ) from iEMMC_GetSanitiseStatus( ) or
+             * the next access, so the mutex is not held across it.
+             */
+            iStatus = XSdPs_CmdTransfer( &( pxThis->xSdInstance ),
+                                         XSDPS_CMD6,
+                                         EMMC_SWITCH_ARG( EMMC_EXT_CSD_SANITIZE_START, 1 ),
+                                         0 );
+            if( XST_SUCCESS == iStatus )
+            {
+                pxThis->iSanitiseBusy     = TRUE;
+                pxThis->ulSanitiseStartMs = ulOSAL_GetUptimeMs();
+                PLL_LOG( EMMC_NAME, "Sanitise started\r\n" );
+                INC_STAT_COUNTER( EMMC_STATS_SANITISE_STARTED )
+                iStatus = OK;
+            }
+            else
+            {
+                INC_ERROR_COUNTER( EMMC_ERRORS_EMMC_SANITISE_FAILED )
+                iStatus = ERROR;
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( EMMC_STATS_RELEASE_MUTEX )
+            }
+        }
+    }
+    else if( TRUE == pxThis->iInitialised )
+    {
+        INC_ERROR_COUNTER( EMMC_ERRORS_SANITISE_NOT_SUPPORTED )
+    }
+    return iStatus;
+}
+
+/**
+ * @brief   Check whether a sanitise started by iEMMC_Sanitise( ) is still running.
+ */
+int iEMMC_GetSanitiseStatus( int *piInProgress )
+{
+    int iStatus = ERROR;
+
+    if( ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != piInProgress ) )
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  EMMC_WAIT_TIMEOUT_MS ) )
+        {
+            INC_STAT_COUNTER( EMMC_STATS_TAKE_MUTEX )
+
+            if( OK == iPollSanitise() )
+            {
+                *piInProgress = pxThis->iSanitiseBusy;
+                iStatus       = OK;
+            }
+
             if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
             {
                 INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_RELEASE_FAILED )
@@ -475,7 +822,27 @@ int iEMMC_PrintInstanceDetails( void )
         PLL_LOG( EMMC_NAME, "SlcrBaseAddr:          0x%x\n\r", pxThis->xSdInstance.SlcrBaseAddr );  /**< SLCR base address*/
         PLL_LOG( EMMC_NAME, "IsBusy:                0x%x\n\r", pxThis->xSdInstance.IsBusy );        /**< Busy Flag*/
         PLL_LOG( EMMC_NAME, "BlkSize:               0x%x\n\r", pxThis->xSdInstance.BlkSize );       /**< Block Size*/
-        PLL_LOG( EMMC_NAME, "IsTuningDone:          0x%x\n\r", pxThis->xSdInstance.IsTuningDone );  /**< Flag to indicate HS200 tuning complete */
+        PLL_LOG( EMMC_NAME, "IsTuningDone:          0x%x\n\r\n\r",
+                                                               pxThis->xSdInstance.IsTuningDone );  /**< Flag to indicate HS200 tuning complete */
+
+        PLL_LOG( EMMC_NAME, "BUS:\n\r" );
+        PLL_LOG( EMMC_NAME, "Mode:                  %s%s\n\r",
+                                                               pcBusModeName( pxThis->xSdInstance.Mode ),
+                                                               ( TRUE == pxThis->iModeFallback ) ? " (fallback)" : "" );
+        PLL_LOG( EMMC_NAME, "DeviceType:            0x%x\n\r", pxThis->pucExtCsd[ EXT_CSD_DEVICE_TYPE_BYTE ] );
+        PLL_LOG( EMMC_NAME, "EraseGroupBlocks:      0x%x\n\r", pxThis->ulEraseGroupBlocks );
+        PLL_LOG( EMMC_NAME, "Release:               %s\n\r",
+                                                               ( EMMC_DISCARD_ARG == pxThis->ulDiscardArg ) ? "discard" :
+                                                               ( EMMC_TRIM_ARG == pxThis->ulDiscardArg ) ? "trim" :
+                                                               ( EMMC_ERASE_ARG == pxThis->ulDiscardArg ) ? "erase" : "none" );
+        PLL_LOG( EMMC_NAME, "Sanitise:              %s\n\r",
+                                                               ( TRUE == pxThis->iSanitiseSupported ) ? "yes" : "no" );
+        PLL_LOG( EMMC_NAME, "Read throughput:       %d KB/s\n\r",
+                                                               ulThroughputKBs( pxThis->ullReadBytes,
+                                                                                pxThis->ullReadMs ) );
+        PLL_LOG( EMMC_NAME, "Write throughput:      %d KB/s\n\r",
+                                                               ulThroughputKBs( pxThis->ullWriteBytes,
+                                                                                pxThis->ullWriteMs ) );
 
         iStatus = OK;
     }
@@ -566,3 +933,332 @@ static int iValidateBlockCount( uint64_t ullAddress, uint32_t ulBlockCount )
 
     return iStatus;
 }
+
+/**
+ * @brief   Switch to the widest bus and fastest timing both the card and host support
+ */
+static int iNegotiateBusMode( void )
+{
+    int     iStatus      = ERROR;
+    XSdPs   *pxSd        = &( pxThis->xSdInstance );
+    uint8_t ucDeviceType = 0;
+    int     i            = 0;
+
+    /* Widest bus the slot is wired for */
+    if( ( XSDPS_WIDTH_8 == pxThis->pxEmmcConfig->BusWidth ) &&
+        ( XSDPS_8_BIT_WIDTH != pxSd->BusWidth ) )
+    {
+        if( XST_SUCCESS != XSdPs_Change_BusWidth( pxSd ) )
+        {
+            PLL_WRN( EMMC_NAME, "8 bit bus width failed, staying at 0x%x\r\n", pxSd->BusWidth );
+            INC_ERROR_COUNTER( EMMC_ERRORS_BUS_WIDTH_FAILED )
+        }
+    }
+
+    if( XST_SUCCESS == XSdPs_Get_Mmc_ExtCsd( pxSd, pxThis->pucExtCsd ) )
+    {
+        ucDeviceType = pxThis->pucExtCsd[ EXT_CSD_DEVICE_TYPE_BYTE ];
+    }
+    else
+    {
+        PLL_WRN( EMMC_NAME, "EXT_CSD read failed, keeping %s\r\n", pcBusModeName( pxSd->Mode ) );
+        INC_ERROR_COUNTER( EMMC_ERRORS_EXT_CSD_READ_FAILED )
+    }
+
+    for( i = 0; i < ( sizeof( pxBusModes ) / sizeof( pxBusModes[ 0 ] ) ); i++ )
+    {
+        const EMMC_BUS_MODE *pxMode = &pxBusModes[ i ];
+
+        if( ( 0 == ( ucDeviceType & pxMode->ucDeviceTypeMask ) ) ||
+            ( ( TRUE == pxMode->iNeeds8Bit ) && ( XSDPS_8_BIT_WIDTH != pxSd->BusWidth ) ) ||
+            ( ( TRUE == pxMode->iNeedsHcV3 ) && ( XSDPS_HC_SPEC_V3 != pxSd->HC_Version ) ) )
+        {
+            continue;
+        }
+
+        /* Card initialisation may already have selected it */
+        if( pxMode->ucMode == pxSd->Mode )
+        {
+            if( OK == iCheckBusMode() )
+            {
+                iStatus = OK;
+                break;
+            }
+        }
+        else
+        {
+            /* Switching to HS200 and above runs the tuning sequence */
+            pxSd->Mode = pxMode->ucMode;
+            if( XST_SUCCESS != XSdPs_Change_BusSpeed( pxSd ) )
+            {
+                PLL_WRN( EMMC_NAME, "%s switch/tuning failed, falling back\r\n", pxMode->pcName );
+                INC_ERROR_COUNTER( EMMC_ERRORS_BUS_SPEED_FAILED )
+            }
+            else if( OK == iCheckBusMode() )
+            {
+                INC_STAT_COUNTER( EMMC_STATS_BUS_MODE_SWITCH )
+                iStatus = OK;
+                break;
+            }
+        }
+
+        INC_STAT_COUNTER( EMMC_STATS_BUS_MODE_FALLBACK )
+        pxThis->iModeFallback = TRUE;
+    }
+
+    /* Nothing better was advertised or worked - legacy timing */
+    if( ( OK != iStatus ) && ( TRUE == pxThis->iModeFallback ) )
+    {
+        pxSd->Mode = XSDPS_DEFAULT_SPEED_MODE;
+        if( ( XST_SUCCESS == XSdPs_Set_Mmc_ExtCsd( pxSd, XSDPS_MMC_DEF_SPEED_ARG ) ) &&
+            ( XST_SUCCESS == XSdPs_Change_ClkFreq( pxSd, XSDPS_CLK_26_MHZ ) ) )
+        {
+            iStatus = OK;
+        }
+        else
+        {
+            PLL_ERR( EMMC_NAME, "Error: unable to restore legacy timing\r\n" );
+            INC_ERROR_COUNTER( EMMC_ERRORS_BUS_SPEED_FAILED )
+        }
+    }
+    else if( OK != iStatus )
+    {
+        iStatus = OK;
+    }
+
+    if( OK == iStatus )
+    {
+        PLL_LOG( EMMC_NAME, "Bus mode: %s, bus width: 0x%x\r\n", pcBusModeName( pxSd->Mode ), pxSd->BusWidth );
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Check data transfers work in the current bus mode
+ */
+static int iCheckBusMode( void )
+{
+    int iStatus = ERROR;
+
+    if( ( XST_SUCCESS == XSdPs_Get_Mmc_ExtCsd( &( pxThis->xSdInstance ), pxThis->pucExtCsdCheck ) ) &&
+        ( 0 == iOSAL_MemCmp( &pxThis->pucExtCsd[ EMMC_EXT_CSD_CHECK_START ],
+                             &pxThis->pucExtCsdCheck[ EMMC_EXT_CSD_CHECK_START ],
+                             EMMC_EXT_CSD_CHECK_END - EMMC_EXT_CSD_CHECK_START ) ) )
+    {
+        iStatus = OK;
+    }
+    else
+    {
+        PLL_WRN( EMMC_NAME, "%s readback check failed, falling back\r\n",
+                 pcBusModeName( pxThis->xSdInstance.Mode ) );
+        INC_ERROR_COUNTER( EMMC_ERRORS_BUS_MODE_CHECK_FAILED )
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Get the display name of a bus speed mode
+ */
+static const char *pcBusModeName( uint8_t ucMode )
+{
+    const char *pcName = EMMC_MODE_NAME_UNKNOWN;
+    int        i       = 0;
+
+    if( XSDPS_DEFAULT_SPEED_MODE == ucMode )
+    {
+        pcName = EMMC_MODE_NAME_LEGACY;
+    }
+    else
+    {
+        for( i = 0; i < ( sizeof( pxBusModes ) / sizeof( pxBusModes[ 0 ] ) ); i++ )
+        {
+            if( pxBusModes[ i ].ucMode == ucMode )
+            {
+                pcName = pxBusModes[ i ].pcName;
+                break;
+            }
+        }
+    }
+
+    return pcName;
+}
+
+/**
+ * @brief   Get the throughput from the bytes moved and the time taken
+ */
+static uint32_t ulThroughputKBs( uint64_t ullBytes, uint64_t ullMs )
+{
+    uint32_t ulKBs = 0;
+
+    /* bytes per ms is KB/s */
+    if( 0 != ullMs )
+    {
+        ulKBs = ( uint32_t )( ullBytes / ullMs );
+    }
+
+    return ulKBs;
+}
+
+/**
+ * @brief   Work out the erase group size and the best release command from EXT_CSD
+ */
+static void vParseEraseFeatures( void )
+{
+    uint8_t ucSecFeatures = pxThis->pucExtCsd[ EMMC_EXT_CSD_SEC_FEATURE_SUPPORT ];
+    uint8_t ucGroupSize   = pxThis->pucExtCsd[ EMMC_EXT_CSD_HC_ERASE_GRP_SIZE ];
+    uint8_t ucGroupDef    = pxThis->pucExtCsd[ EMMC_EXT_CSD_ERASE_GROUP_DEF ];
+
+    if( 0 != ( ucSecFeatures & EMMC_SEC_FEATURE_GB_CL_EN ) )
+    {
+        pxThis->ulDiscardArg = ( EMMC_EXT_CSD_REV_4_5 <= pxThis->pucExtCsd[ EMMC_EXT_CSD_REV ] ) ?
+                               EMMC_DISCARD_ARG : EMMC_TRIM_ARG;
+    }
+
+    /* HC_ERASE_GRP_SIZE only applies once ERASE_GROUP_DEF is set - the card powers up with it clear */
+    if( ( 0 != ucGroupSize ) &&
+        ( 0 == ( ucGroupDef & EMMC_ERASE_GROUP_DEF_ENABLE ) ) )
+    {
+        if( XST_SUCCESS == XSdPs_Set_Mmc_ExtCsd( &( pxThis->xSdInstance ),
+                                                 EMMC_SWITCH_ARG( EMMC_EXT_CSD_ERASE_GROUP_DEF,
+                                                                  EMMC_ERASE_GROUP_DEF_ENABLE ) ) )
+        {
+            ucGroupDef |= EMMC_ERASE_GROUP_DEF_ENABLE;
+        }
+        else
+        {
+            INC_ERROR_COUNTER( EMMC_ERRORS_ERASE_GROUP_DEF_FAILED )
+        }
+    }
+
+    if( ( 0 != ucGroupSize ) &&
+        ( 0 != ( ucGroupDef & EMMC_ERASE_GROUP_DEF_ENABLE ) ) )
+    {
+        pxThis->ulEraseGroupBlocks = ucGroupSize * EMMC_HC_ERASE_GRP_UNIT_BLOCKS;
+    }
+    else if( EMMC_ERASE_ARG == pxThis->ulDiscardArg )
+    {
+        /* The legacy group size is unknown, so a plain erase could take live data with it */
+        pxThis->ulDiscardArg = EMMC_DISCARD_NONE;
+    }
+
+    pxThis->iSanitiseSupported = ( ( 0 != ( ucSecFeatures & EMMC_SEC_FEATURE_SANITIZE ) ) &&
+                                   ( EMMC_EXT_CSD_REV_4_5 <= pxThis->pucExtCsd[ EMMC_EXT_CSD_REV ] ) ) ? TRUE : FALSE;
+
+    PLL_LOG( EMMC_NAME,
+             "Erase group: %d blocks, release: 0x%x, sanitise: %d\r\n",
+             pxThis->ulEraseGroupBlocks,
+             pxThis->ulDiscardArg,
+             pxThis->iSanitiseSupported );
+}
+
+/**
+ * @brief   Issue an erase class command over a block range
+ */
+static int iSendEraseCmd( uint32_t ulStartBlock, uint32_t ulEndBlock, uint32_t ulArg )
+{
+    int     iStatus = ERROR;
+    XSdPs   *pxSd   = &( pxThis->xSdInstance );
+
+    /* Standard capacity cards take byte addresses */
+    if( 0 == pxSd->HCS )
+    {
+        ulStartBlock <<= EMMC_BLOCK_BITSHIFT;
+        ulEndBlock   <<= EMMC_BLOCK_BITSHIFT;
+    }
+
+    iStatus = XSdPs_CmdTransfer( pxSd, XSDPS_CMD35, ulStartBlock, 0 );
+    if( XST_SUCCESS == iStatus )
+    {
+        iStatus = XSdPs_CmdTransfer( pxSd, XSDPS_CMD36, ulEndBlock, 0 );
+    }
+
+    if( XST_SUCCESS == iStatus )
+    {
+        iStatus = XSdPs_CmdTransfer( pxSd, XSDPS_CMD38, ulArg, 0 );
+    }
+
+    /* CMD38 holds the card busy until the release is done */
+    if( XST_SUCCESS == iStatus )
+    {
+        iStatus = XSdPs_CheckTransferComplete( pxSd );
+    }
+
+    return ( XST_SUCCESS == iStatus ) ? OK : ERROR;
+}
+
+/**
+ * @brief   Update iSanitiseBusy from the card status if a sanitise was started
+ */
+static int iPollSanitise( void )
+{
+    int     iStatus = OK;
+    XSdPs   *pxSd   = &( pxThis->xSdInstance );
+
+    if( TRUE == pxThis->iSanitiseBusy )
+    {
+        iStatus = ERROR;
+
+        if( XST_SUCCESS == XSdPs_CmdTransfer( pxSd, XSDPS_CMD13, pxSd->RelCardAddr, 0 ) )
+        {
+            uint32_t ulResp = XSdPs_ReadReg( pxSd->Config.BaseAddress, XSDPS_RESP0_OFFSET );
+
+            /* The card sits in the programming state until the purge is done */
+            if( EMMC_R1_STATE_TRAN == EMMC_R1_STATE( ulResp ) )
+            {
+                pxThis->iSanitiseBusy = FALSE;
+
+                if( 0 == ( ulResp & EMMC_R1_SWITCH_ERROR ) )
+                {
+                    PLL_LOG( EMMC_NAME,
+                             "Sanitise complete - %dms\r\n",
+                             ulOSAL_GetUptimeMs() - pxThis->ulSanitiseStartMs );
+                    INC_STAT_COUNTER( EMMC_STATS_EMMC_SANITISE )
+                }
+                else
+                {
+                    INC_ERROR_COUNTER( EMMC_ERRORS_EMMC_SANITISE_FAILED )
+                }
+            }
+
+            iStatus = OK;
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Take the driver mutex once no sanitise is running on the card
+ */
+static int iTakeIdleCard( void )
+{
+    int iStatus = ERROR;
+
+    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                              EMMC_WAIT_TIMEOUT_MS ) )
+    {
+        if( ( OK == iPollSanitise() ) &&
+            ( FALSE == pxThis->iSanitiseBusy ) )
+        {
+            iStatus = OK;
+        }
+        else
+        {
+            INC_ERROR_COUNTER( EMMC_ERRORS_SANITISE_BUSY )
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( EMMC_ERRORS_MUTEX_TAKE_FAILED )
+    }
+
+    return iStatus;
+}
+
@@ -119,6 +119,27 @@ static void vEmmcEraseAll( void );
  */
 static void vEmmcEraseBlocks( void );
 
+/**
+ * @brief   Debug function to discard a range of the EMMC
+ *
+ * @return  N/A
+ */
+static void vEmmcDiscard( void );
+
+/**
+ * @brief   Debug function to sanitise the EMMC
+ *
+ * @return  N/A
+ */
+static void vEmmcSanitise( void );
+
+/**
+ * @brief   Debug function to check on a running sanitise
+ *
+ * @return  N/A
+ */
+static void vEmmcSanitiseStatus( void );
+
 /**
  * @brief   Debug function to print EMMC instance details
  *
@@ -167,6 +188,7 @@ void vEMMC_DebugInit( DAL_HDL pxParentHandle )
             if( NULL != pxGetDir )
             {
                 pxDAL_NewDebugFunction( "read",         pxGetDir, vEmmcRead );
+                pxDAL_NewDebugFunction( "sanitise_status", pxGetDir, vEmmcSanitiseStatus );
             }
             if( NULL != pxSetDir )
             {
@@ -174,6 +196,8 @@ void vEMMC_DebugInit( DAL_HDL pxParentHandle )
                 pxDAL_NewDebugFunction( "erase",        pxSetDir, vEmmcErase );
                 pxDAL_NewDebugFunction( "erase_all",    pxSetDir, vEmmcEraseAll );
                 pxDAL_NewDebugFunction( "erase_blocks", pxSetDir, vEmmcEraseBlocks );
+                pxDAL_NewDebugFunction( "discard",      pxSetDir, vEmmcDiscard );
+                pxDAL_NewDebugFunction( "sanitise",     pxSetDir, vEmmcSanitise );
             }
             if( NULL != pxTestDir )
             {
@@ -384,6 +408,56 @@ static void vEmmcEraseAll( void )
     }
 }
 
+/**
+ * @brief   Debug function to discard a range of the EMMC
+ */
+static void vEmmcDiscard( void )
+{
+    uint32_t    ulBlock = 0;
+    uint32_t    ulBlockCount = 0;
+
+    if( OK != iDAL_GetHexInRange( "Enter Start Block:", &ulBlock, 0, EMMC_LAST_BLOCK ) )
+    {
+        PLL_DAL( EMMC_DBG_NAME, "Error retrieving Start Block\r\n" );
+    }
+    else if( OK != iDAL_GetHexInRange( "Enter Block Count:", &ulBlockCount, 1, HAL_EMMC_MAX_BLOCKS ) )
+    {
+        PLL_DAL( EMMC_DBG_NAME, "Error retrieving Block Count\r\n" );
+    }
+    else if( OK != iEMMC_Discard( ( uint64_t )ulBlock << EMMC_BLOCK_BITSHIFT, ulBlockCount ) )
+    {
+        PLL_DAL( EMMC_DBG_NAME, "Error iEMMC_Discard\r\n" );
+    }
+}
+
+/**
+ * @brief   Debug function to sanitise the EMMC
+ */
+static void vEmmcSanitise( void )
+{
+    if( OK != iEMMC_Sanitise() )
+    {
+        PLL_DAL( EMMC_DBG_NAME, "Error iEMMC_Sanitise\r\n" );
+    }
+}
+
+/**
+ * @brief   Debug function to check on a running sanitise
+ */
+static void vEmmcSanitiseStatus( void )
+{
+    int iInProgress = FALSE;
+
+    if( OK != iEMMC_GetSanitiseStatus( &iInProgress ) )
+    {
+        PLL_DAL( EMMC_DBG_NAME, "Error iEMMC_GetSanitiseStatus\r\n" );
+    }
+    else
+    {
+        PLL_DAL( EMMC_DBG_NAME, "Sanitise %s\r\n", ( TRUE == iInProgress ) ? "in progress" : "idle" );
+    }
+}
+
 /**
  * @brief   Debug function to fill variable Gbyte chunks of EMMC
  */
@@ -82,6 +82,45 @@ int iEMMC_Erase( uint64_t ullStartBlockAddress, uint64_t ullEndBlockAddress );
  */
 int iEMMC_EraseAll( void );
 
+/**
+ * @brief   Release a range of blocks back to the EMMC's free pool.
+ *
+ * @param   ullAddress          The EMMC address of the first block
+ * @param   ulBlockCount        The number of blocks to release
+ *
+ * @return  OK                  Range released (or nothing to release)
+ *          ERROR               Release failed
+ *
+ * @note    Uses DISCARD, then TRIM, then erase of the whole erase groups in
+ *          the range, depending on what the card supports. Nothing is
+ *          released if only erase is supported and the erase group size is
+ *          unknown. The contents of a released range are undefined until
+ *          rewritten.
+ */
+int iEMMC_Discard( uint64_t ullAddress, uint32_t ulBlockCount );
+
+/**
+ * @brief   Start physically purging all unmapped blocks on the EMMC.
+ *
+ * @return  OK                  Sanitise was started
+ *          ERROR               Sanitise failed to start or is not supported
+ *
+ * @note    Returns once the card has accepted the command. The purge can take
+ *          minutes; poll iEMMC_GetSanitiseStatus( ) for completion. Other
+ *          accesses fail until the card has finished.
+ */
+int iEMMC_Sanitise( void );
+
+/**
+ * @brief   Check whether a sanitise started by iEMMC_Sanitise( ) is still running.
+ *
+ * @param   piInProgress        Set to TRUE while the card is sanitising
+ *
+ * @return  OK                  Status retrieved
+ *          ERROR               The card could not be queried
+ */
+int iEMMC_GetSanitiseStatus( int *piInProgress );
+
 /**
  * @brief   Print the EMMC detected device details.
  *
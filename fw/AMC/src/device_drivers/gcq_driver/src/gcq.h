@@ -197,6 +197,12 @@ typedef enum GCQ_FLAGS_TYPE
      */
     GCQ_FLAGS_TYPE_DOUBLE_READ_ENABLE  = ( 1 << 0 ),
     GCQ_FLAGS_TYPE_IN_MEM_PTR_ENABLE   = ( 1 << 1 ),
+    /*
+     * Additional queue pair riding on an IP block already initialised
+     * by another instance, the HW is left untouched and in memory
+     * pointers are used as the doorbells (implies IN_MEM_PTR)
+     */
+    GCQ_FLAGS_TYPE_SHARED_IP_ENABLE    = ( 1 << 2 ),
 
     MAX_GCQ_FLAGS_TYPE
 
@@ -217,6 +223,7 @@ typedef enum GCQ_FLAGS_TYPE
  *           - Initialise the internal ring buffers for the producer
  *           - Write the magic metadata to the producer
  *           - Handle the extended driver functionality flags
+ *           - Skip the IP block init if the instance shares an IP block
  *
  * @param    ppxGCQInstance is the instance of the of the GCQ returned by driver
  * @param    pxIOAccess is the bound in function pointers for memory & register access
@@ -408,6 +408,12 @@ GCQ_ERRORS_TYPE xGCQInit( struct GCQ_INSTANCE_TYPE **ppxGCQInstance,
                 GCQ_DEBUG( "Error: Invalid SQ/CQ slot size specified, zero is not a valid value\r\n" );
                 xStatus = GCQ_ERRORS_INVALID_SLOT_SIZE;
             }
+            else if( ( GCQ_FEATURES_IS_SHARED_IP( xflags ) ) &&
+                     ( GCQ_INTERRUPT_MODE_POLLING != xIntMode ) )
+            {
+                GCQ_DEBUG( "Error: A shared IP block instance only supports polling mode\r\n" );
+                xStatus = GCQ_ERRORS_INVALID_ARG;
+            }
 
 
             if( GCQ_ERRORS_NONE == xStatus )
@@ -427,9 +433,19 @@ GCQ_ERRORS_TYPE xGCQInit( struct GCQ_INSTANCE_TYPE **ppxGCQInstance,
             uint64_t ullCQProduced = 0;
             uint64_t ullSQProduced = 0;
 
-            /* Init IP block and configure interrupt mode */
-            xGCQHWInit(xMode, ullBaseAddr, ullRingAddr, pxGCQIOAccess );
-            xGCQHWConfigureInterruptMode( xMode, xIntMode, ullBaseAddr, pxGCQIOAccess );
+            /*
+             * Init IP block and configure interrupt mode, an instance sharing the
+             * IP block must not reset the registers owned by the first instance
+             */
+            if( GCQ_FEATURES_IS_SHARED_IP( xflags ) )
+            {
+                xflags |= GCQ_FLAGS_TYPE_IN_MEM_PTR_ENABLE;
+            }
+            else
+            {
+                xGCQHWInit(xMode, ullBaseAddr, ullRingAddr, pxGCQIOAccess );
+                xGCQHWConfigureInterruptMode( xMode, xIntMode, ullBaseAddr, pxGCQIOAccess );
+            }
 
             if( GCQ_MODE_TYPE_PRODUCER_MODE == xMode )
             {
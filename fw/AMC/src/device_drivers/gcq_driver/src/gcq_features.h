@@ -18,6 +18,7 @@
 
 #define GCQ_FEATURES_IS_IN_MEM_PTR( flags )              ( ( flags & GCQ_FLAGS_TYPE_IN_MEM_PTR_ENABLE ) != 0 )
 #define GCQ_FEATURES_NEED_DOUBLE_MEM_READ( flags )       ( ( flags & GCQ_FLAGS_TYPE_DOUBLE_READ_ENABLE ) != 0 )
+#define GCQ_FEATURES_IS_SHARED_IP( flags )               ( ( flags & GCQ_FLAGS_TYPE_SHARED_IP_ENABLE ) != 0 )
 #define GCQ_FEATURES_DOUBLE_MEM_READ_RETRY_COUNT         ( 1000 )
 
 
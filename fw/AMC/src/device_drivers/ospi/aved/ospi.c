@@ -40,6 +40,13 @@
     DO( OSPI_STATS_CREATE_MUTEX )               \
     DO( OSPI_STATS_TAKE_MUTEX )                 \
     DO( OSPI_STATS_RELEASE_MUTEX )              \
+    DO( OSPI_STATS_SFDP_CONFIG )                \
+    DO( OSPI_STATS_FCT_CONFIG )                 \
+    DO( OSPI_STATS_INTERLEAVED_OPS )            \
+    DO( OSPI_STATS_READ_PREEMPT )               \
+    DO( OSPI_STATS_SUSPEND )                    \
+    DO( OSPI_STATS_RESUME )                     \
+    DO( OSPI_STATS_ERASED_PROGRAMS_SKIPPED )    \
     DO( OSPI_STATS_MAX )
 
 #define OSPI_ERRORS( DO )                       \
@@ -70,6 +77,11 @@
     DO( OSPI_ERRORS_MUTEX_RELEASE_FAILED )      \
     DO( OSPI_ERRORS_MUTEX_TAKE_FAILED )         \
     DO( OSPI_ERRORS_FLASH_ID_READ )             \
+    DO( OSPI_ERRORS_FLASH_CONFIG )              \
+    DO( OSPI_ERRORS_SFDP_READ )                 \
+    DO( OSPI_ERRORS_SFDP_INVALID )              \
+    DO( OSPI_ERRORS_SUSPEND_FAILED )            \
+    DO( OSPI_ERRORS_RESUME_FAILED )             \
     DO( OSPI_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )  PLL_INF( OSPI_NAME,             \
@@ -105,6 +117,7 @@
 #define EXIT_4B_ADDR_MODE        ( 0xE9 )
 #define WRITE_CONFIG_REG         ( 0x81 )
 #define READ_CONFIG_REG          ( 0x85 )
+#define READ_SFDP_CMD            ( 0x5A )
 
 #define SIXTEENMB                ( 0x1000000 )
 
@@ -128,6 +141,11 @@
 #define OSPI_CMD_BUFFER_SIZE            ( 8 )
 #define OSPI_STATUS_BUFFER_SIZE         ( 2 )
 
+#define OSPI_MAX_UNITS                  ( 2 )                                  /* CS0 and CS1 when stacked */
+#define OSPI_PREEMPT_YIELD_MS           ( 1 )                                  /* Lets a waiting reader take the lock */
+#define OSPI_SUSPEND_POLL_RETRIES       ( 1000 )                               /* Flag status reads before a suspend is given up */
+#define OSPI_ERASED_BYTE                ( 0xFF )                               /* State of an erased cell */
+
 #define OSPI_POLL_OVERALL_TIMEOUT_MS    ( 1000 )
 #define OSPI_POLL_INTERVAL_TIMEOUT_MS   ( 100 )
 
@@ -147,6 +165,60 @@
 #define XFLASH_BYTE_COUNT_2             ( 2 )
 #define XFLASH_OPCODE_DUMMY_CYCLES      ( 8 )
 #define XFLASH_STATUS_BYTE              ( 0x80 )
+#define XFLASH_STATUS_ERASE_SUSPEND     ( 0x40 )
+#define XFLASH_STATUS_PROGRAM_SUSPEND   ( 0x04 )
+
+/* JESD216 Serial Flash Discoverable Parameters */
+#define SFDP_SIGNATURE                  ( 0x50444653 )                         /* "SFDP" */
+#define SFDP_HEADER_SIZE                ( 8 )
+#define SFDP_PARAM_HEADER_SIZE          ( 8 )
+#define SFDP_MAX_PARAM_HEADERS          ( 14 )
+#define SFDP_BUFFER_SIZE                ( 128 )
+#define SFDP_DUMMY_CYCLES               ( 8 )
+#define SFDP_DWORD_SIZE                 ( 4 )
+#define SFDP_DWORD( buf, n )            ( ( ( uint32_t )( buf )[ ( ( n ) - 1 ) * SFDP_DWORD_SIZE ] ) |                  \
+                                          ( ( uint32_t )( buf )[ ( ( n ) - 1 ) * SFDP_DWORD_SIZE + 1 ] << BITSHIFT_1B ) | \
+                                          ( ( uint32_t )( buf )[ ( ( n ) - 1 ) * SFDP_DWORD_SIZE + 2 ] << BITSHIFT_2B ) | \
+                                          ( ( uint32_t )( buf )[ ( ( n ) - 1 ) * SFDP_DWORD_SIZE + 3 ] << BITSHIFT_3B ) )
+
+#define SFDP_PARAM_ID_BFPT              ( 0xFF00 )                             /* Basic Flash Parameter Table */
+#define SFDP_PARAM_ID_4BAIT             ( 0xFF84 )                             /* 4-byte Address Instruction Table */
+#define SFDP_PARAM_ID_SECTOR_MAP        ( 0xFF81 )                             /* Sector Map - non-uniform erase layout */
+#define SFDP_PARAM_ID_XSPI_PROFILE1     ( 0xFF05 )                             /* xSPI Profile 1.0 */
+
+#define BFPT_DWORD1_ADDR_BYTES_MASK     ( 0x00060000 )
+#define BFPT_DWORD1_ADDR_BYTES_3B_ONLY  ( 0x00000000 )
+#define BFPT_DWORD2_DENSITY_POW2        ( 0x80000000 )
+#define BFPT_DWORD11_PAGE_SIZE_SHIFT    ( 4 )
+#define BFPT_DWORD11_PAGE_SIZE_MASK     ( 0xF )
+#define BFPT_DWORD17_1_8_8_WAIT_SHIFT   ( 0 )
+#define BFPT_DWORD17_1_8_8_MODE_SHIFT   ( 5 )
+#define BFPT_DWORD17_1_8_8_OPCODE_SHIFT ( 8 )
+#define BFPT_DWORD17_CLOCKS_MASK        ( 0x1F )
+#define BFPT_DWORD17_MODE_MASK          ( 0x7 )
+#define BFPT_ERASE_DWORD                ( 8 )
+#define BFPT_PAGE_SIZE_DWORD            ( 11 )
+#define BFPT_OCTAL_READ_DWORD           ( 17 )
+#define BFPT_SUSPEND_INFO_DWORD         ( 12 )
+#define BFPT_SUSPEND_CMD_DWORD          ( 13 )
+#define BFPT_DWORD12_NO_SUSPEND         ( 0x80000000 )
+#define BFPT_DWORD13_RESUME_SHIFT       ( 16 )
+#define BFPT_DWORD13_SUSPEND_SHIFT      ( 24 )
+
+#define FOURBAIT_READ_1_8_8             ( 1 << 21 )
+#define FOURBAIT_PROGRAM_1_1_1          ( 1 << 6 )
+#define FOURBAIT_PROGRAM_1_1_8          ( 1 << 22 )
+#define FOURBAIT_ERASE_TYPE_SHIFT       ( 9 )
+
+#define XSPI_DWORD1_READ_CMD_SHIFT      ( 8 )
+#define XSPI_DWORD4_DUMMY_200MHZ_SHIFT  ( 7 )
+#define XSPI_DUMMY_MASK                 ( 0x1F )
+#define XSPI_DUMMY_DEFAULT              ( 20 )
+
+#define OSPI_ERASE_TYPES_MAX            ( 4 )
+#define BYTE_MASK                       ( 0xFF )
+#define BITS_PER_BYTE                   ( 8 )
+#define BYTES_PER_BYTE_SHIFT            ( 3 )
 
 
 /******************************************************************************/
@@ -193,6 +265,29 @@ typedef struct OSPI_FLASH_INFO
 
 } OSPI_FLASH_INFO;
 
+/**
+ * @struct  OSPI_ERASE_TYPE
+ * @brief   An erase granularity supported by the flash device
+ */
+typedef struct OSPI_ERASE_TYPE
+{
+    uint32_t ulSize;                                                           /* Bytes erased by one command */
+    uint8_t  ucCmd;                                                            /* 4-byte address erase opcode */
+
+} OSPI_ERASE_TYPE;
+
+/**
+ * @struct  OSPI_UNIT_WORK
+ * @brief   Outstanding erase work on one independently busy flash unit
+ */
+typedef struct OSPI_UNIT_WORK
+{
+    uint32_t ulAddress;                                                        /* Next address to issue */
+    uint32_t ulRemaining;                                                      /* Bytes still to issue */
+    uint32_t ulInFlight;                                                       /* Bytes covered by the erase in progress */
+
+} OSPI_UNIT_WORK;
+
 /**
  * @struct  OSPI_PRIVATE_DATA
  * @brief   Structure to hold ths driver's private data
@@ -206,11 +301,26 @@ typedef struct OSPI_PRIVATE_DATA
     uint32_t ulFlashMake;
     uint32_t ulOspiSectorSize;
     uint8_t  ucFctIndex;
+    int      iFctFound;
+    int      iSfdpFound;
+    OSPI_FLASH_INFO xFlashInfo;
+    OSPI_ERASE_TYPE pxEraseTypes[ OSPI_ERASE_TYPES_MAX ];
+    uint8_t  ucNumEraseTypes;
+    uint8_t  ucOctalDtrReadCmd;
+    uint8_t  ucOctalDtrDummyCycles;
     uint32_t ulPageSize;
     uint8_t  ucOspiFlashPercentage;
     void     *pvOsalMutexHdl;
     void     *pvTimerHandle;
     int      iAbortPollWait;
+    uint8_t  ucNumUnits;
+    int      piUnitBusy[ OSPI_MAX_UNITS ];
+    int      piUnitSuspended[ OSPI_MAX_UNITS ];
+    uint8_t  ucSuspendCmd;
+    uint8_t  ucResumeCmd;
+    uint32_t ulReadsPending;
+    int      iUpdateSuspended;
+    uint32_t ulLastWriteSkipped;
     uint8_t  ucReadBfrPtr[ OSPI_READ_BUFFER_SIZE ] __attribute__ ( ( aligned ( OSPI_DATA_ALIGNMENT ) ) );
 
     uint32_t pulStatCounters[ OSPI_STATS_MAX ];
@@ -269,6 +379,16 @@ static OSPI_FLASH_INFO pxFlashConfigTable[] =
 };
 
 
+/* Starting point for parts not in the table above, refined from their SFDP */
+static const OSPI_FLASH_INFO xSfdpFlashInfo =
+{
+    0, FLASH_SECTOR_SIZE_64KB, 0, FLASH_PAGE_SIZE_DEFAULT, 0,
+    0, 1,
+    READ_CMD_OCTAL_IO_4B, ( WRITE_CMD_OCTAL_4B << BITSHIFT_1B ) | WRITE_CMD_4B,
+    ( DIE_ERASE_CMD << BITSHIFT_2B ) | ( BULK_ERASE_CMD << BITSHIFT_1B ) | SEC_ERASE_CMD_4B,
+    READ_FLAG_STATUS_CMD, 16
+};
+
 static OSPI_PRIVATE_DATA xLocalData =
 {
     UPPER_FIREWALL, /* ulUpperFirewall */
@@ -279,11 +399,34 @@ static OSPI_PRIVATE_DATA xLocalData =
     0,              /* ulFlashMake */
     0,              /* ulOspiSectorSize */
     0,              /* ucFctIndex */
+    FALSE,          /* iFctFound */
+    FALSE,          /* iSfdpFound */
+    {
+        0
+    },              /* xFlashInfo */
+    { {
+          0
+    } },            /* pxEraseTypes */
+    0,              /* ucNumEraseTypes */
+    0,              /* ucOctalDtrReadCmd */
+    0,              /* ucOctalDtrDummyCycles */
     0,              /* ulPageSize */
     0,              /* ucOspiFlashPercentage */
     NULL,           /* pvOsalMutexHdl */
     NULL,           /* pvTimerHandle */
     FALSE,          /* iAbortPollWait */
+    1,              /* ucNumUnits */
+    {
+        FALSE
+    },              /* piUnitBusy */
+    {
+        FALSE
+    },              /* piUnitSuspended */
+    0,              /* ucSuspendCmd */
+    0,              /* ucResumeCmd */
+    0,              /* ulReadsPending */
+    FALSE,          /* iUpdateSuspended */
+    0,              /* ulLastWriteSkipped */
     {
         0
     },              /* ucReadBfrPtr */
@@ -456,6 +599,155 @@ static int iDieErase( XOspiPsv *pxOspiPsvPtr );
  */
 static void vTimerPollTimeoutCb( void *pvTimerHandle );
 
+/**
+ * @brief   Build the flash configuration, from SFDP where the part provides it
+ *          and from the FCT otherwise
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ */
+static int iFlashConfigure( XOspiPsv *pxOspiPsvPtr );
+
+/**
+ * @brief   Read from the SFDP address space of the flash device
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ * @param   ulAddress           SFDP address to read from
+ * @param   ulByteCount         Number of bytes to read (at most SFDP_BUFFER_SIZE)
+ * @param   pucReadBfrPtr       8 byte aligned buffer of SFDP_BUFFER_SIZE bytes
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ */
+static int iFlashReadSfdp( XOspiPsv *pxOspiPsvPtr,
+                           uint32_t ulAddress,
+                           uint32_t ulByteCount,
+                           uint8_t *pucReadBfrPtr );
+
+/**
+ * @brief   Parse the SFDP tables of the flash device into the flash configuration
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ *
+ * @return  XST_SUCCESS if a valid Basic Flash Parameter Table was applied, else XST_FAILURE.
+ */
+static int iFlashParseSfdp( XOspiPsv *pxOspiPsvPtr );
+
+/**
+ * @brief   Pick the largest erase type that fits the remaining range
+ *
+ * @param   ulAddress           Address of the next erase
+ * @param   ulRemaining         Number of bytes still to erase
+ *
+ * @return  Index into the erase types
+ */
+static uint8_t ucSelectEraseType( uint32_t ulAddress, uint32_t ulRemaining );
+
+/**
+ * @brief   Get the flash unit (chip select) an address belongs to
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ * @param   ulAddress           Flash address
+ *
+ * @return  Unit index, 0 unless the flashes are stacked
+ */
+static uint8_t ucGetUnit( XOspiPsv *pxOspiPsvPtr, uint32_t ulAddress );
+
+/**
+ * @brief   Read the flag status of the selected flash once, without waiting
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ * @param   piReady             Set TRUE if the flash is ready for the next operation
+ * @param   pucFlagStatus       Optional copy of the flag status register
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ */
+static int iReadFlagStatus( XOspiPsv *pxOspiPsvPtr, int *piReady, uint8_t *pucFlagStatus );
+
+/**
+ * @brief   Start an erase without waiting for it to complete
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ * @param   ulAddress           Address to erase
+ * @param   ucEraseType         Index into the erase types
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ */
+static int iIssueErase( XOspiPsv *pxOspiPsvPtr, uint32_t ulAddress, uint8_t ucEraseType );
+
+/**
+ * @brief   Erase a range, overlapping the erases across the flash units
+ *          so that an idle unit is erasing while another is still busy
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ * @param   ulAddress           Start address of the range
+ * @param   ulByteCount         Number of bytes in the range
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note    Programs are short and issued one at a time by iFlashWrite, so only
+ *          erases gain from overlapping.
+ */
+static int iScheduleUnits( XOspiPsv *pxOspiPsvPtr,
+                           uint32_t ulAddress,
+                           uint32_t ulByteCount );
+
+/**
+ * @brief   Wait for any unit left busy by an earlier erase to finish
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note    Called on entry to every read, write and erase. Units suspended
+ *          to serve a read are left alone, as they can be read while suspended.
+ */
+static int iWaitUnitsIdle( XOspiPsv *pxOspiPsvPtr );
+
+/**
+ * @brief   Send a single opcode with no address or data
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ * @param   ucCmd               Opcode to send
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ */
+static int iSendFlashCmd( XOspiPsv *pxOspiPsvPtr, uint8_t ucCmd );
+
+/**
+ * @brief   Take the driver lock for an erase or write, waiting out any update
+ *          that is suspended while a read is served
+ *
+ * @return  OSAL_ERRORS_NONE if the lock was taken, else the OSAL error
+ */
+static int iTakeUpdateLock( void );
+
+/**
+ * @brief   Hand the driver lock to any waiting readers part way through an update
+ *
+ * @param   pxOspiPsvPtr        The XOspiPsv driver instance
+ *
+ * @return  XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note    Called with the lock held. Busy units are suspended first where the part
+ *          supports it; otherwise readers only get in while every unit is idle.
+ *          A reader must not target the range being updated.
+ */
+static int iServicePendingReads( XOspiPsv *pxOspiPsvPtr );
+
+/**
+ * @brief   Check if data matches the erased state of the flash
+ *
+ * @param   pucData             Data about to be programmed
+ * @param   ulLength            Number of bytes to check
+ *
+ * @return  TRUE if every byte is 0xFF, else FALSE
+ *
+ * @note    Programming can only clear bits, so programming 0xFF leaves the
+ *          flash unchanged whatever it held and the operation can be skipped.
+ */
+static int iIsErasedPattern( const uint8_t *pucData, uint32_t ulLength );
+
 
 /******************************************************************************/
 /* Public Function implementations                                            */
@@ -596,6 +888,18 @@ int iOSPI_FlashInit( OSPI_CFG_TYPE *pxOspiCfg )
             }
         }
 
+        /* Opcodes and geometry - SFDP first, the FCT for parts without it */
+        if( OK == iStatus )
+        {
+            iOspiStatus = iFlashConfigure( &pxThis->xOspiPsvInstance );
+            if( XST_SUCCESS != iOspiStatus )
+            {
+                PLL_ERR( OSPI_NAME, "Error: iFlashConfigure failed:%d\r\n", iOspiStatus );
+                INC_ERROR_COUNTER( OSPI_ERRORS_FLASH_CONFIG )
+                iStatus = ERROR;
+            }
+        }
+
         /* Set Flash device and Controller modes */
         if( OK == iStatus )
         {
@@ -610,7 +914,7 @@ int iOSPI_FlashInit( OSPI_CFG_TYPE *pxOspiCfg )
 
         if( OK == iStatus )
         {
-            if( pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize > SIXTEENMB )
+            if( pxThis->xFlashInfo.ulFlashDeviceSize > SIXTEENMB )
             {
                 iOspiStatus = iFlashSet4bAddrMode( &pxThis->xOspiPsvInstance, TRUE );
                 if( XST_SUCCESS != iOspiStatus )
@@ -627,8 +931,8 @@ int iOSPI_FlashInit( OSPI_CFG_TYPE *pxOspiCfg )
             if( XOSPIPSV_CONNECTION_MODE_STACKED == pxThis->xOspiPsvInstance.Config.ConnectionMode )
             {
                 /* TODO: need to understand why this is * 2*/
-                pxFlashConfigTable[ pxThis->ucFctIndex ].ulNumPage   *= 2;
-                pxFlashConfigTable[ pxThis->ucFctIndex ].ululNumSect *= 2;
+                pxThis->xFlashInfo.ulNumPage   *= 2;
+                pxThis->xFlashInfo.ululNumSect *= 2;
 
                 /* Reset the controller mode to NON-PHY */
                 iOspiStatus = XOspiPsv_SetSdrDdrMode( &pxThis->xOspiPsvInstance, XOSPIPSV_EDGE_MODE_SDR_NON_PHY );
@@ -665,7 +969,7 @@ int iOSPI_FlashInit( OSPI_CFG_TYPE *pxOspiCfg )
 
                 if( OK == iStatus )
                 {
-                    if( pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize > SIXTEENMB )
+                    if( pxThis->xFlashInfo.ulFlashDeviceSize > SIXTEENMB )
                     {
                         iOspiStatus = iFlashSet4bAddrMode( &pxThis->xOspiPsvInstance, TRUE );
                         if( XST_SUCCESS != iOspiStatus )
@@ -682,11 +986,11 @@ int iOSPI_FlashInit( OSPI_CFG_TYPE *pxOspiCfg )
         /* Page Size */
         if( OK == iStatus )
         {
-            if( pxFlashConfigTable[ pxThis->ucFctIndex ].ulPageSize != pxThis->ulPageSize )
+            if( pxThis->xFlashInfo.ulPageSize != pxThis->ulPageSize )
             {
                 PLL_ERR( OSPI_NAME,
                          "Error: page size is: %d, expected: %d\r\n",
-                         pxFlashConfigTable[ pxThis->ucFctIndex ].ulPageSize,
+                         pxThis->xFlashInfo.ulPageSize,
                          pxThis->ulPageSize );
                 INC_ERROR_COUNTER( OSPI_ERRORS_PAGE_SIZE )
                 iStatus = ERROR;
@@ -696,12 +1000,18 @@ int iOSPI_FlashInit( OSPI_CFG_TYPE *pxOspiCfg )
         /* Sector Size */
         if( OK == iStatus )
         {
-            pxThis->ulOspiSectorSize = pxFlashConfigTable[ pxThis->ucFctIndex ].ulSectSize;
+            pxThis->ulOspiSectorSize = pxThis->xFlashInfo.ulSectSize;
+            pxThis->ucNumUnits       = 1;
+            if( XOSPIPSV_CONNECTION_MODE_STACKED == pxThis->xOspiPsvInstance.Config.ConnectionMode )
+            {
+                pxThis->ucNumUnits = OSPI_MAX_UNITS;
+            }
             PLL_LOG( OSPI_NAME,
-                     "FCT Index:%d, page size:%d, sector size:%d\r\n",
-                     pxThis->ucFctIndex,
+                     "Config:%s, page size:%d, sector size:%d, largest erase:%d\r\n",
+                     ( TRUE == pxThis->iSfdpFound ) ? "SFDP" : "FCT",
                      pxThis->ulPageSize,
-                     pxThis->ulOspiSectorSize );
+                     pxThis->ulOspiSectorSize,
+                     pxThis->pxEraseTypes[ 0 ].ulSize );
             pxThis->iInitialised = TRUE;
             INC_STAT_COUNTER( OSPI_STATS_INIT_COMPLETED )
         }
@@ -726,8 +1036,7 @@ int iOSPI_FlashErase( uint32_t ulAddr, uint32_t ulLength )
         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
         ( TRUE == pxThis->iInitialised ) )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        if( OSAL_ERRORS_NONE == iTakeUpdateLock() )
         {
             int     iOspiStatus = XST_FAILURE;
             uint8_t ucCmdBfr[ OSPI_CMD_BUFFER_SIZE ] =
@@ -792,8 +1101,20 @@ int iOSPI_FlashRead( uint32_t ulAddr, uint8_t *pucReadBuffer, uint32_t *pulLengt
         ( NULL != pucReadBuffer ) &&
         ( NULL != pulLength ) )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        int iMutexStatus = OSAL_ERRORS_NONE;
+
+        /* Let a long erase or write in progress know that a read is waiting */
+        vOSAL_EnterCritical();
+        pxThis->ulReadsPending++;
+        vOSAL_ExitCritical();
+
+        iMutexStatus = iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl, OSAL_TIMEOUT_WAIT_FOREVER );
+
+        vOSAL_EnterCritical();
+        pxThis->ulReadsPending--;
+        vOSAL_ExitCritical();
+
+        if( OSAL_ERRORS_NONE == iMutexStatus )
         {
             int iOspiStatus = XST_FAILURE;
 
@@ -848,14 +1169,14 @@ int iOSPI_FlashWrite( uint32_t ulAddr, uint8_t *pucWriteBuffer, uint32_t ulLengt
         ( TRUE == pxThis->iInitialised ) &&
         ( NULL != pucWriteBuffer ) )
     {
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        if( OSAL_ERRORS_NONE == iTakeUpdateLock() )
         {
             int      iOspiStatus = XST_FAILURE;
             int      iPage       = 0;
             uint32_t ucPageCount = 0;
             uint32_t ucPageSize  = pxThis->ulPageSize;
             pxThis->ucOspiFlashPercentage = 0;
+            pxThis->ulLastWriteSkipped    = 0;
 
             INC_STAT_COUNTER( OSPI_STATS_TAKE_MUTEX )
 
@@ -880,11 +1201,11 @@ int iOSPI_FlashWrite( uint32_t ulAddr, uint8_t *pucWriteBuffer, uint32_t ulLengt
             {
                 PLL_DBG( OSPI_NAME,
                          "WriteCmd: 0x%x\r\n",
-                         ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulWriteCmd >> BITSHIFT_1B ) );
+                         ( uint8_t )( pxThis->xFlashInfo.ulWriteCmd >> BITSHIFT_1B ) );
 
                 iOspiStatus = iFlashLinearWrite( &pxThis->xOspiPsvInstance,
                                                  ulAddr,
-                                                 ( pxFlashConfigTable[ pxThis->ucFctIndex ].ulPageSize * ucPageCount ),
+                                                 ( pxThis->xFlashInfo.ulPageSize * ucPageCount ),
                                                  pucWriteBuffer );
                 if( XST_SUCCESS == iOspiStatus )
                 {
@@ -902,10 +1223,16 @@ int iOSPI_FlashWrite( uint32_t ulAddr, uint8_t *pucWriteBuffer, uint32_t ulLengt
 
                 PLL_DBG( OSPI_NAME,
                          "WriteCmd: 0x%x \r\n",
-                         ( uint8_t )pxFlashConfigTable[ pxThis->ucFctIndex ].ulWriteCmd );
+                         ( uint8_t )pxThis->xFlashInfo.ulWriteCmd );
                 for( iPage = 0; iPage < ucPageCount; iPage++ )
                 {
-                    uint32_t ulWriteOffset = ( iPage * pxFlashConfigTable[ pxThis->ucFctIndex ].ulPageSize );
+                    uint32_t ulWriteOffset = ( iPage * pxThis->xFlashInfo.ulPageSize );
+                    uint32_t ulPageData    = ulLength - ulWriteOffset;
+
+                    if( ulPageData > pxThis->xFlashInfo.ulPageSize )
+                    {
+                        ulPageData = pxThis->xFlashInfo.ulPageSize;
+                    }
 
                     pxThis->ucOspiFlashPercentage = ( iPage * 100 / ucPageCount );
                     /* Only display when its been updated */
@@ -917,10 +1244,22 @@ int iOSPI_FlashWrite( uint32_t ulAddr, uint8_t *pucWriteBuffer, uint32_t ulLengt
                         ucOspiPrevFlashPercentage = pxThis->ucOspiFlashPercentage;
                     }
 
-                    iOspiStatus = iFlashWrite( &pxThis->xOspiPsvInstance,
-                                               ulAddr + ulWriteOffset,
-                                               ( ( pxFlashConfigTable[ pxThis->ucFctIndex ].ulPageSize ) ),
-                                               pucWriteBuffer + ulWriteOffset );
+                    if( TRUE == iIsErasedPattern( pucWriteBuffer + ulWriteOffset, ulPageData ) )
+                    {
+                        INC_STAT_COUNTER( OSPI_STATS_ERASED_PROGRAMS_SKIPPED )
+                        pxThis->ulLastWriteSkipped += ulPageData;
+                        iStatus = OK;
+                        continue;
+                    }
+
+                    iOspiStatus = iServicePendingReads( &pxThis->xOspiPsvInstance );
+                    if( XST_SUCCESS == iOspiStatus )
+                    {
+                        iOspiStatus = iFlashWrite( &pxThis->xOspiPsvInstance,
+                                                   ulAddr + ulWriteOffset,
+                                                   ( ( pxThis->xFlashInfo.ulPageSize ) ),
+                                                   pucWriteBuffer + ulWriteOffset );
+                    }
                     if( XST_SUCCESS != iOspiStatus )
                     {
                         PLL_ERR( OSPI_NAME, "Error: write failed: %d\r\n", iOspiStatus );
@@ -1052,6 +1391,25 @@ int iOSPI_GetOperationProgress( uint8_t *pucPercentage )
     return iStatus;
 }
 
+/**
+ * @brief   Return how much of the last write needed no programming
+ */
+int iOSPI_GetLastWriteSkipped( uint32_t *pulSkippedBytes )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pulSkippedBytes ) )
+    {
+        iStatus          = OK;
+        *pulSkippedBytes = pxThis->ulLastWriteSkipped;
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Print all the stats gathered by the driver
  */
@@ -1277,7 +1635,10 @@ static int iFlashReadId( XOspiPsv *pxOspiPsvPtr )
                          pxThis->ucReadBfrPtr[ 2 ] );
 
             pxThis->ulFlashMake = pxThis->ucReadBfrPtr[ 0 ];
-            iOspiStatus         = iFindFctIndex( ulReadId, &pxThis->ucFctIndex );
+
+            /* Parts missing from the FCT can still be configured from SFDP */
+            pxThis->iFctFound = ( XST_SUCCESS == iFindFctIndex( ulReadId, &pxThis->ucFctIndex ) ) ? TRUE : FALSE;
+            pxThis->xFlashInfo.ulJedecId = ulReadId;
         }
     }
     else
@@ -1484,7 +1845,7 @@ int iFlashSet4bAddrMode( XOspiPsv *pxOspiPsvPtr, int iEnable )
         {
             FOREVER
             {
-                xFlashMsg.Opcode      = pxFlashConfigTable[ pxThis->ucFctIndex ].ucStatusCmd;
+                xFlashMsg.Opcode      = pxThis->xFlashInfo.ucStatusCmd;
                 xFlashMsg.Addrsize    = 0;
                 xFlashMsg.Addrvalid   = 0;
                 xFlashMsg.TxBfrPtr    = NULL;
@@ -1579,10 +1940,10 @@ static int iGetRealAddr( XOspiPsv *pxOspiPsvPtr, uint32_t ulAddress, uint32_t *p
         *pulRealAddress = ulAddress;
 
         if( ( XOSPIPSV_CONNECTION_MODE_STACKED == pxOspiPsvPtr->Config.ConnectionMode ) &&
-            ( ulAddress & pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize ) )
+            ( ulAddress & pxThis->xFlashInfo.ulFlashDeviceSize ) )
         {
             ucChipSel       = XOSPIPSV_SELECT_FLASH_CS1;
-            *pulRealAddress = ulAddress & ( ~pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize );
+            *pulRealAddress = ulAddress & ( ~pxThis->xFlashInfo.ulFlashDeviceSize );
         }
 
         iOspiStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr, ucChipSel );
@@ -1649,47 +2010,42 @@ static int iFlashErase( XOspiPsv *pxOspiPsvPtr,
         ( NULL != pxOspiPsvPtr ) &&
         ( NULL != pucWriteBfrPtr ) )
     {
-        XOspiPsv_Msg xFlashMsg =
-        {
-            0
-        };
-        int      iSector   = 0;
-        uint32_t ulNumSect = 0;
-        uint8_t  ucFlashStatus[ OSPI_STATUS_BUFFER_SIZE ] __attribute__ ( ( aligned( OSPI_WRITE_BUFFER_ALIGNMENT ) ) ) =
-        {
-            0
-        };
-        uint32_t ulRealAddr = 0;
-
         /*
          * If erase size is same as the total size of the flash, use bulk erase
          * command or die erase command multiple times as required
          */
-        if( ulByteCount == ( pxFlashConfigTable[ pxThis->ucFctIndex ].ululNumSect *
-                             pxFlashConfigTable[ pxThis->ucFctIndex ].ulSectSize ) )
+        if( ulByteCount == ( pxThis->xFlashInfo.ululNumSect *
+                             pxThis->xFlashInfo.ulSectSize ) )
         {
-            if( XOSPIPSV_CONNECTION_MODE_STACKED == pxOspiPsvPtr->Config.ConnectionMode )
+            /* The scheduler waits for busy units itself, a full erase must do so first */
+            int iWaitStatus = iWaitUnitsIdle( pxOspiPsvPtr );
+
+            if( XST_SUCCESS != iWaitStatus )
+            {
+                iOspiStatus = iWaitStatus;
+            }
+            else if( XOSPIPSV_CONNECTION_MODE_STACKED == pxOspiPsvPtr->Config.ConnectionMode )
             {
                 iOspiStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr, XOSPIPSV_SELECT_FLASH_CS0 );
             }
 
             if( XST_SUCCESS == iOspiStatus )
             {
-                if( 1 == pxFlashConfigTable[ pxThis->ucFctIndex ].ucNumDie )
+                if( 1 == pxThis->xFlashInfo.ucNumDie )
                 {
                     /* Call Bulk erase */
                     PLL_DBG( OSPI_NAME,
                              "Bulk EraseCmd: 0x%x\r\n",
-                             ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd >> BITSHIFT_1B ) );
+                             ( uint8_t )( pxThis->xFlashInfo.ulEraseCmd >> BITSHIFT_1B ) );
                     iBulkErase( pxOspiPsvPtr );
                 }
 
-                if( pxFlashConfigTable[ pxThis->ucFctIndex ].ucNumDie > 1 )
+                if( pxThis->xFlashInfo.ucNumDie > 1 )
                 {
                     /* Call Die erase */
                     PLL_DBG( OSPI_NAME,
                              "Die EraseCmd: 0x%x\r\n",
-                             ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd >> BITSHIFT_2B ) );
+                             ( uint8_t )( pxThis->xFlashInfo.ulEraseCmd >> BITSHIFT_2B ) );
                     iDieErase( pxOspiPsvPtr );
                 }
 
@@ -1698,22 +2054,22 @@ static int iFlashErase( XOspiPsv *pxOspiPsvPtr,
                     iOspiStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr, XOSPIPSV_SELECT_FLASH_CS1 );
                     if( XST_SUCCESS == iOspiStatus )
                     {
-                        if( 1 == pxFlashConfigTable[ pxThis->ucFctIndex ].ucNumDie )
+                        if( 1 == pxThis->xFlashInfo.ucNumDie )
                         {
                             /* Call Bulk erase */
                             PLL_DBG( OSPI_NAME,
                                      "Bulk EraseCmd 0x%x\r\n",
-                                     ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd >>
+                                     ( uint8_t )( pxThis->xFlashInfo.ulEraseCmd >>
                                                   BITSHIFT_1B ) );
                             iBulkErase( pxOspiPsvPtr );
                         }
 
-                        if( pxFlashConfigTable[ pxThis->ucFctIndex ].ucNumDie > 1 )
+                        if( pxThis->xFlashInfo.ucNumDie > 1 )
                         {
                             /* Call Die erase */
                             PLL_DBG( OSPI_NAME,
                                      "Die EraseCmd 0x%x\r\n",
-                                     ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd >>
+                                     ( uint8_t )( pxThis->xFlashInfo.ulEraseCmd >>
                                                   BITSHIFT_2B ) );
                             iDieErase( pxOspiPsvPtr );
                         }
@@ -1731,113 +2087,13 @@ static int iFlashErase( XOspiPsv *pxOspiPsvPtr,
         }
         else
         {
-            PLL_DBG( OSPI_NAME, "EraseCmd 0x%x\r\n", ( uint8_t )pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd );
-
             /*
              * If the erase size is less than the total size of the flash, use
-             * sector erase command
+             * the largest erase command that fits at each step; a partial
+             * trailing sector is rounded up to the smallest erase size. When
+             * the range spans stacked flashes the erases are interleaved
              */
-
-            /*
-             * Calculate no. of sectors to erase based on byte count
-             */
-            ulNumSect = ulByteCount / ( pxFlashConfigTable[ pxThis->ucFctIndex ].ulSectSize );
-            if( 0 != ( ulByteCount % ( pxFlashConfigTable[ pxThis->ucFctIndex ].ulSectSize ) ) )
-            {
-                ulNumSect += 1;
-            }
-
-            for( iSector = 0; iSector < ulNumSect; iSector++ )
-            {
-                /*
-                 * Translate address based on type of connection
-                 * If stacked assert the slave select based on address
-                 */
-                iOspiStatus = iGetRealAddr( pxOspiPsvPtr, ulAddress, &ulRealAddr );
-                if( XST_SUCCESS != iOspiStatus )
-                {
-                    PLL_ERR( OSPI_NAME, "Error: iGetRealAddr failed: %d\r\n", iOspiStatus );
-                    break;
-                }
-
-                /*
-                 * Send the write enable command to the Flash so that it can be
-                 * written to, this needs to be sent as a separate transfer before
-                 * the write
-                 */
-
-                xFlashMsg.Opcode      = WRITE_ENABLE_CMD;
-                xFlashMsg.Addrsize    = 0;
-                xFlashMsg.Addrvalid   = 0;
-                xFlashMsg.TxBfrPtr    = NULL;
-                xFlashMsg.RxBfrPtr    = NULL;
-                xFlashMsg.ByteCount   = 0;
-                xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_TX;
-                xFlashMsg.IsDDROpCode = 0;
-                xFlashMsg.Proto       = 0;
-                xFlashMsg.Dummy       = 0;
-                if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
-                {
-                    xFlashMsg.Proto = XOSPIPSV_WRITE_8_0_0;
-                }
-
-                iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
-                if( XST_SUCCESS == iOspiStatus )
-                {
-                    xFlashMsg.Opcode      = ( uint8_t )pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd;
-                    xFlashMsg.Addrsize    = XFLASH_CMD_ADDRSIZE_4;
-                    xFlashMsg.Addrvalid   = TRUE;
-                    xFlashMsg.TxBfrPtr    = NULL;
-                    xFlashMsg.RxBfrPtr    = NULL;
-                    xFlashMsg.ByteCount   = 0;
-                    xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_TX;
-                    xFlashMsg.Addr        = ulRealAddr;
-                    xFlashMsg.IsDDROpCode = 0;
-                    xFlashMsg.Proto       = 0;
-                    xFlashMsg.Dummy       = 0;
-                    if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
-                    {
-                        xFlashMsg.Proto = XOSPIPSV_WRITE_8_8_0;
-                    }
-                    iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
-                }
-
-                if( XST_SUCCESS == iOspiStatus )
-                {
-                    FOREVER
-                    {
-                        xFlashMsg.Opcode      = pxFlashConfigTable[ pxThis->ucFctIndex ].ucStatusCmd;
-                        xFlashMsg.Addrsize    = 0;
-                        xFlashMsg.Addrvalid   = 0;
-                        xFlashMsg.TxBfrPtr    = NULL;
-                        xFlashMsg.RxBfrPtr    = ucFlashStatus;
-                        xFlashMsg.ByteCount   = XFLASH_BYTE_COUNT_1;
-                        xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_RX;
-                        xFlashMsg.Dummy       = pxOspiPsvPtr->Extra_DummyCycle;
-                        xFlashMsg.IsDDROpCode = 0;
-                        xFlashMsg.Proto       = 0;
-                        if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
-                        {
-                            xFlashMsg.Proto     = XOSPIPSV_READ_8_0_8;
-                            xFlashMsg.ByteCount = XFLASH_BYTE_COUNT_2;
-                            xFlashMsg.Dummy    += XFLASH_OPCODE_DUMMY_CYCLES;
-                        }
-
-                        iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
-                        if( XST_SUCCESS != iOspiStatus )
-                        {
-                            break;
-                        }
-
-                        if( ( 0 != ( ucFlashStatus[ 0 ] & XFLASH_STATUS_BYTE ) ) )
-                        {
-                            break;
-                        }
-                    }
-
-                    ulAddress += pxFlashConfigTable[ pxThis->ucFctIndex ].ulSectSize;
-                }
-            }
+            iOspiStatus = iScheduleUnits( pxOspiPsvPtr, ulAddress, ulByteCount );
         }
     }
     else
@@ -1876,7 +2132,8 @@ static int iFlashWrite( XOspiPsv *pxOspiPsvPtr,
         uint32_t ulRealAddr     = 0;
         uint8_t  ucNumLines     = 0;
 
-        while( 0 != ulByteCount )
+        iOspiStatus = iWaitUnitsIdle( pxOspiPsvPtr );
+        while( ( XST_SUCCESS == iOspiStatus ) && ( 0 != ulByteCount ) )
         {
             /*
              * Translate address based on type of connection
@@ -1930,7 +2187,7 @@ static int iFlashWrite( XOspiPsv *pxOspiPsvPtr,
                 break;
             }
 
-            xFlashMsg.Opcode      = ( uint8_t )pxFlashConfigTable[ pxThis->ucFctIndex ].ulWriteCmd;
+            xFlashMsg.Opcode      = ( uint8_t )pxThis->xFlashInfo.ulWriteCmd;
             xFlashMsg.Addrvalid   = TRUE;
             xFlashMsg.TxBfrPtr    = pucWriteBfrPtr;
             xFlashMsg.RxBfrPtr    = NULL;
@@ -1957,7 +2214,7 @@ static int iFlashWrite( XOspiPsv *pxOspiPsvPtr,
 
             FOREVER
             {
-                xFlashMsg.Opcode      = pxFlashConfigTable[ pxThis->ucFctIndex ].ucStatusCmd;
+                xFlashMsg.Opcode      = pxThis->xFlashInfo.ucStatusCmd;
                 xFlashMsg.Addrsize    = 0;
                 xFlashMsg.Addrvalid   = 0;
                 xFlashMsg.TxBfrPtr    = NULL;
@@ -2032,7 +2289,11 @@ static int iFlashLinearWrite( XOspiPsv *pxOspiPsvPtr,
             xFlashMsg.Proto = XOSPIPSV_WRITE_8_0_0;
         }
 
-        iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+        iOspiStatus = iWaitUnitsIdle( pxOspiPsvPtr );
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+        }
         if( XST_SUCCESS == iOspiStatus )
         {
             uint8_t ucNumLines = 0;
@@ -2044,7 +2305,7 @@ static int iFlashLinearWrite( XOspiPsv *pxOspiPsvPtr,
             }
             else
             {
-                xFlashMsg.Opcode    = ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulWriteCmd >> BITSHIFT_1B );
+                xFlashMsg.Opcode    = ( uint8_t )( pxThis->xFlashInfo.ulWriteCmd >> BITSHIFT_1B );
                 xFlashMsg.Addrvalid = TRUE;
                 xFlashMsg.TxBfrPtr  = pucWriteBfrPtr;
                 xFlashMsg.RxBfrPtr  = NULL;
@@ -2098,11 +2359,11 @@ static int iFlashRead( XOspiPsv *pxOspiPsvPtr,
         uint32_t ucReadIterations = 1;                                         /* At least one read required when aligned */
         int      i                = 0;
 
-        if( ( ulAddress < pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize ) &&
-            ( ( ulAddress + ulByteCount ) >= pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize ) &&
+        if( ( ulAddress < pxThis->xFlashInfo.ulFlashDeviceSize ) &&
+            ( ( ulAddress + ulByteCount ) >= pxThis->xFlashInfo.ulFlashDeviceSize ) &&
             ( XOSPIPSV_CONNECTION_MODE_STACKED == pxOspiPsvPtr->Config.ConnectionMode ) )
         {
-            ulBytesToRead = ( pxFlashConfigTable[ pxThis->ucFctIndex ].ulFlashDeviceSize - ulAddress );
+            ulBytesToRead = ( pxThis->xFlashInfo.ulFlashDeviceSize - ulAddress );
         }
         else
         {
@@ -2120,7 +2381,8 @@ static int iFlashRead( XOspiPsv *pxOspiPsvPtr,
             ulBytesToRead  = OSPI_READ_BUFFER_SIZE;
         }
 
-        for( i = 0; i < ucReadIterations; i++ )
+        iOspiStatus = iWaitUnitsIdle( pxOspiPsvPtr );
+        for( i = 0; ( XST_SUCCESS == iOspiStatus ) && ( i < ucReadIterations ); i++ )
         {
             /*
              * Translate address based on type of connection
@@ -2140,7 +2402,7 @@ static int iFlashRead( XOspiPsv *pxOspiPsvPtr,
                 break;
             }
 
-            xFlashMsg.Opcode    = ( uint8_t )pxFlashConfigTable[ pxThis->ucFctIndex ].ulReadCmd;
+            xFlashMsg.Opcode    = ( uint8_t )pxThis->xFlashInfo.ulReadCmd;
             xFlashMsg.Addrsize  = XFLASH_CMD_ADDRSIZE_4;
             xFlashMsg.Addrvalid = TRUE;
             xFlashMsg.TxBfrPtr  = NULL;
@@ -2158,7 +2420,7 @@ static int iFlashRead( XOspiPsv *pxOspiPsvPtr,
             xFlashMsg.Flags     = XOSPIPSV_MSG_FLAG_RX;
             xFlashMsg.Addr      = ulRealAddr;
             xFlashMsg.Proto     = ucNumLines;
-            xFlashMsg.Dummy     = pxFlashConfigTable[ pxThis->ucFctIndex ].ucDummyCycles +
+            xFlashMsg.Dummy     = pxThis->xFlashInfo.ucDummyCycles +
                                   pxOspiPsvPtr->Extra_DummyCycle;
             xFlashMsg.IsDDROpCode = 0;
 
@@ -2246,7 +2508,7 @@ static int iBulkErase( XOspiPsv *pxOspiPsvPtr )
              * written to, this needs to be sent as a separate transfer before
              * the write
              */
-            xFlashMsg.Opcode      = ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd >> BITSHIFT_1B );
+            xFlashMsg.Opcode      = ( uint8_t )( pxThis->xFlashInfo.ulEraseCmd >> BITSHIFT_1B );
             xFlashMsg.Addrsize    = 0;
             xFlashMsg.Addrvalid   = 0;
             xFlashMsg.TxBfrPtr    = NULL;
@@ -2268,7 +2530,7 @@ static int iBulkErase( XOspiPsv *pxOspiPsvPtr )
         {
             FOREVER
             {
-                xFlashMsg.Opcode      = pxFlashConfigTable[ pxThis->ucFctIndex ].ucStatusCmd;
+                xFlashMsg.Opcode      = pxThis->xFlashInfo.ucStatusCmd;
                 xFlashMsg.Addrsize    = 0;
                 xFlashMsg.Addrvalid   = 0;
                 xFlashMsg.TxBfrPtr    = NULL;
@@ -2329,7 +2591,7 @@ static int iDieErase( XOspiPsv *pxOspiPsvPtr )
             0
         };
 
-        for( ucDieCnt = 0; ucDieCnt < pxFlashConfigTable[ pxThis->ucFctIndex ].ucNumDie; ucDieCnt++ )
+        for( ucDieCnt = 0; ucDieCnt < pxThis->xFlashInfo.ucNumDie; ucDieCnt++ )
         {
             /*
              * Send the write enable command to the Flash so that it can be
@@ -2354,7 +2616,7 @@ static int iDieErase( XOspiPsv *pxOspiPsvPtr )
             iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
             if( XST_SUCCESS == iOspiStatus )
             {
-                xFlashMsg.Opcode = ( uint8_t )( pxFlashConfigTable[ pxThis->ucFctIndex ].ulEraseCmd >>
+                xFlashMsg.Opcode = ( uint8_t )( pxThis->xFlashInfo.ulEraseCmd >>
                                                 BITSHIFT_2B );
                 xFlashMsg.Addrsize    = 0;
                 xFlashMsg.Addrvalid   = 0;
@@ -2377,7 +2639,7 @@ static int iDieErase( XOspiPsv *pxOspiPsvPtr )
             {
                 FOREVER
                 {
-                    xFlashMsg.Opcode      = pxFlashConfigTable[ pxThis->ucFctIndex ].ucStatusCmd;
+                    xFlashMsg.Opcode      = pxThis->xFlashInfo.ucStatusCmd;
                     xFlashMsg.Addrsize    = 0;
                     xFlashMsg.Addrvalid   = 0;
                     xFlashMsg.TxBfrPtr    = NULL;
@@ -2436,3 +2698,1057 @@ static void vTimerPollTimeoutCb( void *pvTimerHandle )
         INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
     }
 }
+
+/**
+ * @brief   Build the flash configuration, from SFDP where the part provides it
+ *          and from the FCT otherwise
+ */
+static int iFlashConfigure( XOspiPsv *pxOspiPsvPtr )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) )
+    {
+        uint32_t ulJedecId = pxThis->xFlashInfo.ulJedecId;
+
+        if( TRUE == pxThis->iFctFound )
+        {
+            pvOSAL_MemCpy( &pxThis->xFlashInfo, &pxFlashConfigTable[ pxThis->ucFctIndex ], sizeof( OSPI_FLASH_INFO ) );
+        }
+        else
+        {
+            pvOSAL_MemCpy( &pxThis->xFlashInfo, &xSfdpFlashInfo, sizeof( OSPI_FLASH_INFO ) );
+            pxThis->xFlashInfo.ulJedecId = ulJedecId;
+        }
+
+        pxThis->pxEraseTypes[ 0 ].ulSize = pxThis->xFlashInfo.ulSectSize;
+        pxThis->pxEraseTypes[ 0 ].ucCmd  = ( uint8_t )pxThis->xFlashInfo.ulEraseCmd;
+        pxThis->ucNumEraseTypes          = 1;
+
+        if( XST_SUCCESS == iFlashParseSfdp( pxOspiPsvPtr ) )
+        {
+            pxThis->iSfdpFound = TRUE;
+            INC_STAT_COUNTER( OSPI_STATS_SFDP_CONFIG )
+            iOspiStatus = XST_SUCCESS;
+        }
+        else if( TRUE == pxThis->iFctFound )
+        {
+            PLL_LOG( OSPI_NAME, "No SFDP, using FCT index:%d\r\n", pxThis->ucFctIndex );
+            INC_STAT_COUNTER( OSPI_STATS_FCT_CONFIG )
+            iOspiStatus = XST_SUCCESS;
+        }
+        else
+        {
+            PLL_ERR( OSPI_NAME, "Error: flash 0x%06x has no SFDP and is not in the FCT\r\n", ulJedecId );
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Read from the SFDP address space of the flash device
+ */
+static int iFlashReadSfdp( XOspiPsv *pxOspiPsvPtr,
+                           uint32_t ulAddress,
+                           uint32_t ulByteCount,
+                           uint8_t *pucReadBfrPtr )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) &&
+        ( NULL != pucReadBfrPtr ) &&
+        ( SFDP_BUFFER_SIZE >= ulByteCount ) )
+    {
+        XOspiPsv_Msg xFlashMsg =
+        {
+            0
+        };
+
+        /* SFDP is always 1S-1S-1S with 3 address bytes and 8 wait states */
+        xFlashMsg.Opcode      = READ_SFDP_CMD;
+        xFlashMsg.Addrsize    = XFLASH_CMD_ADDRSIZE_3;
+        xFlashMsg.Addrvalid   = TRUE;
+        xFlashMsg.Addr        = ulAddress;
+        xFlashMsg.TxBfrPtr    = NULL;
+        xFlashMsg.RxBfrPtr    = pucReadBfrPtr;
+        xFlashMsg.ByteCount   = ( ulByteCount + ( OSPI_READ_BUFFER_ALIGNMENT - 1 ) ) &
+                                ~( OSPI_READ_BUFFER_ALIGNMENT - 1 );
+        xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_RX;
+        xFlashMsg.Dummy       = SFDP_DUMMY_CYCLES + pxOspiPsvPtr->Extra_DummyCycle;
+        xFlashMsg.IsDDROpCode = 0;
+        xFlashMsg.Proto       = 0;
+
+        iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+        if( XST_SUCCESS != iOspiStatus )
+        {
+            INC_ERROR_COUNTER( OSPI_ERRORS_SFDP_READ )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Parse the SFDP tables of the flash device into the flash configuration
+ */
+static int iFlashParseSfdp( XOspiPsv *pxOspiPsvPtr )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) )
+    {
+        uint8_t pucBuf[ SFDP_BUFFER_SIZE ] __attribute__ ( ( aligned( OSPI_READ_BUFFER_ALIGNMENT ) ) ) =
+        {
+            0
+        };
+        OSPI_FLASH_INFO xInfo =
+        {
+            0
+        };
+        OSPI_ERASE_TYPE pxErase[ OSPI_ERASE_TYPES_MAX ] =
+        {
+            {
+                0
+            }
+        };
+        uint8_t  puc4bEraseCmd[ OSPI_ERASE_TYPES_MAX ] =
+        {
+            0
+        };
+        uint32_t ul4bSupport  = 0;
+        int      i4baitFound  = FALSE;
+        int      iSectorMap   = FALSE;
+        uint32_t ulBfptAddr   = 0;
+        uint32_t ulBfptLen    = 0;
+        uint32_t ul4baitAddr  = 0;
+        uint32_t ul4baitLen   = 0;
+        uint32_t ulXspiAddr   = 0;
+        uint32_t ulXspiLen    = 0;
+        uint8_t  ucNumHeaders = 0;
+        uint8_t  ucNumErase   = 0;
+        uint8_t  ucSuspendCmd = 0;
+        uint8_t  ucResumeCmd  = 0;
+        int      i            = 0;
+
+        pvOSAL_MemCpy( &xInfo, &pxThis->xFlashInfo, sizeof( OSPI_FLASH_INFO ) );
+
+        /* SFDP header */
+        iOspiStatus = iFlashReadSfdp( pxOspiPsvPtr, 0, SFDP_HEADER_SIZE, pucBuf );
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            if( SFDP_SIGNATURE != SFDP_DWORD( pucBuf, 1 ) )
+            {
+                PLL_DBG( OSPI_NAME, "No SFDP signature\r\n" );
+                iOspiStatus = XST_FAILURE;
+            }
+            else
+            {
+                /* NPH is zero based */
+                ucNumHeaders = pucBuf[ 6 ] + 1;
+                if( SFDP_MAX_PARAM_HEADERS < ucNumHeaders )
+                {
+                    ucNumHeaders = SFDP_MAX_PARAM_HEADERS;
+                }
+            }
+        }
+
+        /* Parameter headers - locate the tables we use */
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            iOspiStatus = iFlashReadSfdp( pxOspiPsvPtr,
+                                          SFDP_HEADER_SIZE,
+                                          ucNumHeaders * SFDP_PARAM_HEADER_SIZE,
+                                          pucBuf );
+        }
+
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            for( i = 0; i < ucNumHeaders; i++ )
+            {
+                uint8_t  *pucHdr = &pucBuf[ i * SFDP_PARAM_HEADER_SIZE ];
+                uint16_t usId    = ( uint16_t )( ( pucHdr[ 7 ] << BITSHIFT_1B ) | pucHdr[ 0 ] );
+                uint32_t ulLen   = pucHdr[ 3 ] * SFDP_DWORD_SIZE;
+                uint32_t ulAddr  = pucHdr[ 4 ] | ( pucHdr[ 5 ] << BITSHIFT_1B ) | ( pucHdr[ 6 ] << BITSHIFT_2B );
+
+                if( SFDP_BUFFER_SIZE < ulLen )
+                {
+                    ulLen = SFDP_BUFFER_SIZE;
+                }
+
+                if( ( SFDP_PARAM_ID_BFPT == usId ) && ( 0 == ulBfptLen ) )
+                {
+                    ulBfptAddr = ulAddr;
+                    ulBfptLen  = ulLen;
+                }
+                else if( SFDP_PARAM_ID_4BAIT == usId )
+                {
+                    ul4baitAddr = ulAddr;
+                    ul4baitLen  = ulLen;
+                }
+                else if( SFDP_PARAM_ID_XSPI_PROFILE1 == usId )
+                {
+                    ulXspiAddr = ulAddr;
+                    ulXspiLen  = ulLen;
+                }
+                else if( SFDP_PARAM_ID_SECTOR_MAP == usId )
+                {
+                    iSectorMap = TRUE;
+                }
+            }
+
+            /* The BFPT is mandatory and must cover at least the erase types */
+            if( ( BFPT_ERASE_DWORD + 1 ) * SFDP_DWORD_SIZE > ulBfptLen )
+            {
+                PLL_ERR( OSPI_NAME, "Error: SFDP has no usable BFPT\r\n" );
+                INC_ERROR_COUNTER( OSPI_ERRORS_SFDP_INVALID )
+                iOspiStatus = XST_FAILURE;
+            }
+        }
+
+        /* 4-byte Address Instruction Table - read first so the BFPT pass can use it */
+        if( ( XST_SUCCESS == iOspiStatus ) && ( ( 2 * SFDP_DWORD_SIZE ) <= ul4baitLen ) )
+        {
+            if( XST_SUCCESS == iFlashReadSfdp( pxOspiPsvPtr, ul4baitAddr, ul4baitLen, pucBuf ) )
+            {
+                uint32_t ulOpcodes = SFDP_DWORD( pucBuf, 2 );
+
+                ul4bSupport = SFDP_DWORD( pucBuf, 1 );
+                i4baitFound = TRUE;
+
+                for( i = 0; i < OSPI_ERASE_TYPES_MAX; i++ )
+                {
+                    puc4bEraseCmd[ i ] = ( uint8_t )( ( ulOpcodes >> ( i * BITS_PER_BYTE ) ) & BYTE_MASK );
+                }
+
+                /* FCT parts keep the read mode the table was validated with */
+                if( ( FALSE == pxThis->iFctFound ) &&
+                    ( 0 != ( ul4bSupport & FOURBAIT_READ_1_8_8 ) ) )
+                {
+                    xInfo.ulReadCmd = READ_CMD_OCTAL_IO_4B;
+                }
+
+                if( 0 != ( ul4bSupport & FOURBAIT_PROGRAM_1_1_1 ) )
+                {
+                    xInfo.ulWriteCmd = ( xInfo.ulWriteCmd & ~BYTE_MASK ) | WRITE_CMD_4B;
+                }
+
+                if( 0 != ( ul4bSupport & FOURBAIT_PROGRAM_1_1_8 ) )
+                {
+                    xInfo.ulWriteCmd = ( xInfo.ulWriteCmd & BYTE_MASK ) | ( WRITE_CMD_OCTAL_4B << BITSHIFT_1B );
+                }
+            }
+        }
+
+        /* Basic Flash Parameter Table */
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            iOspiStatus = iFlashReadSfdp( pxOspiPsvPtr, ulBfptAddr, ulBfptLen, pucBuf );
+        }
+
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            uint32_t ulDensity = SFDP_DWORD( pucBuf, 2 );
+
+            if( 0 != ( ulDensity & BFPT_DWORD2_DENSITY_POW2 ) )
+            {
+                ulDensity &= ~BFPT_DWORD2_DENSITY_POW2;
+
+                /* 2^N bits - only sizes that fit in 32 bit addresses */
+                if( ( BYTES_PER_BYTE_SHIFT > ulDensity ) ||
+                    ( ( BITS_PER_BYTE * sizeof( uint32_t ) + BYTES_PER_BYTE_SHIFT ) <= ulDensity ) )
+                {
+                    iOspiStatus = XST_FAILURE;
+                }
+                else
+                {
+                    xInfo.ulFlashDeviceSize = ( 1UL << ( ulDensity - BYTES_PER_BYTE_SHIFT ) );
+                }
+            }
+            else
+            {
+                xInfo.ulFlashDeviceSize = ( ulDensity >> BYTES_PER_BYTE_SHIFT ) + 1;
+            }
+
+            if( ( BFPT_PAGE_SIZE_DWORD * SFDP_DWORD_SIZE ) <= ulBfptLen )
+            {
+                xInfo.ulPageSize = 1UL << ( ( SFDP_DWORD( pucBuf, BFPT_PAGE_SIZE_DWORD ) >>
+                                              BFPT_DWORD11_PAGE_SIZE_SHIFT ) & BFPT_DWORD11_PAGE_SIZE_MASK );
+            }
+
+            /*
+             * 1S-8S-8S wait states are in bits 15:0 (bits 31:16 are 1S-1S-8S); the opcode
+             * itself comes from the 4BAIT. FCT parts keep the table's dummy cycles.
+             */
+            if( ( FALSE == pxThis->iFctFound ) &&
+                ( ( BFPT_OCTAL_READ_DWORD * SFDP_DWORD_SIZE ) <= ulBfptLen ) )
+            {
+                uint32_t ulOctal = SFDP_DWORD( pucBuf, BFPT_OCTAL_READ_DWORD );
+
+                if( 0 != ( ( ulOctal >> BFPT_DWORD17_1_8_8_OPCODE_SHIFT ) & BYTE_MASK ) )
+                {
+                    xInfo.ucDummyCycles = ( ( ulOctal >> BFPT_DWORD17_1_8_8_WAIT_SHIFT ) & BFPT_DWORD17_CLOCKS_MASK ) +
+                                          ( ( ulOctal >> BFPT_DWORD17_1_8_8_MODE_SHIFT ) & BFPT_DWORD17_MODE_MASK );
+                }
+            }
+
+            /* Program/erase suspend and resume opcodes; the support bit is active low */
+            if( ( BFPT_SUSPEND_CMD_DWORD * SFDP_DWORD_SIZE ) <= ulBfptLen )
+            {
+                if( 0 == ( SFDP_DWORD( pucBuf, BFPT_SUSPEND_INFO_DWORD ) & BFPT_DWORD12_NO_SUSPEND ) )
+                {
+                    uint32_t ulSuspend = SFDP_DWORD( pucBuf, BFPT_SUSPEND_CMD_DWORD );
+
+                    ucSuspendCmd = ( uint8_t )( ( ulSuspend >> BFPT_DWORD13_SUSPEND_SHIFT ) & BYTE_MASK );
+                    ucResumeCmd  = ( uint8_t )( ( ulSuspend >> BFPT_DWORD13_RESUME_SHIFT ) & BYTE_MASK );
+                }
+            }
+
+            /*
+             * Erase types: size exponent and 3-byte opcode in DWORDs 8 and 9. Use the
+             * 4-byte opcode from the 4BAIT where there is one; the 3-byte opcode is only
+             * usable when the device will be switched into 4-byte address mode.
+             *
+             * The sector map is not parsed, so only the largest type is kept: without a
+             * sector map every type is uniform across the array, and it keeps the sector
+             * size (and so the partition alignment) as coarse as the part allows.
+             */
+            for( i = 0; ( XST_SUCCESS == iOspiStatus ) && ( i < OSPI_ERASE_TYPES_MAX ); i++ )
+            {
+                uint32_t ulErase = SFDP_DWORD( pucBuf, BFPT_ERASE_DWORD + ( i / 2 ) ) >> ( ( i % 2 ) * BITSHIFT_2B );
+                uint8_t  ucShift = ( uint8_t )( ulErase & BYTE_MASK );
+                uint8_t  ucCmd   = ( uint8_t )( ( ulErase >> BITSHIFT_1B ) & BYTE_MASK );
+
+                if( ( 0 == ucShift ) || ( ( BITS_PER_BYTE * sizeof( uint32_t ) ) <= ucShift ) )
+                {
+                    continue;
+                }
+
+                if( ( TRUE == i4baitFound ) &&
+                    ( 0 != ( ul4bSupport & ( 1 << ( FOURBAIT_ERASE_TYPE_SHIFT + i ) ) ) ) )
+                {
+                    ucCmd = puc4bEraseCmd[ i ];
+                }
+                else if( SIXTEENMB >= xInfo.ulFlashDeviceSize )
+                {
+                    continue;
+                }
+
+                if( pxErase[ 0 ].ulSize < ( 1UL << ucShift ) )
+                {
+                    pxErase[ 0 ].ulSize = 1UL << ucShift;
+                    pxErase[ 0 ].ucCmd  = ucCmd;
+                    ucNumErase          = 1;
+                }
+            }
+
+            if( XST_SUCCESS != iOspiStatus )
+            {
+                PLL_ERR( OSPI_NAME, "Error: unsupported SFDP density 0x%x\r\n", SFDP_DWORD( pucBuf, 2 ) );
+                INC_ERROR_COUNTER( OSPI_ERRORS_SFDP_INVALID )
+            }
+        }
+
+        /* xSPI Profile 1.0 - octal DTR capability */
+        if( ( XST_SUCCESS == iOspiStatus ) && ( SFDP_DWORD_SIZE <= ulXspiLen ) )
+        {
+            if( XST_SUCCESS == iFlashReadSfdp( pxOspiPsvPtr, ulXspiAddr, ulXspiLen, pucBuf ) )
+            {
+                pxThis->ucOctalDtrReadCmd     = ( uint8_t )( ( SFDP_DWORD( pucBuf, 1 ) >> XSPI_DWORD1_READ_CMD_SHIFT ) &
+                                                             BYTE_MASK );
+                pxThis->ucOctalDtrDummyCycles = XSPI_DUMMY_DEFAULT;
+
+                if( ( 4 * SFDP_DWORD_SIZE ) <= ulXspiLen )
+                {
+                    uint8_t ucDummy = ( uint8_t )( ( SFDP_DWORD( pucBuf, 4 ) >> XSPI_DWORD4_DUMMY_200MHZ_SHIFT ) &
+                                                   XSPI_DUMMY_MASK );
+
+                    /* DTR needs an even number of dummy cycles */
+                    if( 0 != ucDummy )
+                    {
+                        pxThis->ucOctalDtrDummyCycles = ( ucDummy + 1 ) & ~1;
+                    }
+                }
+            }
+        }
+
+        /* Commit */
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            /*
+             * A sector map means the erase types may not cover the whole array, and FCT
+             * parts keep the erase geometry the partition table was laid out for
+             */
+            if( TRUE == iSectorMap )
+            {
+                PLL_LOG( OSPI_NAME, "SFDP: non-uniform sector map, keeping configured erase type\r\n" );
+            }
+            else if( ( 0 != ucNumErase ) && ( FALSE == pxThis->iFctFound ) )
+            {
+                pvOSAL_MemCpy( pxThis->pxEraseTypes, pxErase, sizeof( pxErase ) );
+                pxThis->ucNumEraseTypes = ucNumErase;
+
+                xInfo.ulSectSize = pxErase[ 0 ].ulSize;
+                xInfo.ulEraseCmd = ( xInfo.ulEraseCmd & ~BYTE_MASK ) | pxErase[ 0 ].ucCmd;
+            }
+
+            /* Any program size dividing the device page is legal, keep the configured one */
+            if( ( 0 != pxThis->ulPageSize ) && ( 0 == ( xInfo.ulPageSize % pxThis->ulPageSize ) ) )
+            {
+                xInfo.ulPageSize = pxThis->ulPageSize;
+            }
+
+            xInfo.ululNumSect = xInfo.ulFlashDeviceSize / xInfo.ulSectSize;
+            xInfo.ulNumPage   = xInfo.ulFlashDeviceSize / xInfo.ulPageSize;
+
+            pvOSAL_MemCpy( &pxThis->xFlashInfo, &xInfo, sizeof( OSPI_FLASH_INFO ) );
+
+            if( ( 0 != ucSuspendCmd ) && ( 0 != ucResumeCmd ) )
+            {
+                pxThis->ucSuspendCmd = ucSuspendCmd;
+                pxThis->ucResumeCmd  = ucResumeCmd;
+                PLL_LOG( OSPI_NAME,
+                         "SFDP: suspend 0x%02x, resume 0x%02x\r\n",
+                         pxThis->ucSuspendCmd,
+                         pxThis->ucResumeCmd );
+            }
+
+            PLL_LOG( OSPI_NAME,
+                     "SFDP: size:0x%x, read:0x%02x/%d, write:0x%04x, erase types:%d\r\n",
+                     xInfo.ulFlashDeviceSize,
+                     ( uint8_t )xInfo.ulReadCmd,
+                     xInfo.ucDummyCycles,
+                     xInfo.ulWriteCmd,
+                     pxThis->ucNumEraseTypes );
+
+            if( 0 != pxThis->ucOctalDtrReadCmd )
+            {
+                PLL_LOG( OSPI_NAME,
+                         "SFDP: octal DTR read 0x%02x with %d dummy cycles supported\r\n",
+                         pxThis->ucOctalDtrReadCmd,
+                         pxThis->ucOctalDtrDummyCycles );
+            }
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Pick the largest erase type that fits the remaining range
+ */
+static uint8_t ucSelectEraseType( uint32_t ulAddress, uint32_t ulRemaining )
+{
+    uint8_t ucType = 0;
+
+    /* Types are sorted largest first; the last (smallest) is the fallback */
+    for( ucType = 0; ucType < ( pxThis->ucNumEraseTypes - 1 ); ucType++ )
+    {
+        if( ( 0 == ( ulAddress % pxThis->pxEraseTypes[ ucType ].ulSize ) ) &&
+            ( ulRemaining >= pxThis->pxEraseTypes[ ucType ].ulSize ) )
+        {
+            break;
+        }
+    }
+
+    return ucType;
+}
+
+/**
+ * @brief   Get the flash unit (chip select) an address belongs to
+ */
+static uint8_t ucGetUnit( XOspiPsv *pxOspiPsvPtr, uint32_t ulAddress )
+{
+    uint8_t ucUnit = 0;
+
+    if( ( NULL != pxOspiPsvPtr ) &&
+        ( XOSPIPSV_CONNECTION_MODE_STACKED == pxOspiPsvPtr->Config.ConnectionMode ) &&
+        ( ulAddress & pxThis->xFlashInfo.ulFlashDeviceSize ) )
+    {
+        ucUnit = 1;
+    }
+
+    return ucUnit;
+}
+
+/**
+ * @brief   Read the flag status of the selected flash once, without waiting
+ */
+static int iReadFlagStatus( XOspiPsv *pxOspiPsvPtr, int *piReady, uint8_t *pucFlagStatus )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) &&
+        ( NULL != piReady ) )
+    {
+        XOspiPsv_Msg xFlashMsg =
+        {
+            0
+        };
+        uint8_t ucFlashStatus[ OSPI_STATUS_BUFFER_SIZE ] __attribute__ ( ( aligned( OSPI_WRITE_BUFFER_ALIGNMENT ) ) ) =
+        {
+            0
+        };
+
+        xFlashMsg.Opcode      = pxThis->xFlashInfo.ucStatusCmd;
+        xFlashMsg.Addrsize    = 0;
+        xFlashMsg.Addrvalid   = 0;
+        xFlashMsg.TxBfrPtr    = NULL;
+        xFlashMsg.RxBfrPtr    = ucFlashStatus;
+        xFlashMsg.ByteCount   = XFLASH_BYTE_COUNT_1;
+        xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_RX;
+        xFlashMsg.Dummy       = pxOspiPsvPtr->Extra_DummyCycle;
+        xFlashMsg.IsDDROpCode = 0;
+        xFlashMsg.Proto       = 0;
+        if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
+        {
+            xFlashMsg.Proto     = XOSPIPSV_READ_8_0_8;
+            xFlashMsg.ByteCount = XFLASH_BYTE_COUNT_2;
+            xFlashMsg.Dummy    += XFLASH_OPCODE_DUMMY_CYCLES;
+        }
+
+        iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            *piReady = ( 0 != ( ucFlashStatus[ 0 ] & XFLASH_STATUS_BYTE ) ) ? TRUE : FALSE;
+            if( NULL != pucFlagStatus )
+            {
+                *pucFlagStatus = ucFlashStatus[ 0 ];
+            }
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Start an erase without waiting for it to complete
+ */
+static int iIssueErase( XOspiPsv *pxOspiPsvPtr, uint32_t ulAddress, uint8_t ucEraseType )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) &&
+        ( ucEraseType < pxThis->ucNumEraseTypes ) )
+    {
+        XOspiPsv_Msg xFlashMsg =
+        {
+            0
+        };
+        uint32_t ulRealAddr = 0;
+
+        /*
+         * Translate address based on type of connection
+         * If stacked assert the slave select based on address
+         */
+        iOspiStatus = iGetRealAddr( pxOspiPsvPtr, ulAddress, &ulRealAddr );
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            /*
+             * Send the write enable command to the Flash so that it can be
+             * written to, this needs to be sent as a separate transfer before
+             * the erase
+             */
+            xFlashMsg.Opcode      = WRITE_ENABLE_CMD;
+            xFlashMsg.Addrsize    = 0;
+            xFlashMsg.Addrvalid   = 0;
+            xFlashMsg.TxBfrPtr    = NULL;
+            xFlashMsg.RxBfrPtr    = NULL;
+            xFlashMsg.ByteCount   = 0;
+            xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_TX;
+            xFlashMsg.IsDDROpCode = 0;
+            xFlashMsg.Proto       = 0;
+            xFlashMsg.Dummy       = 0;
+            if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
+            {
+                xFlashMsg.Proto = XOSPIPSV_WRITE_8_0_0;
+            }
+
+            iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+        }
+        else
+        {
+            PLL_ERR( OSPI_NAME, "Error: iGetRealAddr failed: %d\r\n", iOspiStatus );
+        }
+
+        if( XST_SUCCESS == iOspiStatus )
+        {
+            xFlashMsg.Opcode      = pxThis->pxEraseTypes[ ucEraseType ].ucCmd;
+            xFlashMsg.Addrsize    = XFLASH_CMD_ADDRSIZE_4;
+            xFlashMsg.Addrvalid   = TRUE;
+            xFlashMsg.TxBfrPtr    = NULL;
+            xFlashMsg.RxBfrPtr    = NULL;
+            xFlashMsg.ByteCount   = 0;
+            xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_TX;
+            xFlashMsg.Addr        = ulRealAddr;
+            xFlashMsg.IsDDROpCode = 0;
+            xFlashMsg.Proto       = 0;
+            xFlashMsg.Dummy       = 0;
+            if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
+            {
+                xFlashMsg.Proto = XOSPIPSV_WRITE_8_8_0;
+            }
+
+            iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Erase a range, overlapping the erases across the flash units
+ */
+static int iScheduleUnits( XOspiPsv *pxOspiPsvPtr,
+                           uint32_t ulAddress,
+                           uint32_t ulByteCount )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxOspiPsvPtr ) &&
+        ( 0 < pxThis->ucNumEraseTypes ) &&
+        ( OSPI_MAX_UNITS >= pxThis->ucNumUnits ) )
+    {
+        OSPI_UNIT_WORK pxWork[ OSPI_MAX_UNITS ] =
+        {
+            {
+                0
+            }
+        };
+        uint32_t ulNext   = ulAddress;
+        uint32_t ulEnd    = ulAddress + ulByteCount;
+        uint8_t  ucUnit   = 0;
+        int      iPending = TRUE;
+
+        /* Split the range into the part held by each unit */
+        while( ulNext < ulEnd )
+        {
+            uint32_t ulUnitEnd = ulEnd;
+
+            ucUnit = ucGetUnit( pxOspiPsvPtr, ulNext );
+            if( ( 1 < pxThis->ucNumUnits ) && ( 0 == ucUnit ) &&
+                ( ulEnd > pxThis->xFlashInfo.ulFlashDeviceSize ) )
+            {
+                ulUnitEnd = pxThis->xFlashInfo.ulFlashDeviceSize;
+            }
+
+            pxWork[ ucUnit ].ulAddress   = ulNext;
+            pxWork[ ucUnit ].ulRemaining = ulUnitEnd - ulNext;
+            ulNext = ulUnitEnd;
+        }
+
+        /*
+         * Issue the next erase to every idle unit, then poll the busy ones;
+         * a unit left busy by an earlier failure is waited on before use
+         */
+        iOspiStatus = XST_SUCCESS;
+        while( ( XST_SUCCESS == iOspiStatus ) && ( TRUE == iPending ) )
+        {
+            iPending = FALSE;
+
+            for( ucUnit = 0; ( XST_SUCCESS == iOspiStatus ) && ( ucUnit < pxThis->ucNumUnits ); ucUnit++ )
+            {
+                OSPI_UNIT_WORK *pxUnit = &pxWork[ ucUnit ];
+
+                if( TRUE == pxThis->piUnitBusy[ ucUnit ] )
+                {
+                    int iReady = FALSE;
+
+                    iOspiStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr,
+                                                        ( 0 == ucUnit ) ? XOSPIPSV_SELECT_FLASH_CS0 :
+                                                                          XOSPIPSV_SELECT_FLASH_CS1 );
+                    if( XST_SUCCESS == iOspiStatus )
+                    {
+                        iOspiStatus = iReadFlagStatus( pxOspiPsvPtr, &iReady, NULL );
+                    }
+                    else
+                    {
+                        INC_ERROR_COUNTER( OSPI_ERRORS_SELECT_FLASH )
+                    }
+
+                    if( ( XST_SUCCESS == iOspiStatus ) && ( TRUE == iReady ) )
+                    {
+                        uint32_t ulCompleted = pxUnit->ulInFlight;
+
+                        if( ulCompleted > pxUnit->ulRemaining )
+                        {
+                            /* A partial trailing sector is erased whole */
+                            ulCompleted = pxUnit->ulRemaining;
+                        }
+
+                        pxThis->piUnitBusy[ ucUnit ] = FALSE;
+                        pxUnit->ulAddress   += pxUnit->ulInFlight;
+                        pxUnit->ulRemaining -= ulCompleted;
+                        pxUnit->ulInFlight   = 0;
+                    }
+                }
+
+                if( ( XST_SUCCESS == iOspiStatus ) &&
+                    ( FALSE == pxThis->piUnitBusy[ ucUnit ] ) &&
+                    ( 0 < pxUnit->ulRemaining ) )
+                {
+                    uint8_t ucEraseType = ucSelectEraseType( pxUnit->ulAddress, pxUnit->ulRemaining );
+                    uint8_t ucOtherUnit = 0;
+
+                    pxUnit->ulInFlight = pxThis->pxEraseTypes[ ucEraseType ].ulSize;
+                    iOspiStatus        = iIssueErase( pxOspiPsvPtr, pxUnit->ulAddress, ucEraseType );
+                    if( XST_SUCCESS == iOspiStatus )
+                    {
+                        pxThis->piUnitBusy[ ucUnit ] = TRUE;
+
+                        for( ucOtherUnit = 0; ucOtherUnit < pxThis->ucNumUnits; ucOtherUnit++ )
+                        {
+                            if( ( ucOtherUnit != ucUnit ) && ( TRUE == pxThis->piUnitBusy[ ucOtherUnit ] ) )
+                            {
+                                INC_STAT_COUNTER( OSPI_STATS_INTERLEAVED_OPS )
+                                break;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        PLL_ERR( OSPI_NAME, "Error: unit %d erase at 0x%x failed: %d\r\n",
+                                 ucUnit, pxUnit->ulAddress, iOspiStatus );
+                    }
+                }
+
+                if( ( TRUE == pxThis->piUnitBusy[ ucUnit ] ) || ( 0 < pxUnit->ulRemaining ) )
+                {
+                    iPending = TRUE;
+                }
+            }
+
+            if( ( XST_SUCCESS == iOspiStatus ) && ( TRUE == iPending ) )
+            {
+                iOspiStatus = iServicePendingReads( pxOspiPsvPtr );
+            }
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Wait for any unit left busy by an earlier erase to finish
+ */
+static int iWaitUnitsIdle( XOspiPsv *pxOspiPsvPtr )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) &&
+        ( OSPI_MAX_UNITS >= pxThis->ucNumUnits ) )
+    {
+        uint8_t ucUnit = 0;
+
+        iOspiStatus = XST_SUCCESS;
+
+        for( ucUnit = 0; ( XST_SUCCESS == iOspiStatus ) && ( ucUnit < pxThis->ucNumUnits ); ucUnit++ )
+        {
+            if( ( TRUE == pxThis->piUnitBusy[ ucUnit ] ) && ( FALSE == pxThis->piUnitSuspended[ ucUnit ] ) )
+            {
+                int iReady = FALSE;
+
+                iOspiStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr,
+                                                    ( 0 == ucUnit ) ? XOSPIPSV_SELECT_FLASH_CS0 :
+                                                                      XOSPIPSV_SELECT_FLASH_CS1 );
+                if( XST_SUCCESS != iOspiStatus )
+                {
+                    INC_ERROR_COUNTER( OSPI_ERRORS_SELECT_FLASH )
+                }
+
+                while( ( XST_SUCCESS == iOspiStatus ) && ( FALSE == iReady ) )
+                {
+                    iOspiStatus = iReadFlagStatus( pxOspiPsvPtr, &iReady, NULL );
+                }
+
+                if( XST_SUCCESS == iOspiStatus )
+                {
+                    pxThis->piUnitBusy[ ucUnit ] = FALSE;
+                }
+                else
+                {
+                    PLL_ERR( OSPI_NAME, "Error: unit %d wait failed: %d\r\n", ucUnit, iOspiStatus );
+                }
+            }
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Send a single opcode with no address or data
+ */
+static int iSendFlashCmd( XOspiPsv *pxOspiPsvPtr, uint8_t ucCmd )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) )
+    {
+        XOspiPsv_Msg xFlashMsg =
+        {
+            0
+        };
+
+        xFlashMsg.Opcode      = ucCmd;
+        xFlashMsg.Addrsize    = 0;
+        xFlashMsg.Addrvalid   = 0;
+        xFlashMsg.TxBfrPtr    = NULL;
+        xFlashMsg.RxBfrPtr    = NULL;
+        xFlashMsg.ByteCount   = 0;
+        xFlashMsg.Flags       = XOSPIPSV_MSG_FLAG_TX;
+        xFlashMsg.IsDDROpCode = 0;
+        xFlashMsg.Proto       = 0;
+        xFlashMsg.Dummy       = 0;
+        if( XOSPIPSV_EDGE_MODE_DDR_PHY == pxOspiPsvPtr->SdrDdrMode )
+        {
+            xFlashMsg.Proto = XOSPIPSV_WRITE_8_0_0;
+        }
+
+        iOspiStatus = iPollTransferWithRetry( pxOspiPsvPtr, &xFlashMsg );
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Take the driver lock for an erase or write, waiting out any update
+ *          that is suspended while a read is served
+ */
+static int iTakeUpdateLock( void )
+{
+    int iMutexStatus = iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl, OSAL_TIMEOUT_WAIT_FOREVER );
+
+    /* Only reads may run while another update is suspended */
+    while( ( OSAL_ERRORS_NONE == iMutexStatus ) && ( TRUE == pxThis->iUpdateSuspended ) )
+    {
+        iMutexStatus = iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl );
+        if( OSAL_ERRORS_NONE == iMutexStatus )
+        {
+            iOSAL_Task_SleepMs( OSPI_PREEMPT_YIELD_MS );
+            iMutexStatus = iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl, OSAL_TIMEOUT_WAIT_FOREVER );
+        }
+    }
+
+    return iMutexStatus;
+}
+
+/**
+ * @brief   Hand the driver lock to any waiting readers part way through an update
+ */
+static int iServicePendingReads( XOspiPsv *pxOspiPsvPtr )
+{
+    int iOspiStatus = XST_FAILURE;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxOspiPsvPtr ) )
+    {
+        int     iCanYield = TRUE;
+        uint8_t ucUnit    = 0;
+
+        iOspiStatus = XST_SUCCESS;
+
+        if( 0 != pxThis->ulReadsPending )
+        {
+            /* Without suspend a busy unit cannot be read, so wait for the next gap */
+            for( ucUnit = 0; ucUnit < pxThis->ucNumUnits; ucUnit++ )
+            {
+                if( ( TRUE == pxThis->piUnitBusy[ ucUnit ] ) && ( 0 == pxThis->ucSuspendCmd ) )
+                {
+                    iCanYield = FALSE;
+                }
+            }
+
+            for( ucUnit = 0;
+                 ( XST_SUCCESS == iOspiStatus ) && ( TRUE == iCanYield ) && ( ucUnit < pxThis->ucNumUnits );
+                 ucUnit++ )
+            {
+                if( TRUE == pxThis->piUnitBusy[ ucUnit ] )
+                {
+                    uint8_t  ucFlagStatus = 0;
+                    int      iReady       = FALSE;
+                    uint32_t ulRetries    = 0;
+
+                    iOspiStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr,
+                                                        ( 0 == ucUnit ) ? XOSPIPSV_SELECT_FLASH_CS0 :
+                                                                          XOSPIPSV_SELECT_FLASH_CS1 );
+                    if( XST_SUCCESS == iOspiStatus )
+                    {
+                        iOspiStatus = iSendFlashCmd( pxOspiPsvPtr, pxThis->ucSuspendCmd );
+                    }
+
+                    /* Suspend latency is tens of microseconds - bounded in case the part ignores it */
+                    while( ( XST_SUCCESS == iOspiStatus ) &&
+                           ( FALSE == iReady ) &&
+                           ( OSPI_SUSPEND_POLL_RETRIES > ulRetries ) )
+                    {
+                        iOspiStatus = iReadFlagStatus( pxOspiPsvPtr, &iReady, &ucFlagStatus );
+                        ulRetries++;
+                    }
+
+                    if( ( XST_SUCCESS == iOspiStatus ) && ( FALSE == iReady ) )
+                    {
+                        /* Resume in case the suspend lands late; the reader waits for the next gap */
+                        PLL_ERR( OSPI_NAME, "Error: unit %d suspend timed out\r\n", ucUnit );
+                        INC_ERROR_COUNTER( OSPI_ERRORS_SUSPEND_FAILED )
+                        iCanYield   = FALSE;
+                        iOspiStatus = iSendFlashCmd( pxOspiPsvPtr, pxThis->ucResumeCmd );
+                        if( XST_SUCCESS != iOspiStatus )
+                        {
+                            PLL_ERR( OSPI_NAME, "Error: unit %d resume failed: %d\r\n", ucUnit, iOspiStatus );
+                            INC_ERROR_COUNTER( OSPI_ERRORS_RESUME_FAILED )
+                        }
+                    }
+                    else if( XST_SUCCESS == iOspiStatus )
+                    {
+                        /* The operation may have completed before the suspend took effect */
+                        if( 0 != ( ucFlagStatus & ( XFLASH_STATUS_ERASE_SUSPEND | XFLASH_STATUS_PROGRAM_SUSPEND ) ) )
+                        {
+                            pxThis->piUnitSuspended[ ucUnit ] = TRUE;
+                            INC_STAT_COUNTER( OSPI_STATS_SUSPEND )
+                        }
+                    }
+                    else
+                    {
+                        PLL_ERR( OSPI_NAME, "Error: unit %d suspend failed: %d\r\n", ucUnit, iOspiStatus );
+                        INC_ERROR_COUNTER( OSPI_ERRORS_SUSPEND_FAILED )
+                    }
+                }
+            }
+
+            if( ( XST_SUCCESS == iOspiStatus ) && ( TRUE == iCanYield ) )
+            {
+                pxThis->iUpdateSuspended = TRUE;
+
+                if( OSAL_ERRORS_NONE == iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                {
+                    iOSAL_Task_SleepMs( OSPI_PREEMPT_YIELD_MS );
+                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl, OSAL_TIMEOUT_WAIT_FOREVER ) )
+                    {
+                        INC_STAT_COUNTER( OSPI_STATS_READ_PREEMPT )
+                    }
+                    else
+                    {
+                        INC_ERROR_COUNTER( OSPI_ERRORS_MUTEX_TAKE_FAILED )
+                        iOspiStatus = XST_FAILURE;
+                    }
+                }
+                else
+                {
+                    INC_ERROR_COUNTER( OSPI_ERRORS_MUTEX_RELEASE_FAILED )
+                    iOspiStatus = XST_FAILURE;
+                }
+
+                pxThis->iUpdateSuspended = FALSE;
+            }
+
+            /* Resume whatever was suspended, even if the hand over failed */
+            for( ucUnit = 0; ucUnit < pxThis->ucNumUnits; ucUnit++ )
+            {
+                if( TRUE == pxThis->piUnitSuspended[ ucUnit ] )
+                {
+                    int iResumeStatus = XOspiPsv_SelectFlash( pxOspiPsvPtr,
+                                                              ( 0 == ucUnit ) ? XOSPIPSV_SELECT_FLASH_CS0 :
+                                                                                XOSPIPSV_SELECT_FLASH_CS1 );
+                    if( XST_SUCCESS == iResumeStatus )
+                    {
+                        iResumeStatus = iSendFlashCmd( pxOspiPsvPtr, pxThis->ucResumeCmd );
+                    }
+
+                    if( XST_SUCCESS == iResumeStatus )
+                    {
+                        pxThis->piUnitSuspended[ ucUnit ] = FALSE;
+                        INC_STAT_COUNTER( OSPI_STATS_RESUME )
+                    }
+                    else
+                    {
+                        PLL_ERR( OSPI_NAME, "Error: unit %d resume failed: %d\r\n", ucUnit, iResumeStatus );
+                        INC_ERROR_COUNTER( OSPI_ERRORS_RESUME_FAILED )
+                        iOspiStatus = XST_FAILURE;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( OSPI_ERRORS_VALIDAION_FAILED )
+    }
+
+    return iOspiStatus;
+}
+
+/**
+ * @brief   Check if data matches the erased state of the flash
+ */
+static int iIsErasedPattern( const uint8_t *pucData, uint32_t ulLength )
+{
+    int iErased = FALSE;
+
+    if( ( NULL != pucData ) && ( 0 < ulLength ) )
+    {
+        uint32_t i = 0;
+
+        while( ( i < ulLength ) && ( OSPI_ERASED_BYTE == pucData[ i ] ) )
+        {
+            i++;
+        }
+
+        if( i == ulLength )
+        {
+            iErased = TRUE;
+        }
+    }
+
+    return iErased;
+}
@@ -83,6 +83,16 @@ int iOSPI_FlashWrite( uint32_t ulAddr, uint8_t *pucWriteBuffer, uint32_t ulLengt
  */
 int iOSPI_GetOperationProgress( uint8_t *pucPercentage );
 
+/**
+ * @brief   Return how much of the last write needed no programming
+ *
+ * @param   pulSkippedBytes     Bytes of the last iOSPI_FlashWrite that were
+ *                              already in the erased state (0xFF)
+ *
+ * @return  OK if successful, else ERROR.
+ */
+int iOSPI_GetLastWriteSkipped( uint32_t *pulSkippedBytes );
+
 /**
  * @brief   Print all the stats gathered by the driver
  *
@@ -44,6 +44,8 @@ typedef enum FW_IF_EMMC_IOCTRL
 {
     FW_IF_EMMC_IOCTRL_PRINT_INSTANCE_DETAILS = MAX_FW_IF_COMMON_IOCTRL_OPTION,
     FW_IF_EMMC_IOCTRL_ERASE_ALL,
+    FW_IF_EMMC_IOCTRL_SANITISE,
+    FW_IF_EMMC_IOCTRL_GET_SANITISE_STATUS,
 
     MAX_FW_IF_EMMC_IOCTRL_OPTION
 
@@ -46,6 +46,7 @@
     DO( FW_IF_EMMC_STATS_READ )                          \
     DO( FW_IF_EMMC_STATS_WRITE )                         \
     DO( FW_IF_EMMC_STATS_IO_CTRL )                       \
+    DO( FW_IF_EMMC_STATS_DISCARD )                       \
     DO( FW_IF_EMMC_STATS_MAX )
 
 #define FW_IF_EMMC_ERROR_COUNTS( DO )    \
@@ -635,6 +636,67 @@ static uint32_t ulEmmcIoCtrl( void *pvFwIf, uint32_t ulOption, void *pvValue )
                 break;
             }
 
+            case FW_IF_COMMON_IOCTRL_DISCARD:
+            {
+                FW_IF_DISCARD_RANGE *pxRange = ( FW_IF_DISCARD_RANGE* )pvValue;
+
+                if( NULL == pxRange )
+                {
+                    ulStatus = FW_IF_ERRORS_PARAMS;
+                }
+                else
+                {
+                    uint64_t ullAddr = pxCfg->ullBaseAddress + pxRange->ullAddrOffset;
+
+                    ulStatus = ulValidateAddressRange( pxCfg, ullAddr, pxRange->ulLength );
+                    if( FW_IF_ERRORS_NONE == ulStatus )
+                    {
+                        /* Only whole blocks inside the range - partial blocks are kept */
+                        uint64_t ullStart = ( ( ullAddr + HAL_EMMC_BLOCK_SIZE - 1 ) / HAL_EMMC_BLOCK_SIZE ) *
+                                            HAL_EMMC_BLOCK_SIZE;
+                        uint64_t ullEnd   = ( ( ullAddr + pxRange->ulLength ) / HAL_EMMC_BLOCK_SIZE ) *
+                                            HAL_EMMC_BLOCK_SIZE;
+
+                        if( ( ullEnd > ullStart ) &&
+                            ( OK != iEMMC_Discard( ullStart, ( uint32_t )( ( ullEnd - ullStart ) /
+                                                                           HAL_EMMC_BLOCK_SIZE ) ) ) )
+                        {
+                            ulStatus = FW_IF_EMMC_ERRORS_DRIVER_FAILURE;
+                            INC_ERROR_COUNTER( FW_IF_EMMC_ERRORS_IO_CTRL_FAILED )
+                        }
+                        else
+                        {
+                            INC_STAT_COUNTER( FW_IF_EMMC_STATS_DISCARD )
+                        }
+                    }
+                }
+                break;
+            }
+
+            case FW_IF_EMMC_IOCTRL_SANITISE:
+            {
+                if( OK != iEMMC_Sanitise() )
+                {
+                    ulStatus = FW_IF_ERRORS_IOCTRL;
+                    INC_ERROR_COUNTER( FW_IF_EMMC_ERRORS_IO_CTRL_FAILED )
+                }
+                break;
+            }
+
+            case FW_IF_EMMC_IOCTRL_GET_SANITISE_STATUS:
+            {
+                if( NULL == pvValue )
+                {
+                    ulStatus = FW_IF_ERRORS_PARAMS;
+                }
+                else if( OK != iEMMC_GetSanitiseStatus( ( int* )pvValue ) )
+                {
+                    ulStatus = FW_IF_ERRORS_IOCTRL;
+                    INC_ERROR_COUNTER( FW_IF_EMMC_ERRORS_IO_CTRL_FAILED )
+                }
+                break;
+            }
+
             default:
                 ulStatus = FW_IF_ERRORS_UNRECOGNISED_OPTION;
                 break;
@@ -288,6 +288,7 @@ static uint32_t ulEmmcIoCtrl( void *pvFwIf, uint32_t ulOption, void *pvValue )
         case FW_IF_COMMON_IOCTRL_FLUSH_TX:
         case FW_IF_COMMON_IOCTRL_FLUSH_RX:
         case FW_IF_COMMON_IOCTRL_GET_RX_MODE:
+        case FW_IF_COMMON_IOCTRL_DISCARD:
             /*
              * Handle common IOCTL's.
              */
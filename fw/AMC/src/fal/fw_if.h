@@ -158,6 +158,8 @@ typedef enum _FW_IF_COMMON_IOCTRL_OPTIONS
     FW_IF_COMMON_IOCTRL_GET_RX_MODE,
     FW_IF_COMMON_IOCTRL_ENABLE_DEBUG_PRINT, 
     FW_IF_COMMON_IOCTRL_DISABLE_DEBUG_PRINT,
+    FW_IF_COMMON_IOCTRL_DISCARD,            /* pvValue is a FW_IF_DISCARD_RANGE; range is about to be rewritten */
+    FW_IF_COMMON_IOCTRL_GET_WRITE_SKIPPED,  /* pvValue is a uint32_t*; bytes of the last write that needed no programming */
                 
     MAX_FW_IF_COMMON_IOCTRL_OPTION
                         
@@ -195,6 +197,18 @@ typedef enum _FW_IF_RX_MODE
 /* structs                                                                   */
 /*****************************************************************************/
 
+/**
+ * @struct  FW_IF_DISCARD_RANGE
+ *
+ * @brief   Address range passed with FW_IF_COMMON_IOCTRL_DISCARD
+ */
+typedef struct _FW_IF_DISCARD_RANGE
+{
+    uint64_t            ullAddrOffset;
+    uint32_t            ulLength;
+
+} FW_IF_DISCARD_RANGE;
+
 /**
  * @struct  FW_IF_CFG
  * 
@@ -350,6 +350,12 @@ static uint32_t prvGCQOpen( void *pvFWIf )
         GCQ_INTERRUPT_MODE_TYPE xIntMode = prvxMapInterruptMode( pxCfg->xInterruptMode );
         GCQ_MODE_TYPE xMode = prvxMapMode( pxCfg->xMode );
 
+        /* Secondary queue pairs leave the IP block to the primary */
+        if( FW_IF_GCQ_QUEUE_SECONDARY == pxCfg->xQueueType )
+        {
+            xFlags |= GCQ_FLAGS_TYPE_SHARED_IP_ENABLE;
+        }
+
         /* Initially only interrupt polling mode supported */
         if( xIntMode == GCQ_INTERRUPT_MODE_POLLING )
         {
@@ -833,7 +839,8 @@ uint32_t ulFW_IF_GCQ_Create( FW_IF_CFG *pxFWIf, FW_IF_GCQ_CFG *pxGCQCfg )
                 INC_ERROR_COUNTER( FW_IF_GCQ_ERRORS_NO_FREE_PROFILES_COUNT );
             }
             else if( ( MAX_FW_IF_GCQ_MODE > pxGCQCfg->xMode ) &&
-                    ( MAX_FW_IF_GCQ_INTERRUPT_MODE > pxGCQCfg->xInterruptMode ) )
+                    ( MAX_FW_IF_GCQ_INTERRUPT_MODE > pxGCQCfg->xInterruptMode ) &&
+                    ( MAX_FW_IF_GCQ_QUEUE > pxGCQCfg->xQueueType ) )
             {
                 FW_IF_CFG myLocalIf =
                 {
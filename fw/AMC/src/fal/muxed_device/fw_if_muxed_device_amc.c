@@ -96,6 +96,7 @@ typedef struct FW_IF_QSFP_PRIVATE_DATA
 
     FW_IF_MUXED_DEVICE_INIT_CFG     xLocalCfg;
     int                             iInitialised;
+    uint8_t                         pucTxBuffer[ FAL_QSFP_MAX_DATA + 1 ];
     uint32_t                        pulStatCounters[ FW_IF_QSFP_STATS_MAX ];
     uint32_t                        pulErrorCounters[ FW_IF_QSFP_ERRORS_MAX ];
 
@@ -113,6 +114,7 @@ static FW_IF_QSFP_PRIVATE_DATA xLocalData =
     QSFP_UPPER_FIREWALL,    /* ulUpperFirewall */
     { 0 },                  /* xLocalCfg       */
     FW_IF_FALSE,            /* iInitialised    */
+    { 0 },                  /* pucTxBuffer     */
     { 0 },                  /* pulStatCounters  */
     { 0 },                  /* pulErrorCounters */
     QSFP_LOWER_FIREWALL     /* ulLowerFirewall */
@@ -640,25 +642,20 @@ static uint32_t ulQsfpWrite( void *pvFwIf, uint64_t ullDstPort, uint8_t *pucData
                             /* delay before writing qsfp registers  */
                             iOSAL_Task_SleepTicks( FAL_QSFP_PROCESS_TIME_TICKS );
 
-                            /* write QSFP memory map registers */
-                            uint8_t *pucQsfpWriteBuff = pvOSAL_MemAlloc( ( ulSize+1 ) * sizeof( uint8_t ) );
+                            /* write QSFP memory map registers (register offset followed by the data) */
+                            uint8_t *pucQsfpWriteBuff = pxThis->pucTxBuffer;
 
-                            if( NULL != pucQsfpWriteBuff )
+                            pucQsfpWriteBuff[ 0 ] = ullDstPort;
+                            pvOSAL_MemCpy( &pucQsfpWriteBuff[ 1 ], pucData, ulSize );
+
+                            if( ERROR != iI2C_Send( pxThis->xLocalCfg.ulI2CBusNum, pxCfg->ucDeviceI2cAddr, pucQsfpWriteBuff, ulSize+1 ) )
                             {
-                                pucQsfpWriteBuff[ 0 ] = ullDstPort;
-                                pvOSAL_MemCpy( &pucQsfpWriteBuff[ 1 ], pucData, ulSize );
-
-                                if( ERROR != iI2C_Send( pxThis->xLocalCfg.ulI2CBusNum, pxCfg->ucDeviceI2cAddr, pucQsfpWriteBuff, ulSize+1 ) )
-                                {
-                                    INC_STAT_COUNTER( FW_IF_QSFP_STATS_I2C_SEND )
-                                    ulStatus = FW_IF_ERRORS_NONE;
-                                }
-                                else
-                                {
-                                    INC_ERROR_COUNTER( FW_IF_QSFP_ERRORS_I2C_SEND_FAILED )
-                                }
-
-                                vOSAL_MemFree( ( void** )&pucQsfpWriteBuff );
+                                INC_STAT_COUNTER( FW_IF_QSFP_STATS_I2C_SEND )
+                                ulStatus = FW_IF_ERRORS_NONE;
+                            }
+                            else
+                            {
+                                INC_ERROR_COUNTER( FW_IF_QSFP_ERRORS_I2C_SEND_FAILED )
                             }
                             break;
                         }
@@ -674,6 +674,21 @@ static uint32_t ulOspiIoCtrl( void *pvFwIf, uint32_t ulOption, void *pvValue )
          */
         break;
 
+    case FW_IF_COMMON_IOCTRL_DISCARD:
+        /*
+         * Nothing to do - sectors are erased as they are written.
+         */
+        break;
+
+    case FW_IF_COMMON_IOCTRL_GET_WRITE_SKIPPED:
+        if( ( NULL == pvValue ) ||
+            ( OK != iOSPI_GetLastWriteSkipped( ( uint32_t* )pvValue ) ) )
+        {
+            xRet = FW_IF_OSPI_ERRORS_DRIVER_FAILURE;
+            INC_ERROR_COUNTER( FW_IF_OSPI_ERRORS_DRIVER_FAILURE_COUNT );
+        }
+        break;
+
     case FW_IF_OSPI_IOCTL_GET_PROGRESS:
     {
         int iStatus = ERROR;
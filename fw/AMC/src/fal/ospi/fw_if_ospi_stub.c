@@ -167,7 +167,7 @@ uint32_t ulFW_IF_OSPI_Init( FW_IF_OSPI_INIT_CFG *pxInitCfg )
          * Initialise the driver based on the device id supplied in the xparameters.h
          * and the page size 'ospi_flash_init()', The default page size in versal is 256.
          */
-        PLL_DBG( FW_IF_OSPI_NAME, "Device Id:%d\r\n", xLocalCfg.ucOspiDeviceId );
+        PLL_DBG( FW_IF_OSPI_NAME, "Device Addr:%d\r\n", xLocalCfg.ulOspiBaseAddr );
         PLL_DBG( FW_IF_OSPI_NAME, "Page Size:%d\r\n", xLocalCfg.usPageSize );
         iInitialised = FW_IF_TRUE;
     }
@@ -424,6 +424,22 @@ static uint32_t ulOspiIoCtrl( void *pvFwIf, uint32_t ulOption, void *pvValue )
          */
         break;
 
+    case FW_IF_COMMON_IOCTRL_DISCARD:
+        /*
+         * Nothing to do - sectors are erased as they are written.
+         */
+        break;
+
+    case FW_IF_COMMON_IOCTRL_GET_WRITE_SKIPPED:
+        /*
+         * Nothing is programmed, so nothing is skipped.
+         */
+        if( NULL != pvValue )
+        {
+            *( uint32_t* )pvValue = 0;
+        }
+        break;
+
     case FW_IF_OSPI_IOCTL_GET_PROGRESS:
         /*
          * Will call ospi_flash_progress( ) to get the progress of the operation
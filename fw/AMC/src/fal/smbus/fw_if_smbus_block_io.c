@@ -130,6 +130,7 @@ typedef struct FW_IF_SMBUS_BLOCK_IO_PRIVATE_DATA
     uint8_t                     pucCallBackWriteData[ FW_IF_SMBUS_MAX_DATA ];
     uint16_t                    usCallBackWriteDataSize;
     void                        *pvWriteCallbackSem;
+    uint8_t                     pucTxBuffers[ SMBUS_NUMBER_OF_SMBUS_INSTANCES ][ FW_IF_SMBUS_MAX_DATA + sizeof( uint8_t ) ];
 
     uint32_t                    pulStatCounters[ FW_IF_SMBUS_BLOCK_IO_STATS_MAX ];
     uint32_t                    pulErrorCounters[ FW_IF_SMBUS_BLOCK_IO_ERRORS_MAX ];
@@ -154,6 +155,7 @@ static FW_IF_SMBUS_BLOCK_IO_PRIVATE_DATA xLocalData =
     { 0 },                          /* pucCallBackWriteData */
     0,                              /* usCallBackWriteDataSize */
     NULL,                           /* pvWriteCallbackSem */
+    { { 0 } },                      /* pucTxBuffers */
 
     { 0 },                          /* pulStatCounters */
     { 0 },                          /* pulErrorCounters */
@@ -503,12 +505,13 @@ static uint32_t ulSmbusBlockIoWrite( void *pvFwIf, uint64_t dstPort, uint8_t *pu
             uint8_t ucCommand = pxThis->xLocalCfg.pucCommandProtocols[ FW_IF_SMBUS_COMMAND_PROTOCOL_BLOCK_WRITE ]; /* specified command code for block write */
             uint32_t ulTransactionID = 0;
 
-            /* allocate memory to send */
+            /* per-instance transmit buffer, the driver copies it before the command is initiated */
             uint16_t usDataToSendSize = ulSize + sizeof( uint8_t ); /* add one byte to payload for size value */
-            uint8_t* pucDataToSend = ( uint8_t* )pvOSAL_MemAlloc( usDataToSendSize * sizeof( uint8_t ) );
 
-            if( NULL != pucDataToSend )
+            if( ( FW_IF_SMBUS_MAX_DATA >= ulSize ) &&
+                ( SMBUS_NUMBER_OF_SMBUS_INSTANCES > pxCfg->ucInstance ) )
             {
+                uint8_t* pucDataToSend = pxThis->pucTxBuffers[ pxCfg->ucInstance ];
                 int iPecCapability = FALSE;
 
                 switch( pxCfg->xPecCapability )
@@ -538,9 +541,6 @@ static uint32_t ulSmbusBlockIoWrite( void *pvFwIf, uint64_t dstPort, uint8_t *pu
                     ulStatus = FW_IF_ERRORS_WRITE;
                     INC_ERROR_COUNTER( FW_IF_SMBUS_BLOCK_IO_ERRORS_WRITE_FAILED )
                 }
-
-                /* free memory */
-                vOSAL_MemFree( ( void** )&pucDataToSend );
             }
             else
             {
@@ -295,7 +295,7 @@ uint32_t ulFW_IF_SMBUS_Create( FW_IF_CFG *pvFwIf, FW_IF_SMBUS_CFG *pxSmbusCfg )
 
     if( ( NULL != pvFwIf ) && ( NULL != pxSmbusCfg ) )
     {
-        if( ( MAX_FW_IF_SMBUS_ROLE > pxSmbusCfg->xRole ) && ( NULL != pxSmbusCfg->pucUdid ) )
+        if( MAX_FW_IF_SMBUS_ROLE > pxSmbusCfg->xRole )
         {
             FW_IF_CFG myLocalIf =
             {
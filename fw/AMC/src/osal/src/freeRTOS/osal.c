@@ -112,6 +112,10 @@ typedef struct OSAL_TASK_STATS_LINKED_LIST
 
 } OSAL_TASK_STATS_LINKED_LIST;
 
+/*
+ * The OSAL handles for semaphores, mutexes and mailboxes point at their stats node,
+ * which holds the OS handle, so counters are updated without searching the list.
+ */
 typedef struct OSAL_SEM_STATS_LINKED_LIST
 {
     void* pvSem;
@@ -202,6 +206,12 @@ static OSAL_OS_STATS xOsStatsHandle =
 
 static OSAL_OS_STATS * pxOsStatsHandle = &xOsStatsHandle;
 
+/* Heap telemetry, kept outside OSAL_OS_STATS so it survives the stats handle being re-allocated at start-up */
+static OSAL_HEAP_CALL_SITE xHeapCallSites[ OSAL_HEAP_MAX_CALL_SITES ] = { 0 };
+static uint32_t ulHeapNumCallSites        = 0;
+static uint32_t ulHeapFailedAllocCount    = 0;
+static uint32_t ulHeapUntrackedAllocCount = 0;
+
 
 /******************************************************************************/
 /* Local Function Declarations                                                */
@@ -216,33 +226,6 @@ static OSAL_OS_STATS * pxOsStatsHandle = &xOsStatsHandle;
  */
 static OSAL_TASK_STATS_LINKED_LIST* pxFindTask( void* pvTaskHandle );
 
-/**
- * @brief Searches the linked list for the given key.
- *
- * @param pvSemHandle Sem handle to search for.
- *
- * @return OSAL_SEM_STATS_LINKED_LIST* Linked List node that matches the given key, NULL if no match found.
- */
-static OSAL_SEM_STATS_LINKED_LIST* pxFindSem( void* pvSemHandle );
-
-/**
- * @brief Searches the linked list for the given key.
- *
- * @param pvMutexHandle Mutex handle to search for.
- *
- * @return OSAL_MUTEX_STATS_LINKED_LIST* Linked List node that matches the given key, NULL if no match found.
- */
-static OSAL_MUTEX_STATS_LINKED_LIST* pxFindMutex( void* pvMutexHandle );
-
-/**
- * @brief Searches the linked list for the given key.
- *
- * @param pvMailboxHandle Mailbox handle to search for.
- *
- * @return OSAL_MBOX_STATS_LINKED_LIST* Linked List node that matches the given key, NULL if no match found.
- */
-static OSAL_MBOX_STATS_LINKED_LIST* pxFindMailbox( void* pvMailboxHandle );
-
 /**
  * @brief Searches the linked list for the given key.
  *
@@ -327,6 +310,17 @@ static void vPrint_Timer_Stats( OSAL_STATS_VERBOSITY eVerbosity );
  */
 static void vPrint_Memory_Stats( void );
 
+/**
+ * @brief Records an allocation against its call site in the heap telemetry table.
+ *
+ * @param pvMemory   The allocated memory (NULL if the allocation failed).
+ * @param pvCallSite Return address into the caller of pvOSAL_MemAlloc.
+ * @param usSize     Number of bytes requested.
+ *
+ * @note  Must be called with the scheduler suspended once the OS has started.
+ */
+static void vRecordAllocCallSite( void* pvMemory, void* pvCallSite, uint16_t usSize );
+
 /**
  * @brief Calculates the deepest point the stack has reached ( the closer this is to 0, the closer the task has come to overflowing its stack )
  */
@@ -519,8 +513,10 @@ int iOSAL_StartOS( int         iRoundRobinEnabled,
 
                             pxNewNode->usTaskStackWaterMark = 0;
                             pxNewNode->ulCpuUsagePercentage = 0;
+                            vTaskSuspendAll();
                             pxNewNode->pxNext = pxOsStatsHandle->pxTaskHead;
                             pxOsStatsHandle->pxTaskHead = pxNewNode;
+                            ( void )xTaskResumeAll();
                         }
                     }
 
@@ -665,8 +661,10 @@ int iOSAL_Task_Create( void**      ppvTaskHandle,
 
                     pxNewNode->usTaskStackWaterMark = 0;
                     pxNewNode->ulCpuUsagePercentage = 0;
+                    vTaskSuspendAll();
                     pxNewNode->pxNext = pxOsStatsHandle->pxTaskHead;
                     pxOsStatsHandle->pxTaskHead = pxNewNode;
+                    ( void )xTaskResumeAll();
                 }
 
                 /* Task created successfully */
@@ -850,27 +848,35 @@ int iOSAL_Semaphore_Create( void** ppvSemHandle,
         ( NULL == *ppvSemHandle ) &&
         ( NULL != pcSemName ) )
     {
-        *ppvSemHandle = xSemaphoreCreateCounting( ( UBaseType_t )ullBucket,
-                                                  ( UBaseType_t )ullCount );
+        SemaphoreHandle_t xSem = xSemaphoreCreateCounting( ( UBaseType_t )ullBucket,
+                                                           ( UBaseType_t )ullCount );
 
-        if( NULL != *ppvSemHandle )
+        if( NULL != xSem )
         {
-            /* Add semaphore to debug stats */
+            /* Add semaphore to debug stats - the node is the OSAL handle */
             OSAL_SEM_STATS_LINKED_LIST *pxNewNode = ( OSAL_SEM_STATS_LINKED_LIST* ) pvOSAL_MemAlloc( sizeof( OSAL_SEM_STATS_LINKED_LIST ) );
             if( NULL != pxNewNode )
             {
-                pxNewNode->pvSem = *ppvSemHandle;
+                pxNewNode->pvSem = xSem;
                 pxNewNode->pcName = strdup( pcSemName );
                 pxNewNode->iPostCount = 0;
                 pxNewNode->iPendCount = 0;
                 pxNewNode->pcStatus = strdup( "Active" );
 
+                vTaskSuspendAll();
                 pxNewNode->pxNext = pxOsStatsHandle->pxSemHead;
                 pxOsStatsHandle->pxSemHead = pxNewNode;
-            }
+                ( void )xTaskResumeAll();
 
-            /* Semaphore created successfully */
-            iStatus = OSAL_ERRORS_NONE;
+                /* Semaphore created successfully */
+                *ppvSemHandle = pxNewNode;
+                iStatus = OSAL_ERRORS_NONE;
+            }
+            else
+            {
+                vSemaphoreDelete( xSem );
+                iStatus = OSAL_ERRORS_INSUFFICIENT_MEM;
+            }
         }
         else
         {
@@ -894,13 +900,13 @@ int iOSAL_Semaphore_Destroy( void** ppvSemHandle )
     if( ( NULL != ppvSemHandle  ) &&
         ( NULL != *ppvSemHandle ) )
     {
-        OSAL_SEM_STATS_LINKED_LIST *pxCurrent = pxFindSem( *ppvSemHandle );
-        if( NULL != pxCurrent)
-        {
-            pxCurrent->pcStatus = strdup( "Deleted" );
-        }
+        OSAL_SEM_STATS_LINKED_LIST *pxSem = ( OSAL_SEM_STATS_LINKED_LIST* )*ppvSemHandle;
+
+        vSemaphoreDelete( ( SemaphoreHandle_t )pxSem->pvSem );
 
-        vSemaphoreDelete( ( SemaphoreHandle_t )*ppvSemHandle );
+        free( pxSem->pcStatus );
+        pxSem->pcStatus = strdup( "Deleted" );
+        pxSem->pvSem = NULL;
 
         if( NULL != *ppvSemHandle )
         {
@@ -924,6 +930,7 @@ int iOSAL_Semaphore_Pend( void* pvSemHandle, uint32_t ulTimeoutMs )
 
     if( NULL != pvSemHandle )
     {
+        OSAL_SEM_STATS_LINKED_LIST *pxSem = ( OSAL_SEM_STATS_LINKED_LIST* )pvSemHandle;
         TickType_t xTimeoutTicks = 0;
 
         if( OSAL_TIMEOUT_WAIT_FOREVER == ulTimeoutMs )
@@ -944,19 +951,14 @@ int iOSAL_Semaphore_Pend( void* pvSemHandle, uint32_t ulTimeoutMs )
             }
         }
 
-        if( pdPASS != xSemaphoreTake( ( SemaphoreHandle_t )pvSemHandle, xTimeoutTicks ) )
+        if( pdPASS != xSemaphoreTake( ( SemaphoreHandle_t )pxSem->pvSem, xTimeoutTicks ) )
         {
             /* Semaphore not taken */
             iStatus = OSAL_ERRORS_OS_IMPLEMENTATION;
         }
         else
         {
-
-            OSAL_SEM_STATS_LINKED_LIST *pxCurrent = pxFindSem( pvSemHandle );
-            if( NULL != pxCurrent)
-            {
-                pxCurrent->iPendCount++;
-            }
+            pxSem->iPendCount++;
 
             /* Semaphore taken successfully */
             iStatus = OSAL_ERRORS_NONE;
@@ -977,18 +979,16 @@ int iOSAL_Semaphore_Post( void* pvSemHandle )
 
     if( NULL != pvSemHandle )
     {
-        if( pdPASS != xSemaphoreGive( ( SemaphoreHandle_t )pvSemHandle ) )
+        OSAL_SEM_STATS_LINKED_LIST *pxSem = ( OSAL_SEM_STATS_LINKED_LIST* )pvSemHandle;
+
+        if( pdPASS != xSemaphoreGive( ( SemaphoreHandle_t )pxSem->pvSem ) )
         {
             /* Semaphore not released */
             iStatus = OSAL_ERRORS_OS_IMPLEMENTATION;
         }
         else
         {
-            OSAL_SEM_STATS_LINKED_LIST *pxCurrent = pxFindSem( pvSemHandle );
-            if( NULL != pxCurrent)
-            {
-                pxCurrent->iPostCount++;
-            }
+            pxSem->iPostCount++;
 
             /* Semaphore released successfully */
             iStatus = OSAL_ERRORS_NONE;
@@ -1011,7 +1011,9 @@ int iOSAL_Semaphore_PostFromISR( void* pvSemHandle )
     {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-        if( pdPASS != xSemaphoreGiveFromISR( ( SemaphoreHandle_t )pvSemHandle,
+        OSAL_SEM_STATS_LINKED_LIST *pxSem = ( OSAL_SEM_STATS_LINKED_LIST* )pvSemHandle;
+
+        if( pdPASS != xSemaphoreGiveFromISR( ( SemaphoreHandle_t )pxSem->pvSem,
                                              &xHigherPriorityTaskWoken ) )
         {
             /* Semaphore not released */
@@ -1052,26 +1054,34 @@ int iOSAL_Mutex_Create( void**      ppvMutexHandle,
         ( NULL == *ppvMutexHandle ) &&
         ( NULL != pcMutexName ) )
     {
-        *ppvMutexHandle = xSemaphoreCreateMutex();
+        SemaphoreHandle_t xMutex = xSemaphoreCreateMutex();
 
-        if( NULL != *ppvMutexHandle )
+        if( NULL != xMutex )
         {
-            /* Add mutex to debug stats */
-            OSAL_MUTEX_STATS_LINKED_LIST *pxNewNode = ( OSAL_MUTEX_STATS_LINKED_LIST* ) pvOSAL_MemAlloc( sizeof( OSAL_SEM_STATS_LINKED_LIST ) );
+            /* Add mutex to debug stats - the node is the OSAL handle */
+            OSAL_MUTEX_STATS_LINKED_LIST *pxNewNode = ( OSAL_MUTEX_STATS_LINKED_LIST* ) pvOSAL_MemAlloc( sizeof( OSAL_MUTEX_STATS_LINKED_LIST ) );
             if( NULL != pxNewNode )
             {
-                pxNewNode->pvMutex = *ppvMutexHandle;
+                pxNewNode->pvMutex = xMutex;
                 pxNewNode->pcName = strdup( pcMutexName );
                 pxNewNode->iTakeCount = 0;
                 pxNewNode->iReleaseCount = 0;
                 pxNewNode->pcStatus = strdup( "Active" );
 
+                vTaskSuspendAll();
                 pxNewNode->pxNext = pxOsStatsHandle->pxMutexHead;
                 pxOsStatsHandle->pxMutexHead = pxNewNode;
-            }
+                ( void )xTaskResumeAll();
 
-            /* Mutex created successfully */
-            iStatus = OSAL_ERRORS_NONE;
+                /* Mutex created successfully */
+                *ppvMutexHandle = pxNewNode;
+                iStatus = OSAL_ERRORS_NONE;
+            }
+            else
+            {
+                vSemaphoreDelete( xMutex );
+                iStatus = OSAL_ERRORS_INSUFFICIENT_MEM;
+            }
         }
         else
         {
@@ -1095,13 +1105,13 @@ int iOSAL_Mutex_Destroy( void** ppvMutexHandle )
     if( ( NULL != ppvMutexHandle  ) &&
         ( NULL != *ppvMutexHandle ) )
     {
-        OSAL_MUTEX_STATS_LINKED_LIST *pxCurrent = pxFindMutex( *ppvMutexHandle );
-        if( NULL != pxCurrent)
-        {
-            pxCurrent->pcStatus = strdup( "Deleted" );
-        }
+        OSAL_MUTEX_STATS_LINKED_LIST *pxMutex = ( OSAL_MUTEX_STATS_LINKED_LIST* )*ppvMutexHandle;
 
-        vSemaphoreDelete( ( SemaphoreHandle_t )*ppvMutexHandle );
+        vSemaphoreDelete( ( SemaphoreHandle_t )pxMutex->pvMutex );
+
+        free( pxMutex->pcStatus );
+        pxMutex->pcStatus = strdup( "Deleted" );
+        pxMutex->pvMutex = NULL;
 
         if( NULL != *ppvMutexHandle )
         {
@@ -1126,6 +1136,7 @@ int iOSAL_Mutex_Take( void*    pvMutexHandle,
 
     if( NULL != pvMutexHandle )
     {
+        OSAL_MUTEX_STATS_LINKED_LIST *pxMutex = ( OSAL_MUTEX_STATS_LINKED_LIST* )pvMutexHandle;
         TickType_t xTimeoutTicks = 0;
         BaseType_t xReturn = pdFAIL;
 
@@ -1147,7 +1158,7 @@ int iOSAL_Mutex_Take( void*    pvMutexHandle,
             }
         }
 
-        xReturn = xSemaphoreTake( ( SemaphoreHandle_t )pvMutexHandle, xTimeoutTicks );
+        xReturn = xSemaphoreTake( ( SemaphoreHandle_t )pxMutex->pvMutex, xTimeoutTicks );
 
         if( pdPASS != xReturn )
         {
@@ -1156,11 +1167,7 @@ int iOSAL_Mutex_Take( void*    pvMutexHandle,
         }
         else
         {
-            OSAL_MUTEX_STATS_LINKED_LIST *pxCurrent = pxFindMutex( pvMutexHandle);
-            if( NULL != pxCurrent)
-            {
-                pxCurrent->iTakeCount++;
-            }
+            pxMutex->iTakeCount++;
 
             /* Mutex taken successfully */
             iStatus = OSAL_ERRORS_NONE;
@@ -1181,9 +1188,10 @@ int iOSAL_Mutex_Release( void* pvMutexHandle )
 
     if( NULL != pvMutexHandle )
     {
+        OSAL_MUTEX_STATS_LINKED_LIST *pxMutex = ( OSAL_MUTEX_STATS_LINKED_LIST* )pvMutexHandle;
         BaseType_t xReturn = pdFAIL;
 
-        xReturn = xSemaphoreGive( ( SemaphoreHandle_t )pvMutexHandle );
+        xReturn = xSemaphoreGive( ( SemaphoreHandle_t )pxMutex->pvMutex );
 
         if( pdPASS != xReturn )
         {
@@ -1192,11 +1200,7 @@ int iOSAL_Mutex_Release( void* pvMutexHandle )
         }
         else
         {
-            OSAL_MUTEX_STATS_LINKED_LIST *pxCurrent = pxFindMutex( pvMutexHandle);
-            if( NULL != pxCurrent)
-            {
-                pxCurrent->iReleaseCount++;
-            }
+            pxMutex->iReleaseCount++;
 
             /* Mutex released successfully */
             iStatus = OSAL_ERRORS_NONE;
@@ -1227,16 +1231,16 @@ int iOSAL_MBox_Create( void**      ppvMBoxHandle,
         ( NULL == *ppvMBoxHandle ) &&
         ( NULL != pcMBoxName     ) )
     {
-        *ppvMBoxHandle = xQueueCreate( ( UBaseType_t )ulMBoxLength,
-                                       ( UBaseType_t )ulItemSize );
+        QueueHandle_t xMBox = xQueueCreate( ( UBaseType_t )ulMBoxLength,
+                                            ( UBaseType_t )ulItemSize );
 
-        if( NULL != *ppvMBoxHandle )
+        if( NULL != xMBox )
         {
-            /* Add mbox to debug stats */
+            /* Add mbox to debug stats - the node is the OSAL handle */
             OSAL_MBOX_STATS_LINKED_LIST *pxNewNode = ( OSAL_MBOX_STATS_LINKED_LIST* ) pvOSAL_MemAlloc( sizeof( OSAL_MBOX_STATS_LINKED_LIST ) );
             if( NULL != pxNewNode )
             {
-                pxNewNode->pvMailbox = *ppvMBoxHandle;
+                pxNewNode->pvMailbox = xMBox;
                 pxNewNode->pcName = strdup( pcMBoxName );
                 pxNewNode->iRxCount = 0;
                 pxNewNode->iTxCount = 0;
@@ -1245,12 +1249,20 @@ int iOSAL_MBox_Create( void**      ppvMBoxHandle,
                 pxNewNode->ulItemSize = ulItemSize;
                 pxNewNode->pcStatus = strdup( "Active" );
 
+                vTaskSuspendAll();
                 pxNewNode->pxNext = pxOsStatsHandle->pxMailboxHead;
                 pxOsStatsHandle->pxMailboxHead = pxNewNode;
-            }
+                ( void )xTaskResumeAll();
 
-            /* MBox created successfully */
-            iStatus = OSAL_ERRORS_NONE;
+                /* MBox created successfully */
+                *ppvMBoxHandle = pxNewNode;
+                iStatus = OSAL_ERRORS_NONE;
+            }
+            else
+            {
+                vQueueDelete( xMBox );
+                iStatus = OSAL_ERRORS_INSUFFICIENT_MEM;
+            }
         }
         else
         {
@@ -1274,13 +1286,13 @@ int iOSAL_MBox_Destroy( void** ppvMBoxHandle )
     if( ( NULL != ppvMBoxHandle  ) &&
         ( NULL != *ppvMBoxHandle ) )
     {
-        OSAL_MBOX_STATS_LINKED_LIST *pxCurrent = pxFindMailbox( *ppvMBoxHandle);
-        if( NULL != pxCurrent)
-        {
-            pxCurrent->pcStatus = strdup( "Deleted" );
-        }
+        OSAL_MBOX_STATS_LINKED_LIST *pxMBox = ( OSAL_MBOX_STATS_LINKED_LIST* )*ppvMBoxHandle;
 
-        vQueueDelete( ( QueueHandle_t )*ppvMBoxHandle );
+        vQueueDelete( ( QueueHandle_t )pxMBox->pvMailbox );
+
+        free( pxMBox->pcStatus );
+        pxMBox->pcStatus = strdup( "Deleted" );
+        pxMBox->pvMailbox = NULL;
 
         if( NULL != *ppvMBoxHandle )
         {
@@ -1307,6 +1319,7 @@ int iOSAL_MBox_Pend( void*    pvMBoxHandle,
     if( ( NULL != pvMBoxHandle ) &&
         ( NULL != pvMBoxBuffer ) )
     {
+        OSAL_MBOX_STATS_LINKED_LIST *pxMBox = ( OSAL_MBOX_STATS_LINKED_LIST* )pvMBoxHandle;
         TickType_t xTimeoutTicks = 0;
         BaseType_t xReturn = pdFAIL;
 
@@ -1328,7 +1341,7 @@ int iOSAL_MBox_Pend( void*    pvMBoxHandle,
             }
         }
 
-        xReturn = xQueueReceive( ( QueueHandle_t )pvMBoxHandle,
+        xReturn = xQueueReceive( ( QueueHandle_t )pxMBox->pvMailbox,
                                     pvMBoxBuffer,
                                     xTimeoutTicks );
 
@@ -1339,12 +1352,8 @@ int iOSAL_MBox_Pend( void*    pvMBoxHandle,
         }
         else
         {
-            OSAL_MBOX_STATS_LINKED_LIST *pxCurrent = pxFindMailbox( pvMBoxHandle );
-            if( NULL != pxCurrent)
-            {
-                pxCurrent->iRxCount++;
-                pxCurrent->iItemCount--;
-            }
+            pxMBox->iRxCount++;
+            pxMBox->iItemCount--;
 
             /* Item recieved successfully */
             iStatus = OSAL_ERRORS_NONE;
@@ -1368,6 +1377,7 @@ int iOSAL_MBox_Post( void*    pvMBoxHandle,
     if( ( NULL != pvMBoxHandle ) &&
         ( NULL != pvMBoxItem   ) )
     {
+        OSAL_MBOX_STATS_LINKED_LIST *pxMBox = ( OSAL_MBOX_STATS_LINKED_LIST* )pvMBoxHandle;
         TickType_t xTimeoutTicks = 0;
         BaseType_t xReturn = pdFAIL;
 
@@ -1389,7 +1399,7 @@ int iOSAL_MBox_Post( void*    pvMBoxHandle,
             }
         }
 
-        xReturn = xQueueSend( ( QueueHandle_t )pvMBoxHandle,
+        xReturn = xQueueSend( ( QueueHandle_t )pxMBox->pvMailbox,
                                 pvMBoxItem,
                                 xTimeoutTicks );
 
@@ -1400,12 +1410,8 @@ int iOSAL_MBox_Post( void*    pvMBoxHandle,
         }
         else
         {
-            OSAL_MBOX_STATS_LINKED_LIST *pxCurrent = pxFindMailbox( pvMBoxHandle );
-            if( NULL != pxCurrent)
-            {
-                pxCurrent->iTxCount++;
-                pxCurrent->iItemCount++;
-            }
+            pxMBox->iTxCount++;
+            pxMBox->iItemCount++;
 
             /* Item posted successfully */
             iStatus = OSAL_ERRORS_NONE;
@@ -1427,10 +1433,11 @@ int iOSAL_MBox_PostFromISR( void* pvMBoxHandle, void* pvMBoxItem )
     if( ( NULL != pvMBoxHandle ) &&
         ( NULL != pvMBoxItem   ) )
     {
+        OSAL_MBOX_STATS_LINKED_LIST *pxMBox = ( OSAL_MBOX_STATS_LINKED_LIST* )pvMBoxHandle;
         BaseType_t xReturn = pdFAIL;
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-        xReturn = xQueueSendFromISR( ( QueueHandle_t )pvMBoxHandle,
+        xReturn = xQueueSendFromISR( ( QueueHandle_t )pxMBox->pvMailbox,
                                      pvMBoxItem,
                                      &xHigherPriorityTaskWoken );
 
@@ -1488,8 +1495,10 @@ int iOSAL_EventFlag_Create( void** ppvEventFlagHandle, const char* pcEventFlagNa
                 pxNewNode->ulFlagSet = 0;
                 pxNewNode->pcStatus = strdup( "Active" );
 
+                vTaskSuspendAll();
                 pxNewNode->pxNext = pxOsStatsHandle->pxEventHead;
                 pxOsStatsHandle->pxEventHead = pxNewNode;
+                ( void )xTaskResumeAll();
             }
 
             /* Event Flag created successfully */
@@ -1700,8 +1709,10 @@ int iOSAL_Timer_Create( void** ppvTimerHandle,
                 pxNewNode->pcType = strdup( OSAL_TIMER_CONFIG_PERIODIC == xTimerConfig ? "Periodic" : "One-shot" );
                 pxNewNode->pcStatus = strdup( "Active" );
 
+                vTaskSuspendAll();
                 pxNewNode->pxNext = pxOsStatsHandle->pxTimerHead;
                 pxOsStatsHandle->pxTimerHead = pxNewNode;
+                ( void )xTaskResumeAll();
             }
 
             /* Timer created successfully */
@@ -1915,6 +1926,10 @@ int iOSAL_Interrupt_Setup( uint8_t ucInterruptID,
 
     if( NULL != pvInterruptHandler )
     {
+#ifdef FREERTOS_SIM
+        /* No interrupt controller on the POSIX simulator port */
+        iStatus = OSAL_ERRORS_OS_IMPLEMENTATION;
+#else
         if( pdPASS != xPortInstallInterruptHandler( ucInterruptID, ( XInterruptHandler )pvInterruptHandler, pvCallBackRef ) )
         {
             /* Interrupts not setup */
@@ -1925,6 +1940,7 @@ int iOSAL_Interrupt_Setup( uint8_t ucInterruptID,
             /* Interrupts setup successfully */
             iStatus = OSAL_ERRORS_NONE;
         }
+#endif
     }
 
     return iStatus;
@@ -1939,8 +1955,12 @@ int iOSAL_Interrupt_Enable( uint8_t ucInterruptID )
 
     RETURN_IF_OS_NOT_STARTED;
 
+#ifdef FREERTOS_SIM
+    iStatus = OSAL_ERRORS_OS_IMPLEMENTATION;
+#else
     vPortEnableInterrupt( ucInterruptID );
     iStatus = OSAL_ERRORS_NONE;
+#endif
 
     return iStatus;
 }
@@ -1954,8 +1974,12 @@ int iOSAL_Interrupt_Disable( uint8_t ucInterruptID )
 
     RETURN_IF_OS_NOT_STARTED;
 
+#ifdef FREERTOS_SIM
+    iStatus = OSAL_ERRORS_OS_IMPLEMENTATION;
+#else
     vPortDisableInterrupt( ucInterruptID );
     iStatus = OSAL_ERRORS_NONE;
+#endif
 
     return iStatus;
 }
@@ -1989,18 +2013,23 @@ void vOSAL_ExitCritical( void )
 void* pvOSAL_MemAlloc( uint16_t xSize )
 {
     void* pvMemory = NULL;
+    void* pvCallSite = __builtin_return_address( 0 );
 
     if( 0 < xSize )
     {
         if( TRUE == iOsStarted )
         {
-            /* thread safe */
+            /* thread safe - scheduler is suspended so the call site table can be updated too */
+            vTaskSuspendAll();
             pvMemory = pvPortMalloc( ( size_t )xSize );
+            vRecordAllocCallSite( pvMemory, pvCallSite, xSize );
+            ( void )xTaskResumeAll();
         }
         else
         {
             /* note: Not thread safe */
             pvMemory = malloc( ( size_t )xSize );
+            vRecordAllocCallSite( pvMemory, pvCallSite, xSize );
         }
 
         pxOsStatsHandle->iMemAllocCallCount++;
@@ -2159,13 +2188,13 @@ void vOSAL_Printf( const char* pcFormat, ... )
         if( TRUE == iOsStarted )
         {
             /* take Mutex */
-            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pvPrintfMutexHandle, OSAL_TIMEOUT_TASK_WAIT_MS ) )
+            if( pdPASS == xSemaphoreTake( ( SemaphoreHandle_t )pvPrintfMutexHandle, pdMS_TO_TICKS( OSAL_TIMEOUT_TASK_WAIT_MS ) ) )
             {
                 /* Mutex taken successfully, print string */
                 xil_printf( "%s", buffer );
 
                 /* release Mutex */
-                iOSAL_Mutex_Release( pvPrintfMutexHandle );
+                xSemaphoreGive( ( SemaphoreHandle_t )pvPrintfMutexHandle );
             }
         }
         else
@@ -2188,13 +2217,13 @@ char cOSAL_GetChar( void )
     if( TRUE == iOsStarted )
     {
         /* take Mutex */
-        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pvGetCharMutexHandle, OSAL_TIMEOUT_TASK_WAIT_MS ) )
+        if( pdPASS == xSemaphoreTake( ( SemaphoreHandle_t )pvGetCharMutexHandle, pdMS_TO_TICKS( OSAL_TIMEOUT_TASK_WAIT_MS ) ) )
         {
             /* Mutex taken successfully, read character */
             cInput = inbyte();
 
             /* release Mutex */
-            iOSAL_Mutex_Release( pvGetCharMutexHandle );
+            xSemaphoreGive( ( SemaphoreHandle_t )pvGetCharMutexHandle );
         }
     }
     else
@@ -2401,47 +2430,83 @@ void vOSAL_ClearAllStats( void )
 
         pxOsStatsHandle->pxTaskHead = NULL;
 
-        OSAL_SEM_STATS_LINKED_LIST* pxCurrentSem = pxOsStatsHandle->pxSemHead;
+        OSAL_SEM_STATS_LINKED_LIST** ppxCurrentSem = &pxOsStatsHandle->pxSemHead;
 
-        while( NULL != pxCurrentSem )
+        vTaskSuspendAll();
+        while( NULL != *ppxCurrentSem )
         {
-            OSAL_SEM_STATS_LINKED_LIST* pxTemp = pxCurrentSem;
-            pxCurrentSem = pxCurrentSem->pxNext;
+            OSAL_SEM_STATS_LINKED_LIST* pxTemp = *ppxCurrentSem;
 
-            free( pxTemp->pcName );
-            free( pxTemp->pcStatus );
-            vOSAL_MemFree( ( void** )&pxTemp );
-        }
+            if( NULL == pxTemp->pvSem )
+            {
+                /* Deleted - no handle refers to the node any more */
+                *ppxCurrentSem = pxTemp->pxNext;
 
-        pxOsStatsHandle->pxSemHead = NULL;
+                free( pxTemp->pcName );
+                free( pxTemp->pcStatus );
+                vOSAL_MemFree( ( void** )&pxTemp );
+            }
+            else
+            {
+                /* Still in use - the node is the handle, so only clear the counters */
+                pxTemp->iPostCount = 0;
+                pxTemp->iPendCount = 0;
+                ppxCurrentSem = &pxTemp->pxNext;
+            }
+        }
+        ( void )xTaskResumeAll();
 
-        OSAL_MUTEX_STATS_LINKED_LIST* pxCurrentMutex = pxOsStatsHandle->pxMutexHead;
+        OSAL_MUTEX_STATS_LINKED_LIST** ppxCurrentMutex = &pxOsStatsHandle->pxMutexHead;
 
-        while( NULL != pxCurrentMutex )
+        vTaskSuspendAll();
+        while( NULL != *ppxCurrentMutex )
         {
-            OSAL_MUTEX_STATS_LINKED_LIST* pxTemp = pxCurrentMutex;
-            pxCurrentMutex = pxCurrentMutex->pxNext;
+            OSAL_MUTEX_STATS_LINKED_LIST* pxTemp = *ppxCurrentMutex;
 
-            free( pxTemp->pcName );
-            free( pxTemp->pcStatus );
-            vOSAL_MemFree( ( void** )&pxTemp );
-        }
+            if( NULL == pxTemp->pvMutex )
+            {
+                /* Deleted - no handle refers to the node any more */
+                *ppxCurrentMutex = pxTemp->pxNext;
 
-        pxOsStatsHandle->pxMutexHead = NULL;
+                free( pxTemp->pcName );
+                free( pxTemp->pcStatus );
+                vOSAL_MemFree( ( void** )&pxTemp );
+            }
+            else
+            {
+                /* Still in use - the node is the handle, so only clear the counters */
+                pxTemp->iTakeCount = 0;
+                pxTemp->iReleaseCount = 0;
+                ppxCurrentMutex = &pxTemp->pxNext;
+            }
+        }
+        ( void )xTaskResumeAll();
 
-        OSAL_MBOX_STATS_LINKED_LIST* pxCurrentMailbox = pxOsStatsHandle->pxMailboxHead;
+        OSAL_MBOX_STATS_LINKED_LIST** ppxCurrentMailbox = &pxOsStatsHandle->pxMailboxHead;
 
-        while( NULL != pxCurrentMailbox )
+        vTaskSuspendAll();
+        while( NULL != *ppxCurrentMailbox )
         {
-            OSAL_MBOX_STATS_LINKED_LIST* pxTemp = pxCurrentMailbox;
-            pxCurrentMailbox = pxCurrentMailbox->pxNext;
+            OSAL_MBOX_STATS_LINKED_LIST* pxTemp = *ppxCurrentMailbox;
 
-            free( pxTemp->pcName );
-            free( pxTemp->pcStatus );
-            vOSAL_MemFree( ( void** )&pxTemp );
-        }
+            if( NULL == pxTemp->pvMailbox )
+            {
+                /* Deleted - no handle refers to the node any more */
+                *ppxCurrentMailbox = pxTemp->pxNext;
 
-        pxOsStatsHandle->pxMailboxHead = NULL;
+                free( pxTemp->pcName );
+                free( pxTemp->pcStatus );
+                vOSAL_MemFree( ( void** )&pxTemp );
+            }
+            else
+            {
+                /* Still in use - the node is the handle, so only clear the counters */
+                pxTemp->iTxCount = 0;
+                pxTemp->iRxCount = 0;
+                ppxCurrentMailbox = &pxTemp->pxNext;
+            }
+        }
+        ( void )xTaskResumeAll();
 
         OSAL_EVENT_STATS_LINKED_LIST* pxCurrentEvent = pxOsStatsHandle->pxEventHead;
 
@@ -2474,6 +2539,48 @@ void vOSAL_ClearAllStats( void )
     }
 }
 
+/**
+ * @brief   Takes a snapshot of the heap telemetry.
+ */
+int iOSAL_GetHeapStats( OSAL_HEAP_STATS* pxHeapStats )
+{
+    int iStatus = OSAL_ERRORS_PARAMS;
+
+    if( NULL != pxHeapStats )
+    {
+        if( TRUE == iOsStarted )
+        {
+            vTaskSuspendAll();
+        }
+
+        pxHeapStats->ulTotalHeapSize       = ( uint32_t )configTOTAL_HEAP_SIZE;
+        pxHeapStats->ulCurrentFreeBytes    = ( uint32_t )xPortGetFreeHeapSize();
+        pxHeapStats->ulMinEverFreeBytes    = ( uint32_t )xPortGetMinimumEverFreeHeapSize();
+        pxHeapStats->ulAllocCount          = 0;
+        pxHeapStats->ulFreeCount           = 0;
+        pxHeapStats->ulFailedAllocCount    = ulHeapFailedAllocCount;
+        pxHeapStats->ulUntrackedAllocCount = ulHeapUntrackedAllocCount;
+        pxHeapStats->ulNumCallSites        = ulHeapNumCallSites;
+
+        if( NULL != pxOsStatsHandle )
+        {
+            pxHeapStats->ulAllocCount = ( uint32_t )pxOsStatsHandle->iMemAllocCallCount;
+            pxHeapStats->ulFreeCount  = ( uint32_t )pxOsStatsHandle->iMemFreeCallCount;
+        }
+
+        memcpy( pxHeapStats->xCallSites, xHeapCallSites, sizeof( xHeapCallSites ) );
+
+        if( TRUE == iOsStarted )
+        {
+            ( void )xTaskResumeAll();
+        }
+
+        iStatus = OSAL_ERRORS_NONE;
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Prints debug stats header.
  */
@@ -2910,106 +3017,95 @@ static void vPrint_Memory_Stats( void )
     vOSAL_Printf( "Total MemAlloc calls: %d\r\n", pxOsStatsHandle->iMemAllocCallCount );
     vOSAL_Printf( "Total MemFree calls: %d\r\n", pxOsStatsHandle->iMemFreeCallCount );
     vOSAL_Printf( LINE_SEPARATOR );
-}
 
-/**
- * @brief Searches for node in the task linked list that matches the handle.
- */
-static OSAL_TASK_STATS_LINKED_LIST* pxFindTask( void* pvTaskHandle )
-{
-    OSAL_TASK_STATS_LINKED_LIST *pxTaskNode = NULL;
+    OSAL_HEAP_STATS xHeapStats = { 0 };
 
-    if( NULL != pvTaskHandle )
+    if( OSAL_ERRORS_NONE == iOSAL_GetHeapStats( &xHeapStats ) )
     {
-        OSAL_TASK_STATS_LINKED_LIST *pxCurrentNode = pxOsStatsHandle->pxTaskHead;
+        uint32_t i = 0;
 
-        while( ( NULL != pxCurrentNode ) &&
-               ( pxCurrentNode->pvTask != pvTaskHandle ) )
+        vOSAL_Printf( "Current Free Heap: %u bytes\r\n", ( unsigned int )xHeapStats.ulCurrentFreeBytes );
+        vOSAL_Printf( "Minimum Ever Free Heap: %u bytes\r\n", ( unsigned int )xHeapStats.ulMinEverFreeBytes );
+        vOSAL_Printf( "Failed MemAlloc calls: %u\r\n", ( unsigned int )xHeapStats.ulFailedAllocCount );
+        vOSAL_Printf( "Untracked MemAlloc calls: %u\r\n", ( unsigned int )xHeapStats.ulUntrackedAllocCount );
+        vOSAL_Printf( LINE_SEPARATOR );
+        vOSAL_Printf( "%-20s %-20s %-20s \r\n", "Call Site", "Alloc Count", "Alloc Bytes" );
+        vOSAL_Printf( LINE_SEPARATOR );
+
+        for( i = 0; i < xHeapStats.ulNumCallSites; i++ )
         {
-            pxCurrentNode = pxCurrentNode->pxNext;
+            vOSAL_Printf( "%-20p %-20u %-20u \r\n",
+                          xHeapStats.xCallSites[ i ].pvCallSite,
+                          ( unsigned int )xHeapStats.xCallSites[ i ].ulAllocCount,
+                          ( unsigned int )xHeapStats.xCallSites[ i ].ulAllocBytes );
         }
-        if( NULL != pxCurrentNode )
-        {
-            pxTaskNode = pxCurrentNode;
-        }
-    }
 
-    return pxTaskNode;
+        vOSAL_Printf( LINE_SEPARATOR );
+    }
 }
 
 /**
- * @brief Searches for node in the sem linked list that matches the handle.
+ * @brief   Records an allocation against its call site in the heap telemetry table.
  */
-static OSAL_SEM_STATS_LINKED_LIST* pxFindSem( void* pvSemHandle )
+static void vRecordAllocCallSite( void* pvMemory, void* pvCallSite, uint16_t usSize )
 {
-    OSAL_SEM_STATS_LINKED_LIST *pxSemNode = NULL;
-
-    if( NULL != pvSemHandle )
+    if( NULL == pvMemory )
+    {
+        ulHeapFailedAllocCount++;
+    }
+    else
     {
-        OSAL_SEM_STATS_LINKED_LIST *pxCurrentNode = pxOsStatsHandle->pxSemHead;
+        uint32_t i = 0;
 
-        while( ( NULL != pxCurrentNode ) &&
-               ( pxCurrentNode->pvSem != pvSemHandle ) )
+        for( i = 0; i < ulHeapNumCallSites; i++ )
         {
-            pxCurrentNode = pxCurrentNode->pxNext;
-        }
-        if( NULL != pxCurrentNode )
-        {
-            pxSemNode = pxCurrentNode;
+            if( pvCallSite == xHeapCallSites[ i ].pvCallSite )
+            {
+                break;
+            }
         }
-    }
 
-    return pxSemNode;
-}
-
-/**
- * @brief Searches for node in the mutex linked list that matches the handle.
- */
-static OSAL_MUTEX_STATS_LINKED_LIST* pxFindMutex( void* pvMutexHandle )
-{
-    OSAL_MUTEX_STATS_LINKED_LIST *pxMutexNode = NULL;
-
-    if( NULL != pvMutexHandle )
-    {
-        OSAL_MUTEX_STATS_LINKED_LIST *pxCurrentNode = pxOsStatsHandle->pxMutexHead;
-
-        while( ( NULL != pxCurrentNode ) &&
-               ( pxCurrentNode->pvMutex != pvMutexHandle ) )
+        if( i < OSAL_HEAP_MAX_CALL_SITES )
         {
-            pxCurrentNode = pxCurrentNode->pxNext;
+            if( i == ulHeapNumCallSites )
+            {
+                xHeapCallSites[ i ].pvCallSite = pvCallSite;
+                ulHeapNumCallSites++;
+            }
+
+            xHeapCallSites[ i ].ulAllocCount++;
+            xHeapCallSites[ i ].ulAllocBytes += usSize;
         }
-        if( NULL != pxCurrentNode )
+        else
         {
-            pxMutexNode = pxCurrentNode;
+            ulHeapUntrackedAllocCount++;
         }
     }
-
-    return pxMutexNode;
 }
 
 /**
- * @brief Searches for node in the mailbox linked list that matches the handle.
+ * @brief Searches for node in the task linked list that matches the handle.
  */
-static OSAL_MBOX_STATS_LINKED_LIST* pxFindMailbox( void* pvMailboxHandle )
+static OSAL_TASK_STATS_LINKED_LIST* pxFindTask( void* pvTaskHandle )
 {
-    OSAL_MBOX_STATS_LINKED_LIST *pxMailboxNode = NULL;
+    OSAL_TASK_STATS_LINKED_LIST *pxTaskNode = NULL;
 
-    if( NULL != pvMailboxHandle )
+    if( NULL != pvTaskHandle )
     {
-        OSAL_MBOX_STATS_LINKED_LIST *pxCurrentNode = pxOsStatsHandle->pxMailboxHead;
+        OSAL_TASK_STATS_LINKED_LIST *pxCurrentNode = pxOsStatsHandle->pxTaskHead;
 
         while( ( NULL != pxCurrentNode ) &&
-               ( pxCurrentNode->pvMailbox != pvMailboxHandle ) )
+               ( pxCurrentNode->pvTask != pvTaskHandle ) )
         {
             pxCurrentNode = pxCurrentNode->pxNext;
         }
         if( NULL != pxCurrentNode )
         {
-            pxMailboxNode = pxCurrentNode;
+            pxTaskNode = pxCurrentNode;
         }
     }
 
-    return pxMailboxNode;
+    return pxTaskNode;
 }
 
 /**
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * This file contains the FreeRTOS kernel configuration for the AMC simulation
+ * build (FreeRTOS POSIX port, Linux profile).
+ *
+ * The values mirror the RPU BSP where the AMC relies on them (tick rate,
+ * static allocation, run-time stats) so task timing is comparable.
+ *
+ * @file FreeRTOSConfig.h
+ *
+ */
+
+#ifndef _FREERTOS_CONFIG_H_
+#define _FREERTOS_CONFIG_H_
+
+
+/*****************************************************************************/
+/* Scheduler                                                                 */
+/*****************************************************************************/
+
+#define configUSE_PREEMPTION                    ( 1 )
+#define configUSE_TIME_SLICING                  ( 1 )
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION ( 0 )
+#define configTICK_RATE_HZ                      ( 1000 )
+#define configMAX_PRIORITIES                    ( 8 )
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short )( 0x4000 / sizeof( StackType_t ) ) )
+#define configMAX_TASK_NAME_LEN                 ( 32 )
+#define configUSE_16_BIT_TICKS                  ( 0 )
+#define configIDLE_SHOULD_YIELD                 ( 1 )
+#define configQUEUE_REGISTRY_SIZE               ( 20 )
+
+
+/*****************************************************************************/
+/* Memory                                                                    */
+/*****************************************************************************/
+
+#define configSUPPORT_STATIC_ALLOCATION         ( 1 )
+#define configSUPPORT_DYNAMIC_ALLOCATION        ( 1 )
+#define configKERNEL_PROVIDED_STATIC_MEMORY     ( 1 )
+#define configTOTAL_HEAP_SIZE                   ( ( size_t )( 4 * 1024 * 1024 ) )
+#define configAPPLICATION_ALLOCATED_HEAP        ( 0 )
+
+
+/*****************************************************************************/
+/* Hooks                                                                     */
+/*****************************************************************************/
+
+#define configUSE_IDLE_HOOK                     ( 0 )
+#define configUSE_TICK_HOOK                     ( 0 )
+#define configUSE_MALLOC_FAILED_HOOK            ( 1 )
+#define configCHECK_FOR_STACK_OVERFLOW          ( 0 )
+
+
+/*****************************************************************************/
+/* Synchronisation primitives                                                */
+/*****************************************************************************/
+
+#define configUSE_MUTEXES                       ( 1 )
+#define configUSE_RECURSIVE_MUTEXES             ( 1 )
+#define configUSE_COUNTING_SEMAPHORES           ( 1 )
+#define configUSE_TASK_NOTIFICATIONS            ( 1 )
+#define configUSE_QUEUE_SETS                    ( 0 )
+
+
+/*****************************************************************************/
+/* Software timers                                                           */
+/*****************************************************************************/
+
+#define configUSE_TIMERS                        ( 1 )
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                ( 20 )
+#define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
+
+
+/*****************************************************************************/
+/* Debug and run-time stats                                                  */
+/*****************************************************************************/
+
+/* The POSIX port supplies the run-time stats counter macros */
+#define configUSE_TRACE_FACILITY                ( 1 )
+#define configUSE_STATS_FORMATTING_FUNCTIONS    ( 1 )
+#define configGENERATE_RUN_TIME_STATS           ( 1 )
+#define configRECORD_STACK_HIGH_ADDRESS         ( 1 )
+
+extern void vAssertCalled( const char * const pcFileName, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+
+/*****************************************************************************/
+/* Optional API                                                              */
+/*****************************************************************************/
+
+#define INCLUDE_vTaskPrioritySet                ( 1 )
+#define INCLUDE_uxTaskPriorityGet               ( 1 )
+#define INCLUDE_vTaskDelete                     ( 1 )
+#define INCLUDE_vTaskSuspend                    ( 1 )
+#define INCLUDE_vTaskDelayUntil                 ( 1 )
+#define INCLUDE_xTaskDelayUntil                 ( 1 )
+#define INCLUDE_vTaskDelay                      ( 1 )
+#define INCLUDE_xTaskGetSchedulerState          ( 1 )
+#define INCLUDE_xTaskGetCurrentTaskHandle       ( 1 )
+#define INCLUDE_uxTaskGetStackHighWaterMark     ( 1 )
+#define INCLUDE_xTaskGetIdleTaskHandle          ( 1 )
+#define INCLUDE_eTaskGetState                   ( 1 )
+#define INCLUDE_xTimerPendFunctionCall          ( 1 )
+#define INCLUDE_xSemaphoreGetMutexHolder        ( 1 )
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * This file contains the application hooks and BSP stand-ins required to run
+ * the FreeRTOS OSAL on the FreeRTOS POSIX (Linux simulator) port.
+ *
+ * @file osal_sim_port.c
+ *
+ */
+
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+/* FreeRTOS includes */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* BSP stand-in */
+#include "xil_printf.h"
+
+
+/*****************************************************************************/
+/* Public function implementations                                           */
+/*****************************************************************************/
+
+/**
+ * @brief   Print a formatted string to stdout.
+ */
+void xil_printf( const char *pcFormat, ... )
+{
+    va_list args;
+
+    va_start( args, pcFormat );
+    vprintf( pcFormat, args );
+    va_end( args );
+
+    fflush( stdout );
+}
+
+/**
+ * @brief   Read a single character from stdin.
+ */
+char inbyte( void )
+{
+    return ( char )getchar();
+}
+
+/**
+ * @brief   FreeRTOS assert handler - stop the simulation so the failure is not missed.
+ */
+void vAssertCalled( const char * const pcFileName, unsigned long ulLine )
+{
+    fprintf( stderr, "FreeRTOS assert failed: %s:%lu\r\n", pcFileName, ulLine );
+    abort();
+}
+
+/**
+ * @brief   FreeRTOS heap exhausted hook.
+ */
+void vApplicationMallocFailedHook( void )
+{
+    fprintf( stderr, "FreeRTOS heap exhausted (%u bytes free)\r\n",
+             ( unsigned int )xPortGetFreeHeapSize() );
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * This file stands in for the BSP console header in the AMC simulation build,
+ * routing the FreeRTOS OSAL console I/O to stdio.
+ *
+ * @file xil_printf.h
+ *
+ */
+
+#ifndef _XIL_PRINTF_SIM_H_
+#define _XIL_PRINTF_SIM_H_
+
+
+/*****************************************************************************/
+/* Public function declarations                                              */
+/*****************************************************************************/
+
+/**
+ * @brief   Print a formatted string to stdout.
+ *
+ * @param   pcFormat    printf-style format string.
+ *
+ * @return  N/A
+ */
+void xil_printf( const char *pcFormat, ... );
+
+/**
+ * @brief   Read a single character from stdin.
+ *
+ * @return  The character read.
+ */
+char inbyte( void );
+
+#endif
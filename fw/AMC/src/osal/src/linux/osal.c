@@ -90,10 +90,13 @@ static pthread_mutex_t xMemAllocMutexHandle        = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t xCriticalSectionMutexHandle = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t xStrNCpyMutexHandle         = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t xMemCmpMutexHandle          = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t xHeapStatsMutexHandle       = PTHREAD_MUTEX_INITIALIZER;
 
 static int iOsStarted = FALSE;
 static uint32_t ulSemNo = 0;
 
+static OSAL_HEAP_STATS xHeapStats = { 0 };
+
 
 /*****************************************************************************/
 /* Structs                                                                   */
@@ -217,6 +220,51 @@ void vTimerCallbackWrapper( union sigval xSv )
     pvCallback( pvHandle );
 }
 
+/**
+ * @brief   Records an allocation against its call site in the heap telemetry table.
+ */
+static void vRecordAllocCallSite( void* pvMemory, void* pvCallSite, uint16_t usSize )
+{
+    assert( OK == pthread_mutex_lock( &xHeapStatsMutexHandle ) );
+
+    if( NULL == pvMemory )
+    {
+        xHeapStats.ulFailedAllocCount++;
+    }
+    else
+    {
+        uint32_t i = 0;
+
+        xHeapStats.ulAllocCount++;
+
+        for( i = 0; i < xHeapStats.ulNumCallSites; i++ )
+        {
+            if( pvCallSite == xHeapStats.xCallSites[ i ].pvCallSite )
+            {
+                break;
+            }
+        }
+
+        if( i < OSAL_HEAP_MAX_CALL_SITES )
+        {
+            if( i == xHeapStats.ulNumCallSites )
+            {
+                xHeapStats.xCallSites[ i ].pvCallSite = pvCallSite;
+                xHeapStats.ulNumCallSites++;
+            }
+
+            xHeapStats.xCallSites[ i ].ulAllocCount++;
+            xHeapStats.xCallSites[ i ].ulAllocBytes += usSize;
+        }
+        else
+        {
+            xHeapStats.ulUntrackedAllocCount++;
+        }
+    }
+
+    assert( OK == pthread_mutex_unlock( &xHeapStatsMutexHandle ) );
+}
+
 
 /*****************************************************************************/
 /* Public APIs                                                               */
@@ -1535,6 +1583,7 @@ void vOSAL_ExitCritical( void )
 void* pvOSAL_MemAlloc( uint16_t usSize )
 {
     void* pvMemory = NULL;
+    void* pvCallSite = __builtin_return_address( 0 );
 
     if( 0 != usSize )
     {
@@ -1551,6 +1600,8 @@ void* pvOSAL_MemAlloc( uint16_t usSize )
             /* OS not started or Mutex for memory allocation not created, allocation not thread safe */
             pvMemory = malloc( usSize );
         }
+
+        vRecordAllocCallSite( pvMemory, pvCallSite, usSize );
     }
 
     return pvMemory;
@@ -1580,6 +1631,10 @@ void vOSAL_MemFree( void** ppv )
             free( *ppv );
             *ppv = NULL;
         }
+
+        assert( OK == pthread_mutex_lock( &xHeapStatsMutexHandle ) );
+        xHeapStats.ulFreeCount++;
+        assert( OK == pthread_mutex_unlock( &xHeapStatsMutexHandle ) );
     }
 }
 
@@ -1843,3 +1898,23 @@ void vOSAL_ClearAllStats( void )
 {
     /* TODO implement clear stats */
 }
+
+/**
+* @brief   Takes a snapshot of the heap telemetry.
+*/
+int iOSAL_GetHeapStats( OSAL_HEAP_STATS* pxHeapStats )
+{
+    int iStatus = OSAL_ERRORS_PARAMS;
+
+    if( NULL != pxHeapStats )
+    {
+        /* glibc does not expose a bounded heap, so the free byte counts are left as 0 */
+        assert( OK == pthread_mutex_lock( &xHeapStatsMutexHandle ) );
+        *pxHeapStats = xHeapStats;
+        assert( OK == pthread_mutex_unlock( &xHeapStatsMutexHandle ) );
+
+        iStatus = OSAL_ERRORS_NONE;
+    }
+
+    return iStatus;
+}
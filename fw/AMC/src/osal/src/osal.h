@@ -31,6 +31,7 @@
 #define OSAL_TIMEOUT_WAIT_FOREVER  ( -1 )
 #define OSAL_TIMEOUT_TASK_WAIT_MS  ( 5  )
 #define OSAL_OS_NAME_LEN           ( 15 )
+#define OSAL_HEAP_MAX_CALL_SITES   ( 32 )
 
 /*****************************************************************************/
 /* Enums                                                                     */
@@ -100,6 +101,41 @@ typedef enum _OSAL_STATS_TYPE
 
 } OSAL_STATS_TYPE;
 
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * @struct  OSAL_HEAP_CALL_SITE
+ * @brief   Allocation counters for a single pvOSAL_MemAlloc call site
+ */
+typedef struct _OSAL_HEAP_CALL_SITE
+{
+    void*    pvCallSite;    /* return address into the caller of pvOSAL_MemAlloc */
+    uint32_t ulAllocCount;  /* successful allocations made from this call site */
+    uint32_t ulAllocBytes;  /* total bytes allocated from this call site */
+
+} OSAL_HEAP_CALL_SITE;
+
+/**
+ * @struct  OSAL_HEAP_STATS
+ * @brief   Heap telemetry snapshot
+ */
+typedef struct _OSAL_HEAP_STATS
+{
+    uint32_t            ulTotalHeapSize;        /* 0 if not reported by the OS */
+    uint32_t            ulCurrentFreeBytes;     /* 0 if not reported by the OS */
+    uint32_t            ulMinEverFreeBytes;     /* 0 if not reported by the OS */
+    uint32_t            ulAllocCount;
+    uint32_t            ulFreeCount;
+    uint32_t            ulFailedAllocCount;
+    uint32_t            ulUntrackedAllocCount;  /* allocations from call sites once the table is full */
+    uint32_t            ulNumCallSites;
+    OSAL_HEAP_CALL_SITE xCallSites[ OSAL_HEAP_MAX_CALL_SITES ];
+
+} OSAL_HEAP_STATS;
+
 /*****************************************************************************/
 /* Public APIs                                                               */
 /*****************************************************************************/
@@ -839,4 +875,17 @@ void vOSAL_PrintAllStats( OSAL_STATS_VERBOSITY eVerbosity, OSAL_STATS_TYPE eStat
  */
 void vOSAL_ClearAllStats( void );
 
+/**
+ * @brief   Takes a snapshot of the heap telemetry.
+ *
+ * @param   pxHeapStats  Pointer to the structure to populate.
+ *
+ * @return  OSAL_ERRORS_NONE                no errors, call was successful
+ *          OSAL_ERRORS_PARAMS              invalid parameters passed in to function
+ *
+ * @note    Call sites are keyed on the return address of pvOSAL_MemAlloc, which
+ *          can be resolved against the ELF with addr2line.
+ */
+int iOSAL_GetHeapStats( OSAL_HEAP_STATS* pxHeapStats );
+
 #endif
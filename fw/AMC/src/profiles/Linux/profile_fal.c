@@ -94,9 +94,10 @@ FW_IF_CFG xDimmIf =
 {
     0
 };
-FW_IF_CFG *pxSMBusIf = NULL;
-FW_IF_CFG *pxEmmcIf  = NULL;
-FW_IF_CFG *pxOspiIf  = &xOspiIf;
+FW_IF_CFG *pxSMBusIf   = NULL;
+FW_IF_CFG *pxEmmcIf    = NULL;
+FW_IF_CFG *pxOspiIf    = &xOspiIf;
+FW_IF_CFG *pxGcqBulkIf = NULL;
 
 
 /*****************************************************************************/
@@ -86,9 +86,10 @@ FW_IF_CFG xSMBusIf =
 };
 
 
-FW_IF_CFG *pxEmmcIf  = NULL;
-FW_IF_CFG *pxOspiIf  = &xOspiIf;
-FW_IF_CFG *pxSMBusIf = NULL;
+FW_IF_CFG *pxEmmcIf    = NULL;
+FW_IF_CFG *pxOspiIf    = &xOspiIf;
+FW_IF_CFG *pxSMBusIf   = NULL;
+FW_IF_CFG *pxGcqBulkIf = NULL;
 
 /*****************************************************************************/
 /* Local variables                                                           */
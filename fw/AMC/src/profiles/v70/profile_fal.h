@@ -51,6 +51,7 @@ extern FW_IF_CFG xQsfpIf3;
 extern FW_IF_CFG xQsfpIf4;
 extern FW_IF_CFG xDimmIf;
 extern FW_IF_CFG *pxSMBusIf;
+extern FW_IF_CFG *pxGcqBulkIf;
 
 /**
  * @brief   Initialise FAL layer
@@ -76,6 +76,10 @@ FW_IF_CFG xGcqIf =
 {
     0
 };
+FW_IF_CFG xGcqBulkIf =
+{
+    0
+};
 FW_IF_CFG xOspiIf =
 {
     0
@@ -109,9 +113,10 @@ FW_IF_CFG xSMBusIf =
     0
 };
 
-FW_IF_CFG *pxEmmcIf  = &xEmmcIf;
-FW_IF_CFG *pxOspiIf  = &xOspiIf;
-FW_IF_CFG *pxSMBusIf = &xSMBusIf;
+FW_IF_CFG *pxEmmcIf    = &xEmmcIf;
+FW_IF_CFG *pxOspiIf    = &xOspiIf;
+FW_IF_CFG *pxSMBusIf   = &xSMBusIf;
+FW_IF_CFG *pxGcqBulkIf = &xGcqBulkIf;
 
 /*****************************************************************************/
 /* Local variables                                                           */
@@ -204,6 +209,20 @@ static FW_IF_GCQ_CFG xGcqCfg =
     ""
 };
 
+/* Second queue pair for bulk requests, shares the GCQ IP block with xGcqCfg */
+static FW_IF_GCQ_CFG xGcqBulkCfg =
+{
+    ( uint64_t )HAL_BASE_LOGIC_GCQ_M2R_S01_AXI_BASEADDR,
+    FW_IF_GCQ_MODE_PRODUCER,
+    FW_IF_GCQ_INTERRUPT_MODE_NONE,
+    ( uint64_t )HAL_RPU_BULK_RING_BUFFER_BASE,
+    HAL_RPU_BULK_RING_BUFFER_LEN,
+    AMI_PROXY_RESPONSE_SIZE,
+    AMI_PROXY_REQUEST_SIZE,
+    "",
+    FW_IF_GCQ_QUEUE_SECONDARY
+};
+
 static FW_IF_GCQ_INIT_CFG myGcqIf =
 {
     NULL
@@ -617,6 +636,17 @@ int iFAL_Initialise( uint64_t *pullAmcInitStatus )
             {
                 PLL_DBG( FAL_PROFILE_NAME, "GCQ created OK\r\n" );
                 *pullAmcInitStatus |= AMC_CFG_GCQ_FAL_CREATED;
+
+                /* The bulk queue pair is optional, the host falls back to the primary pair without it */
+                if( FW_IF_ERRORS_NONE == ulFW_IF_GCQ_Create( &xGcqBulkIf, &xGcqBulkCfg ) )
+                {
+                    PLL_DBG( FAL_PROFILE_NAME, "GCQ bulk queue created OK\r\n" );
+                }
+                else
+                {
+                    PLL_ERR( FAL_PROFILE_NAME, "Error creating GCQ bulk queue\r\n" );
+                    pxGcqBulkIf = NULL;
+                }
             }
             else
             {
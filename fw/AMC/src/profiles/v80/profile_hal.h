@@ -52,10 +52,13 @@
 #define HAL_PARTITION_TABLE_MAGIC_NO            ( 0x564D5230 )
 #define HAL_ENABLE_AMI_COMMS                    ( 0x1 )
 #define HAL_RPU_RING_BUFFER_LEN                 ( 0x1000 )
+#define HAL_PARTITION_TABLE_QUEUE_MAGIC_NO      ( 0x47435132 )
+#define HAL_RPU_BULK_RING_BUFFER_LEN            ( 0x1000 )
 #define HAL_RPU_SHARED_MEMORY_BASE_ADDR         ( 0x38000000 )
 #define HAL_RPU_SHARED_MEMORY_END_ADDR          ( 0x3FFFF000 )
 #define HAL_RPU_SHARED_MEMORY_SIZE              ( HAL_RPU_SHARED_MEMORY_END_ADDR - HAL_RPU_SHARED_MEMORY_BASE_ADDR )
 #define HAL_RPU_RING_BUFFER_BASE                ( HAL_RPU_SHARED_MEMORY_BASE_ADDR + HAL_PARTITION_TABLE_SIZE )
+#define HAL_RPU_BULK_RING_BUFFER_BASE           ( HAL_RPU_RING_BUFFER_BASE + HAL_RPU_RING_BUFFER_LEN )
 #define HAL_BASE_LOGIC_GCQ_M2R_S01_AXI_BASEADDR ( XPAR_BASE_LOGIC_GCQ_M2R_BASEADDR )
 
 #define HAL_FLUSH_CACHE_DATA( addr, size ) Xil_DCacheFlushRange( addr, size )
@@ -172,6 +175,22 @@ typedef struct HAL_PARTITION_TABLE_DATA
 
 } HAL_PARTITION_TABLE_DATA;
 
+/**
+ * @struct  HAL_PARTITION_TABLE_QUEUES
+ *
+ * @brief   Stores the GCQ queue pairs on offer - part of the partition table.
+ *          Appended to the table so older hosts ignore it, a host that does
+ *          not find the magic number falls back to the single ring buffer.
+ */
+typedef struct HAL_PARTITION_TABLE_QUEUES
+{
+    uint32_t ulQueueMagicNum;
+    uint32_t ulNumQueues;
+    uint32_t ulBulkRingBufferOff;
+    uint32_t ulBulkRingBufferLen;
+
+} HAL_PARTITION_TABLE_QUEUES;
+
 /**
  * @struct  HAL_PARTITION_TABLE
  *
@@ -185,6 +204,7 @@ typedef struct HAL_PARTITION_TABLE
     HAL_PARTITION_TABLE_STATUS      xStatus;
     HAL_PARTITION_TABLE_LOG_MSG     xLogMsg;
     HAL_PARTITION_TABLE_DATA        xData;
+    HAL_PARTITION_TABLE_QUEUES      xQueues;
 
 } HAL_PARTITION_TABLE;
 
@@ -34,6 +34,12 @@
 
 #define AMI_MAX_MSG_SIZE                ( 64 )
 #define AMI_MBOX_SIZE                   ( 10 )
+#define AMI_BULK_MBOX_SIZE              ( AMI_RXDATA_SIZE )
+
+/* GCQ queue pairs, queue 0 is the primary pair passed in at init */
+#define AMI_MAX_QUEUES                  ( 2 )
+#define AMI_PRIMARY_QUEUE               ( 0 )
+#define AMI_PRIMARY_QUEUE_WEIGHT        ( 4 )
 
 /* Maximum number of in flight requests/responses */
 #define AMI_RXDATA_SIZE                 ( 8 )
@@ -52,6 +58,10 @@
 #define APC_LOAD_LINK_VER_MAJOR( v )    ( ( ( v ) << 16 ) & 0x00FF0000 )
 #define APC_LOAD_LINK_VER_MINOR( v )    ( ( ( v ) << 24 ) & 0xFF000000 )
 
+/* Heartbeat response word 1: bit 31 tells the host the progress counter is live */
+#define AMI_HEARTBEAT_PROGRESS_VALID    ( 0x80000000 )
+#define AMI_HEARTBEAT_PROGRESS_MASK     ( 0x7FFFFFFF )
+
 /* Stat & Error definitions */
 #define AMI_PROXY_STATS( DO )   \
     DO( AMI_PROXY_STATS_INIT_OVERALL_COMPLETE )        \
@@ -84,6 +94,15 @@
     DO( AMI_PROXY_STATS_GET_EEPROM_RW_REQUEST )        \
     DO( AMI_PROXY_STATS_STATUS_RETRIEVAL )             \
     DO( AMI_PROXY_STATS_GET_MODULE_RW_REQUEST )        \
+    DO( AMI_PROXY_STATS_ECHO_MBOX_POST )               \
+    DO( AMI_PROXY_STATS_ECHO_MBOX_PEND )               \
+    DO( AMI_PROXY_STATS_GET_ECHO_REQUEST )             \
+    DO( AMI_PROXY_STATS_BULK_MBOX_POST )               \
+    DO( AMI_PROXY_STATS_BULK_MBOX_PEND )               \
+    DO( AMI_PROXY_STATS_BULK_TASK_TIME_MS )            \
+    DO( AMI_PROXY_STATS_QUEUE_ATTACHED )               \
+    DO( AMI_PROXY_STATS_PRIMARY_QUEUE_RX )             \
+    DO( AMI_PROXY_STATS_SECONDARY_QUEUE_RX )           \
     DO( AMI_PROXY_STATS_MAX )
 
 #define AMI_PROXY_ERRORS( DO )    \
@@ -122,6 +141,11 @@
     DO( AMI_PROXY_BIND_CB_FAILED )                     \
     DO( AMI_PROXY_RX_DATA_INDEX_FAILED )               \
     DO( AMI_PROXY_ERRORS_INIT_EVL_RECORD_FAILED )      \
+    DO( AMI_PROXY_ERRORS_ECHO_REQUEST )                \
+    DO( AMI_PROXY_ERRORS_GET_ECHO_REQUEST )            \
+    DO( AMI_PROXY_RAISE_EVENT_ECHO_FAILED )            \
+    DO( AMI_PROXY_ERRORS_BULK_MBOX_POST_FAILED )       \
+    DO( AMI_PROXY_ERRORS_ATTACH_QUEUE_FAILED )         \
     DO( AMI_PROXY_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )             PLL_INF( AMI_NAME, "%50s . . . . %d\r\n",          \
@@ -156,6 +180,7 @@ typedef enum AMI_MSG_TYPES
     AMI_MSG_TYPE_EEPROM_RW_COMPLETE,
     AMI_MSG_TYPE_MODULE_RW_COMPLETE,
     AMI_MSG_TYPE_DEBUG_VERBOSITY_COMPLETE,
+    AMI_MSG_TYPE_ECHO_COMPLETE,
 
     MAX_AMI_MSG_TYPE
 
@@ -172,6 +197,7 @@ typedef enum AMI_CMD_OPCODE_REQ
     AMI_CMD_OPCODE_EEPROM_RW_REQ       = 0x3,
     AMI_CMD_OPCODE_MODULE_RW_REQ       = 0x4,
     AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ = 0x5,
+    AMI_CMD_OPCODE_ECHO_REQ            = 0x6,
     AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ    = 0xA,
     AMI_CMD_OPCODE_SENSOR_REQ          = 0xC,
     AMI_CMD_OPCODE_PDI_COPY_REQ        = 0xD,
@@ -221,6 +247,7 @@ UTIL_MAKE_ENUM_AND_STRINGS( AMI_PROXY_ERRORS, AMI_PROXY_ERRORS, AMI_PROXY_ERRORS
 typedef struct AMI_RX_DATA
 {
     uint8_t ucInUse;
+    uint8_t ucQueue;
     AMI_CMD_OPCODE_REQ xOpCode;
     uint16_t usCid;
     union
@@ -231,11 +258,24 @@ typedef struct AMI_RX_DATA
         AMI_PROXY_BOOT_SELECT_REQUEST      xBootSelectRequest;
         AMI_PROXY_EEPROM_RW_REQUEST        xEepromReadWriteRequest;
         AMI_PROXY_MODULE_RW_REQUEST        xModuleReadWriteRequest;
+        AMI_PROXY_ECHO_REQUEST             xEchoRequest;
         uint8_t                            ucDebugVerbosityRequest;
     };
 
 } AMI_RX_DATA;
 
+/**
+ * @struct  AMI_QUEUE
+ * @brief   A GCQ queue pair serviced by the proxy driver
+ */
+typedef struct AMI_QUEUE
+{
+    FW_IF_CFG *     pxFwIf;
+    uint32_t        ulFwIfPort;
+    uint32_t        ulWeight;
+
+} AMI_QUEUE;
+
 /**
  * @struct  AMI_PRIVATE_DATA
  * @brief   Structure to hold ths proxy driver's private data
@@ -247,17 +287,22 @@ typedef struct AMI_PRIVATE_DATA
     int             iInitialised;
     uint8_t         ucMyId;
 
-    FW_IF_CFG *     pxFwIf;
-    uint32_t        ulFwIfPort;
+    AMI_QUEUE       xQueues[ AMI_MAX_QUEUES ];
+    uint8_t         ucNumQueues;
 
     EVL_RECORD      *pxEvlRecord;
+    EVL_RECORD      *pxBulkEvlRecord;
 
     void *          pvOsalMutexHdl;
     void *          pvOsalMBoxHdl;
     void *          pvOsalTaskHdl;
+    void *          pvOsalBulkMBoxHdl;
+    void *          pvOsalBulkTaskHdl;
 
     AMI_RX_DATA     xRxData[ AMI_RXDATA_SIZE ];
 
+    volatile uint32_t ulProgress;
+
     uint32_t        pulStatCounters[ AMI_PROXY_STATS_MAX ];
     uint32_t        pulErrorCounters[ AMI_PROXY_ERRORS_MAX ];
 
@@ -280,6 +325,7 @@ typedef struct AMI_MBOX_MSG
     {
         AMI_PROXY_IDENTITY_RESPONSE xIdentity;
         AMI_PROXY_HEARTBEAT_RESPONSE xHeartbeat;
+        AMI_PROXY_ECHO_RESPONSE xEcho;
     };
 
 } AMI_MBOX_MSG;
@@ -387,7 +433,8 @@ typedef struct AMI_CMD_DATA_PAYLOAD
     uint32_t ulBootDevice:1;
     uint32_t ulSrcDevice:1;
     uint32_t ulDestDevice:1;
-    uint32_t ulPartitionRsvd:16;
+    uint32_t ulCodec:4;         /* transfer codec of the packet data */
+    uint32_t ulPartitionRsvd:12;
     uint16_t usLastPacket:1;
     uint16_t usPacketNum:15;
     uint16_t usPacketSize; /* packet size in KB */
@@ -435,6 +482,18 @@ typedef struct AMI_CMD_MODULE_PAYLOAD
 
 } AMI_CMD_MODULE_PAYLOAD;
 
+/**
+ * @struct  AMI_CMD_ECHO_PAYLOAD
+ * @brief   The echo payload
+ */
+typedef struct AMI_CMD_ECHO_PAYLOAD
+{
+    uint64_t ullAddress;
+    uint32_t ulSize;
+    uint32_t ulCookie;
+
+} AMI_CMD_ECHO_PAYLOAD;
+
 /**
  * @struct  AMI_CMD_REQUEST
  * @brief   The request command header & payload
@@ -451,12 +510,24 @@ typedef struct AMI_CMD_REQUEST
         AMI_CMD_HEARTBEAT_PAYLOAD xHeartbeatPayload;
         AMI_CMD_EEPROM_PAYLOAD xEepromPayload;
         AMI_CMD_MODULE_PAYLOAD xModulePayload;
+        AMI_CMD_ECHO_PAYLOAD xEchoPayload;
         uint8_t ucDebugVerbosityPayload;
     };
 
 } AMI_CMD_REQUEST;
 STATIC_ASSERT( sizeof( AMI_CMD_RESPONSE ) < AMI_PROXY_REQUEST_SIZE );
 
+/**
+ * @struct  AMI_BULK_MSG
+ * @brief   Data posted via the AMI Proxy driver bulk lane mailbox
+ */
+typedef struct AMI_BULK_MSG
+{
+    uint8_t         ucQueue;
+    AMI_CMD_REQUEST xCmdRequest;
+
+} AMI_BULK_MSG;
+
 
 /******************************************************************************/
 /* Local Variables                                                            */
@@ -467,13 +538,17 @@ static AMI_PRIVATE_DATA xLocalData =
     UPPER_FIREWALL,             /* ulUpperFirewall */
     FALSE,                      /* iInitialised */
     0,                          /* ucMyId */
-    NULL,                       /* pxFwIf */
-    0,                          /* ulFwIfPort */
+    { { 0 } },                  /* xQueues */
+    0,                          /* ucNumQueues */
     NULL,                       /* pxEvlRecord */
+    NULL,                       /* pxBulkEvlRecord */
     NULL,                       /* pvOsalMutexHdl */
     NULL,                       /* pvOsalMBoxHdl */
     NULL,                       /* pvOsalTaskHdl */
+    NULL,                       /* pvOsalBulkMBoxHdl */
+    NULL,                       /* pvOsalBulkTaskHdl */
     { { 0 } },                  /* xRxData */
+    0,                          /* ulProgress */
     { 0 },                      /* pulStatCounters */
     { 0 },                      /* pulErrorCounters */
     MODULE_STATE_UNINITIALISED, /* xState */
@@ -496,6 +571,53 @@ static AMI_PRIVATE_DATA *pxThis = &xLocalData;
  */
 static void vProxyDriverTask( void *pvArgs );
 
+/**
+ * @brief   Bulk lane task declaration
+ *
+ * @param   pvArgs  Pointer to task args (unused)
+ *
+ * @return  N/A
+ *
+ * @note    Services the requests that can take a long time (EEPROM, QSFP module
+ *          and flash) so they do not hold up the latency sensitive requests
+ *          handled by the main proxy task.
+ */
+static void vProxyDriverBulkTask( void *pvArgs );
+
+/**
+ * @brief   Read a single request from a queue pair and pass it to the
+ *          main or bulk lane
+ *
+ * @param   ucQueue     Index of the queue pair to read from
+ *
+ * @return  OK if a request was read
+ *          ERROR if the queue pair had nothing to read
+ *
+ */
+static int iReadRequest( uint8_t ucQueue );
+
+/**
+ * @brief   Check if a request opcode belongs in the bulk lane
+ *
+ * @param   ulOpCode    The request opcode
+ *
+ * @return  TRUE if the request should be handled by the bulk lane task
+ *          FALSE if the request should be handled by the main proxy task
+ *
+ */
+static int iIsBulkRequest( uint32_t ulOpCode );
+
+/**
+ * @brief   Store an incoming request and raise the matching event
+ *
+ * @param   pxCmdRequest The request details
+ * @param   ucQueue      The queue the request arrived on
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandleRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue );
+
 /**
  * @brief   Find the next free data index
  *
@@ -510,41 +632,56 @@ static int iFindNextFreeRxDataIndex( uint8_t *pucIndex );
  * @brief   Handle the heartbeat request
  *
  * @param   pxCmdRequest The request details
+ * @param   ucQueue      The queue the request arrived on
  *
  * @return  OK/ERROR
  *
  */
-static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest );
+static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue );
 
 /**
  * @brief   Handle the eeprom request
  *
  * @param   pxCmdRequest The request details
+ * @param   ucQueue      The queue the request arrived on
  *
  * @return  OK/ERROR
  *
  */
-static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest );
+static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue );
 
 /**
  * @brief   Handle the module request
  *
  * @param   pxCmdRequest The request details
+ * @param   ucQueue      The queue the request arrived on
  *
  * @return  OK/ERROR
  *
  */
-static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest );
+static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue );
 
 /**
  * @brief   Handle the debug verbosity request
  *
  * @param   pxCmdRequest The request details
+ * @param   ucQueue      The queue the request arrived on
+ *
+ * @return  OK/ERROR
+ *
+ */
+static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue );
+
+/**
+ * @brief   Handle the echo request
+ *
+ * @param   pxCmdRequest The request details
+ * @param   ucQueue      The queue the request arrived on
  *
  * @return  OK/ERROR
  *
  */
-static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest );
+static int iHandleEchoRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue );
 
 
 /******************************************************************************/
@@ -566,12 +703,14 @@ int iAMI_Initialise( uint8_t ucProxyId, FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort,
         ( NULL != pxFwIf ) )
     {
         /* Store parameters locally */
-        pxThis->ucMyId     = ucProxyId;
-        pxThis->pxFwIf     = pxFwIf;
-        pxThis->ulFwIfPort = ulFwIfPort;
-
-        /* initalise evl record*/
-        if ( OK != iEVL_CreateRecord( &pxThis->pxEvlRecord ) )
+        pxThis->ucMyId = ucProxyId;
+        pxThis->xQueues[ AMI_PRIMARY_QUEUE ].pxFwIf     = pxFwIf;
+        pxThis->xQueues[ AMI_PRIMARY_QUEUE ].ulFwIfPort = ulFwIfPort;
+        pxThis->xQueues[ AMI_PRIMARY_QUEUE ].ulWeight   = AMI_PRIMARY_QUEUE_WEIGHT;
+
+        /* initalise evl records, one per lane so a slow bulk callback does not block the main lane */
+        if( ( OK != iEVL_CreateRecord( &pxThis->pxEvlRecord ) ) ||
+            ( OK != iEVL_CreateRecord( &pxThis->pxBulkEvlRecord ) ) )
         {
             PLL_ERR( AMI_NAME, "Error initialising EVL_RECORD\r\n" );
             INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_INIT_EVL_RECORD_FAILED );
@@ -579,13 +718,15 @@ int iAMI_Initialise( uint8_t ucProxyId, FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort,
         else
         {
 
-            if( FW_IF_ERRORS_NONE != pxThis->pxFwIf->open( pxThis->pxFwIf ) )
+            if( FW_IF_ERRORS_NONE != pxFwIf->open( pxFwIf ) )
             {
                 PLL_ERR( AMI_NAME, "Error opening FW_IF\r\n" );
                 INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_FW_IF_OPEN_FAILED )
             }
             else
             {
+                pxThis->ucNumQueues = 1;
+
                 /* Initialise OSAL items */
                 if( OSAL_ERRORS_NONE != iOSAL_Mutex_Create( &pxThis->pvOsalMutexHdl,
                                                                 "ami_proxy mutex" ) )
@@ -599,6 +740,22 @@ int iAMI_Initialise( uint8_t ucProxyId, FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort,
                     PLL_ERR( AMI_NAME, "Error initialising mbox\r\n" );
                     INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_MBOX_CREATE_FAILED )
                 }
+                else if( OSAL_ERRORS_NONE != iOSAL_MBox_Create( &pxThis->pvOsalBulkMBoxHdl, AMI_BULK_MBOX_SIZE,
+                                                    sizeof( AMI_BULK_MSG ), "ami_proxy bulk mbox" ) )
+                {
+                    PLL_ERR( AMI_NAME, "Error initialising bulk mbox\r\n" );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_MBOX_CREATE_FAILED )
+                }
+                else if( OSAL_ERRORS_NONE != iOSAL_Task_Create( &pxThis->pvOsalBulkTaskHdl,
+                                                                vProxyDriverBulkTask,
+                                                                ulTaskStack,
+                                                                NULL,
+                                                                ulTaskPrio,
+                                                                "ami_proxy bulk task" ) )
+                {
+                    PLL_ERR( AMI_NAME, "Error initialising bulk task\r\n" );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_INIT_TASK_CREATE_FAILED )
+                }
                 else if( OSAL_ERRORS_NONE != iOSAL_Task_Create( &pxThis->pvOsalTaskHdl,
                                                                 vProxyDriverTask,
                                                                 ulTaskStack,
@@ -629,6 +786,47 @@ int iAMI_Initialise( uint8_t ucProxyId, FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort,
     return iStatus;
 }
 
+/**
+ * @brief   Attach an additional queue pair to the AMI Proxy Driver
+ */
+int iAMI_AttachQueue( FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort, uint32_t ulWeight )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxFwIf ) &&
+        ( 0 != ulWeight ) &&
+        ( AMI_MAX_QUEUES > pxThis->ucNumQueues ) )
+    {
+        if( FW_IF_ERRORS_NONE != pxFwIf->open( pxFwIf ) )
+        {
+            PLL_ERR( AMI_NAME, "Error opening queue FW_IF\r\n" );
+            INC_ERROR_COUNTER( AMI_PROXY_ERRORS_ATTACH_QUEUE_FAILED )
+        }
+        else
+        {
+            AMI_QUEUE *pxQueue = &pxThis->xQueues[ pxThis->ucNumQueues ];
+
+            pxQueue->pxFwIf     = pxFwIf;
+            pxQueue->ulFwIfPort = ulFwIfPort;
+            pxQueue->ulWeight   = ulWeight;
+
+            /* Only publish the queue to the proxy task once fully populated */
+            pxThis->ucNumQueues++;
+            INC_STAT_COUNTER( AMI_PROXY_STATS_QUEUE_ATTACHED )
+            iStatus = OK;
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Bind into this proxy driver
  */
@@ -640,9 +838,14 @@ int iAMI_BindCallback( EVL_CALLBACK *pxCallback )
         ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
         ( TRUE == pxThis->iInitialised ) &&
         ( NULL != pxCallback ) &&
-        ( NULL != pxThis->pxEvlRecord ) )
+        ( NULL != pxThis->pxEvlRecord ) &&
+        ( NULL != pxThis->pxBulkEvlRecord ) )
     {
         iStatus = iEVL_BindCallback( pxThis->pxEvlRecord, pxCallback );
+        if( OK == iStatus )
+        {
+            iStatus = iEVL_BindCallback( pxThis->pxBulkEvlRecord, pxCallback );
+        }
         if( ERROR == iStatus )
         {
             INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_BIND_CB_FAILED )
@@ -951,6 +1154,68 @@ int iAMI_SetDebugVerbosityResponse( EVL_SIGNAL *pxSignal, AMI_PROXY_RESULT xResu
     return iStatus;
 }
 
+/**
+ * @brief   Set the echo response
+ */
+int iAMI_SetEchoCompleteResponse( EVL_SIGNAL *pxSignal,
+                                  AMI_PROXY_RESULT xResult,
+                                  AMI_PROXY_ECHO_RESPONSE *pxEchoResponse )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxSignal ) &&
+        ( NULL != pxEchoResponse ) )
+    {
+        AMI_MBOX_MSG xMsg = { 0 };
+        xMsg.ucRxDataIndex = pxSignal->ucInstance;
+        xMsg.eMsgType = AMI_MSG_TYPE_ECHO_COMPLETE;
+        xMsg.xResult = xResult;
+        pvOSAL_MemCpy( &xMsg.xEcho, pxEchoResponse, sizeof( xMsg.xEcho ) );
+        if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
+                                                 ( void* )&xMsg,
+                                                 OSAL_TIMEOUT_NO_WAIT ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_ECHO_MBOX_POST )
+            iStatus = OK;
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MAILBOX_POST_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Set the progress counter reported with each heartbeat
+ */
+int iAMI_SetProgress( uint32_t ulProgress )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        pxThis->ulProgress = ulProgress;
+        iStatus            = OK;
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
 /* Get Functions **************************************************************/
 
 /**
@@ -996,6 +1261,8 @@ int iAMI_GetPdiDownloadRequest( EVL_SIGNAL *pxSignal,
                              pxThis->xRxData[ ucIndex ].xDownloadRequest.iUpdateFpt;
                 pxDownloadRequest->iLastPacket =
                              pxThis->xRxData[ ucIndex ].xDownloadRequest.iLastPacket;
+                pxDownloadRequest->ucCodec =
+                             pxThis->xRxData[ ucIndex ].xDownloadRequest.ucCodec;
                 iStatus = OK;
             }
             else
@@ -1422,6 +1689,66 @@ int iAMI_GetDebugVerbosityRequest( EVL_SIGNAL *pxSignal,
     return iStatus;
 }
 
+/**
+ * @brief   Get the echo request
+ */
+int iAMI_GetEchoRequest( EVL_SIGNAL *pxSignal, AMI_PROXY_ECHO_REQUEST *pxEchoRequest )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxSignal ) &&
+        ( NULL != pxEchoRequest ) )
+    {
+        INC_STAT_COUNTER( AMI_PROXY_STATS_GET_ECHO_REQUEST )
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            uint8_t ucIndex = pxSignal->ucInstance;
+
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            if( AMI_CHECK_VALID_INDEX( ucIndex ) &&
+                ( TRUE == pxThis->xRxData[ ucIndex ].ucInUse ) &&
+                ( AMI_CMD_OPCODE_ECHO_REQ == pxThis->xRxData[ ucIndex ].xOpCode ) )
+            {
+                pxEchoRequest->ullAddress = pxThis->xRxData[ ucIndex ].xEchoRequest.ullAddress;
+                pxEchoRequest->ulLength = pxThis->xRxData[ ucIndex ].xEchoRequest.ulLength;
+                pxEchoRequest->ulCookie = pxThis->xRxData[ ucIndex ].xEchoRequest.ulCookie;
+                iStatus = OK;
+            }
+            else
+            {
+                PLL_ERR( AMI_NAME, "Error invalid get echo request for instance\r\n" );
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_ECHO_REQUEST )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                iStatus = ERROR;
+            }
+            else
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( AMI_PROXY_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Display the current stats/errors
  */
@@ -1533,355 +1860,44 @@ int iAMI_GetState( MODULE_STATE *pxState )
 static void vProxyDriverTask( void *pvArgs )
 {
     AMI_MBOX_MSG xMBoxData = { 0 };
-    AMI_CMD_REQUEST xCmdRequest = { { { { 0 } } } };
     uint32_t ulStartMs = 0;
 
     FOREVER
     {
+        uint8_t ucQueue = 0;
+        uint8_t ucSent = 0;
+
         ulStartMs = ulOSAL_GetUptimeMs();
-        uint32_t ulCmdRequestSize = sizeof(AMI_CMD_REQUEST);
 
-        /* Check on incoming FW_IF data (rx path) */
-        if( FW_IF_ERRORS_NONE == pxThis->pxFwIf->read( pxThis->pxFwIf, ( uint64_t )pxThis->ulFwIfPort,
-                                                       ( uint8_t* )&xCmdRequest, &ulCmdRequestSize,
-                                                       FW_IF_TIMEOUT_NO_WAIT ) )
+        /*
+         * Check on incoming FW_IF data (rx path), queues are visited in priority
+         * order and each hands over at most its weight in requests per pass
+         */
+        for( ucQueue = 0; ucQueue < pxThis->ucNumQueues; ucQueue++ )
         {
-            int iStatus = ERROR;
-            uint8_t ucIndex = 0;
+            uint32_t ulRead = 0;
 
-            /* Handle request based on opcode, Store data internally and raise event */
-            switch( xCmdRequest.xHdr.ulOpCode )
+            for( ulRead = 0; ulRead < pxThis->xQueues[ ucQueue ].ulWeight; ulRead++ )
             {
-                case AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ:
+                if( OK != iReadRequest( ucQueue ) )
                 {
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iBootDevice =
-                                                                xCmdRequest.xPdiDownloadPayload.ulBootDevice;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ullAddress =
-                                                                xCmdRequest.xPdiDownloadPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulLength =
-                                                                xCmdRequest.xPdiDownloadPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPartitionSel =
-                                                                xCmdRequest.xPdiDownloadPayload.ulPartitionSel;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketNum =
-                                                                xCmdRequest.xPdiDownloadPayload.usPacketNum;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketSize =
-                                                                xCmdRequest.xPdiDownloadPayload.usPacketSize;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iUpdateFpt =
-                                                                xCmdRequest.xPdiDownloadPayload.ulUpdateFpt;
-                            pxThis->xRxData[ ucIndex ].xDownloadRequest.iLastPacket =
-                                                                xCmdRequest.xPdiDownloadPayload.usLastPacket;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_DOWNLOAD_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
                     break;
                 }
-                case AMI_CMD_OPCODE_PDI_COPY_REQ:
-                {
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ullAddress =
-                                                                xCmdRequest.xPdiCopyPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulMaxLength =
-                                                                xCmdRequest.xPdiCopyPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcDevice =
-                                                                xCmdRequest.xPdiCopyPayload.ulSrcDevice;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcPartition =
-                                                                xCmdRequest.xPdiCopyPayload.ulSrcPartition;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestDevice =
-                                                                xCmdRequest.xPdiCopyPayload.ulDestDevice;
-                            pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestPartition =
-                                                                xCmdRequest.xPdiCopyPayload.ulDestPartition;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
+            }
+        }
 
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
+        /* Check for new MBox data (tx path), enough to keep up with the weighted rx path */
+        while( ( AMI_RXDATA_SIZE > ucSent ) &&
+               ( OSAL_ERRORS_NONE == iOSAL_MBox_Pend( pxThis->pvOsalMBoxHdl,
+                                                      ( void* )&xMBoxData,
+                                                      OSAL_TIMEOUT_NO_WAIT ) ) )
+        {
+            AMI_CMD_RESPONSE xCmdResponse = { { { { { { 0 } } } } } };
+            uint32_t xCmdResponseSize = sizeof( AMI_CMD_RESPONSE );
+            uint32_t ulValidMsg = TRUE;
+            uint8_t ucIndex = xMBoxData.ucRxDataIndex;
 
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_PDI_COPY_START,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_PDI_COPY_START );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_COPY_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_SENSOR_REQ:
-                {
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ullAddress =
-                                                            xCmdRequest.xSensorPayload.ullAddress;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ulLength =
-                                                            xCmdRequest.xSensorPayload.ulSize;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.ulSensorId =
-                                                            xCmdRequest.xSensorPayload.ulSensorId;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.xRepo =
-                                                            xCmdRequest.xSensorPayload.ulSID;
-                            pxThis->xRxData[ ucIndex ].xSensorRequest.xRequest =
-                                                            xCmdRequest.xSensorPayload.ulAID;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_SENSOR_READ, ucIndex, 0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_SENSOR_READ );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_SENSOR_READ_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_IDENTIFY_REQ:
-                {
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_GET_IDENTITY,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_GET_IDENTITY );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_GET_IDENTIFY_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_BOOT_SEL_REQ:
-                {
-                    if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
-                                                              OSAL_TIMEOUT_WAIT_FOREVER ) )
-                    {
-                        INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
-
-                        iStatus = iFindNextFreeRxDataIndex( &ucIndex );
-                        if( ERROR != iStatus )
-                        {
-                            pxThis->xRxData[ ucIndex ].usCid = xCmdRequest.xHdr.usCid;
-                            pxThis->xRxData[ ucIndex ].xOpCode = xCmdRequest.xHdr.ulOpCode;
-                            pxThis->xRxData[ ucIndex ].xBootSelectRequest.ulPartitionSel =
-                                                            xCmdRequest.xBootSelect.ulPartitionSel;
-                            pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
-                        }
-                        else
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
-                        }
-
-                        if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
-                        {
-                            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
-                        }
-
-                        if( ERROR != iStatus )
-                        {
-                            INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
-
-                            /* Raise event using the index as the method to track the event */
-                            EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
-                                                    AMI_PROXY_DRIVER_E_BOOT_SELECT,
-                                                    ucIndex,
-                                                    0 };
-                            iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
-                            if( ERROR == iStatus )
-                            {
-                                PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
-                                         AMI_PROXY_DRIVER_E_BOOT_SELECT );
-                                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_BOOT_SELECT_FAILED )
-                            }
-                        }
-                    }
-                    else
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_HEARTBEAT_REQ:
-                {
-                    iStatus = iHandleHeartbeatRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_HEARTBEAT_REQUEST )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_EEPROM_RW_REQ:
-                {
-                    iStatus = iHandleEepromRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_EEPROM_RW_REQUEST )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_MODULE_RW_REQ:
-                {
-                    iStatus = iHandleModuleRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_MODULE_RW_REQUEST )
-                    }
-                    break;
-                }
-                case AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ:
-                {
-                    iStatus = iHandleDebugVerbosityRequest( &xCmdRequest );
-                    if( ERROR == iStatus )
-                    {
-                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_DEBUG_VERBOSITY_REQUEST )
-                    }
-                    break;
-                }
-                default:
-                    PLL_ERR( AMI_NAME, "Error unsupported opcode received 0x%x\r\n", xCmdRequest.xHdr.ulOpCode );
-                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_UNSUPPORTED_OPCODE_RX )
-                    break;
-            }
-        }
-
-        /* Check for new MBox data (tx path) */
-        if( OSAL_ERRORS_NONE == iOSAL_MBox_Pend( pxThis->pvOsalMBoxHdl,
-                                                 ( void* )&xMBoxData,
-                                                 OSAL_TIMEOUT_NO_WAIT ) )
-        {
-            AMI_CMD_RESPONSE xCmdResponse = { { { { { { 0 } } } } } };
-            uint32_t xCmdResponseSize = sizeof( AMI_CMD_RESPONSE );
-            uint32_t ulValidMsg = TRUE;
-            uint8_t ucIndex = xMBoxData.ucRxDataIndex;
+            ucSent++;
 
             switch( xMBoxData.eMsgType )
             {
@@ -1916,6 +1932,7 @@ static void vProxyDriverTask( void *pvArgs )
                 case AMI_MSG_TYPE_HEARTBEAT_COMPLETE:
                     INC_STAT_COUNTER( AMI_PROXY_STATS_HEARTBEAT_MBOX_PEND )
                     xCmdResponse.ulPayload[ 0 ] = xMBoxData.xHeartbeat.ucHeartbeatCount;
+                    xCmdResponse.ulPayload[ 1 ] = xMBoxData.xHeartbeat.ulProgress;
                     break;
                 case AMI_MSG_TYPE_EEPROM_RW_COMPLETE:
                     INC_STAT_COUNTER( AMI_PROXY_STATS_EEPROM_RW_MBOX_PEND )
@@ -1926,6 +1943,11 @@ static void vProxyDriverTask( void *pvArgs )
                 case AMI_MSG_TYPE_DEBUG_VERBOSITY_COMPLETE:
                     INC_STAT_COUNTER( AMI_PROXY_STATS_DEBUG_VERBOSITY_MBOX_PEND )
                     break;
+                case AMI_MSG_TYPE_ECHO_COMPLETE:
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_ECHO_MBOX_PEND )
+                    xCmdResponse.ulPayload[ 0 ] = xMBoxData.xEcho.ulCookie;
+                    xCmdResponse.ulPayload[ 1 ] = xMBoxData.xEcho.ulChecksum;
+                    break;
 
                 default:
                     PLL_ERR( AMI_NAME, "Error unknown mailbox message type 0x%x\r\n", xMBoxData.eMsgType );
@@ -1939,10 +1961,12 @@ static void vProxyDriverTask( void *pvArgs )
                 xCmdResponse.xHdr.usCid = pxThis->xRxData[ ucIndex ].usCid;
                 xCmdResponse.xHdr.usCState = AMI_CMD_STATE_COMPLETED;
                 xCmdResponse.ulRCode = xMBoxData.xResult;
-                int iStatus = pxThis->pxFwIf->write( pxThis->pxFwIf, ( uint64_t )pxThis->ulFwIfPort,
-                                                 ( uint8_t* )&xCmdResponse,
-                                                  xCmdResponseSize,
-                                                  FW_IF_TIMEOUT_NO_WAIT );
+                /* Respond on the queue pair the request arrived on */
+                AMI_QUEUE *pxQueue = &pxThis->xQueues[ pxThis->xRxData[ ucIndex ].ucQueue ];
+                int iStatus = pxQueue->pxFwIf->write( pxQueue->pxFwIf, ( uint64_t )pxQueue->ulFwIfPort,
+                                                      ( uint8_t* )&xCmdResponse,
+                                                      xCmdResponseSize,
+                                                      FW_IF_TIMEOUT_NO_WAIT );
                 if( FW_IF_ERRORS_NONE == iStatus )
                 {
                     if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
@@ -1977,6 +2001,454 @@ static void vProxyDriverTask( void *pvArgs )
     }
 }
 
+/**
+ * @brief   Task to handle the bulk lane requests posted by the main proxy task
+ */
+static void vProxyDriverBulkTask( void *pvArgs )
+{
+    AMI_BULK_MSG xBulkMsg = { 0 };
+    uint32_t ulStartMs = 0;
+
+    FOREVER
+    {
+        if( OSAL_ERRORS_NONE == iOSAL_MBox_Pend( pxThis->pvOsalBulkMBoxHdl,
+                                                 ( void* )&xBulkMsg,
+                                                 OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_BULK_MBOX_PEND )
+            ulStartMs = ulOSAL_GetUptimeMs();
+
+            iHandleRequest( &xBulkMsg.xCmdRequest, xBulkMsg.ucQueue );
+
+            pxThis->pulStatCounters[ AMI_PROXY_STATS_BULK_TASK_TIME_MS ] = UTIL_ELAPSED_TIME_MS( ulStartMs )
+        }
+    }
+}
+
+/**
+ * @brief   Read a single request from a queue pair and pass it to the right lane
+ */
+static int iReadRequest( uint8_t ucQueue )
+{
+    int iStatus = ERROR;
+    AMI_QUEUE *pxQueue = &pxThis->xQueues[ ucQueue ];
+    AMI_BULK_MSG xBulkMsg = { 0 };
+    uint32_t ulCmdRequestSize = sizeof( AMI_CMD_REQUEST );
+
+    if( FW_IF_ERRORS_NONE == pxQueue->pxFwIf->read( pxQueue->pxFwIf, ( uint64_t )pxQueue->ulFwIfPort,
+                                                    ( uint8_t* )&xBulkMsg.xCmdRequest, &ulCmdRequestSize,
+                                                    FW_IF_TIMEOUT_NO_WAIT ) )
+    {
+        iStatus = OK;
+        xBulkMsg.ucQueue = ucQueue;
+
+        if( AMI_PRIMARY_QUEUE == ucQueue )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_PRIMARY_QUEUE_RX )
+        }
+        else
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_SECONDARY_QUEUE_RX )
+        }
+
+        if( TRUE == iIsBulkRequest( xBulkMsg.xCmdRequest.xHdr.ulOpCode ) )
+        {
+            /* Hand slow requests to the bulk lane so the main lane stays responsive */
+            if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalBulkMBoxHdl,
+                                                     ( void* )&xBulkMsg,
+                                                     OSAL_TIMEOUT_NO_WAIT ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_BULK_MBOX_POST )
+            }
+            else
+            {
+                /* Bulk lane is backed up - service the request here rather than drop it */
+                INC_ERROR_COUNTER( AMI_PROXY_ERRORS_BULK_MBOX_POST_FAILED )
+                iHandleRequest( &xBulkMsg.xCmdRequest, ucQueue );
+            }
+        }
+        else
+        {
+            iHandleRequest( &xBulkMsg.xCmdRequest, ucQueue );
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Check if a request opcode belongs in the bulk lane
+ */
+static int iIsBulkRequest( uint32_t ulOpCode )
+{
+    int iBulk = FALSE;
+
+    switch( ulOpCode )
+    {
+        case AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ:
+        case AMI_CMD_OPCODE_PDI_COPY_REQ:
+        case AMI_CMD_OPCODE_EEPROM_RW_REQ:
+        case AMI_CMD_OPCODE_MODULE_RW_REQ:
+            iBulk = TRUE;
+            break;
+
+        default:
+            break;
+    }
+
+    return iBulk;
+}
+
+/**
+ * @brief   Store an incoming request and raise the matching event
+ */
+static int iHandleRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue )
+{
+    int iStatus = ERROR;
+    uint8_t ucIndex = 0;
+
+    /* Handle request based on opcode, Store data internally and raise event */
+    switch( pxCmdRequest->xHdr.ulOpCode )
+    {
+        case AMI_CMD_OPCODE_PDI_DOWNLOAD_REQ:
+        {
+            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                      OSAL_TIMEOUT_WAIT_FOREVER ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+                iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+                if( ERROR != iStatus )
+                {
+                    pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                    pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
+                    pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.iBootDevice =
+                                                        pxCmdRequest->xPdiDownloadPayload.ulBootDevice;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.ullAddress =
+                                                        pxCmdRequest->xPdiDownloadPayload.ullAddress;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.ulLength =
+                                                        pxCmdRequest->xPdiDownloadPayload.ulSize;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.ulPartitionSel =
+                                                        pxCmdRequest->xPdiDownloadPayload.ulPartitionSel;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketNum =
+                                                        pxCmdRequest->xPdiDownloadPayload.usPacketNum;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.usPacketSize =
+                                                        pxCmdRequest->xPdiDownloadPayload.usPacketSize;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.iUpdateFpt =
+                                                        pxCmdRequest->xPdiDownloadPayload.ulUpdateFpt;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.iLastPacket =
+                                                        pxCmdRequest->xPdiDownloadPayload.usLastPacket;
+                    pxThis->xRxData[ ucIndex ].xDownloadRequest.ucCodec =
+                                                        pxCmdRequest->xPdiDownloadPayload.ulCodec;
+                    pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+                }
+
+                if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                }
+
+                if( ERROR != iStatus )
+                {
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                    /* Raise event using the index as the method to track the event */
+                    EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
+                                            AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START,
+                                            ucIndex,
+                                            0 };
+                    iStatus = iEVL_RaiseEvent( pxThis->pxBulkEvlRecord, &xNewSignal );
+                    if( ERROR == iStatus )
+                    {
+                        PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                                 AMI_PROXY_DRIVER_E_PDI_DOWNLOAD_START );
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_DOWNLOAD_FAILED )
+                    }
+                }
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_PDI_COPY_REQ:
+        {
+            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                      OSAL_TIMEOUT_WAIT_FOREVER ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+                iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+                if( ERROR != iStatus )
+                {
+                    pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                    pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
+                    pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                    pxThis->xRxData[ ucIndex ].xCopyRequest.ullAddress =
+                                                        pxCmdRequest->xPdiCopyPayload.ullAddress;
+                    pxThis->xRxData[ ucIndex ].xCopyRequest.ulMaxLength =
+                                                        pxCmdRequest->xPdiCopyPayload.ulSize;
+                    pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcDevice =
+                                                        pxCmdRequest->xPdiCopyPayload.ulSrcDevice;
+                    pxThis->xRxData[ ucIndex ].xCopyRequest.ulSrcPartition =
+                                                        pxCmdRequest->xPdiCopyPayload.ulSrcPartition;
+                    pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestDevice =
+                                                        pxCmdRequest->xPdiCopyPayload.ulDestDevice;
+                    pxThis->xRxData[ ucIndex ].xCopyRequest.ulDestPartition =
+                                                        pxCmdRequest->xPdiCopyPayload.ulDestPartition;
+                    pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+                }
+
+                if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                }
+
+                if( ERROR != iStatus )
+                {
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                    /* Raise event using the index as the method to track the event */
+                    EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
+                                            AMI_PROXY_DRIVER_E_PDI_COPY_START,
+                                            ucIndex,
+                                            0 };
+                    iStatus = iEVL_RaiseEvent( pxThis->pxBulkEvlRecord, &xNewSignal );
+                    if( ERROR == iStatus )
+                    {
+                        PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                                 AMI_PROXY_DRIVER_E_PDI_COPY_START );
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_PDI_COPY_FAILED )
+                    }
+                }
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_SENSOR_REQ:
+        {
+            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                      OSAL_TIMEOUT_WAIT_FOREVER ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+                iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+                if( ERROR != iStatus )
+                {
+                    pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                    pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
+                    pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                    pxThis->xRxData[ ucIndex ].xSensorRequest.ullAddress =
+                                                    pxCmdRequest->xSensorPayload.ullAddress;
+                    pxThis->xRxData[ ucIndex ].xSensorRequest.ulLength =
+                                                    pxCmdRequest->xSensorPayload.ulSize;
+                    pxThis->xRxData[ ucIndex ].xSensorRequest.ulSensorId =
+                                                    pxCmdRequest->xSensorPayload.ulSensorId;
+                    pxThis->xRxData[ ucIndex ].xSensorRequest.xRepo =
+                                                    pxCmdRequest->xSensorPayload.ulSID;
+                    pxThis->xRxData[ ucIndex ].xSensorRequest.xRequest =
+                                                    pxCmdRequest->xSensorPayload.ulAID;
+                    pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+                }
+
+                if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                }
+
+                if( ERROR != iStatus )
+                {
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                    /* Raise event using the index as the method to track the event */
+                    EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
+                                            AMI_PROXY_DRIVER_E_SENSOR_READ, ucIndex, 0 };
+                    iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                    if( ERROR == iStatus )
+                    {
+                        PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                                 AMI_PROXY_DRIVER_E_SENSOR_READ );
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_SENSOR_READ_FAILED )
+                    }
+                }
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_IDENTIFY_REQ:
+        {
+            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                      OSAL_TIMEOUT_WAIT_FOREVER ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+                iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+                if( ERROR != iStatus )
+                {
+                    pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                    pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
+                    pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                    pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+                }
+
+                if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                }
+
+                if( ERROR != iStatus )
+                {
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                    /* Raise event using the index as the method to track the event */
+                    EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
+                                            AMI_PROXY_DRIVER_E_GET_IDENTITY,
+                                            ucIndex,
+                                            0 };
+                    iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                    if( ERROR == iStatus )
+                    {
+                        PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                                 AMI_PROXY_DRIVER_E_GET_IDENTITY );
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_GET_IDENTIFY_FAILED )
+                    }
+                }
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_BOOT_SEL_REQ:
+        {
+            if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                      OSAL_TIMEOUT_WAIT_FOREVER ) )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+                iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+                if( ERROR != iStatus )
+                {
+                    pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                    pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
+                    pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                    pxThis->xRxData[ ucIndex ].xBootSelectRequest.ulPartitionSel =
+                                                    pxCmdRequest->xBootSelect.ulPartitionSel;
+                    pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+                }
+
+                if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+                }
+
+                if( ERROR != iStatus )
+                {
+                    INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+
+                    /* Raise event using the index as the method to track the event */
+                    EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
+                                            AMI_PROXY_DRIVER_E_BOOT_SELECT,
+                                            ucIndex,
+                                            0 };
+                    iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                    if( ERROR == iStatus )
+                    {
+                        PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                                 AMI_PROXY_DRIVER_E_BOOT_SELECT );
+                        INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_BOOT_SELECT_FAILED )
+                    }
+                }
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_HEARTBEAT_REQ:
+        {
+            iStatus = iHandleHeartbeatRequest( pxCmdRequest, ucQueue );
+            if( ERROR == iStatus )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_HEARTBEAT_REQUEST )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_EEPROM_RW_REQ:
+        {
+            iStatus = iHandleEepromRequest( pxCmdRequest, ucQueue );
+            if( ERROR == iStatus )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_EEPROM_RW_REQUEST )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_MODULE_RW_REQ:
+        {
+            iStatus = iHandleModuleRequest( pxCmdRequest, ucQueue );
+            if( ERROR == iStatus )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_MODULE_RW_REQUEST )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_DEBUG_VERBOSITY_REQ:
+        {
+            iStatus = iHandleDebugVerbosityRequest( pxCmdRequest, ucQueue );
+            if( ERROR == iStatus )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_DEBUG_VERBOSITY_REQUEST )
+            }
+            break;
+        }
+        case AMI_CMD_OPCODE_ECHO_REQ:
+        {
+            iStatus = iHandleEchoRequest( pxCmdRequest, ucQueue );
+            if( ERROR == iStatus )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_GET_ECHO_REQUEST )
+            }
+            break;
+        }
+        default:
+            PLL_ERR( AMI_NAME, "Error unsupported opcode received 0x%x\r\n", pxCmdRequest->xHdr.ulOpCode );
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_UNSUPPORTED_OPCODE_RX )
+            break;
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Find the next free rxdata instance, should be called within mutex to protect data
  */
@@ -2010,7 +2482,7 @@ static int iFindNextFreeRxDataIndex( uint8_t *pucIndex )
 /**
  * @brief   Handle the heartbeat request
  */
-static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest )
+static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue )
 {
     int iStatus = ERROR;
 
@@ -2030,6 +2502,7 @@ static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest )
             if( ERROR != iStatus )
             {
                 pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
                 pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
                 pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
             }
@@ -2075,6 +2548,8 @@ static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest )
             xMsg.eMsgType = AMI_MSG_TYPE_HEARTBEAT_COMPLETE;
             xMsg.xResult = AMI_PROXY_RESULT_SUCCESS;
             xHeartbeatResponse.ucHeartbeatCount = pxCmdRequest->xHeartbeatPayload.ucHeartbeatCount;
+            xHeartbeatResponse.ulProgress       = ( pxThis->ulProgress & AMI_HEARTBEAT_PROGRESS_MASK ) |
+                                                  AMI_HEARTBEAT_PROGRESS_VALID;
             pvOSAL_MemCpy( &xMsg.xHeartbeat, &xHeartbeatResponse, sizeof( xMsg.xHeartbeat ) );
             if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
                                                      ( void* )&xMsg,
@@ -2096,7 +2571,7 @@ static int iHandleHeartbeatRequest( AMI_CMD_REQUEST *pxCmdRequest )
 /**
  * @brief   Handle the eeprom request
  */
-static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest )
+static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue )
 {
     int iStatus = ERROR;
 
@@ -2116,6 +2591,7 @@ static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest )
             if( ERROR != iStatus )
             {
                 pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
                 pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
                 pxThis->xRxData[ ucIndex ].xEepromReadWriteRequest.xRequest =
                     pxCmdRequest->xEepromPayload.ucReqType;
@@ -2145,7 +2621,7 @@ static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest )
                                           AMI_PROXY_DRIVER_E_EEPROM_READ_WRITE,
                                           ucIndex,
                                           0 };
-                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                iStatus = iEVL_RaiseEvent( pxThis->pxBulkEvlRecord, &xNewSignal );
                 if( ERROR == iStatus )
                 {
                     PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
@@ -2166,7 +2642,7 @@ static int iHandleEepromRequest( AMI_CMD_REQUEST *pxCmdRequest )
 /**
  * @brief   Handle the module request
  */
-static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest )
+static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue )
 {
     int iStatus = ERROR;
 
@@ -2186,6 +2662,7 @@ static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest )
             if( ERROR != iStatus )
             {
                 pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
                 pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
                 pxThis->xRxData[ ucIndex ].xModuleReadWriteRequest.xRequest =
                     pxCmdRequest->xModulePayload.ulReqType;
@@ -2219,7 +2696,7 @@ static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest )
                                           AMI_PROXY_DRIVER_E_MODULE_READ_WRITE,
                                           ucIndex,
                                           0 };
-                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                iStatus = iEVL_RaiseEvent( pxThis->pxBulkEvlRecord, &xNewSignal );
                 if( ERROR == iStatus )
                 {
                     PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
@@ -2240,7 +2717,7 @@ static int iHandleModuleRequest( AMI_CMD_REQUEST *pxCmdRequest )
 /**
  * @brief   Handle the debug verbosity request
  */
-static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest )
+static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue )
 {
     int iStatus = ERROR;
 
@@ -2260,6 +2737,7 @@ static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest )
             if( ERROR != iStatus )
             {
                 pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
                 pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
                 pxThis->xRxData[ ucIndex ].ucDebugVerbosityRequest = pxCmdRequest->ucDebugVerbosityPayload;
                 pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
@@ -2298,3 +2776,68 @@ static int iHandleDebugVerbosityRequest( AMI_CMD_REQUEST *pxCmdRequest )
 
     return iStatus;
 }
+
+/**
+ * @brief   Handle the echo request
+ */
+static int iHandleEchoRequest( AMI_CMD_REQUEST *pxCmdRequest, uint8_t ucQueue )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pxCmdRequest ) &&
+        ( TRUE == pxThis->iInitialised ) )
+    {
+        uint8_t ucIndex = 0;
+
+        if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl,
+                                                  OSAL_TIMEOUT_WAIT_FOREVER ) )
+        {
+            INC_STAT_COUNTER( AMI_PROXY_STATS_TAKE_MUTEX )
+
+            iStatus = iFindNextFreeRxDataIndex( &ucIndex );
+            if( ERROR != iStatus )
+            {
+                pxThis->xRxData[ ucIndex ].usCid = pxCmdRequest->xHdr.usCid;
+                pxThis->xRxData[ ucIndex ].ucQueue = ucQueue;
+                pxThis->xRxData[ ucIndex ].xOpCode = pxCmdRequest->xHdr.ulOpCode;
+                pxThis->xRxData[ ucIndex ].xEchoRequest.ullAddress = pxCmdRequest->xEchoPayload.ullAddress;
+                pxThis->xRxData[ ucIndex ].xEchoRequest.ulLength = pxCmdRequest->xEchoPayload.ulSize;
+                pxThis->xRxData[ ucIndex ].xEchoRequest.ulCookie = pxCmdRequest->xEchoPayload.ulCookie;
+                pxThis->xRxData[ ucIndex ].ucInUse = TRUE;
+            }
+            else
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RX_DATA_INDEX_FAILED )
+            }
+
+            if( OSAL_ERRORS_NONE != iOSAL_Mutex_Release( pxThis->pvOsalMutexHdl ) )
+            {
+                INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_RELEASE_FAILED )
+            }
+
+            if( ERROR != iStatus )
+            {
+                INC_STAT_COUNTER( AMI_PROXY_STATS_RELEASE_MUTEX )
+                EVL_SIGNAL xNewSignal = { pxThis->ucMyId,
+                                          AMI_PROXY_DRIVER_E_ECHO,
+                                          ucIndex,
+                                          0 };
+                iStatus = iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal );
+                if( ERROR == iStatus )
+                {
+                    PLL_ERR( AMI_NAME, "Error attempting to raise event 0x%x\r\n",
+                             AMI_PROXY_DRIVER_E_ECHO );
+                    INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_RAISE_EVENT_ECHO_FAILED )
+                }
+            }
+        }
+        else
+        {
+            INC_ERROR_COUNTER_WITH_STATE( AMI_PROXY_ERRORS_MUTEX_TAKE_FAILED )
+        }
+    }
+
+    return iStatus;
+}
@@ -47,6 +47,7 @@ typedef enum AMI_PROXY_DRIVER_EVENTS
     AMI_PROXY_DRIVER_E_EEPROM_READ_WRITE,
     AMI_PROXY_DRIVER_E_MODULE_READ_WRITE,
     AMI_PROXY_DRIVER_E_DEBUG_VERBOSITY,
+    AMI_PROXY_DRIVER_E_ECHO,
 
     MAX_AMI_PROXY_DRIVER_EVENTS
 
@@ -152,6 +153,7 @@ typedef struct AMI_PROXY_PDI_DOWNLOAD_REQUEST
     uint32_t ulPartitionSel;
     uint16_t usPacketNum; 
     uint16_t usPacketSize;
+    uint8_t  ucCodec;       /* transfer codec of the packet, 0 if uncompressed */
 
 } AMI_PROXY_PDI_DOWNLOAD_REQUEST;
 
@@ -208,6 +210,18 @@ typedef struct AMI_PROXY_MODULE_RW_REQUEST
 
 } AMI_PROXY_MODULE_RW_REQUEST;
 
+/**
+ * @struct  AMI_PROXY_ECHO_REQUEST
+ * @brief   Echo a payload from shared memory back to the host
+ */
+typedef struct AMI_PROXY_ECHO_REQUEST
+{
+    uint64_t ullAddress;
+    uint32_t ulLength;
+    uint32_t ulCookie;
+
+} AMI_PROXY_ECHO_REQUEST;
+
 /**
  * @struct  AMI_PROXY_IDENTITY_RESPONSE
  * @brief   Identity reponse
@@ -231,10 +245,22 @@ typedef struct AMI_PROXY_IDENTITY_RESPONSE
  */
 typedef struct AMI_PROXY_HEARTBEAT_RESPONSE
 {
-    uint8_t ucHeartbeatCount;   /* return the value sent in the request */
+    uint8_t  ucHeartbeatCount;  /* return the value sent in the request */
+    uint32_t ulProgress;        /* progress counter of any long running request */
 
 } AMI_PROXY_HEARTBEAT_RESPONSE;
 
+/**
+ * @struct  AMI_PROXY_ECHO_RESPONSE
+ * @brief   Echo response
+ */
+typedef struct AMI_PROXY_ECHO_RESPONSE
+{
+    uint32_t ulCookie;          /* return the value sent in the request */
+    uint32_t ulChecksum;        /* byte sum of the payload as received */
+
+} AMI_PROXY_ECHO_RESPONSE;
+
 
 /******************************************************************************/
 /* Function declarations                                                      */
@@ -248,8 +274,8 @@ typedef struct AMI_PROXY_HEARTBEAT_RESPONSE
  * @param   ucProxyId   Unique ID for this Proxy driver
  * @param   pxFwIf      Handle to the Firmware Interface to use
  * @param   ulFwIfPort  Port to use on the Firmware Interface
- * @param   ulTaskPrio  Priority of the Proxy driver task (if RR disabled)
- * @param   ulTaskStack Stack size of the Proxy driver task
+ * @param   ulTaskPrio  Priority of the Proxy driver main and bulk lane tasks (if RR disabled)
+ * @param   ulTaskStack Stack size of each Proxy driver task
  *
  * @return  OK          Proxy driver initialised correctly
  *          ERROR       Proxy driver not initialised, or was already initialised
@@ -259,6 +285,22 @@ typedef struct AMI_PROXY_HEARTBEAT_RESPONSE
 int iAMI_Initialise( uint8_t ucProxyId, FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort,
                      uint32_t ulTaskPrio, uint32_t ulTaskStack );
 
+/**
+ * @brief   Attach an additional queue pair to the AMI Proxy Driver
+ *
+ * @param   pxFwIf      Handle to the Firmware Interface of the queue pair
+ * @param   ulFwIfPort  Port to use on the Firmware Interface
+ * @param   ulWeight    Max requests read from this queue per pass of the proxy task
+ *
+ * @return  OK          Queue pair opened and serviced by the proxy driver
+ *          ERROR       Queue pair not attached
+ *
+ * @note    Queue pairs are serviced in the order they are attached, after the
+ *          pair passed into iAMI_Initialise. Responses are always sent back on
+ *          the queue pair the request arrived on.
+ */
+int iAMI_AttachQueue( FW_IF_CFG *pxFwIf, uint32_t ulFwIfPort, uint32_t ulWeight );
+
 /**
  * @brief   Bind into this proxy driver
  *
@@ -363,6 +405,34 @@ int iAMI_SetModuleReadWriteCompleteResponse( EVL_SIGNAL *pxSignal, AMI_PROXY_RES
  */
 int iAMI_SetDebugVerbosityResponse( EVL_SIGNAL *pxSignal, AMI_PROXY_RESULT xResult );
 
+/**
+ * @brief   Set the response after the echo request has completed
+ *
+ * @param   pxSignal        Current event occurance (used for tracking)
+ * @param   xResult         The result of the echo request
+ * @param   pxEchoResponse  The cookie and checksum to return to the host
+ *
+ * @return  OK              Data passed to proxy driver successfully
+ *          ERROR           Data not passed successfully
+ */
+int iAMI_SetEchoCompleteResponse( EVL_SIGNAL *pxSignal,
+                                  AMI_PROXY_RESULT xResult,
+                                  AMI_PROXY_ECHO_RESPONSE *pxEchoResponse );
+
+/**
+ * @brief   Set the progress counter returned with each heartbeat
+ *
+ * @param   ulProgress      Counter which advances while a long running request
+ *                          (PDI download or copy) is making headway
+ *
+ * @return  OK              Data passed to proxy driver successfully
+ *          ERROR           Data not passed successfully
+ *
+ * @note    The host uses changes in this value to tell a slow but healthy
+ *          request from a stalled one.
+ */
+int iAMI_SetProgress( uint32_t ulProgress );
+
 /* Get Functions **************************************************************/
 
 /**
@@ -451,6 +521,18 @@ int iAMI_GetModuleReadWriteRequest( EVL_SIGNAL *pxSignal,
 int iAMI_GetDebugVerbosityRequest( EVL_SIGNAL *pxSignal,
                                    uint8_t *pucDebugVerbosityRequest );
 
+/**
+ * @brief   Get the echo request
+ *
+ * @param   pxSignal                    Current event occurance (used for tracking)
+ * @param   pxEchoRequest               Pointer to echo request structure
+ *
+ * @return  OK                          Data retrieved from proxy driver successfully
+ *          ERROR                       Data not retrieved successfully
+ *
+ */
+int iAMI_GetEchoRequest( EVL_SIGNAL *pxSignal, AMI_PROXY_ECHO_REQUEST *pxEchoRequest );
+
 /**
  * @brief   Print all the stats gathered by the application
  *
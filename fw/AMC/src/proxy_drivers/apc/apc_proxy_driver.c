@@ -49,6 +49,9 @@
 
 #define APC_COPY_CHUNK_LEN          ( 0x1000 )             /* 4KB */
 
+#define APC_RLE_RUN_FLAG            ( 0x80 )
+#define APC_RLE_MIN_RUN             ( 4 )
+
 #ifndef APC_FPT_HDR_MAGIC_NUM
 #define APC_FPT_HDR_MAGIC_NUM       ( 0x92F7A516 )
 #endif
@@ -82,6 +85,11 @@
     DO( APC_PROXY_STATS_FPT_UPDATE )                 \
     DO( APC_PROXY_STATS_STATUS_RETRIEVAL )           \
     DO( APC_PROXY_STATS_NUM_BOOT_DEVICES )           \
+    DO( APC_PROXY_STATS_PARTITION_PREPARED )         \
+    DO( APC_PROXY_STATS_PACKET_EXPANDED )            \
+    DO( APC_PROXY_STATS_PACKED_BYTES )               \
+    DO( APC_PROXY_STATS_EXPANDED_BYTES )             \
+    DO( APC_PROXY_STATS_ERASED_BYTES_SKIPPED )       \
     DO( APC_PROXY_STATS_MAX )
 
 #define APC_PROXY_ERRORS( DO )                               \
@@ -121,6 +129,9 @@
     DO( APC_PROXY_ERRORS_FPT_UPDATE_FAILED )                 \
     DO( APC_PROXY_ERRORS_FPT_UPDATE_EVENT_FAILED )           \
     DO( APC_PROXY_ERRORS_INVALID_BOOT_DEVICE )               \
+    DO( APC_PROXY_ERRORS_PREPARE_PARTITION_FAILED )          \
+    DO( APC_PROXY_ERRORS_EXPAND_BUFFER_CREATION_FAILED )     \
+    DO( APC_PROXY_ERRORS_PACKET_EXPAND_FAILED )              \
     DO( APC_PROXY_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )  PLL_INF( APC_NAME,     \
@@ -200,7 +211,11 @@ typedef struct APC_PRIVATE_DATA
 
     uint8_t pucChunkBuffer[ APC_COPY_CHUNK_LEN ];
 
+    uint8_t *pucExpandBuffer;
+    uint32_t ulExpandBufferSize;
+
     uint32_t ulNextBootAddr;
+    volatile uint32_t ulProgress;
 
     MODULE_STATE xState;
 
@@ -225,6 +240,7 @@ typedef struct APC_MBOX_DOWNLOAD_IMAGE
     uint32_t ulSrcAddr;
     uint16_t usPacketNum;
     uint16_t usPacketSize;
+    APC_IMAGE_CODECS xCodec;                                               /* encoding of the packet at ulSrcAddr */
 
 } APC_MBOX_DOWNLOAD_IMAGE;
 
@@ -353,6 +369,49 @@ static int iVerifyDownload( APC_MBOX_DOWNLOAD_IMAGE *pxImageData );
  */
 static int iRefreshFptData( APC_BOOT_DEVICES xBootDevice );
 
+/**
+ * @brief   Prepare the part of a partition that is about to be written
+ *
+ * @param   xBootDevice Target boot device
+ * @param   ulDestAddr  Address the data will be written to
+ * @param   ulLength    Number of bytes that will be written
+ *
+ * @return  OK or ERROR
+ *
+ * @note    Lets a managed device (eMMC) drop the old contents of the range so
+ *          the write does not pay for them; devices that need nothing are a no-op.
+ */
+static int iPreparePartition( APC_BOOT_DEVICES xBootDevice, uint32_t ulDestAddr, uint32_t ulLength );
+
+/**
+ * @brief   Expand an encoded image packet in place of its source
+ *
+ * @param   pxImageData Pointer to data regarding the image packet
+ *
+ * @return  OK if the packet is ready to be written
+ *          ERROR if the packet could not be expanded
+ *
+ * @note    On success an encoded packet's source address and size are
+ *          replaced with those of the expanded copy, so the write and verify
+ *          steps see raw image data. Uncompressed packets are left untouched.
+ */
+static int iExpandPacket( APC_MBOX_DOWNLOAD_IMAGE *pxImageData );
+
+/**
+ * @brief   Expand a run-length encoded stream
+ *
+ * @param   pucSrc      Encoded data
+ * @param   ulSrcLen    Length of the encoded data
+ * @param   pucDst      Buffer to expand into
+ * @param   ulDstLen    Size of pucDst
+ * @param   pulOutLen   Number of bytes expanded
+ *
+ * @return  OK if the whole stream was expanded
+ *          ERROR if the stream is malformed or does not fit in pucDst
+ */
+static int iRleExpand( const uint8_t *pucSrc, uint32_t ulSrcLen, uint8_t *pucDst, uint32_t ulDstLen,
+                       uint32_t *pulOutLen );
+
 
 /******************************************************************************/
 /* Local variables                                                            */
@@ -383,7 +442,10 @@ static APC_PRIVATE_DATA xLocalData =
     {
         0
     },                          /* pucChunkBuffer */
+    NULL,                       /* pucExpandBuffer */
+    0,                          /* ulExpandBufferSize */
     0,                          /* ulNextBootAddr */
+    0,                          /* ulProgress */
     MODULE_STATE_UNINITIALISED, /* xState */
     {
         0
@@ -598,7 +660,8 @@ int iAPC_DownloadImage( EVL_SIGNAL *pxSignal,
                         uint32_t ulSrcAddr,
                         uint32_t ulImageSize,
                         uint16_t usPacketNum,
-                        uint16_t usPacketSize )
+                        uint16_t usPacketSize,
+                        APC_IMAGE_CODECS xCodec )
 {
     int iStatus = ERROR;
 
@@ -608,6 +671,7 @@ int iAPC_DownloadImage( EVL_SIGNAL *pxSignal,
         ( MAX_APC_BOOT_DEVICES > xBootDevice ) &&
         ( TRUE == pxThis->piValidFpt[ xBootDevice ] ) &&
         ( NULL != pxSignal ) &&
+        ( MAX_APC_IMAGE_CODECS > xCodec ) &&
         ( 0 != ulImageSize ) )
     {
         if( iPartition < pxThis->pxFptHeader[ xBootDevice ].ucNumEntries )
@@ -625,6 +689,7 @@ int iAPC_DownloadImage( EVL_SIGNAL *pxSignal,
             xMsg.xDownloadImageData.ulSrcAddr    = ulSrcAddr;
             xMsg.xDownloadImageData.usPacketNum  = usPacketNum;
             xMsg.xDownloadImageData.usPacketSize = usPacketSize;
+            xMsg.xDownloadImageData.xCodec       = xCodec;
 
             if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
                                                      ( void* )&xMsg,
@@ -660,7 +725,8 @@ int iAPC_UpdateFpt( EVL_SIGNAL *pxSignal,
                     uint32_t ulImageSize,
                     uint16_t usPacketNum,
                     uint16_t usPacketSize,
-                    int iLastPacket )
+                    int iLastPacket,
+                    APC_IMAGE_CODECS xCodec )
 {
     int iStatus = ERROR;
 
@@ -670,6 +736,7 @@ int iAPC_UpdateFpt( EVL_SIGNAL *pxSignal,
         ( NULL != pxSignal ) &&
         ( MAX_APC_BOOT_DEVICES > xBootDevice ) &&
         ( NULL != pxThis->ppxFwIf[ xBootDevice ] ) &&
+        ( MAX_APC_IMAGE_CODECS > xCodec ) &&
         ( 0 != ulImageSize ) )
     {
         /* Partition is unused */
@@ -686,6 +753,7 @@ int iAPC_UpdateFpt( EVL_SIGNAL *pxSignal,
         xMsg.xDownloadImageData.usPacketNum  = usPacketNum;
         xMsg.xDownloadImageData.usPacketSize = usPacketSize;
         xMsg.xDownloadImageData.iLastPacket  = iLastPacket;
+        xMsg.xDownloadImageData.xCodec       = xCodec;
 
         if( OSAL_ERRORS_NONE == iOSAL_MBox_Post( pxThis->pvOsalMBoxHdl,
                                                  ( void* )&xMsg,
@@ -970,6 +1038,29 @@ int iAPC_GetFptPartition( APC_BOOT_DEVICES xBootDevice, int iPartition, APC_PROX
     return iStatus;
 }
 
+/**
+ * @brief   Gets the flash progress counter
+ */
+int iAPC_GetProgress( uint32_t *pulProgress )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( NULL != pulProgress ) )
+    {
+        /* Single aligned word updated only by the APC task; no lock needed */
+        *pulProgress = pxThis->ulProgress;
+        iStatus      = OK;
+    }
+    else
+    {
+        INC_ERROR_COUNTER( APC_PROXY_ERRORS_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
 /**
  * @brief   Gets the current state of the proxy
  */
@@ -1410,7 +1501,9 @@ static int iDownloadImage( APC_MBOX_DOWNLOAD_IMAGE *pxImageData )
 {
     int iStatus = ERROR;
 
-    if( ( NULL != pxImageData ) && ( MAX_APC_BOOT_DEVICES > pxImageData->xBootDevice ) )
+    if( ( NULL != pxImageData ) &&
+        ( MAX_APC_BOOT_DEVICES > pxImageData->xBootDevice ) &&
+        ( OK == iExpandPacket( pxImageData ) ) )
     {
         int iPartition  = pxImageData->iPartition;
         uint32_t ulImageSize = pxImageData->ulImageSize;
@@ -1473,6 +1566,9 @@ static int iDownloadImage( APC_MBOX_DOWNLOAD_IMAGE *pxImageData )
                   ( pxThis->ppxFptPartitions[ pxImageData->xBootDevice ][ iPartition ].ulPartitionBaseAddr +
                     pxThis->ppxFptPartitions[ pxImageData->xBootDevice ][ iPartition ].ulPartitionSize ) ) )
             {
+                /* Not fatal - the write below still replaces the data */
+                iPreparePartition( pxImageData->xBootDevice, ulDestAddr, ulImageSize );
+
                 if( FW_IF_ERRORS_NONE ==
                     pxThis->ppxFwIf[ pxImageData->xBootDevice ]->write( pxThis->ppxFwIf[ pxImageData->xBootDevice ],
                                                                         ( uint64_t )ulDestAddr,
@@ -1480,6 +1576,20 @@ static int iDownloadImage( APC_MBOX_DOWNLOAD_IMAGE *pxImageData )
                                                                         ulImageSize,
                                                                         0 ) )
                 {
+                    uint32_t ulSkipped = 0;
+
+                    pxThis->ulProgress += ulImageSize;
+
+                    /* Devices that cannot skip erased-pattern data do not support the query */
+                    if( FW_IF_ERRORS_NONE ==
+                        pxThis->ppxFwIf[ pxImageData->xBootDevice ]->ioctrl( pxThis->ppxFwIf[ pxImageData->xBootDevice ],
+                                                                             FW_IF_COMMON_IOCTRL_GET_WRITE_SKIPPED,
+                                                                             &ulSkipped ) )
+                    {
+                        pxThis->pulStats[ APC_PROXY_STATS_ERASED_BYTES_SKIPPED ] += ulSkipped;
+                        PLL_DBG( APC_NAME, "%d of %d bytes already erased\r\n", ulSkipped, ulImageSize );
+                    }
+
                     PLL_DBG( APC_NAME, "===== Verifying write =====\r\n" );
                     if( OK == iVerifyDownload( pxImageData ) )
                     {
@@ -1873,3 +1983,187 @@ static int iVerifyDownload( APC_MBOX_DOWNLOAD_IMAGE *pxImageData )
 
     return iStatus;
 }
+
+/**
+ * @brief   Prepare the part of a partition that is about to be written
+ */
+static int iPreparePartition( APC_BOOT_DEVICES xBootDevice, uint32_t ulDestAddr, uint32_t ulLength )
+{
+    int iStatus = ERROR;
+
+    if( ( MAX_APC_BOOT_DEVICES > xBootDevice ) && ( NULL != pxThis->ppxFwIf[ xBootDevice ] ) )
+    {
+        FW_IF_DISCARD_RANGE xRange =
+        {
+            ( uint64_t )ulDestAddr,
+            ulLength
+        };
+        uint32_t ulFwIfStatus = pxThis->ppxFwIf[ xBootDevice ]->ioctrl( pxThis->ppxFwIf[ xBootDevice ],
+                                                                        FW_IF_COMMON_IOCTRL_DISCARD,
+                                                                        &xRange );
+
+        if( FW_IF_ERRORS_NONE == ulFwIfStatus )
+        {
+            INC_STAT_COUNTER( APC_PROXY_STATS_PARTITION_PREPARED )
+            iStatus = OK;
+        }
+        else
+        {
+            INC_ERROR_COUNTER( APC_PROXY_ERRORS_PREPARE_PARTITION_FAILED )
+            PLL_WRN( APC_NAME, "Unable to prepare 0x%08x (%d bytes): %d\r\n", ulDestAddr, ulLength, ulFwIfStatus );
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Expand an encoded image packet
+ */
+static int iExpandPacket( APC_MBOX_DOWNLOAD_IMAGE *pxImageData )
+{
+    int iStatus = ERROR;
+
+    if( NULL != pxImageData )
+    {
+        uint32_t ulPacketBytes = pxImageData->usPacketSize * APC_BASE_PACKET_SIZE;
+        uint32_t ulExpanded    = 0;
+
+        if( APC_IMAGE_CODEC_NONE == pxImageData->xCodec )
+        {
+            iStatus = OK;
+        }
+        else if( ( APC_IMAGE_CODEC_RLE != pxImageData->xCodec ) ||
+                 ( 0 == ulPacketBytes ) ||
+                 ( UTIL_MAX_UINT16 < ulPacketBytes ) )
+        {
+            INC_ERROR_COUNTER( APC_PROXY_ERRORS_PACKET_EXPAND_FAILED )
+            PLL_ERR( APC_NAME, "ERROR: cannot expand codec %d packet of %d KB\r\n",
+                     pxImageData->xCodec, pxImageData->usPacketSize );
+        }
+        else
+        {
+            /* Sized for the largest packet seen so far and kept for the rest of the download */
+            if( ulPacketBytes > pxThis->ulExpandBufferSize )
+            {
+                if( NULL != pxThis->pucExpandBuffer )
+                {
+                    vOSAL_MemFree( ( void** )&pxThis->pucExpandBuffer );
+                }
+                pxThis->ulExpandBufferSize = 0;
+                pxThis->pucExpandBuffer    = ( uint8_t* )pvOSAL_MemAlloc( ( uint16_t )ulPacketBytes );
+
+                if( NULL != pxThis->pucExpandBuffer )
+                {
+                    pxThis->ulExpandBufferSize = ulPacketBytes;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER( APC_PROXY_ERRORS_EXPAND_BUFFER_CREATION_FAILED )
+                }
+            }
+
+            if( NULL != pxThis->pucExpandBuffer )
+            {
+                HAL_FLUSH_CACHE_DATA( ( uintptr_t )( pxImageData->ulSrcAddr ), pxImageData->ulImageSize );
+
+                if( OK == iRleExpand( ( const uint8_t* )( uintptr_t )( pxImageData->ulSrcAddr ),
+                                      pxImageData->ulImageSize,
+                                      pxThis->pucExpandBuffer,
+                                      ulPacketBytes,
+                                      &ulExpanded ) )
+                {
+                    INC_STAT_COUNTER( APC_PROXY_STATS_PACKET_EXPANDED )
+                    pxThis->pulStats[ APC_PROXY_STATS_PACKED_BYTES ]   += pxImageData->ulImageSize;
+                    pxThis->pulStats[ APC_PROXY_STATS_EXPANDED_BYTES ] += ulExpanded;
+
+                    PLL_DBG( APC_NAME, "Packet %d expanded %d -> %d bytes\r\n",
+                             pxImageData->usPacketNum, pxImageData->ulImageSize, ulExpanded );
+
+                    pxImageData->ulSrcAddr   = ( uint32_t )( uintptr_t )pxThis->pucExpandBuffer;
+                    pxImageData->ulImageSize = ulExpanded;
+                    pxImageData->xCodec      = APC_IMAGE_CODEC_NONE;
+                    iStatus = OK;
+                }
+                else
+                {
+                    INC_ERROR_COUNTER_WITH_STATE( APC_PROXY_ERRORS_PACKET_EXPAND_FAILED )
+                    PLL_ERR( APC_NAME, "ERROR: packet %d is not a valid RLE stream\r\n", pxImageData->usPacketNum );
+                }
+            }
+        }
+    }
+
+    return iStatus;
+}
+
+/**
+ * @brief   Expand a run-length encoded stream
+ */
+static int iRleExpand( const uint8_t *pucSrc, uint32_t ulSrcLen, uint8_t *pucDst, uint32_t ulDstLen,
+                       uint32_t *pulOutLen )
+{
+    int iStatus = ERROR;
+
+    if( ( NULL != pucSrc ) && ( NULL != pucDst ) && ( NULL != pulOutLen ) )
+    {
+        uint32_t ulIn  = 0;
+        uint32_t ulOut = 0;
+
+        iStatus = OK;
+
+        while( ( OK == iStatus ) && ( ulIn < ulSrcLen ) )
+        {
+            uint8_t ucToken = pucSrc[ ulIn++ ];
+            uint32_t ulLen  = 0;
+
+            if( APC_RLE_RUN_FLAG > ucToken )
+            {
+                /* Literal stretch of ucToken + 1 bytes */
+                ulLen = ( uint32_t )ucToken + 1;
+
+                if( ( ulLen > ( ulSrcLen - ulIn ) ) || ( ulLen > ( ulDstLen - ulOut ) ) )
+                {
+                    iStatus = ERROR;
+                }
+                else
+                {
+                    pvOSAL_MemCpy( &pucDst[ ulOut ], &pucSrc[ ulIn ], ( uint16_t )ulLen );
+                    ulIn  += ulLen;
+                    ulOut += ulLen;
+                }
+            }
+            else if( 2 > ( ulSrcLen - ulIn ) )
+            {
+                iStatus = ERROR;
+            }
+            else
+            {
+                /* 15 bit repeat count followed by the byte to repeat */
+                ulLen = ( ( ( ( uint32_t )ucToken & ~APC_RLE_RUN_FLAG ) << 8 ) | pucSrc[ ulIn ] ) + APC_RLE_MIN_RUN;
+
+                if( ulLen > ( ulDstLen - ulOut ) )
+                {
+                    iStatus = ERROR;
+                }
+                else
+                {
+                    pvOSAL_MemSet( &pucDst[ ulOut ], pucSrc[ ulIn + 1 ], ( uint16_t )ulLen );
+                    ulIn  += 2;
+                    ulOut += ulLen;
+                }
+            }
+        }
+
+        if( ( OK == iStatus ) && ( 0 != ulOut ) )
+        {
+            *pulOutLen = ulOut;
+        }
+        else
+        {
+            iStatus = ERROR;
+        }
+    }
+
+    return iStatus;
+}
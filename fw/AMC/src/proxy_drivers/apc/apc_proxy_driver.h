@@ -59,6 +59,19 @@ typedef enum
 
 } APC_BOOT_DEVICES;
 
+/**
+ * @enum    APC_IMAGE_CODECS
+ * @brief   Transfer codecs an image packet can arrive in
+ */
+typedef enum
+{
+    APC_IMAGE_CODEC_NONE = 0,
+    APC_IMAGE_CODEC_RLE,
+
+    MAX_APC_IMAGE_CODECS
+
+} APC_IMAGE_CODECS;
+
 
 /******************************************************************************/
 /* Structs                                                                    */
@@ -136,13 +149,17 @@ int iAPC_BindCallback( EVL_CALLBACK *pxCallback );
  * @param   ulImageSize  Size of image (in bytes)
  * @param   usPacketNum  Image packet number
  * @param   usPacketSize Size of image packet (in KB)
+ * @param   xCodec       Codec the packet is encoded with
  *
  * @return  OK           Image downloaded successfully
  *          ERROR        Image not downloaded successfully
  * 
+ * @note    With a codec, ulImageSize is the encoded size; the packet is
+ *          expanded before it is written and must not exceed usPacketSize.
  */
 int iAPC_DownloadImage( EVL_SIGNAL *pxSignal, APC_BOOT_DEVICES xBootDevice, int iPartition, uint32_t ulSrcAddr,
-                        uint32_t ulImageSize, uint16_t usPacketNum, uint16_t usPacketSize );
+                        uint32_t ulImageSize, uint16_t usPacketNum, uint16_t usPacketSize,
+                        APC_IMAGE_CODECS xCodec );
 
 /**
  * @brief   Download an image with an FPT to a location in NV memory
@@ -154,13 +171,14 @@ int iAPC_DownloadImage( EVL_SIGNAL *pxSignal, APC_BOOT_DEVICES xBootDevice, int
  * @param   usPacketNum  Image packet number
  * @param   usPacketSize Size of image packet (in KB)
  * @param   iLastPacket  Boolean indicating if this is the last data packet
+ * @param   xCodec       Codec the packet is encoded with
  *
  * @return  OK           Image downloaded successfully
  *          ERROR        Image not downloaded successfully
  * 
  */
 int iAPC_UpdateFpt( EVL_SIGNAL *pxSignal, APC_BOOT_DEVICES xBootDevice, uint32_t ulSrcAddr, uint32_t ulImageSize,
-                    uint16_t usPacketNum, uint16_t usPacketSize, int iLastPacket );
+                    uint16_t usPacketNum, uint16_t usPacketSize, int iLastPacket, APC_IMAGE_CODECS xCodec );
 
 /**
  * @brief   Copy an image from one partition to another
@@ -244,6 +262,21 @@ int iAPC_PrintStatistics( void );
  */
 int iAPC_ClearStatistics( void );
 
+/**
+ * @brief   Gets the flash progress counter
+ *
+ * @param   pulProgress     Pointer to the number of bytes written
+ *                          to flash since initialisation (wraps)
+ *
+ * @return  OK              If successful
+ *          ERROR           If not successful
+ *
+ * @note    The counter only ever moves forward while a download or copy is
+ *          making headway, so callers can detect a stalled operation by
+ *          sampling it and comparing.
+ */
+int iAPC_GetProgress( uint32_t *pulProgress );
+
 /**
  * @brief   Gets the current state of the proxy driver
  *
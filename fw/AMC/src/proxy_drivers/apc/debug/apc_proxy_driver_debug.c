@@ -249,7 +249,7 @@ static void vSetDownloadImage( void )
         xSignal.ucInstance = iInstance;
 
         if( OK != iAPC_DownloadImage( &xSignal, ( APC_BOOT_DEVICES )xBootDevice, iPartition, ulSrcAddr, ( uint32_t )iImageSize, 
-                                      ( uint16_t )iPacketNum, ( uint16_t )iPacketSize ) )
+                                      ( uint16_t )iPacketNum, ( uint16_t )iPacketSize, APC_IMAGE_CODEC_NONE ) )
         {
             PLL_DAL( APC_DBG_NAME, "Error writing %d bytes to partition %d\r\n", iImageSize, iPartition );
         }
@@ -28,6 +28,14 @@
 
 #define ASC_TASK_SLEEP_MS ( 100 )
 
+/* A reading is quarantined after this many consecutive failures and then only
+ * retried on an exponential backoff, so one dead device cannot stretch the scan */
+#define ASC_QUARANTINE_FAILURE_THRESHOLD ( 3 )
+#define ASC_QUARANTINE_BACKOFF_MIN_MS    ( 1000 )
+#define ASC_QUARANTINE_BACKOFF_MAX_SHIFT ( 6 )
+
+#define ASC_SENSOR_HEALTH_ENTRY( s, t ) ( &pxThis->pxSensorHealth[ ( ( s ) * MAX_ASC_PROXY_DRIVER_SENSOR_TYPE ) + ( t ) ] )
+
 #define ASC_NAME "ASC"
 
 /* Stat & Error definitions */
@@ -48,6 +56,9 @@
         DO( ASC_PROXY_GET_OPERATIONAL_STATE )                  \
         DO( ASC_PROXY_STATS_SET_OPERATIONAL_STATE_BY_ID )      \
         DO( ASC_PROXY_STATS_GET_OPERATIONAL_STATE_BY_ID )      \
+        DO( ASC_PROXY_STATS_SENSOR_QUARANTINED )               \
+        DO( ASC_PROXY_STATS_SENSOR_RECOVERED )                 \
+        DO( ASC_PROXY_STATS_SENSOR_READ_SKIPPED )              \
         DO( ASC_PROXY_STATS_MAX )
 
 #define ASC_PROXY_ERRORS( DO )                                  \
@@ -71,6 +82,7 @@
         DO( ASC_PROXY_ERRORS_SET_SENSOR_THRESHOLD_BY_ID )       \
         DO( ASC_PROXY_ERRORS_GET_OPERATIONAL_STATE_BY_ID )      \
         DO( ASC_PROXY_ERRORS_SET_OPERATIONAL_STATE_BY_ID )      \
+        DO( ASC_PROXY_ERRORS_SENSOR_READ_FAILED )               \
         DO( ASC_PROXY_ERRORS_MAX )
 
 #define PRINT_STAT_COUNTER( x )  PLL_INF( ASC_NAME,                 \
@@ -108,6 +120,19 @@ UTIL_MAKE_ENUM_AND_STRINGS( ASC_PROXY_ERRORS, ASC_PROXY_ERRORS, ASC_PROXY_ERRORS
 /******************************************************************************/
 /* Structures                                                                 */
 /******************************************************************************/
+/**
+ * @brief   Failure tracking for a single sensor reading
+ */
+typedef struct ASC_SENSOR_HEALTH
+{
+    uint8_t  ucConsecutiveFailures;
+    uint8_t  ucBackoffShift;
+    int      iQuarantined;
+    int      iReportPending;
+    uint32_t ulRetryMs;
+
+} ASC_SENSOR_HEALTH;
+
 /**
  * @brief   Structure to hold ths proxy driver's private data
  */
@@ -124,6 +149,7 @@ typedef struct ASC_PRIVATE_DATA
     void                         *pvOsalTaskHdl;
 
     ASC_PROXY_DRIVER_SENSOR_DATA *pxSensorData;
+    ASC_SENSOR_HEALTH            *pxSensorHealth;
     uint8_t                      ucNumSensors;
 
     uint32_t                     pulStatCounters[ ASC_PROXY_STATS_MAX ];
@@ -149,6 +175,7 @@ static ASC_PRIVATE_DATA xLocalData =
     NULL,                                                                      /* pvOsalMutexHdl */
     NULL,                                                                      /* pvOsalTaskHdl */
     NULL,                                                                      /* pxSensorData */
+    NULL,                                                                      /* pxSensorHealth */
     0,                                                                         /* ucNumSensors */
     {
         0
@@ -176,6 +203,55 @@ static ASC_PRIVATE_DATA *pxThis = &xLocalData;
  */
 static void vProxyDriverTask( void *pvArgs );
 
+/**
+ * @brief   Clear the failure tracking of every reading of a sensor
+ *
+ * @param   iSensor     Index into the sensor table
+ *
+ * @return  N/A
+ *
+ */
+static void vClearSensorHealth( int iSensor );
+
+/**
+ * @brief   Check if a reading should be attempted on this scan
+ *
+ * @param   pxHealth    Failure tracking for the reading
+ * @param   ulNowMs     Current uptime in ms
+ *
+ * @return  TRUE if the reading is not quarantined or its backoff has expired
+ *          FALSE otherwise
+ *
+ */
+static int iSensorReadDue( ASC_SENSOR_HEALTH *pxHealth, uint32_t ulNowMs );
+
+/**
+ * @brief   Record a successful reading, releasing it from quarantine
+ *
+ * @param   iSensor     Index into the sensor table
+ * @param   pxHealth    Failure tracking for the reading
+ *
+ * @return  N/A
+ *
+ */
+static void vSensorReadPassed( int iSensor, ASC_SENSOR_HEALTH *pxHealth );
+
+/**
+ * @brief   Record a failed reading, quarantining it or extending its backoff
+ *
+ * @param   iSensor     Index into the sensor table
+ * @param   pxHealth    Failure tracking for the reading
+ * @param   pxReading   Reading to update the status of
+ * @param   ulNowMs     Current uptime in ms
+ *
+ * @return  N/A
+ *
+ */
+static void vSensorReadFailed( int iSensor,
+                               ASC_SENSOR_HEALTH *pxHealth,
+                               ASC_PROXY_DRIVER_SENSOR_READINGS *pxReading,
+                               uint32_t ulNowMs );
+
 
 /******************************************************************************/
 /* Public Function implementations                                            */
@@ -224,9 +300,15 @@ int iASC_Initialise( uint8_t ucProxyId,
                 pxThis->pxSensorData =
                     ( ASC_PROXY_DRIVER_SENSOR_DATA * )pvOSAL_MemAlloc( sizeof ( ASC_PROXY_DRIVER_SENSOR_DATA ) *
                                                                        ucNumSensors );
+                pxThis->pxSensorHealth =
+                    ( ASC_SENSOR_HEALTH * )pvOSAL_MemAlloc( sizeof ( ASC_SENSOR_HEALTH ) *
+                                                            ucNumSensors * MAX_ASC_PROXY_DRIVER_SENSOR_TYPE );
 
-                if( NULL != pxThis->pxSensorData )
+                if( ( NULL != pxThis->pxSensorData ) && ( NULL != pxThis->pxSensorHealth ) )
                 {
+                    pvOSAL_MemSet( pxThis->pxSensorHealth,
+                                   0,
+                                   sizeof( ASC_SENSOR_HEALTH ) * ucNumSensors * MAX_ASC_PROXY_DRIVER_SENSOR_TYPE );
                     pvOSAL_MemCpy( pxThis->pxSensorData,
                                    pxSensorData,
                                    sizeof( ASC_PROXY_DRIVER_SENSOR_DATA ) * ucNumSensors );
@@ -291,6 +373,33 @@ int iASC_BindCallback( EVL_CALLBACK *pxCallback )
     return iStatus;
 }
 
+/**
+ * @brief   Bind into this proxy driver for a subset of its events
+ */
+int iASC_BindFilteredCallback( EVL_CALLBACK *pxCallback, uint32_t ulEventMask )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxCallback ) &&
+        ( NULL != pxThis->pxEvlRecord ) )
+    {
+        iStatus = iEVL_BindFilteredCallback( pxThis->pxEvlRecord, pxCallback, pxThis->ucMyId, ulEventMask );
+        if( ERROR == iStatus )
+        {
+            INC_ERROR_COUNTER_WITH_STATE( ASC_PROXY_ERRORS_BIND_CB_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( ASC_PROXY_ERRORS_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
 /* Set functions **************************************************************/
 
 /**
@@ -323,6 +432,8 @@ int iASC_ResetAllSensorData( void )
                     pxThis->pxSensorData[ i ].pxReadings[ j ].xSensorOperationalStatus =
                         ASC_PROXY_DRIVER_SENSOR_OPERATIONAL_STATUS_ENABLED;
                 }
+
+                vClearSensorHealth( i );
             }
 
             INC_STAT_COUNTER( ASC_PROXY_STATS_RESET_ALL_SENSOR_DATA );
@@ -385,6 +496,7 @@ int iASC_ResetSingleSensorDataById( uint8_t ucId )
                             ASC_PROXY_DRIVER_SENSOR_OPERATIONAL_STATUS_ENABLED;
                     }
 
+                    vClearSensorHealth( i );
                     INC_STAT_COUNTER( ASC_PROXY_STATS_RESET_SINGLE_SENSOR_DATA_BY_ID );
                     iStatus = OK;
                     break;
@@ -453,6 +565,7 @@ int iASC_ResetSingleSensorDataByName( const char *pcName )
                             ASC_PROXY_DRIVER_SENSOR_OPERATIONAL_STATUS_ENABLED;
                     }
 
+                    vClearSensorHealth( i );
                     INC_STAT_COUNTER( ASC_PROXY_STATS_RESET_SINGLE_SENSOR_DATA_BY_NAME );
                     iStatus = OK;
                     break;
@@ -869,6 +982,11 @@ int iASC_PrintStatistics( void )
         {
             PRINT_ERROR_COUNTER( i );
         }
+        if( NULL != pxThis->pxEvlRecord )
+        {
+            PLL_INF( ASC_NAME, "------------------------------------------------------------\n\r" );
+            iEVL_GetStats( pxThis->pxEvlRecord );
+        }
         PLL_INF( ASC_NAME, "============================================================\n\r" );
         iStatus = OK;
     }
@@ -974,10 +1092,12 @@ static void vProxyDriverTask( void *pvArgs )
                    pxThis->ucNumSensors * sizeof( uint32_t ) * MAX_ASC_PROXY_DRIVER_SENSOR_TYPE );
 
     uint32_t ulStartMs = 0;
+    uint32_t ulNowMs   = 0;
 
     FOREVER
     {
         ulStartMs = ulOSAL_GetUptimeTicks();
+        ulNowMs   = ulOSAL_GetUptimeMs();
         if( OSAL_ERRORS_NONE == iOSAL_Mutex_Take( pxThis->pvOsalMutexHdl, OSAL_TIMEOUT_WAIT_FOREVER ) )
         {
             INC_STAT_COUNTER( ASC_PROXY_STATS_TAKE_MUTEX )
@@ -993,9 +1113,15 @@ static void vProxyDriverTask( void *pvArgs )
                     {
                         if( NULL != pxThis->pxSensorData[ i ].ppxReadSensorFunc[ j ] )
                         {
-                            float fTempSensorVal = 0.0;
+                            ASC_SENSOR_HEALTH *pxHealth       = ASC_SENSOR_HEALTH_ENTRY( i, j );
+                            float             fTempSensorVal = 0.0;
 
-                            if( OK == pxThis->pxSensorData[ i ].ppxReadSensorFunc[ j ]( ASC_SENSOR_I2C_BUS_NUM,
+                            if( FALSE == iSensorReadDue( pxHealth, ulNowMs ) )
+                            {
+                                /* Quarantined - keep the last status until the next retry */
+                                INC_STAT_COUNTER( ASC_PROXY_STATS_SENSOR_READ_SKIPPED )
+                            }
+                            else if( OK == pxThis->pxSensorData[ i ].ppxReadSensorFunc[ j ]( ASC_SENSOR_I2C_BUS_NUM,
                                                                                         pxThis->pxSensorData[ i ].
                                                                                         ucSensorAddress,
                                                                                         pxThis->pxSensorData[ i ].
@@ -1023,11 +1149,15 @@ static void vProxyDriverTask( void *pvArgs )
                                     pxThis->pxSensorData[ i ].pxReadings[ j ].ulMaxSensorValue =
                                         pxThis->pxSensorData[ i ].pxReadings[ j ].ulSensorValue;
                                 }
+
+                                vSensorReadPassed( i, pxHealth );
                             }
                             else
                             {
-                                pxThis->pxSensorData[ i ].pxReadings[ j ].xSensorStatus =
-                                    ASC_PROXY_DRIVER_SENSOR_STATUS_DATA_NOT_AVAILABLE;
+                                vSensorReadFailed( i,
+                                                   pxHealth,
+                                                   &pxThis->pxSensorData[ i ].pxReadings[ j ],
+                                                   ulNowMs );
                             }
                         }
                     }
@@ -1051,8 +1181,31 @@ static void vProxyDriverTask( void *pvArgs )
 
                         for( j = 0; j < MAX_ASC_PROXY_DRIVER_SENSOR_TYPE; j++ )
                         {
+                            ASC_SENSOR_HEALTH *pxHealth = ASC_SENSOR_HEALTH_ENTRY( i, j );
+
                             /* Record Sensor type in the event */
                             xNewSignal.ucAdditionalData = j;
+
+                            if( TRUE == pxHealth->iReportPending )
+                            {
+                                pxHealth->iReportPending = FALSE;
+                                xNewSignal.ucEventType   = ASC_PROXY_DRIVER_E_SENSOR_COMMS_FAILURE;
+
+                                if( ERROR == iEVL_RaiseEvent( pxThis->pxEvlRecord, &xNewSignal ) )
+                                {
+                                    PLL_ERR( ASC_NAME,
+                                             "Error attempting to raise event 0x%x\r\n",
+                                             ASC_PROXY_DRIVER_E_SENSOR_COMMS_FAILURE );
+                                    INC_ERROR_COUNTER_WITH_STATE( ASC_PROXY_ERRORS_RAISE_EVENT_FAILED )
+                                }
+                            }
+
+                            /* The last good value of a quarantined reading is stale */
+                            if( TRUE == pxHealth->iQuarantined )
+                            {
+                                continue;
+                            }
+
                             if( ( ASC_SENSOR_INVALID_VAL !=
                                   pxThis->pxSensorData[ i ].pxReadings[ j ].ulUpperFatalLimit ) &&
                                 ( pxThis->pxSensorData[ i ].pxReadings[ j ].ulSensorValue >=
@@ -1124,3 +1277,88 @@ static void vProxyDriverTask( void *pvArgs )
                                                                   iOSAL_Task_SleepMs( ASC_TASK_SLEEP_MS );
     }
 }
+
+/**
+ * @brief   Clear the failure tracking of every reading of a sensor
+ */
+static void vClearSensorHealth( int iSensor )
+{
+    pvOSAL_MemSet( ASC_SENSOR_HEALTH_ENTRY( iSensor, 0 ),
+                   0,
+                   sizeof( ASC_SENSOR_HEALTH ) * MAX_ASC_PROXY_DRIVER_SENSOR_TYPE );
+}
+
+/**
+ * @brief   Check if a reading should be attempted on this scan
+ */
+static int iSensorReadDue( ASC_SENSOR_HEALTH *pxHealth, uint32_t ulNowMs )
+{
+    int iDue = TRUE;
+
+    /* Signed difference so the check survives uptime wrapping */
+    if( ( TRUE == pxHealth->iQuarantined ) &&
+        ( 0 > ( int32_t )( ulNowMs - pxHealth->ulRetryMs ) ) )
+    {
+        iDue = FALSE;
+    }
+
+    return iDue;
+}
+
+/**
+ * @brief   Record a successful reading, releasing it from quarantine
+ */
+static void vSensorReadPassed( int iSensor, ASC_SENSOR_HEALTH *pxHealth )
+{
+    if( TRUE == pxHealth->iQuarantined )
+    {
+        PLL_INF( ASC_NAME,
+                 "Sensor %s recovered, leaving quarantine\r\n",
+                 pxThis->pxSensorData[ iSensor ].pcSensorName );
+        INC_STAT_COUNTER( ASC_PROXY_STATS_SENSOR_RECOVERED )
+    }
+
+    pvOSAL_MemSet( pxHealth, 0, sizeof( ASC_SENSOR_HEALTH ) );
+}
+
+/**
+ * @brief   Record a failed reading, quarantining it or extending its backoff
+ */
+static void vSensorReadFailed( int iSensor,
+                               ASC_SENSOR_HEALTH *pxHealth,
+                               ASC_PROXY_DRIVER_SENSOR_READINGS *pxReading,
+                               uint32_t ulNowMs )
+{
+    INC_ERROR_COUNTER( ASC_PROXY_ERRORS_SENSOR_READ_FAILED )
+
+    if( TRUE == pxHealth->iQuarantined )
+    {
+        /* Retry failed - back off further, up to the cap */
+        if( ASC_QUARANTINE_BACKOFF_MAX_SHIFT > pxHealth->ucBackoffShift )
+        {
+            pxHealth->ucBackoffShift++;
+        }
+    }
+    else if( ASC_QUARANTINE_FAILURE_THRESHOLD <= ++pxHealth->ucConsecutiveFailures )
+    {
+        PLL_WRN( ASC_NAME,
+                 "Sensor %s failed %d consecutive reads, quarantining\r\n",
+                 pxThis->pxSensorData[ iSensor ].pcSensorName,
+                 pxHealth->ucConsecutiveFailures );
+        INC_STAT_COUNTER( ASC_PROXY_STATS_SENSOR_QUARANTINED )
+
+        pxHealth->iQuarantined   = TRUE;
+        pxHealth->iReportPending = TRUE;
+        pxHealth->ucBackoffShift = 0;
+    }
+
+    if( TRUE == pxHealth->iQuarantined )
+    {
+        pxHealth->ulRetryMs      = ulNowMs + ( ASC_QUARANTINE_BACKOFF_MIN_MS << pxHealth->ucBackoffShift );
+        pxReading->xSensorStatus = ASC_PROXY_DRIVER_SENSOR_STATUS_QUARANTINED;
+    }
+    else
+    {
+        pxReading->xSensorStatus = ASC_PROXY_DRIVER_SENSOR_STATUS_DATA_NOT_AVAILABLE;
+    }
+}
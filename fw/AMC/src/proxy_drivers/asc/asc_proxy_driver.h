@@ -68,6 +68,7 @@ typedef enum ASC_PROXY_DRIVER_SENSOR_STATUS
     ASC_PROXY_DRIVER_SENSOR_STATUS_PRESENT_AND_VALID,
     ASC_PROXY_DRIVER_SENSOR_STATUS_DATA_NOT_AVAILABLE,
     ASC_PROXY_DRIVER_SENSOR_STATUS_NOT_AVAILABLE,
+    ASC_PROXY_DRIVER_SENSOR_STATUS_QUARANTINED,
     MAX_ASC_PROXY_DRIVER_SENSOR_STATUS
 
 } ASC_PROXY_DRIVER_SENSOR_STATUS;
@@ -255,6 +256,18 @@ int iASC_Initialise( uint8_t ucProxyId,
  */
 int iASC_BindCallback( EVL_CALLBACK *pxCallback );
 
+/**
+ * @brief   Bind into this proxy driver for a subset of its events
+ *
+ * @param   pxCallback  Callback to bind into the proxy driver
+ * @param   ulEventMask Events to deliver, built with EVL_EVENT_MASK( x )
+ *
+ * @return  OK          Callback successfully bound
+ *          ERROR       Callback not bound
+ *
+ */
+int iASC_BindFilteredCallback( EVL_CALLBACK *pxCallback, uint32_t ulEventMask );
+
 
 /* Set functions **************************************************************/
 
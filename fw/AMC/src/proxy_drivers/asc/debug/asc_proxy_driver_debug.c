@@ -137,7 +137,7 @@ static const char *pcTypeStrings[ MAX_ASC_PROXY_DRIVER_SENSOR_TYPE ] =
 
 static const char *pcStatusStrings[ MAX_ASC_PROXY_DRIVER_SENSOR_STATUS ] =
 {
-    "Not present", "Present and valid", "No data", "Not available"
+    "Not present", "Present and valid", "No data", "Not available", "Quarantined"
 };
 
 static const char *pcModStrings[ MAX_ASC_PROXY_DRIVER_SENSOR_UNIT_MOD ] =
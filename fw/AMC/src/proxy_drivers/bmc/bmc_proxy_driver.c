@@ -635,6 +635,33 @@ int iBMC_BindCallback( EVL_CALLBACK *pxCallback )
     return iStatus;
 }
 
+/**
+ * @brief   Bind into this proxy driver for a subset of its events
+ */
+int iBMC_BindFilteredCallback( EVL_CALLBACK *pxCallback, uint32_t ulEventMask )
+{
+    int iStatus = ERROR;
+
+    if( ( UPPER_FIREWALL == pxThis->ulUpperFirewall ) &&
+        ( LOWER_FIREWALL == pxThis->ulLowerFirewall ) &&
+        ( TRUE == pxThis->iInitialised ) &&
+        ( NULL != pxCallback ) &&
+        ( NULL != pxThis->pxEvlRecord ) )
+    {
+        iStatus = iEVL_BindFilteredCallback( pxThis->pxEvlRecord, pxCallback, pxThis->ucMyId, ulEventMask );
+        if( ERROR == iStatus )
+        {
+            INC_ERROR_COUNTER_WITH_STATE( BMC_PROXY_BIND_CB_FAILED )
+        }
+    }
+    else
+    {
+        INC_ERROR_COUNTER( BMC_PROXY_VALIDATION_FAILED )
+    }
+
+    return iStatus;
+}
+
 
 /* Set Functions **************************************************************/
 
@@ -756,6 +783,11 @@ int iBMC_PrintStatistics( void )
             PRINT_ERROR_COUNTER( i );
 
         }
+        if( NULL != pxThis->pxEvlRecord )
+        {
+            PLL_INF( BMC_NAME, "------------------------------------------------------------\n\r" );
+            iEVL_GetStats( pxThis->pxEvlRecord );
+        }
         PLL_INF( BMC_NAME, "============================================================\n\r" );
         iStatus = OK;
     }
@@ -162,6 +162,18 @@ int iBMC_Initialise( uint8_t ucProxyId,
  */
 int iBMC_BindCallback( EVL_CALLBACK *pxCallback );
 
+/**
+ * @brief   Bind into this proxy driver for a subset of its events
+ *
+ * @param   pxCallback  Callback to bind into the proxy driver
+ * @param   ulEventMask Events to deliver, built with EVL_EVENT_MASK( x )
+ *
+ * @return  OK          Callback successfully bound
+ *          ERROR       Callback not bound
+ *
+ */
+int iBMC_BindFilteredCallback( EVL_CALLBACK *pxCallback, uint32_t ulEventMask );
+
 /**
  * @brief   Response to a Sensor Info request
  *
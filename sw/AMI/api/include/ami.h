@@ -175,6 +175,13 @@ int ami_get_api_version(struct ami_version *ami_version);
  * AMI_STATUS_ERROR - otherwise, you may get the string for an error
  * from a previous, unrelated function call.
  * 
+ * The error state is kept per thread, so this returns the last error raised
+ * by the calling thread only. The string remains valid until the next API
+ * call made from the same thread.
+ * 
+ * Only the final message is built here; the context supplied with an error
+ * is still formatted on the failure path when the error is raised.
+ * 
  * Return: Error code string.
  */
 const char *ami_get_last_error(void);
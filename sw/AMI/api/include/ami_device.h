@@ -39,6 +39,11 @@ extern "C" {
 #define AMI_DEV_NAME_SIZE	(32 + 1)
 #define AMI_DEV_PCI_PORT_SIZE	(13)  /* 0000:00:00.0 + NULL */
 
+/* PCIe link health conditions (`struct ami_pcie_health` flags). */
+#define AMI_PCIE_HEALTH_SPEED_DOWN	(1 << 0)
+#define AMI_PCIE_HEALTH_WIDTH_DOWN	(1 << 1)
+#define AMI_PCIE_HEALTH_ERR_RATE	(1 << 2)
+
 /*****************************************************************************/
 /* Structs                                                                   */
 /*****************************************************************************/
@@ -62,6 +67,56 @@ struct amc_version {
 	uint16_t  dev_commits;
 };
 
+/**
+ * struct ami_echo_stats - GCQ echo round trip summary
+ * @min_ns: Fastest round trip.
+ * @p50_ns: Median round trip.
+ * @p99_ns: 99th percentile round trip.
+ * @max_ns: Slowest round trip.
+ * @total_ns: Sum of all round trips.
+ */
+struct ami_echo_stats {
+	uint64_t min_ns;
+	uint64_t p50_ns;
+	uint64_t p99_ns;
+	uint64_t max_ns;
+	uint64_t total_ns;
+};
+
+/**
+ * struct ami_pcie_health - PCIe link health as sampled by the driver
+ * @flags: Currently active AMI_PCIE_HEALTH_* conditions.
+ * @speed_current: PCI generation of the current link speed.
+ * @speed_max: PCI generation of the maximum link speed.
+ * @width_current: Current link width.
+ * @width_max: Maximum link width.
+ * @downgrades: Number of times the link was found downgraded.
+ * @events: Number of health events raised by the driver.
+ * @cor_errors: Total correctable AER errors.
+ * @rx_errors: Receiver errors.
+ * @bad_tlp: Bad TLPs.
+ * @bad_dllp: Bad DLLPs.
+ * @replays: Replay number rollovers and replay timer timeouts.
+ * @samples: Number of samples taken.
+ * @interval_ms: Sampling interval in milliseconds (0 if sampling is stopped).
+ */
+struct ami_pcie_health {
+	uint32_t  flags;
+	uint8_t   speed_current;
+	uint8_t   speed_max;
+	uint8_t   width_current;
+	uint8_t   width_max;
+	uint64_t  downgrades;
+	uint64_t  events;
+	uint64_t  cor_errors;
+	uint64_t  rx_errors;
+	uint64_t  bad_tlp;
+	uint64_t  bad_dllp;
+	uint64_t  replays;
+	uint64_t  samples;
+	uint32_t  interval_ms;
+};
+
 /*****************************************************************************/
 /* Enums                                                                     */
 /*****************************************************************************/
@@ -187,6 +242,10 @@ int ami_dev_request_access(ami_device *dev);
  * do not have any open device handles pointing to the same device - this
  * could lead to stability issues!
  *
+ * Only the secondary bus of the device's upstream port is rescanned, so devices
+ * behind other ports are not affected. A device on a root bus has no upstream
+ * port and the whole PCI tree is rescanned instead.
+ *
  * This function requires sudo/root permissions.
  *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
@@ -202,12 +261,57 @@ int ami_dev_pci_reload(ami_device **dev, const char *bdf);
  * do not have any other open device handles pointing to the same device - this
  * could lead to stability issues!
  *
+ * Only the secondary bus of the device's upstream port is rescanned, so devices
+ * behind other ports are not affected. This function returns as soon as the
+ * link is back up and the driver has finished bringing the device up (or with
+ * an error if that does not happen within a bounded timeout).
+ *
  * This function requires sudo/root permissions.
  *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
  */
 int ami_dev_hot_reset(ami_device **dev);
 
+/**
+ * ami_dev_hot_reset_batch() - Trigger a PCI hot reset for several devices at once.
+ * @devs: Array of device handles.
+ * @num_devs: Number of handles in `devs`.
+ *
+ * This is equivalent to calling `ami_dev_hot_reset` on every handle, except
+ * that all devices are reset together and then waited for in parallel, so the
+ * total time is roughly that of the slowest device rather than the sum of all
+ * of them. Devices which share an upstream port are reset with a single
+ * secondary bus reset.
+ *
+ * Every handle in `devs` is deleted and replaced with a fresh handle once the
+ * corresponding device is back. Entries for devices which could not be
+ * recovered are set to NULL. The same rules about other open handles apply as
+ * for `ami_dev_hot_reset`.
+ *
+ * This function requires sudo/root permissions.
+ *
+ * Return: AMI_STATUS_OK if every device was reset, AMI_STATUS_ERROR otherwise
+ */
+int ami_dev_hot_reset_batch(ami_device **devs, int num_devs);
+
+/**
+ * ami_dev_pci_reload_batch() - Remove several devices and rescan their ports.
+ * @devs: Array of device handles.
+ * @num_devs: Number of handles in `devs`.
+ *
+ * Batched equivalent of `ami_dev_pci_reload` for devices attached to the
+ * AMI driver. Only the secondary buses of the ports above the given devices
+ * are rescanned and the devices are waited for in parallel. Handles are
+ * replaced in the same way as for `ami_dev_hot_reset_batch`. A device which
+ * is not attached to the AMI driver has no handle and must be reloaded on its
+ * own with `ami_dev_pci_reload`, passing its BDF string.
+ *
+ * This function requires sudo/root permissions.
+ *
+ * Return: AMI_STATUS_OK if every device was reloaded, AMI_STATUS_ERROR otherwise
+ */
+int ami_dev_pci_reload_batch(ami_device **devs, int num_devs);
+
 /**
  * ami_dev_set_amc_debug_level() - Set the AMC debug verbosity level.
  * @dev: Device handle.
@@ -217,6 +321,28 @@ int ami_dev_hot_reset(ami_device **dev);
  */
 int ami_dev_set_amc_debug_level(ami_device *dev, enum ami_amc_debug_level level);
 
+/**
+ * ami_dev_echo() - Measure the host to AMC command round trip.
+ * @dev: Device handle.
+ * @size: Number of payload bytes carried per echo (may be 0).
+ * @count: Number of echoes to run.
+ * @stats: Latency summary populated on success.
+ *
+ * The driver sends `count` echo commands back to back through the GCQ. Each
+ * one carries `size` bytes through shared memory which the AMC reads and
+ * writes back; the driver verifies the returned payload before the next
+ * echo is sent. Timings are taken in the driver so they exclude the ioctl
+ * overhead.
+ *
+ * The driver accepts at most 10000 echoes of up to 1 MiB each and abandons
+ * a run which takes longer than 10 seconds, since other device requests are
+ * blocked while it runs.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int ami_dev_echo(ami_device *dev, uint32_t size, uint32_t count,
+	struct ami_echo_stats *stats);
+
 /**
  * ami_dev_read_uuid() - Read the logic uuid sysfs node.
  * @dev: Device handle.
@@ -256,6 +382,19 @@ int ami_dev_get_pci_link_speed(ami_device *dev, uint8_t *current, uint8_t *max);
  */
 int ami_dev_get_pci_link_width(ami_device *dev, uint8_t *current, uint8_t *max);
 
+/**
+ * ami_dev_get_pcie_health() - Get the PCIe link health.
+ * @dev: Device handle.
+ * @health: Variable to store the link health.
+ *
+ * The driver samples the link periodically; a downgrade or a high rate of
+ * correctable errors sets the matching flag until the condition clears.
+ * The `pcie_health` sysfs attribute can be polled for new events.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
+ */
+int ami_dev_get_pcie_health(ami_device *dev, struct ami_pcie_health *health);
+
 /**
  * ami_dev_get_pci_vendor() - Get the PCI vendor ID.
  * @dev: Device handle.
@@ -304,6 +443,25 @@ int ami_dev_get_pci_cpulist(ami_device *dev, char buf[AMI_PCI_CPULIST_SIZE]);
  */
 int ami_dev_get_state(ami_device *dev, char buf[AMI_DEV_STATE_SIZE]);
 
+/**
+ * ami_dev_wait_state() - Wait for the device to change state.
+ * @dev: Device handle.
+ * @state: State string to wait for (e.g., `AMI_DEV_READY_STR`) or NULL to
+ *   wait for any transition away from the current state.
+ * @timeout_ms: Maximum time to wait in milliseconds. A value of 0 checks the
+ *   state once without blocking; a negative value waits indefinitely.
+ * @buf: Optional variable to store the final device state string (may be NULL).
+ *
+ * The driver signals every state transition on the `dev_state` sysfs
+ * attribute, so this function sleeps in poll() rather than repeatedly
+ * reading the state. If the requested state is already set, this function
+ * returns immediately.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR (ETIMEDOUT if the state was not reached in time)
+ */
+int ami_dev_wait_state(ami_device *dev, const char *state, int timeout_ms,
+	char buf[AMI_DEV_STATE_SIZE]);
+
 /**
  * ami_dev_get_name() - Get the device name.
  * @dev: Device handle.
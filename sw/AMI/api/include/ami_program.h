@@ -99,6 +99,28 @@ struct ami_pdi_progress {
 	uint64_t reserved;
 };
 
+/**
+ * enum ami_pdi_codec - Transfer codecs for PDI downloads.
+ * @AMI_PDI_CODEC_NONE: Image is sent as-is.
+ * @AMI_PDI_CODEC_RLE: Each chunk is run-length encoded and expanded by the AMC.
+ */
+enum ami_pdi_codec {
+	AMI_PDI_CODEC_NONE = 0,
+	AMI_PDI_CODEC_RLE,
+};
+
+/**
+ * struct ami_pdi_transfer - Summary of a PDI download.
+ * @codec: Codec the image was actually sent with.
+ * @image_size: Size of the image in bytes.
+ * @transfer_size: Number of bytes sent to the device.
+ */
+struct ami_pdi_transfer {
+	enum ami_pdi_codec codec;
+	uint32_t image_size;
+	uint32_t transfer_size;
+};
+
 /*****************************************************************************/
 /* Function Declarations                                                     */
 /*****************************************************************************/
@@ -120,6 +142,29 @@ struct ami_pdi_progress {
 int ami_prog_download_pdi(ami_device *dev, const char *path, uint8_t boot_device,
 	uint32_t partition, ami_event_handler progress_handler);
 
+/**
+ * ami_prog_download_pdi_codec() - Program a .pdi bitstream using a transfer codec.
+ * @dev: Device handle.
+ * @path: Full path to PDI file.
+ * @boot_device: Target boot device.
+ * @partition: Partition number to flash to.
+ * @codec: Codec to compress the image with for the transfer.
+ * @progress_handler: An event handler to accept progress notifications.
+ * @transfer: Filled in with the codec and sizes used (optional).
+ *
+ * Behaves like `ami_prog_download_pdi`, except that the image is compressed
+ * chunk by chunk on the host and expanded by the AMC before it is written.
+ * Chunks which do not compress are sent as-is; if nothing compresses, or the
+ * driver does not support transfer codecs, the image is sent without a codec
+ * and `transfer->codec` reports that.
+ * Progress notifications count image bytes, not transferred bytes.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+int ami_prog_download_pdi_codec(ami_device *dev, const char *path, uint8_t boot_device,
+	uint32_t partition, enum ami_pdi_codec codec, ami_event_handler progress_handler,
+	struct ami_pdi_transfer *transfer);
+
 /**
  * ami_prog_update_fpt() - Program a PDI containing an FPT onto a device.
  * @dev: Device handle.
@@ -64,6 +64,8 @@ enum ami_sensor_type {
  * @AMI_SENSOR_STATUS_OK: Sensor present and valid.
  * @AMI_SENSOR_STATUS_NO_DATA: Data not available.
  * @AMI_SENSOR_STATUS_OK_CACHED: Value is OK but not fresh.
+ * @AMI_SENSOR_STATUS_QUARANTINED: Sensor keeps failing and is only retried
+ *  periodically; the value is stale.
  * @AMI_SENSOR_STATUS_NA: Not applicable or default value.
  */
 enum ami_sensor_status {
@@ -73,7 +75,8 @@ enum ami_sensor_status {
 	AMI_SENSOR_STATUS_OK          = 0x01,
 	AMI_SENSOR_STATUS_NO_DATA     = 0x02,
 	AMI_SENSOR_STATUS_OK_CACHED   = 0x03,  /* Not from ASDM */
-	/* 0x04 - 0x7E Reserved */
+	AMI_SENSOR_STATUS_QUARANTINED = 0x04,
+	/* 0x05 - 0x7E Reserved */
 	AMI_SENSOR_STATUS_NA          = 0x7F,
 	/* 0x80 - 0xFF Reserved */
 };
@@ -151,27 +154,36 @@ struct ami_sensor {
 int ami_sensor_discover(ami_device *dev);
 
 /**
- * ami_sensor_set_refresh() - Set the sensor update interval.
+ * ami_sensor_set_refresh() - Set the sensor update interval for this handle.
  * @dev: Device handle.
  * @val: New update interval (ms).
  * 
  * Note that nothing needs to be done by the user to enforce the refresh
- * interval. The set/get functions are simply for updating the interval
- * or fetching it. The refresh will always be in effect under the hood
+ * interval. The refresh will always be in effect under the hood
  * (unless, of course, the refresh timeout is set to 0). Every applicable
- * sensor getter will read a hwmon file, which triggers a driver callback; the
- * driver knows the last update timestamp and can figure out whether or not
- * a new value should be fetched.
+ * sensor getter triggers a driver callback; the driver knows the last update
+ * timestamp and can figure out whether or not a new value should be fetched.
+ *
+ * The interval is the oldest cached reading this handle will accept and does
+ * not affect other handles or processes. Readers share one cache, so it is
+ * refreshed at the tightest interval in use. Handles which never call this
+ * follow the device wide hwmon `update_interval`. Once set, every sensor value
+ * read through this handle goes through the driver so that the interval is
+ * honoured; reading the hwmon sysfs files directly (e.g. with `sensors`)
+ * always follows `update_interval`.
  *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
  */
 int ami_sensor_set_refresh(ami_device *dev, uint16_t val);
 
 /**
- * ami_sensor_get_refresh() - Get the current sensor update interval.
+ * ami_sensor_get_refresh() - Get the sensor update interval for this handle.
  * @dev: Device handle.
  * @val: Variable to hold update interval (ms).
  *
+ * This is the value set with `ami_sensor_set_refresh` on this handle or,
+ * if none was set, the device wide hwmon `update_interval`.
+ *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
  */
 int ami_sensor_get_refresh(ami_device *dev, uint16_t *val);
@@ -40,8 +40,7 @@
 #define AMI_BDF_FORMAT_FULL	"%*04x:" AMI_BDF_FORMAT  /* ignore domain */
 
 #define MAX_ERROR_DEFAULT_STR	(128)
-#define MAX_ERROR_CTXT_STR	(256)
-#define MAX_ERROR_STR		(MAX_ERROR_DEFAULT_STR + MAX_ERROR_CTXT_STR)
+#define MAX_ERROR_STR		(MAX_ERROR_DEFAULT_STR + AMI_ERROR_CTXT_STR_MAX)
 
 #define EVENT_POLL_FDS		(1)
 #define EVENT_POLL_TIMEOUT_MS	(1000)
@@ -53,8 +52,27 @@
 /* Global variables                                                          */
 /*****************************************************************************/
 
-volatile enum ami_error ami_last_error = AMI_ERROR_NONE;
-static char last_error_str[MAX_ERROR_STR] = { 0 };
+/*
+ * All error state is per-thread. Setting an error only records the code and
+ * the caller's context; the full message is built by `ami_get_last_error`.
+ */
+__thread enum ami_error ami_last_error = AMI_ERROR_NONE;
+static __thread char last_error_ctxt[AMI_ERROR_CTXT_STR_MAX] = { 0 };
+static __thread char last_error_str[MAX_ERROR_STR] = { 0 };
+static __thread bool last_error_has_ctxt = false;
+static __thread bool last_error_formatted = true;
+
+static const char * const error_desc[] = {
+	[AMI_ERROR_EINVAL]    = "EINVAL: Invalid arguments",
+	[AMI_ERROR_EBADF]     = "EBADF: File could not be opened and/or closed",
+	[AMI_ERROR_EIO]       = "EIO: File could not be read or written",
+	[AMI_ERROR_EFMT]      = "EFMT: Bad format; data could not be parsed",
+	[AMI_ERROR_ENOMEM]    = "ENOMEM: Could not allocate memory",
+	[AMI_ERROR_ERET]      = "ERET: Invalid return code from function call",
+	[AMI_ERROR_ENODEV]    = "ENODEV: No such device",
+	[AMI_ERROR_EVER]      = "EVER: Version does not match expected value",
+	[AMI_ERROR_ETIMEDOUT] = "ETIMEDOUT: Operation timed out",
+};
 
 /*****************************************************************************/
 /* Local function definitions                                                */
@@ -193,109 +211,63 @@ int ami_convert_num(const char *buf, int base, long *out)
 }
 
 /*
- * Set the last error.
+ * Build the last error string for the calling thread.
  */
-int ami_set_last_error(enum ami_error err, const char *ctxt, ...)
+static void format_last_error(void)
 {
-	ami_last_error = err;
-	char error_ctxt[MAX_ERROR_CTXT_STR] = { 0 };
-
-	if (ctxt != NULL) {
-		va_list args;
-		va_start(args, ctxt);
-		vsnprintf(error_ctxt, MAX_ERROR_CTXT_STR, ctxt, args);
-		va_end(args);
-	} else {
-		/* Default to just the numeric error code. */
-		sprintf(
-			error_ctxt,
-			"%d",
-			(int)err
-		);
-	}
-
-	memset(last_error_str, 0x00, MAX_ERROR_STR);
+	enum ami_error err = ami_last_error;
+	const char *desc = NULL;
 
-	switch (err) {
-	case AMI_ERROR_EINVAL:
-		snprintf(
-			last_error_str,
-			MAX_ERROR_STR,
-			"EINVAL: Invalid arguments [%s].\r\n",
-			error_ctxt
-		);
-		break;
-
-	case AMI_ERROR_EBADF:
-		snprintf(
-			last_error_str,
-			MAX_ERROR_STR,
-			"EBADF: File could not be opened and/or closed [%s].\r\n",
-			error_ctxt
-		);
-		break;
+	if ((size_t)err < (sizeof(error_desc) / sizeof(error_desc[0])))
+		desc = error_desc[err];
 
-	case AMI_ERROR_EIO:
+	if (!desc) {
 		snprintf(
 			last_error_str,
 			MAX_ERROR_STR,
-			"EIO: File could not be read or written [%s].\r\n",
-			error_ctxt
+			"Unknown error (%d).\r\n",
+			(int)err
 		);
-		break;
-
-	case AMI_ERROR_EFMT:
+	} else if (last_error_has_ctxt) {
 		snprintf(
 			last_error_str,
 			MAX_ERROR_STR,
-			"EFMT: Bad format; data could not be parsed [%s].\r\n",
-			error_ctxt
+			"%s [%s].\r\n",
+			desc,
+			last_error_ctxt
 		);
-		break;
-
-	case AMI_ERROR_ENOMEM:
-		snprintf(
-			last_error_str,
-			MAX_ERROR_STR,
-			"ENOMEM: Could not allocate memory [%s].\r\n",
-			error_ctxt
-		);
-		break;
-
-	case AMI_ERROR_ERET:
+	} else {
+		/* Default to just the numeric error code. */
 		snprintf(
 			last_error_str,
 			MAX_ERROR_STR,
-			"ERET: Invalid return code from function call [%s].\r\n",
-			error_ctxt
+			"%s [%d].\r\n",
+			desc,
+			(int)err
 		);
-		break;
+	}
 
-	case AMI_ERROR_ENODEV:
-		snprintf(
-			last_error_str,
-			MAX_ERROR_STR,
-			"ENODEV: No such device [%s].\r\n",
-			error_ctxt
-		);
-		break;
+	last_error_formatted = true;
+}
 
-	case AMI_ERROR_EVER:
-		snprintf(
-			last_error_str,
-			MAX_ERROR_STR,
-			"EVER: Version does not match expected value [%s].\r\n",
-			error_ctxt
-		);
-		break;
+/*
+ * Set the last error.
+ *
+ * The va_list cannot be kept, so the context is formatted here; the full
+ * message is only built by `ami_get_last_error`.
+ */
+int ami_set_last_error(enum ami_error err, const char *ctxt, ...)
+{
+	ami_last_error = err;
+	last_error_has_ctxt = false;
+	last_error_formatted = false;
 
-	default:
-		sprintf(
-			last_error_str,
-			"Unknown error (%d).\r\n",
-			(int)err
-		);
-		break;
+	if (ctxt != NULL) {
+		va_list args;
+		va_start(args, ctxt);
+		vsnprintf(last_error_ctxt, AMI_ERROR_CTXT_STR_MAX, ctxt, args);
+		va_end(args);
+		last_error_has_ctxt = true;
 	}
 
 	return AMI_STATUS_OK;
@@ -370,6 +342,9 @@ int ami_get_api_version(struct ami_version *ami_version)
  */
 const char *ami_get_last_error(void)
 {
+	if (!last_error_formatted)
+		format_last_error();
+
 	return last_error_str;
 }
 
@@ -11,6 +11,7 @@
 
 /* Standard includes */
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <fcntl.h>
@@ -20,6 +21,8 @@
 #include <libgen.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
+#include <poll.h>
+#include <time.h>
 
 /* Private API includes */
 #include "ami_internal.h"
@@ -57,27 +60,125 @@
 #define SYSFS_PCI_LINK_WIDTH_C		"link_width_current"
 #define SYSFS_PCI_LINK_WIDTH_M		"link_width_max"
 
+/* Must match the format used by the driver. */
+#define SYSFS_PCIE_HEALTH		"pcie_health"
+#define PCIE_HEALTH_ATTR_FMT		"flags=0x%x speed=%hhu/%hhu width=%hhu/%hhu " \
+					"downgrades=%" SCNu64 " events=%" SCNu64 " " \
+					"cor_errors=%" SCNu64 " rx_errors=%" SCNu64 " " \
+					"bad_tlp=%" SCNu64 " bad_dllp=%" SCNu64 " " \
+					"replays=%" SCNu64 " samples=%" SCNu64 " interval_ms=%u"
+#define PCIE_HEALTH_ATTR_FIELDS		(14)
+
 /* For PCI reloading */
 #define HOT_RESET_GPIO_BAR		(0)
 #define HOT_RESET_GPIO_OFFSET		(0x1040000)
 #define PCI_ENABLE			(1)
+#define PCI_DISABLE			(0)
 /*
  * NOTE: The following delays may need tweaking.
  * It is possible that a device may not show up after a rescan
  * if improper delays are used!
  */
 #define HOT_RESET_SBR_SET_DELAY_MS	(2)
-#define HOT_RESET_RESCAN_DELAY_MS	(5000)
 #define HOT_RESET_GPIO_SET_DELAY_MS	(1)
 
+/*
+ * Readiness polling after a hot reset. Polls start at HOT_RESET_POLL_MIN_MS
+ * and double up to HOT_RESET_POLL_MAX_MS until the relevant timeout expires.
+ * HOT_RESET_LINK_SETTLE_MS is the PCIe-mandated wait between link up and the
+ * first configuration request.
+ */
+#define HOT_RESET_POLL_MIN_MS		(10)
+#define HOT_RESET_POLL_MAX_MS		(500)
+#define HOT_RESET_LINK_TIMEOUT_MS	(5000)
+#define HOT_RESET_LINK_SETTLE_MS	(100)
+#define HOT_RESET_READY_TIMEOUT_MS	(30000)
+
 #define PCI_DEV_DIR			"/sys/bus/pci/devices/0000:%02x:%02x.%1x"
 #define PCI_BRIDGE_CONTROL		(0x3e)
 #define PCI_BRIDGE_CTL_BUS_RESET	(0x40)
 
+/* PCIe capability registers of the upstream port */
+#define PCI_CAPABILITY_LIST		(0x34)
+#define PCI_CAP_LIST_MAX		(48)
+#define PCI_CAP_ID_EXP			(0x10)
+#define PCI_EXP_LNKCAP			(0x0c)
+#define PCI_EXP_LNKCAP_DLLLARC		(0x00100000)
+#define PCI_EXP_LNKSTA			(0x12)
+#define PCI_EXP_LNKSTA_DLLLA		(0x2000)
+
 #define SYSFS_ENABLE			"1"
 #define SYSFS_PCI_CONFIG		"/sys/bus/pci/devices/%s/config"
 #define SYSFS_PCI_REMOVE		PCI_DEV_DIR "/remove"
 #define SYSFS_PCI_RESCAN		"/sys/bus/pci/rescan"
+#define SYSFS_PCI_PORT_RESCAN		"/sys/bus/pci/devices/%s/pci_bus/%.*s:%02x/rescan"
+
+/* Parent of a device which sits directly on a root bus, e.g. `pci0000:00` */
+#define PCI_ROOT_BUS_PREFIX		"pci"
+
+/* `dev_state` value while the driver is still bringing a device up */
+#define DEV_STATE_INIT_STR		"INIT"
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct backoff - State for a bounded exponential backoff.
+ * @delay_ms: Delay to use for the next wait.
+ * @waited_ms: Total time waited so far.
+ * @timeout_ms: Upper bound on the total time to wait.
+ */
+struct backoff {
+	long delay_ms;
+	long waited_ms;
+	long timeout_ms;
+};
+
+#define BACKOFF_INIT(timeout)	{ HOT_RESET_POLL_MIN_MS, 0, (timeout) }
+
+/**
+ * struct reset_target - A device taking part in a batched reset or reload.
+ * @dev: Pointer to the caller's device handle (updated on completion).
+ * @bdf: Numeric BDF of the device.
+ * @has_sensors: Did the handle have sensor data?
+ * @group: Index of the upstream port group this device belongs to.
+ * @ret: Result for this device.
+ * @err: Error set by the worker thread (errors are per-thread).
+ */
+struct reset_target {
+	ami_device     **dev;
+	uint16_t         bdf;
+	bool             has_sensors;
+	int              group;
+	int              ret;
+	enum ami_error   err;
+};
+
+/**
+ * struct reset_group - Devices which share an upstream port.
+ * @id: Index of this group.
+ * @port: BDF string of the upstream port.
+ * @config: Config space file descriptor of the port (hot reset only).
+ * @ret: Result of removing the devices and resetting the port.
+ * @targets: All targets in the batch (only those with a matching group are used).
+ * @num_targets: Number of entries in `targets`.
+ * @thread: Thread waiting for the devices in this group.
+ * @thread_created: Was `thread` started?
+ *
+ * A secondary bus reset affects every device below a port, so the port is
+ * reset once per group rather than once per device.
+ */
+struct reset_group {
+	int                   id;
+	char                  port[AMI_DEV_PCI_PORT_SIZE];
+	int                   config;
+	int                   ret;
+	struct reset_target  *targets;
+	int                   num_targets;
+	pthread_t             thread;
+	bool                  thread_created;
+};
 
 /*****************************************************************************/
 /* Local function declarations                                               */
@@ -93,6 +194,19 @@
  */
 static int open_sysfs(ami_device *dev, const char *attr, int mode);
 
+/**
+ * open_sysfs_bdf() - Open a sysfs node by device BDF.
+ * @bdf: Numeric BDF of the device.
+ * @attr: Attribute name.
+ * @mode: File mode (O_RDONLY, O_WRONLY, O_RDWR).
+ *
+ * Unlike `open_sysfs`, this does not require a device handle, so it can be
+ * used while a device is being re-enumerated.
+ *
+ * Return: The file descriptor (-1 on error).
+ */
+static int open_sysfs_bdf(uint16_t bdf, const char *attr, int mode);
+
 /**
  * get_new_device_handle() - Get a fresh handle for a specific device.
  * @new_dev: Variable to store new handle.
@@ -135,6 +249,147 @@ static int pci_remove(uint16_t bdf);
  */
 static int pci_rescan(void);
 
+/**
+ * pci_rescan_port() - Rescan the bus below a single PCI port.
+ * @port: BDF string of the port (as returned by `ami_dev_get_pci_port`).
+ * @bdf: BDF of a device directly below the port.
+ *
+ * The port's own `rescan` attribute walks the bus the port sits on, so the
+ * secondary bus is rescanned through `<port>/pci_bus/<domain>:<bus>/rescan`
+ * instead. The bus number is taken from @bdf, which lives on that secondary
+ * bus, and the domain from @port. Devices behind other ports are not
+ * disturbed. A device on a root bus has no port above it, so the whole tree
+ * is rescanned instead. Sudo/root permissions are required.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int pci_rescan_port(const char *port, uint16_t bdf);
+
+/**
+ * pci_config_read() - Read from an open PCI config space file.
+ * @config: Config space file descriptor.
+ * @offset: Register offset.
+ * @buf: Output buffer.
+ * @len: Number of bytes to read.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int pci_config_read(int config, off_t offset, void *buf, size_t len);
+
+/**
+ * pci_config_write() - Write to an open PCI config space file.
+ * @config: Config space file descriptor.
+ * @offset: Register offset.
+ * @buf: Data to write.
+ * @len: Number of bytes to write.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int pci_config_write(int config, off_t offset, const void *buf, size_t len);
+
+/**
+ * pci_find_exp_cap() - Find the PCI Express capability of a port.
+ * @config: Config space file descriptor.
+ *
+ * Return: Offset of the capability or 0 if it could not be found.
+ */
+static uint8_t pci_find_exp_cap(int config);
+
+/**
+ * backoff_wait() - Sleep for the next period of a bounded backoff.
+ * @b: Backoff state.
+ *
+ * Return: true if a wait was performed, false if the timeout has expired.
+ */
+static bool backoff_wait(struct backoff *b);
+
+/**
+ * sbr_toggle() - Assert and release the secondary bus reset of a port.
+ * @config: Config space file descriptor of the port.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int sbr_toggle(int config);
+
+/**
+ * wait_link_up() - Wait for the link below a port to come back up.
+ * @config: Config space file descriptor of the port.
+ *
+ * If the port does not support Data Link Layer Link Active reporting, this
+ * returns immediately and readiness is left to `wait_dev_ready`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int wait_link_up(int config);
+
+/**
+ * read_dev_state() - Read the `dev_state` attribute of a device by BDF.
+ * @bdf: Numeric BDF of the device.
+ * @buf: Buffer to store the state (newline stripped).
+ *
+ * This does not set the last error, as failure is expected while a
+ * device is still being enumerated.
+ *
+ * Return: true if the attribute could be read, false otherwise.
+ */
+static bool read_dev_state(uint16_t bdf, char buf[AMI_DEV_STATE_SIZE]);
+
+/**
+ * read_dev_state_fd() - Re-read an open `dev_state` attribute.
+ * @file: File descriptor of the attribute.
+ * @buf: Variable to store the state string (newline stripped).
+ *
+ * Sysfs attributes must be read from the start after every poll()
+ * wake up to re-arm the notification.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int read_dev_state_fd(int file, char buf[AMI_DEV_STATE_SIZE]);
+
+/**
+ * wait_dev_ready() - Wait for a device to re-enumerate and finish probing.
+ * @port: BDF string of the upstream port.
+ * @bdf: Numeric BDF of the device.
+ *
+ * The port is rescanned until the device is attached to the AMI driver and
+ * its `dev_state` has left the initialising state.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int wait_dev_ready(const char *port, uint16_t bdf);
+
+/**
+ * build_reset_groups() - Group the devices of a batch by upstream port.
+ * @devs: Array of device handles.
+ * @num_devs: Number of entries in `devs`.
+ * @hot_reset: Open the config space of each port for a secondary bus reset?
+ * @targets: Array of `num_devs` targets to populate.
+ * @groups: Array of (at least) `num_devs` groups to populate.
+ * @num_groups: Variable to store the number of groups.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int build_reset_groups(ami_device **devs, int num_devs, bool hot_reset,
+	struct reset_target *targets, struct reset_group *groups, int *num_groups);
+
+/**
+ * reset_group_worker() - Wait for every device in a group to come back.
+ * @data: Pointer to `struct reset_group`.
+ *
+ * Return: NULL.
+ */
+static void *reset_group_worker(void *data);
+
+/**
+ * reset_batch() - Reset or reload a set of devices concurrently.
+ * @devs: Array of device handles.
+ * @num_devs: Number of entries in `devs`.
+ * @hot_reset: Trigger a secondary bus reset (true) or only remove and rescan (false).
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int reset_batch(ami_device **devs, int num_devs, bool hot_reset);
+
 /**
  * do_app_setup() - Utility function to execute an app setup IOCTL.
  * @dev: Device handle.
@@ -153,104 +408,623 @@ static int do_app_setup(ami_device *dev, enum ami_ioc_app_setup arg);
  */
 static int open_sysfs(ami_device *dev, const char *attr, int mode)
 {
-	int file = AMI_INVALID_FD;
+	if (!dev || !attr)
+		return AMI_INVALID_FD;
+
+	return open_sysfs_bdf(dev->bdf, attr, mode);
+}
+
+/*
+ * Open a sysfs node by BDF.
+ */
+static int open_sysfs_bdf(uint16_t bdf, const char *attr, int mode)
+{
 	char path[AMI_SYSFS_PATH_MAX] = { 0 };
 
-	if (!dev || !attr)
-		return file;
+	if (!attr)
+		return AMI_INVALID_FD;
 	
 	snprintf(
 		path,
 		AMI_SYSFS_PATH_MAX,
 		AMI_DEV_SYSFS_NODE,
-		AMI_PCI_BUS(dev->bdf),
-		AMI_PCI_DEV(dev->bdf),
-		AMI_PCI_FUNC(dev->bdf),
+		AMI_PCI_BUS(bdf),
+		AMI_PCI_DEV(bdf),
+		AMI_PCI_FUNC(bdf),
 		attr
 	);
 
-	return open(path, mode);
+	return open(path, mode);
+}
+
+/*
+ * Get a fresh handle for a specific device.
+ */
+static int get_new_device_handle(ami_device **new_dev, uint16_t bdf, bool with_sensors)
+{
+	int ret = AMI_STATUS_ERROR;
+	ami_device *dev = NULL;
+
+	if (!new_dev || (*new_dev))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	ret =  ami_dev_find_next(
+		&dev,
+		AMI_PCI_BUS(bdf),
+		AMI_PCI_DEV(bdf),
+		AMI_PCI_FUNC(bdf),
+		NULL
+	);
+
+	if (ret == AMI_STATUS_OK) {
+		/* Check if we need to setup sensors. */
+		if (!with_sensors || ((ret = ami_sensor_discover(dev)) == AMI_STATUS_OK))
+			*new_dev = dev;
+	}
+
+	return ret;
+}
+
+/*
+ * Remove a device from the PCI tree.
+ */
+static int pci_remove(uint16_t bdf)
+{
+	int ret = AMI_STATUS_ERROR;
+	int file = AMI_INVALID_FD;
+	char path[AMI_SYSFS_PATH_MAX] = { 0 };
+
+	snprintf(
+		path,
+		AMI_SYSFS_PATH_MAX,
+		SYSFS_PCI_REMOVE,
+		AMI_PCI_BUS(bdf),
+		AMI_PCI_DEV(bdf),
+		AMI_PCI_FUNC(bdf)
+	);
+
+	if ((file = open(path, O_WRONLY)) != AMI_INVALID_FD) {
+		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
+			ret = AMI_STATUS_OK;
+		else
+			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+
+		close(file);
+	} else {
+		ret = AMI_API_ERROR(AMI_ERROR_EBADF);
+	}
+	
+	return ret;
+}
+
+/*
+ * Rescan the PCI bus.
+ */
+static int pci_rescan(void)
+{
+	int ret = AMI_STATUS_ERROR;
+	int file = AMI_INVALID_FD;
+
+	if ((file = open(SYSFS_PCI_RESCAN, O_WRONLY)) != AMI_INVALID_FD) {
+		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
+			ret = AMI_STATUS_OK;
+		else
+			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+
+		close(file);
+	} else {
+		ret = AMI_API_ERROR(AMI_ERROR_EBADF);
+	}
+
+	return ret;
+}
+
+/*
+ * Rescan the secondary bus of a single port.
+ */
+static int pci_rescan_port(const char *port, uint16_t bdf)
+{
+	int ret = AMI_STATUS_ERROR;
+	int file = AMI_INVALID_FD;
+	int domain_len = 0;
+	char path[AMI_SYSFS_PATH_MAX] = { 0 };
+
+	if (!port)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (strncmp(port, PCI_ROOT_BUS_PREFIX, strlen(PCI_ROOT_BUS_PREFIX)) == 0)
+		return pci_rescan();
+
+	/* The port is named `<domain>:<bus>:<dev>.<func>` */
+	domain_len = (int)strcspn(port, ":");
+
+	if ((domain_len == 0) || (port[domain_len] == '\0'))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	snprintf(
+		path,
+		AMI_SYSFS_PATH_MAX,
+		SYSFS_PCI_PORT_RESCAN,
+		port,
+		domain_len,
+		port,
+		AMI_PCI_BUS(bdf)
+	);
+
+	if ((file = open(path, O_WRONLY)) != AMI_INVALID_FD) {
+		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
+			ret = AMI_STATUS_OK;
+		else
+			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+
+		close(file);
+	} else {
+		ret = AMI_API_ERROR(AMI_ERROR_EBADF);
+	}
+
+	return ret;
+}
+
+/*
+ * Read from PCI config space.
+ */
+static int pci_config_read(int config, off_t offset, void *buf, size_t len)
+{
+	ssize_t n = 0;
+
+	errno = 0;
+	if ((lseek(config, offset, SEEK_SET) == AMI_LINUX_STATUS_ERROR) ||
+		((n = read(config, buf, len)) == AMI_LINUX_STATUS_ERROR))
+		return AMI_API_ERROR_M(
+			AMI_ERROR_EIO,
+			"errno %d (%s)",
+			errno,
+			strerror(errno)
+		);
+
+	/* A partial register is as bad as no register. */
+	if (n != (ssize_t)len)
+		return AMI_API_ERROR_M(
+			AMI_ERROR_EIO,
+			"short read of %zd/%zu bytes at 0x%lx",
+			n,
+			len,
+			(unsigned long)offset
+		);
+
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Write to PCI config space.
+ */
+static int pci_config_write(int config, off_t offset, const void *buf, size_t len)
+{
+	errno = 0;
+	if ((lseek(config, offset, SEEK_SET) == AMI_LINUX_STATUS_ERROR) ||
+		(write(config, buf, len) == AMI_LINUX_STATUS_ERROR))
+		return AMI_API_ERROR_M(
+			AMI_ERROR_EIO,
+			"errno %d (%s)",
+			errno,
+			strerror(errno)
+		);
+
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Find the PCI Express capability.
+ */
+static uint8_t pci_find_exp_cap(int config)
+{
+	int i = 0;
+	uint8_t pos = 0;
+	uint8_t hdr[2] = { 0 };  /* capability ID, next pointer */
+
+	if (pci_config_read(config, PCI_CAPABILITY_LIST, &pos, sizeof(pos)) != AMI_STATUS_OK)
+		return 0;
+
+	/* Bound the walk in case of a malformed (looping) list. */
+	for (i = 0; (i < PCI_CAP_LIST_MAX) && pos; i++) {
+		pos &= ~0x3;
+
+		if (pci_config_read(config, pos, hdr, sizeof(hdr)) != AMI_STATUS_OK)
+			return 0;
+
+		if (hdr[0] == PCI_CAP_ID_EXP)
+			return pos;
+
+		pos = hdr[1];
+	}
+
+	return 0;
+}
+
+/*
+ * Sleep for the next backoff period.
+ */
+static bool backoff_wait(struct backoff *b)
+{
+	long delay = 0;
+
+	if (!b || (b->waited_ms >= b->timeout_ms))
+		return false;
+
+	delay = b->delay_ms;
+
+	if (delay > (b->timeout_ms - b->waited_ms))
+		delay = b->timeout_ms - b->waited_ms;
+
+	ami_msleep(delay);
+	b->waited_ms += delay;
+
+	b->delay_ms *= 2;
+	if (b->delay_ms > HOT_RESET_POLL_MAX_MS)
+		b->delay_ms = HOT_RESET_POLL_MAX_MS;
+
+	return true;
+}
+
+/*
+ * Toggle the secondary bus reset bit of a port.
+ */
+static int sbr_toggle(int config)
+{
+	uint16_t bridge_ctl = 0;
+
+	/* Read current BRIDGE_CONTROL */
+	if (pci_config_read(config, PCI_BRIDGE_CONTROL, &bridge_ctl, sizeof(uint16_t)) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	/* Set SBR */
+	bridge_ctl |= PCI_BRIDGE_CTL_BUS_RESET;
+	if (pci_config_write(config, PCI_BRIDGE_CONTROL, &bridge_ctl, sizeof(uint16_t)) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	/* Wait a short while before resetting the SBR */
+	ami_msleep(HOT_RESET_SBR_SET_DELAY_MS);
+
+	/* Reset SBR */
+	bridge_ctl &= ~PCI_BRIDGE_CTL_BUS_RESET;
+	return pci_config_write(config, PCI_BRIDGE_CONTROL, &bridge_ctl, sizeof(uint16_t));
+}
+
+/*
+ * Wait for the link to come back up.
+ */
+static int wait_link_up(int config)
+{
+	struct backoff b = BACKOFF_INIT(HOT_RESET_LINK_TIMEOUT_MS);
+	uint8_t cap = pci_find_exp_cap(config);
+	uint32_t lnkcap = 0;
+	uint16_t lnksta = 0;
+
+	if (!cap)
+		return AMI_STATUS_OK;
+
+	if (pci_config_read(config, cap + PCI_EXP_LNKCAP, &lnkcap, sizeof(lnkcap)) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	/* Nothing to poll - the rescan loop will detect the device instead. */
+	if (!(lnkcap & PCI_EXP_LNKCAP_DLLLARC))
+		return AMI_STATUS_OK;
+
+	do {
+		if (pci_config_read(config, cap + PCI_EXP_LNKSTA, &lnksta, sizeof(lnksta)) != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR;
+
+		if (lnksta & PCI_EXP_LNKSTA_DLLLA)
+			return ami_msleep(HOT_RESET_LINK_SETTLE_MS);
+	} while (backoff_wait(&b));
+
+	return AMI_API_ERROR_M(AMI_ERROR_ENODEV, "link did not come up");
+}
+
+/*
+ * Read the device state by BDF.
+ */
+static bool read_dev_state(uint16_t bdf, char buf[AMI_DEV_STATE_SIZE])
+{
+	bool ret = false;
+	int file = AMI_INVALID_FD;
+	char raw_buf[AMI_SYSFS_STR_MAX] = { 0 };
+
+	if (!buf)
+		return false;
+
+	file = open_sysfs_bdf(bdf, SYSFS_DEV_STATE, O_RDONLY);
+
+	if (file != AMI_INVALID_FD) {
+		if (read(file, raw_buf, AMI_SYSFS_STR_MAX - 1) != AMI_LINUX_STATUS_ERROR) {
+			raw_buf[strcspn(raw_buf, "\r\n")] = 0;
+			memset(buf, 0x00, AMI_DEV_STATE_SIZE);
+			strncpy(buf, raw_buf, AMI_DEV_STATE_SIZE - 1);
+			ret = true;
+		}
+
+		close(file);
+	}
+
+	return ret;
+}
+
+/*
+ * Re-read an open device state attribute.
+ */
+static int read_dev_state_fd(int file, char buf[AMI_DEV_STATE_SIZE])
+{
+	char raw_buf[AMI_SYSFS_STR_MAX] = { 0 };
+
+	errno = 0;
+	if ((lseek(file, 0, SEEK_SET) == AMI_LINUX_STATUS_ERROR) ||
+		(read(file, raw_buf, AMI_SYSFS_STR_MAX - 1) == AMI_LINUX_STATUS_ERROR))
+		return AMI_API_ERROR_M(
+			AMI_ERROR_ENODEV,
+			"could not read device state, errno %d (%s)",
+			errno,
+			strerror(errno)
+		);
+
+	raw_buf[strcspn(raw_buf, "\r\n")] = 0;
+	memset(buf, 0x00, AMI_DEV_STATE_SIZE);
+	strncpy(buf, raw_buf, AMI_DEV_STATE_SIZE - 1);
+	return AMI_STATUS_OK;
+}
+
+/*
+ * Wait for a device to come back after a reset.
+ */
+static int wait_dev_ready(const char *port, uint16_t bdf)
+{
+	struct backoff b = BACKOFF_INIT(HOT_RESET_READY_TIMEOUT_MS);
+	char state[AMI_DEV_STATE_SIZE] = { 0 };
+
+	do {
+		/* Only rescan while the device has not been re-attached. */
+		if (!read_dev_state(bdf, state) && (pci_rescan_port(port, bdf) != AMI_STATUS_OK))
+			return AMI_STATUS_ERROR;
+
+		if (read_dev_state(bdf, state) && (strcmp(state, DEV_STATE_INIT_STR) != 0))
+			return AMI_STATUS_OK;
+	} while (backoff_wait(&b));
+
+	return AMI_API_ERROR_M(
+		AMI_ERROR_ENODEV,
+		"device " AMI_BDF_FORMAT " not ready",
+		AMI_PCI_BUS(bdf),
+		AMI_PCI_DEV(bdf),
+		AMI_PCI_FUNC(bdf)
+	);
+}
+
+/*
+ * Group devices by upstream port.
+ */
+static int build_reset_groups(ami_device **devs, int num_devs, bool hot_reset,
+	struct reset_target *targets, struct reset_group *groups, int *num_groups)
+{
+	int i = 0, j = 0;
+	char port[AMI_DEV_PCI_PORT_SIZE] = { 0 };
+	char config_path[AMI_SYSFS_PATH_MAX] = { 0 };
+
+	if (!devs || !targets || !groups || !num_groups)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	*num_groups = 0;
+
+	for (i = 0; i < num_devs; i++) {
+		if (!devs[i])
+			return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+		/* The same device must not be given twice. */
+		for (j = 0; j < i; j++)
+			if (targets[j].bdf == devs[i]->bdf)
+				return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+		memset(port, 0x00, AMI_DEV_PCI_PORT_SIZE);
+		if (ami_dev_get_pci_port(devs[i], port) != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR;
+
+		for (j = 0; j < *num_groups; j++)
+			if (strcmp(groups[j].port, port) == 0)
+				break;
+
+		if (j == *num_groups) {
+			groups[j].id = j;
+			groups[j].config = AMI_INVALID_FD;
+			groups[j].ret = AMI_STATUS_OK;
+			groups[j].targets = targets;
+			groups[j].num_targets = num_devs;
+			strncpy(groups[j].port, port, AMI_DEV_PCI_PORT_SIZE - 1);
+			(*num_groups)++;
+
+			if (hot_reset) {
+				snprintf(
+					config_path,
+					AMI_SYSFS_PATH_MAX,
+					SYSFS_PCI_CONFIG,
+					port
+				);
+
+				groups[j].config = open(config_path, O_RDWR | O_SYNC);
+
+				if (groups[j].config == AMI_INVALID_FD)
+					return AMI_API_ERROR(AMI_ERROR_EBADF);
+			}
+		}
+
+		targets[i].dev = &devs[i];
+		targets[i].bdf = devs[i]->bdf;
+		targets[i].has_sensors = (devs[i]->sensors != NULL);
+		targets[i].group = j;
+		targets[i].ret = AMI_STATUS_ERROR;
+	}
+
+	return AMI_STATUS_OK;
 }
 
 /*
- * Get a fresh handle for a specific device.
+ * Wait for the devices in a group.
  */
-static int get_new_device_handle(ami_device **new_dev, uint16_t bdf, bool with_sensors)
+static void *reset_group_worker(void *data)
 {
+	struct reset_group *group = NULL;
+	struct reset_target *target = NULL;
 	int ret = AMI_STATUS_ERROR;
-	ami_device *dev = NULL;
+	int i = 0;
 
-	if (!new_dev || (*new_dev))
-		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+	if (!data)
+		return NULL;
 
-	ret =  ami_dev_find_next(
-		&dev,
-		AMI_PCI_BUS(bdf),
-		AMI_PCI_DEV(bdf),
-		AMI_PCI_FUNC(bdf),
-		NULL
-	);
+	group = (struct reset_group*)data;
+	ret = group->ret;
 
-	if (ret == AMI_STATUS_OK) {
-		/* Check if we need to setup sensors. */
-		if (!with_sensors || ((ret = ami_sensor_discover(dev)) == AMI_STATUS_OK))
-			*new_dev = dev;
+	if ((ret == AMI_STATUS_OK) && (group->config != AMI_INVALID_FD))
+		ret = wait_link_up(group->config);
+
+	/*
+	 * Even if the reset failed, the removed devices must be brought back,
+	 * so every device is waited for regardless of `ret`.
+	 */
+	for (i = 0; i < group->num_targets; i++) {
+		target = &group->targets[i];
+
+		if (target->group != group->id)
+			continue;
+
+		target->ret = wait_dev_ready(group->port, target->bdf);
+
+		if (target->ret == AMI_STATUS_OK)
+			target->ret = get_new_device_handle(
+				target->dev,
+				target->bdf,
+				target->has_sensors
+			);
+
+		if (ret != AMI_STATUS_OK)
+			target->ret = ret;
+
+		if (target->ret != AMI_STATUS_OK)
+			target->err = ami_last_error;
 	}
 
-	return ret;
+	return NULL;
 }
 
 /*
- * Remove a device from the PCI tree.
+ * Reset or reload a batch of devices.
  */
-static int pci_remove(uint16_t bdf)
+static int reset_batch(ami_device **devs, int num_devs, bool hot_reset)
 {
 	int ret = AMI_STATUS_ERROR;
-	int file = AMI_INVALID_FD;
-	char path[AMI_SYSFS_PATH_MAX] = { 0 };
+	int i = 0;
+	int num_groups = 0;
+	struct reset_target *targets = NULL;
+	struct reset_group *groups = NULL;
 
-	snprintf(
-		path,
-		AMI_SYSFS_PATH_MAX,
-		SYSFS_PCI_REMOVE,
-		AMI_PCI_BUS(bdf),
-		AMI_PCI_DEV(bdf),
-		AMI_PCI_FUNC(bdf)
-	);
+	if (!devs || (num_devs <= 0))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	if ((file = open(path, O_WRONLY)) != AMI_INVALID_FD) {
-		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
-			ret = AMI_STATUS_OK;
-		else
-			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+	targets = (struct reset_target*)calloc(num_devs, sizeof(struct reset_target));
+	groups = (struct reset_group*)calloc(num_devs, sizeof(struct reset_group));
 
-		close(file);
-	} else {
-		ret = AMI_API_ERROR(AMI_ERROR_EBADF);
+	if (!targets || !groups) {
+		ret = AMI_API_ERROR(AMI_ERROR_ENOMEM);
+		goto free_batch;
 	}
-	
-	return ret;
-}
 
-/*
- * Rescan the PCI bus.
- */
-static int pci_rescan(void)
-{
-	int ret = AMI_STATUS_ERROR;
-	int file = AMI_INVALID_FD;
+	ret = build_reset_groups(devs, num_devs, hot_reset, targets, groups, &num_groups);
 
-	if ((file = open(SYSFS_PCI_RESCAN, O_WRONLY)) != AMI_INVALID_FD) {
-		if (write(file, SYSFS_ENABLE, strlen(SYSFS_ENABLE)) != AMI_LINUX_STATUS_ERROR)
-			ret = AMI_STATUS_OK;
+	if (ret)
+		goto free_batch;
+
+	/* Set PMC GPIO on every device before any of them are removed */
+	if (hot_reset) {
+		for (i = 0; i < num_devs; i++) {
+			ret = ami_mem_bar_write(
+				devs[i], HOT_RESET_GPIO_BAR, HOT_RESET_GPIO_OFFSET, PCI_ENABLE
+			);
+
+			if (ret)
+				break;
+		}
+
+		/*
+		 * No device has been removed yet - clear the GPIO again on the
+		 * devices already set, so none of them reboots on its own.
+		 */
+		if (ret) {
+			while (--i >= 0)
+				ami_mem_bar_write(
+					devs[i], HOT_RESET_GPIO_BAR, HOT_RESET_GPIO_OFFSET, PCI_DISABLE
+				);
+
+			goto free_batch;
+		}
+	}
+
+	/* From here on, every group must be waited for to restore the handles */
+	for (i = 0; i < num_devs; i++) {
+		ami_dev_delete(targets[i].dev);
+
+		if (pci_remove(targets[i].bdf) != AMI_STATUS_OK)
+			groups[targets[i].group].ret = AMI_STATUS_ERROR;
+	}
+
+	if (hot_reset) {
+		/* See `ami_dev_hot_reset` */
+		ami_msleep(HOT_RESET_GPIO_SET_DELAY_MS);
+
+		/* Never reset a port while one of its devices is still attached */
+		for (i = 0; i < num_groups; i++)
+			if (groups[i].ret == AMI_STATUS_OK)
+				groups[i].ret = sbr_toggle(groups[i].config);
+	}
+
+	/* Wait for all ports in parallel */
+	for (i = 0; i < num_groups; i++) {
+		if (pthread_create(&groups[i].thread, NULL, reset_group_worker, &groups[i]) == 0)
+			groups[i].thread_created = true;
 		else
-			ret = AMI_API_ERROR(AMI_ERROR_EIO);
+			reset_group_worker(&groups[i]);
+	}
 
-		close(file);
-	} else {
-		ret = AMI_API_ERROR(AMI_ERROR_EBADF);
+	for (i = 0; i < num_groups; i++)
+		if (groups[i].thread_created)
+			pthread_join(groups[i].thread, NULL);
+
+	ret = AMI_STATUS_OK;
+
+	for (i = 0; i < num_devs; i++) {
+		if (targets[i].ret == AMI_STATUS_OK)
+			continue;
+
+		/* Carry the worker's error over to the calling thread */
+		if ((ret == AMI_STATUS_OK) && (targets[i].err != AMI_ERROR_NONE))
+			ret = AMI_API_ERROR_M(
+				targets[i].err,
+				"device " AMI_BDF_FORMAT " failed to come back",
+				AMI_PCI_BUS(targets[i].bdf),
+				AMI_PCI_DEV(targets[i].bdf),
+				AMI_PCI_FUNC(targets[i].bdf)
+			);
+		else
+			ret = AMI_STATUS_ERROR;
+	}
+
+free_batch:
+	if (groups) {
+		for (i = 0; i < num_groups; i++)
+			if (groups[i].config != AMI_INVALID_FD)
+				close(groups[i].config);
+
+		free(groups);
 	}
 
+	if (targets)
+		free(targets);
+
 	return ret;
 }
 
@@ -550,6 +1324,7 @@ void ami_dev_delete(ami_device **dev)
 			(*dev)->num_sensors = 0;
 			(*dev)->num_total_sensors = 0;
 			(*dev)->sensors = NULL;
+			(*dev)->last_sensor = NULL;
 		}
 
 		/* Cleanup device. */
@@ -580,6 +1355,7 @@ int ami_dev_pci_reload(ami_device **dev, const char *bdf)
 	int ret = AMI_STATUS_ERROR;
 	uint16_t bdf_num = 0;
 	bool has_sensors = false;
+	char port[AMI_DEV_PCI_PORT_SIZE] = { 0 };
 
 	/* Only `bdf` or `dev` may be specified (not both); *dev must be non-NULL */
 	if ((bdf && dev) || (!dev && !bdf) || (dev && (!(*dev))))
@@ -588,13 +1364,25 @@ int ami_dev_pci_reload(ami_device **dev, const char *bdf)
 	if (dev) {
 		bdf_num = (*dev)->bdf;
 		has_sensors = ((*dev)->sensors != NULL);
+
+		/* Need the port so only the bus below it is rescanned. */
+		if (ami_dev_get_pci_port(*dev, port) != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR;
+
 		ami_dev_delete(dev);
 	} else {
+		/* The port lookup only needs the BDF. */
+		ami_device raw = { 0 };
+
 		bdf_num = ami_parse_bdf(bdf);
+		raw.bdf = bdf_num;
+
+		if (ami_dev_get_pci_port(&raw, port) != AMI_STATUS_OK)
+			return AMI_STATUS_ERROR;
 	}
 
 	if (pci_remove(bdf_num) == AMI_STATUS_OK) {
-		if ((ret = pci_rescan()) == AMI_STATUS_OK) {
+		if ((ret = pci_rescan_port(port, bdf_num)) == AMI_STATUS_OK) {
 			/* Check if we need to update the device handle. */
 			if (dev)
 				ret = get_new_device_handle(
@@ -617,7 +1405,6 @@ int ami_dev_hot_reset(ami_device **dev)
 	char config_path[AMI_SYSFS_PATH_MAX] = { 0 };
 	int config = AMI_INVALID_FD;
 	char port[AMI_DEV_PCI_PORT_SIZE] = { 0 };
-	uint16_t bridge_ctl = 0;
 
 	/* Store data so we can restore the handle later. */
 	uint16_t bdf = 0;
@@ -667,89 +1454,26 @@ int ami_dev_hot_reset(ami_device **dev)
 	 */
 	ami_msleep(HOT_RESET_GPIO_SET_DELAY_MS);
 
-	/* Toggle SBR */
-	/* Read current BRIDGE_CONTROL */
-	errno = 0;
-	if (lseek(config, PCI_BRIDGE_CONTROL, SEEK_SET) != AMI_LINUX_STATUS_ERROR) {
-		errno = 0;
-		if (read(config, &bridge_ctl, sizeof(uint16_t)) == AMI_LINUX_STATUS_ERROR) {
-			ret = AMI_API_ERROR_M(
-				AMI_ERROR_EIO,
-				"errno %d (%s)",
-				errno,
-				strerror(errno)
-			);
-			goto close_config;
-		}
-	} else {
-		ret = AMI_API_ERROR_M(
-			AMI_ERROR_EIO,
-			"errno %d (%s)",
-			errno,
-			strerror(errno)
-		);
-		goto close_config;
-	}
-
-	/* Set SBR - PDI will reload here */
-	errno = 0;
-	bridge_ctl |= PCI_BRIDGE_CTL_BUS_RESET;
-	if (lseek(config, PCI_BRIDGE_CONTROL, SEEK_SET) != AMI_LINUX_STATUS_ERROR) {
-		errno = 0;
-		if (write(config, &bridge_ctl, sizeof(uint16_t)) == AMI_LINUX_STATUS_ERROR) {
-			ret = AMI_API_ERROR_M(
-				AMI_ERROR_EIO,
-				"errno %d (%s)",
-				errno,
-				strerror(errno)
-			);
-			goto close_config;
-		}
-	} else {
-		ret = AMI_API_ERROR_M(
-			AMI_ERROR_EIO,
-			"errno %d (%s)",
-			errno,
-			strerror(errno)
-		);
-		goto close_config;
-	}
-
-	/* Wait a short while before resetting the SBR */
-	ami_msleep(HOT_RESET_SBR_SET_DELAY_MS);
+	/* Toggle SBR - PDI will reload here */
+	ret = sbr_toggle(config);
 
-	/* Reset SBR */
-	errno = 0;
-	bridge_ctl &= ~PCI_BRIDGE_CTL_BUS_RESET;
-	if (lseek(config, PCI_BRIDGE_CONTROL, SEEK_SET) != AMI_LINUX_STATUS_ERROR) {
-		errno = 0 ;
-		if (write(config, &bridge_ctl, sizeof(uint16_t)) == AMI_LINUX_STATUS_ERROR) {
-			ret = AMI_API_ERROR_M(
-				AMI_ERROR_EIO,
-				"errno %d (%s)",
-				errno,
-				strerror(errno)
-			);
-			goto close_config;
-		}
-	} else {
-		ret = AMI_API_ERROR_M(
-			AMI_ERROR_EIO,
-			"errno %d (%s)",
-			errno,
-			strerror(errno)
-		);
+	if (ret)
 		goto close_config;
-	}
 
-	/* Give enough time for the PDI to initialize */
-	ami_msleep(HOT_RESET_RESCAN_DELAY_MS);
+	/* Wait for the link to retrain while the PDI reloads */
+	ret = wait_link_up(config);
 
 	/* Finished with the config */
 	close(config);
 
-	/* Rescan bus */
-	ret = pci_rescan();
+	if (ret)
+		return ret;
+
+	/* Rescan only below our port until the device is back */
+	ret = wait_dev_ready(port, bdf);
+
+	if (ret)
+		return ret;
 
 	/* Update handle */
 	return get_new_device_handle(dev, bdf, has_sensors);
@@ -759,6 +1483,22 @@ int ami_dev_hot_reset(ami_device **dev)
 	return ret;
 }
 
+/*
+ * Perform a hot reset on a batch of devices.
+ */
+int ami_dev_hot_reset_batch(ami_device **devs, int num_devs)
+{
+	return reset_batch(devs, num_devs, true);
+}
+
+/*
+ * Remove and rescan a batch of devices.
+ */
+int ami_dev_pci_reload_batch(ami_device **devs, int num_devs)
+{
+	return reset_batch(devs, num_devs, false);
+}
+
 /*
  * Set the AMC debug verbosity.
  */
@@ -785,6 +1525,40 @@ int ami_dev_set_amc_debug_level(ami_device *dev, enum ami_amc_debug_level level)
 	return ret;
 }
 
+/*
+ * Measure the host to AMC command round trip.
+ */
+int ami_dev_echo(ami_device *dev, uint32_t size, uint32_t count,
+	struct ami_echo_stats *stats)
+{
+	struct ami_ioc_echo_payload payload = { 0 };
+
+	if (!dev || !stats || (count == 0))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (ami_open_cdev(dev) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	payload.size = size;
+	payload.count = count;
+
+	if (ioctl(dev->cdev, AMI_IOC_ECHO, &payload) == AMI_LINUX_STATUS_ERROR)
+		return AMI_API_ERROR_M(
+			AMI_ERROR_EIO,
+			"errno %d (%s)",
+			errno,
+			strerror(errno)
+		);
+
+	stats->min_ns = payload.min_ns;
+	stats->p50_ns = payload.p50_ns;
+	stats->p99_ns = payload.p99_ns;
+	stats->max_ns = payload.max_ns;
+	stats->total_ns = payload.total_ns;
+
+	return AMI_STATUS_OK;
+}
+
 /*
  * Read the logic uuid of a device.
  */
@@ -910,6 +1684,41 @@ int ami_dev_get_pci_link_width(ami_device *dev, uint8_t *current, uint8_t *max)
 	return ret;
 }
 
+/*
+ * Get the PCIe link health.
+ */
+int ami_dev_get_pcie_health(ami_device *dev, struct ami_pcie_health *health)
+{
+	char raw_buf[AMI_SYSFS_STR_MAX] = { 0 };
+	struct ami_pcie_health h = { 0 };
+
+	if (!dev || !health)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	if (ami_read_sysfs(dev, SYSFS_PCIE_HEALTH, raw_buf) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	if (sscanf(raw_buf, PCIE_HEALTH_ATTR_FMT,
+			&h.flags,
+			&h.speed_current,
+			&h.speed_max,
+			&h.width_current,
+			&h.width_max,
+			&h.downgrades,
+			&h.events,
+			&h.cor_errors,
+			&h.rx_errors,
+			&h.bad_tlp,
+			&h.bad_dllp,
+			&h.replays,
+			&h.samples,
+			&h.interval_ms) != PCIE_HEALTH_ATTR_FIELDS)
+		return AMI_API_ERROR(AMI_ERROR_ERET);
+
+	*health = h;
+	return AMI_STATUS_OK;
+}
+
 /*
  * Get the PCI vendor.
  */
@@ -1026,6 +1835,85 @@ int ami_dev_get_state(ami_device *dev, char buf[AMI_DEV_STATE_SIZE])
 	return ret;
 }
 
+/*
+ * Wait for a device state transition.
+ */
+int ami_dev_wait_state(ami_device *dev, const char *state, int timeout_ms,
+	char buf[AMI_DEV_STATE_SIZE])
+{
+	int ret = AMI_STATUS_ERROR;
+	int file = AMI_INVALID_FD;
+	int poll_timeout = -1;
+	long elapsed_ms = 0;
+	struct pollfd fds = { 0 };
+	struct timespec start = { 0 }, now = { 0 };
+	char initial[AMI_DEV_STATE_SIZE] = { 0 };
+	char current[AMI_DEV_STATE_SIZE] = { 0 };
+
+	if (!dev)
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	file = open_sysfs(dev, SYSFS_DEV_STATE, O_RDONLY);
+
+	if (file == AMI_INVALID_FD)
+		return AMI_API_ERROR(AMI_ERROR_EBADF);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	fds.fd = file;
+	fds.events = POLLPRI | POLLERR;
+
+	/* Initial read - this also arms the notification for the first poll. */
+	if (read_dev_state_fd(file, initial) != AMI_STATUS_OK)
+		goto done;
+
+	strcpy(current, initial);
+
+	while (state ? (strcmp(current, state) != 0) : (strcmp(current, initial) == 0)) {
+		if (timeout_ms >= 0) {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			elapsed_ms = ((now.tv_sec - start.tv_sec) * 1000) +
+				((now.tv_nsec - start.tv_nsec) / 1000000);
+
+			if (elapsed_ms >= timeout_ms) {
+				ret = AMI_API_ERROR_M(
+					AMI_ERROR_ETIMEDOUT,
+					"device state is %s",
+					current
+				);
+				goto done;
+			}
+
+			poll_timeout = (int)(timeout_ms - elapsed_ms);
+		}
+
+		errno = 0;
+		if ((poll(&fds, 1, poll_timeout) == AMI_LINUX_STATUS_ERROR) && (errno != EINTR)) {
+			ret = AMI_API_ERROR_M(
+				AMI_ERROR_EIO,
+				"errno %d (%s)",
+				errno,
+				strerror(errno)
+			);
+			goto done;
+		}
+
+		/* Always re-read - a wake up is not guaranteed to be a real change. */
+		if (read_dev_state_fd(file, current) != AMI_STATUS_OK)
+			goto done;
+	}
+
+	if (buf) {
+		memset(buf, 0x00, AMI_DEV_STATE_SIZE);
+		strncpy(buf, current, AMI_DEV_STATE_SIZE - 1);
+	}
+
+	ret = AMI_STATUS_OK;
+
+done:
+	close(file);
+	return ret;
+}
+
 /*
  * Get the device name.
  */
@@ -45,7 +45,12 @@
  * @num_sensors: number of suported sensors (eg. vccint, 12v_pex, etc...)
  * @num_total_sensors: total number of sensors  (e.g. vccint temp, vccint power, etc...)
  * @sensors: list of supported sensors (head)
- * 
+ * @last_sensor: last sensor found by name (lookup cache)
+ * @sensor_refresh_set: an update interval was set on this handle
+ *
+ * Once `sensor_refresh_set` is true, sensor values are always read through
+ * the character device so that the interval set on it is honoured.
+ *
  * If `cap_override` is set to true, all IOCTL's (and any other relevant API)
  * issued using this device handle will bypass any permission checks
  * and execute code that would, normally, only be reachable with root/sudo!
@@ -59,6 +64,8 @@ struct ami_device {
 	int                 num_sensors;
 	int                 num_total_sensors;
 	struct ami_sensor  *sensors;
+	struct ami_sensor  *last_sensor;
+	bool                sensor_refresh_set;
 };
 
 /*****************************************************************************/
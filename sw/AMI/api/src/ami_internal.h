@@ -24,6 +24,9 @@
 
 #define AMI_BASE_10 (10)
 
+/* Maximum length of the context recorded with an error. */
+#define AMI_ERROR_CTXT_STR_MAX (256)
+
 /*
  * Utility macro to set the last error and return AMI_STATUS_ERROR.
  * We ignore the return value of `ami_set_last_error` and ALWAYS return
@@ -52,6 +55,7 @@
  * @AMI_ERROR_ERET: error return code from function call
  * @AMI_ERROR_ENODEV: no such device
  * @AMI_ERROR_EVER: version mismatch
+ * @AMI_ERROR_ETIMEDOUT: operation timed out
  */
 enum ami_error {
 	AMI_ERROR_NONE = 0,
@@ -63,6 +67,7 @@ enum ami_error {
 	AMI_ERROR_ERET,
 	AMI_ERROR_ENODEV,
 	AMI_ERROR_EVER,
+	AMI_ERROR_ETIMEDOUT,
 };
 
 /**
@@ -88,11 +93,10 @@ struct ami_event_data {
 /*****************************************************************************/
 
 /*
- * Global variable to keep track of the last API error.
- * Declared volatile to mimic the behaviour of errno, so it can be used
- * from signal handlers or separate threads.
+ * Last API error of the calling thread. Thread local to mimic the behaviour
+ * of errno, so concurrent callers never see each other's errors.
  */
-extern volatile enum ami_error ami_last_error;
+extern __thread enum ami_error ami_last_error;
 
 /*****************************************************************************/
 /* Private API function definitions                                          */
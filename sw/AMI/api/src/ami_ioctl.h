@@ -26,6 +26,18 @@
  */
 
 #define AMI_IOC_FPT_UPDATE_MAGIC	(0xAAAAAAAA)
+
+/*
+ * PDI transfer codecs. With a codec other than NONE the download buffer is a
+ * sequence of records, one per PDI chunk, each a 32-bit header followed by the
+ * chunk data. The header holds the record length; the top bit is set if the
+ * data is encoded and clear if the chunk was stored as-is.
+ */
+#define AMI_IOC_PDI_CODEC_NONE		(0)
+#define AMI_IOC_PDI_CODEC_RLE		(1)
+#define AMI_IOC_PDI_CODEC_MAX		(2)
+#define AMI_IOC_PDI_RECORD_PACKED	(0x80000000)
+#define AMI_IOC_PDI_RECORD_LEN(hdr)	((hdr) & ~AMI_IOC_PDI_RECORD_PACKED)
 #define AMI_IOC_SENSOR_STATUS_LEN	(40)
 
 /**
@@ -63,6 +75,22 @@ struct ami_ioc_data_payload {
 	int            efd;
 };
 
+/**
+ * struct ami_ioc_pdi_codec_payload - payload struct for encoded PDI downloads
+ * @data: Download request as for AMI_IOC_DOWNLOAD_PDI; `size` is the size of
+ *     the encoded buffer.
+ * @codec: Transfer codec of the download buffer (`AMI_IOC_PDI_CODEC_*`).
+ * @raw_size: Size of the image once decoded.
+ *
+ * This is a separate IOCTL so that the layout of `ami_ioc_data_payload`, and
+ * with it the ABI of the existing IOCTL's, stays unchanged.
+ */
+struct ami_ioc_pdi_codec_payload {
+	struct ami_ioc_data_payload  data;
+	uint8_t                      codec;
+	uint32_t                     raw_size;
+};
+
 /**
  * struct ami_ioc_bar_data - payload struct for PCI BAR-related IOCTL calls
  * @num: Number of BAR registers (to read or write).
@@ -188,6 +216,26 @@ struct ami_ioc_module_payload {
 	uint8_t       offset;
 };
 
+/**
+ * struct ami_ioc_echo_payload - payload struct for the GCQ echo benchmark
+ * @size: Number of payload bytes carried per echo.
+ * @count: Number of echoes to run.
+ * @min_ns: Fastest round trip. Populated by the driver.
+ * @p50_ns: Median round trip. Populated by the driver.
+ * @p99_ns: 99th percentile round trip. Populated by the driver.
+ * @max_ns: Slowest round trip. Populated by the driver.
+ * @total_ns: Sum of all round trips. Populated by the driver.
+ */
+struct ami_ioc_echo_payload {
+	uint32_t size;
+	uint32_t count;
+	uint64_t min_ns;
+	uint64_t p50_ns;
+	uint64_t p99_ns;
+	uint64_t max_ns;
+	uint64_t total_ns;
+};
+
 /**
  * enum ami_ioc_app_setup - accepted values for the AMI_IOC_APP_SETUP IOCTL
  * @IOC_APP_SETUP_REGISTER: Register a process with a device.
@@ -214,7 +262,10 @@ enum ami_ioc_app_setup {
 #define AMI_IOC_READ_MODULE		_IOW(AMI_IOC_MAGIC, 12, struct ami_ioc_module_payload*)
 #define AMI_IOC_WRITE_MODULE		_IOW(AMI_IOC_MAGIC, 13, struct ami_ioc_module_payload*)
 #define AMI_IOC_DEBUG_VERBOSITY		_IOW(AMI_IOC_MAGIC, 14, uint8_t)
-#define AMI_IOC_MAX			(15)
+#define AMI_IOC_ECHO			_IOWR(AMI_IOC_MAGIC, 15, struct ami_ioc_echo_payload*)
+#define AMI_IOC_DOWNLOAD_PDI_CODEC	_IOW(AMI_IOC_MAGIC, 16, struct ami_ioc_pdi_codec_payload*)
+#define AMI_IOC_GET_SENSOR_REFRESH	_IOR(AMI_IOC_MAGIC, 17, uint16_t*)
+#define AMI_IOC_MAX			(18)
 
 
 #endif  /* AMI_IOCTL_H */
@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <string.h>
+#include <stdbool.h>
 
 /* Public API includes */
 #include "ami_program.h"
@@ -25,6 +26,25 @@
 #include "ami_internal.h"
 #include "ami_device_internal.h"
 
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+/*
+ * RLE transfer codec. A control byte below `RLE_RUN_FLAG` is followed by
+ * (control + 1) literal bytes. Otherwise the low 7 bits and the next byte
+ * hold a 15 bit repeat count (biased by `RLE_MIN_RUN`), followed by the
+ * byte to repeat. Every chunk is encoded on its own so the AMC can expand
+ * chunks in any order.
+ */
+#define PDI_CHUNK_BYTES		(PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER)
+#define PDI_RECORD_HDR_SIZE	(sizeof(uint32_t))
+#define RLE_RUN_FLAG		(0x80)
+#define RLE_MAX_LITERAL		(128)
+#define RLE_MIN_RUN		(4)
+#define RLE_MAX_RUN		(0x7FFF + RLE_MIN_RUN)
+#define RLE_RUN_TOKEN_SIZE	(3)
+
 /*****************************************************************************/
 /* Private functions                                                         */
 /*****************************************************************************/
@@ -101,23 +121,150 @@ static int read_file(const char *fname, uint8_t **buf, uint32_t *size)
 	return ret;
 }
 
+/**
+ * rle_put_literals() - Append a literal stretch to an RLE stream.
+ * @src: Literal bytes.
+ * @len: Number of literal bytes.
+ * @dst: Output stream.
+ * @pos: Current output position (updated).
+ * @cap: Output capacity.
+ *
+ * Return: true if the literals fit in the output.
+ */
+static bool rle_put_literals(const uint8_t *src, uint32_t len, uint8_t *dst,
+	uint32_t *pos, uint32_t cap)
+{
+	while (len) {
+		uint32_t n = (len > RLE_MAX_LITERAL) ? (RLE_MAX_LITERAL) : (len);
+
+		if ((cap - *pos) < (n + 1))
+			return false;
+
+		dst[(*pos)++] = (uint8_t)(n - 1);
+		memcpy(&dst[*pos], src, n);
+		*pos += n;
+		src += n;
+		len -= n;
+	}
+
+	return true;
+}
+
+/**
+ * rle_encode() - Run-length encode a single chunk.
+ * @src: Chunk data.
+ * @len: Chunk length.
+ * @dst: Output buffer.
+ * @cap: Output capacity.
+ *
+ * Return: Encoded length, or 0 if the result would not fit in `cap`.
+ */
+static uint32_t rle_encode(const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t cap)
+{
+	uint32_t pos = 0;
+	uint32_t i = 0;
+	uint32_t lit_start = 0;
+
+	while (i < len) {
+		uint32_t run = 1;
+
+		while (((i + run) < len) && (src[i + run] == src[i]) && (run < RLE_MAX_RUN))
+			run++;
+
+		if (run >= RLE_MIN_RUN) {
+			if (!rle_put_literals(&src[lit_start], i - lit_start, dst, &pos, cap) ||
+			    ((cap - pos) < RLE_RUN_TOKEN_SIZE))
+				return 0;
+
+			dst[pos++] = (uint8_t)(RLE_RUN_FLAG | ((run - RLE_MIN_RUN) >> 8));
+			dst[pos++] = (uint8_t)(run - RLE_MIN_RUN);
+			dst[pos++] = src[i];
+			lit_start = i + run;
+		}
+
+		i += run;
+	}
+
+	if (!rle_put_literals(&src[lit_start], len - lit_start, dst, &pos, cap))
+		return 0;
+
+	return pos;
+}
+
+/**
+ * compress_image() - Build the record stream for a compressed download.
+ * @img: Image data.
+ * @img_size: Image size.
+ * @buf: Pointer to the allocated stream.
+ * @size: Pointer to variable which will hold the stream size.
+ *
+ * Each PDI chunk becomes one record; chunks which do not get smaller are
+ * stored as-is. The caller is responsible for freeing `buf`.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int compress_image(const uint8_t *img, uint32_t img_size, uint8_t **buf, uint32_t *size)
+{
+	uint32_t num_chunks = (img_size + (PDI_CHUNK_BYTES - 1)) / PDI_CHUNK_BYTES;
+	uint32_t offset = 0;
+	uint32_t pos = 0;
+	uint8_t *stream = NULL;
+
+	stream = (uint8_t*)malloc(img_size + (num_chunks * PDI_RECORD_HDR_SIZE));
+
+	if (!stream)
+		return AMI_API_ERROR(AMI_ERROR_ENOMEM);
+
+	while (offset < img_size) {
+		uint32_t raw_len = img_size - offset;
+		uint32_t hdr = 0;
+		uint32_t len = 0;
+
+		if (raw_len > PDI_CHUNK_BYTES)
+			raw_len = PDI_CHUNK_BYTES;
+
+		len = rle_encode(&img[offset], raw_len, &stream[pos + PDI_RECORD_HDR_SIZE], raw_len - 1);
+
+		if (len) {
+			hdr = len | AMI_IOC_PDI_RECORD_PACKED;
+		} else {
+			len = raw_len;
+			hdr = raw_len;
+			memcpy(&stream[pos + PDI_RECORD_HDR_SIZE], &img[offset], raw_len);
+		}
+
+		memcpy(&stream[pos], &hdr, PDI_RECORD_HDR_SIZE);
+		pos += PDI_RECORD_HDR_SIZE + len;
+		offset += raw_len;
+	}
+
+	*buf = stream;
+	*size = pos;
+	return AMI_STATUS_OK;
+}
+
 /**
  * do_image_download() - Perform an image download operation.
  * @dev: Device handle.
  * @path: Path to image file.
  * @boot_device: Target boot device.
  * @partition: Partition number to program.
+ * @codec: Transfer codec.
  * @progress_handler: Progress handler callback (optional).
+ * @transfer: Transfer summary (optional).
  *
  * Return: AMI_STATUS_OK or AMI_STATUS_ERROR
  */
 static int do_image_download(ami_device *dev, const char *path, uint8_t boot_device, uint32_t partition,
-	ami_event_handler progress_handler)
+	enum ami_pdi_codec codec, ami_event_handler progress_handler, struct ami_pdi_transfer *transfer)
 {
 	uint8_t *img_data = NULL;
 	uint32_t img_size = 0;
+	uint8_t *xfer_data = NULL;
+	uint32_t xfer_size = 0;
 	int ret = AMI_STATUS_ERROR;
-	struct ami_ioc_data_payload payload = { 0 };
+	struct ami_ioc_pdi_codec_payload codec_payload = { 0 };
+	struct ami_ioc_data_payload *payload = &codec_payload.data;
 	
 	/* For progress tracking */
 	struct ami_event_data evt_data = { 0 };
@@ -130,22 +277,50 @@ static int do_image_download(ami_device *dev, const char *path, uint8_t boot_dev
 		return AMI_STATUS_ERROR;  /* last error is set by ami_open_cdev */
 	
 	if (read_file(path, &img_data, &img_size) == AMI_STATUS_OK) {
-		payload.size = img_size;
-		payload.addr = (unsigned long)(&img_data[0]);
-		payload.cap_override = dev->cap_override;
-		payload.boot_device = boot_device;
-		payload.partition = partition;
-		payload.efd = AMI_INVALID_FD;
+		payload->size = img_size;
+		payload->addr = (unsigned long)(&img_data[0]);
+		codec_payload.codec = AMI_IOC_PDI_CODEC_NONE;
+
+		if ((codec == AMI_PDI_CODEC_RLE) && img_size &&
+		    (compress_image(img_data, img_size, &xfer_data, &xfer_size) == AMI_STATUS_OK)) {
+			/* Not worth it if nothing got smaller */
+			if (xfer_size < img_size) {
+				payload->size = xfer_size;
+				payload->addr = (unsigned long)(&xfer_data[0]);
+				codec_payload.codec = AMI_IOC_PDI_CODEC_RLE;
+				codec_payload.raw_size = img_size;
+			}
+		}
+
+		payload->cap_override = dev->cap_override;
+		payload->boot_device = boot_device;
+		payload->partition = partition;
+		payload->efd = AMI_INVALID_FD;
 
 		if (progress_handler) {
 			progress.bytes_to_write = img_size;
 
 			if (ami_watch_driver_events(&evt_data, progress_handler, (void*)&progress) == AMI_STATUS_OK)
-				payload.efd = evt_data.efd;
+				payload->efd = evt_data.efd;
 		}
 
 		errno = 0;
-		if (ioctl(dev->cdev, AMI_IOC_DOWNLOAD_PDI, &payload) == AMI_LINUX_STATUS_ERROR)
+		if (codec_payload.codec != AMI_IOC_PDI_CODEC_NONE) {
+			ret = ioctl(dev->cdev, AMI_IOC_DOWNLOAD_PDI_CODEC, &codec_payload);
+
+			/* Drivers without codec support - send the image as-is */
+			if ((ret == AMI_LINUX_STATUS_ERROR) && (errno == ENOTTY)) {
+				payload->size = img_size;
+				payload->addr = (unsigned long)(&img_data[0]);
+				codec_payload.codec = AMI_IOC_PDI_CODEC_NONE;
+				errno = 0;
+				ret = ioctl(dev->cdev, AMI_IOC_DOWNLOAD_PDI, payload);
+			}
+		} else {
+			ret = ioctl(dev->cdev, AMI_IOC_DOWNLOAD_PDI, payload);
+		}
+
+		if (ret == AMI_LINUX_STATUS_ERROR)
 			ret = AMI_API_ERROR_M(
 				AMI_ERROR_EIO,
 				"errno %d (%s)",
@@ -155,7 +330,15 @@ static int do_image_download(ami_device *dev, const char *path, uint8_t boot_dev
 		else
 			ret = AMI_STATUS_OK;
 
+		if (transfer) {
+			transfer->codec = (codec_payload.codec == AMI_IOC_PDI_CODEC_RLE) ?
+				(AMI_PDI_CODEC_RLE) : (AMI_PDI_CODEC_NONE);
+			transfer->image_size = img_size;
+			transfer->transfer_size = payload->size;
+		}
+
 		free(img_data);  /* allocated by `read_file` */
+		free(xfer_data);  /* allocated by `compress_image` */
 
 		if (progress_handler && (evt_data.efd != AMI_INVALID_FD))
 			ami_stop_watching_events(&evt_data);
@@ -182,7 +365,31 @@ int ami_prog_download_pdi(ami_device *dev, const char *path, uint8_t boot_device
 		path,
 		boot_device,
 		partition,
-		progress_handler
+		AMI_PDI_CODEC_NONE,
+		progress_handler,
+		NULL
+	);
+}
+
+/*
+ * Program a pdi bitstream onto a device using a transfer codec.
+ */
+int ami_prog_download_pdi_codec(ami_device *dev, const char *path, uint8_t boot_device,
+	uint32_t partition, enum ami_pdi_codec codec, ami_event_handler progress_handler,
+	struct ami_pdi_transfer *transfer)
+{
+	if (!dev || !path || (partition == AMI_IOC_FPT_UPDATE_MAGIC) ||
+	    ((codec != AMI_PDI_CODEC_NONE) && (codec != AMI_PDI_CODEC_RLE)))
+		return AMI_API_ERROR(AMI_ERROR_EINVAL);
+
+	return do_image_download(
+		dev,
+		path,
+		boot_device,
+		partition,
+		codec,
+		progress_handler,
+		transfer
 	);
 }
 
@@ -200,7 +407,9 @@ int ami_prog_update_fpt(ami_device *dev, const char *path, uint8_t boot_device,
 		path,
 		boot_device,
 		AMI_IOC_FPT_UPDATE_MAGIC,
-		progress_handler
+		AMI_PDI_CODEC_NONE,
+		progress_handler,
+		NULL
 	);
 }
 
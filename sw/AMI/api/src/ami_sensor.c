@@ -30,13 +30,13 @@
 /* Defines                                                                   */
 /*****************************************************************************/
 
-#define SENSOR_REFRESH_ATTR		"update_interval"
 #define SENSOR_REFRESH_MAX_STR		(8)
 
 /* For parsing hwmon sensor status */
 #define SENSOR_STATUS_NAME_NOT_PRESENT	"Sensor Not Present"
 #define SENSOR_STATUS_NAME_OK		"Sensor Present and Valid"
 #define SENSOR_STATUS_NAME_NO_DATA	"Data Not Available"
+#define SENSOR_STATUS_NAME_QUARANTINED	"Sensor Quarantined"
 #define SENSOR_STATUS_NAME_NA		"Not Applicable or Default Value"
 
 /*****************************************************************************/
@@ -516,16 +516,12 @@ static int find_sensor_by_name(ami_device *dev, const char *name,
 {
 	int ret = AMI_STATUS_ERROR;
 
-	/* Cache last value */
-	static ami_device *last_dev = NULL;
-	static struct ami_sensor *last = NULL;
-
 	if (!dev || !dev->sensors || !name || !sensor)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	/* Check cached value. */
-	if (last && (last_dev == dev) && (strcmp(last->name, name) == 0)) {
-		*sensor = last;
+	/* Check cached value - kept per device so threads never share it. */
+	if (dev->last_sensor && (strcmp(dev->last_sensor->name, name) == 0)) {
+		*sensor = dev->last_sensor;
 		ret = AMI_STATUS_OK;
 	} else {
 		struct ami_sensor *next = dev->sensors;
@@ -533,8 +529,7 @@ static int find_sensor_by_name(ami_device *dev, const char *name,
 		while (next) {
 			if (strcmp(next->name, name) == 0) {
 				*sensor = next;
-				last = next;
-				last_dev = dev;
+				dev->last_sensor = next;
 				ret = AMI_STATUS_OK;
 				break;
 			}
@@ -634,6 +629,8 @@ static enum ami_sensor_status parse_sensor_status(const char *status)
 		return AMI_SENSOR_STATUS_OK;
 	else if (strcmp(status, SENSOR_STATUS_NAME_NO_DATA) == 0)
 		return AMI_SENSOR_STATUS_NO_DATA;
+	else if (strcmp(status, SENSOR_STATUS_NAME_QUARANTINED) == 0)
+		return AMI_SENSOR_STATUS_QUARANTINED;
 	else if (strcmp(status, SENSOR_STATUS_NAME_NA) == 0)
 		return AMI_SENSOR_STATUS_NA;
 
@@ -720,13 +717,16 @@ static int get_value(ami_device *dev, const char *sensor_name,
 		break;
 
 	case AMI_SENSOR_ATTR_VALUE:
-		/* If user requested status, use IOCTL instead. */
-		if (status) {
+		/*
+		 * If user requested status, or set an update interval on this
+		 * handle, use IOCTL instead - hwmon follows `update_interval`.
+		 */
+		if (status || dev->sensor_refresh_set) {
 			bool f = false;
 			ret = get_single_sensor_val(dev, type, data->sid,
 				&data->value, &data->status, &f);
 			
-			if (!ret) {
+			if (!ret && status) {
 				*status = parse_sensor_status(data->status.value_s);
 
 				if ((*status == AMI_SENSOR_STATUS_OK) && (f == false))
@@ -1012,15 +1012,17 @@ int ami_sensor_set_refresh(ami_device *dev, uint16_t val)
 	if (ami_open_cdev(dev) != AMI_STATUS_OK)
 		return AMI_STATUS_ERROR;
 
-	if (ioctl(dev->cdev, AMI_IOC_SET_SENSOR_REFRESH, val) == AMI_LINUX_STATUS_ERROR)
+	if (ioctl(dev->cdev, AMI_IOC_SET_SENSOR_REFRESH, val) == AMI_LINUX_STATUS_ERROR) {
 		ret = AMI_API_ERROR_M(
 			AMI_ERROR_EIO,
 			"errno %d (%s)",
 			errno,
 			strerror(errno)
 		);
-	else
+	} else {
+		dev->sensor_refresh_set = true;
 		ret = AMI_STATUS_OK;
+	}
 	
 	return ret;
 }
@@ -1030,19 +1032,24 @@ int ami_sensor_set_refresh(ami_device *dev, uint16_t val)
  */
 int ami_sensor_get_refresh(ami_device *dev, uint16_t *val)
 {
-	long value = 0;
 	int ret = AMI_STATUS_ERROR;
-	char buf[AMI_HWMON_MAX_STR] = { 0 };
 
 	if (!dev || !val)
 		return AMI_API_ERROR(AMI_ERROR_EINVAL);
 
-	if (AMI_STATUS_OK == read_hwmon(NULL, dev->hwmon_num, SENSOR_REFRESH_ATTR, buf)) {
-		if (AMI_STATUS_OK == ami_convert_num(buf, AMI_BASE_10, &value)) {
-			ret = AMI_STATUS_OK;
-			*val = value;
-		}
-	}
+	if (ami_open_cdev(dev) != AMI_STATUS_OK)
+		return AMI_STATUS_ERROR;
+
+	errno = 0;
+	if (ioctl(dev->cdev, AMI_IOC_GET_SENSOR_REFRESH, val) == AMI_LINUX_STATUS_ERROR)
+		ret = AMI_API_ERROR_M(
+			AMI_ERROR_EIO,
+			"errno %d (%s)",
+			errno,
+			strerror(errno)
+		);
+	else
+		ret = AMI_STATUS_OK;
 
 	return ret;
 }
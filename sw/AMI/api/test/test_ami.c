@@ -30,7 +30,7 @@
 /*****************************************************************************/
 
 /* Update this when more error codes are added. */
-#define MAX_AMI_ERROR (AMI_ERROR_EVER + 1)
+#define MAX_AMI_ERROR (AMI_ERROR_ETIMEDOUT + 1)
 
 /*****************************************************************************/
 /* Global variables                                                          */
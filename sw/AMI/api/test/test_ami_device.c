@@ -19,6 +19,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
+#include <poll.h>
 
 /* External includes */
 #include "cmocka.h"
@@ -50,6 +51,12 @@ static struct wrapper w_open   = { REAL, REAL, 0, 0 };
 static struct wrapper w_read   = { REAL, REAL, 0, 0 };
 static struct wrapper w_write  = { REAL, REAL, 0, 0 };
 
+/* Upstream port returned by the `basename` wrapper */
+#define TEST_PCI_PORT "0000:c0:01.1"
+
+/* Last sysfs `rescan` attribute opened, so tests can check which bus was walked */
+static char rescan_path[AMI_SYSFS_PATH_MAX] = { 0 };
+
 /*****************************************************************************/
 /* Redefinitions/Wrapping                                                    */
 /*****************************************************************************/
@@ -188,6 +195,9 @@ int __wrap_open(const char *pathname, int flags, int mode)
 	if (b == CMOCKA)
 		b = (enum wrapper_behaviour)mock();
 
+	if (pathname && strstr(pathname, "/rescan"))
+		strncpy(rescan_path, pathname, AMI_SYSFS_PATH_MAX - 1);
+
 	switch (b) {
 	case OK:
 		ret = AMI_LINUX_STATUS_OK;
@@ -328,7 +338,7 @@ char *__wrap_dirname(char *path)
 
 char *__wrap_basename(char *path)
 {
-	return "";
+	return TEST_PCI_PORT;
 }
 
 unsigned int __wrap_sleep(unsigned int seconds)
@@ -341,6 +351,11 @@ off_t __wrap_lseek(int fd, off_t offset, int whence)
 	return (off_t)mock();
 }
 
+int __wrap_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+	return (int)mock();
+}
+
 /*****************************************************************************/
 /* Tests                                                                     */
 /*****************************************************************************/
@@ -655,6 +670,7 @@ void test_happy_ami_dev_pci_reload(void **state)
 
 	/* Happy path - Device handle given */
 	dev->cdev = AMI_INVALID_FD;
+	will_return(__wrap_readlink, 0);
 	WRAPPER_ACTION_C(OK, open, 2);
 	WRAPPER_ACTION_C(OK, close, 2);
 	WRAPPER_ACTION_C(OK, write, 2);
@@ -674,6 +690,8 @@ void test_happy_ami_dev_pci_reload(void **state)
 	assert_int_equal(dev->bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
 
 	/* Happy path - BDF string given */
+	memset(rescan_path, 0x00, AMI_SYSFS_PATH_MAX);
+	will_return(__wrap_readlink, 0);
 	WRAPPER_ACTION_C(OK, open, 2);
 	WRAPPER_ACTION_C(OK, close, 2);
 	WRAPPER_ACTION_C(OK, write, 2);
@@ -682,6 +700,12 @@ void test_happy_ami_dev_pci_reload(void **state)
 		ami_dev_pci_reload(NULL, "c1:00.0"),
 		AMI_STATUS_OK
 	);
+
+	/* Only the bus below the device's port is rescanned */
+	assert_string_equal(
+		rescan_path,
+		"/sys/bus/pci/devices/" TEST_PCI_PORT "/pci_bus/0000:c1/rescan"
+	);
 	
 	free(dev);
 }
@@ -718,6 +742,28 @@ void test_fail_ami_dev_pci_reload(void **state)
 		ami_dev_pci_reload(NULL, NULL),
 		AMI_STATUS_ERROR
 	);
+
+	/* Failure path - port lookup fails, handle is kept */
+	will_return(__wrap_readlink, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ERET);
+	assert_int_equal(
+		ami_dev_pci_reload(&dev, NULL),
+		AMI_STATUS_ERROR
+	);
+	assert_non_null(dev);
+
+	/* Failure path - port lookup fails for a BDF string */
+	will_return(__wrap_ami_parse_bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	will_return(__wrap_readlink, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ERET);
+	assert_int_equal(
+		ami_dev_pci_reload(NULL, "c1:00.0"),
+		AMI_STATUS_ERROR
+	);
+
+	free(dev);
 }
 
 void test_happy_ami_dev_hot_reset(void **state)
@@ -732,18 +778,75 @@ void test_happy_ami_dev_hot_reset(void **state)
 	/*
 	 * open+close for PCI config
 	 * open+close for PCI remove
-	 * open+close for PCI rescan
-	 * 2 writes for PCI remove+rescan
+	 * open+close for device state
+	 * 1 write for PCI remove
 	 * 1 read + 2 writes for reset
+	 * 2 reads to find the PCIe capability
+	 * 1 read for the link capabilities (no link active reporting)
+	 * 1 read for the device state
 	 */
 
 	/* Happy path */
 	WRAPPER_ACTION_C(OK, open, 3);
 	WRAPPER_ACTION_C(OK, close, 3);
-	WRAPPER_ACTION(OK, read);
-	will_return(__wrap_read, "");
+	WRAPPER_ACTION_C(OK, read, 5);
+	will_return(__wrap_read, "\x01\x01");
+	will_return(__wrap_read, "\x40");
+	will_return(__wrap_read, "\x10\x01");
+	will_return(__wrap_read, "\x01\x01\x01\x01");
+	will_return(__wrap_read, "READY");
+	WRAPPER_ACTION_C(OK, write, 3);
+	will_return_count(__wrap_lseek, 0, 6);
+	will_return(__wrap_readlink, 0);
+	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
+	/* Set values for ami_dev_find_next */
+	will_return(__wrap_getline, "1");
+	will_return(__wrap_getline, "c1:00.0 2 3");
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MAJOR);
+	will_return(__wrap_ami_get_driver_version, GIT_TAG_VER_MINOR);
+	will_return(__wrap_ami_get_driver_version, AMI_STATUS_OK);
+	assert_int_equal(
+		ami_dev_hot_reset(&dev),
+		AMI_STATUS_OK
+	);
+
+	free(dev);
+}
+
+void test_happy_ami_dev_hot_reset_rescan(void **state)
+{
+	ami_device *dev = NULL;
+
+	dev = calloc(1, sizeof(ami_device));
+	assert_non_null(dev);
+	dev->bdf = AMI_MK_BDF(0xC1, 0x00, 0x00);
+	dev->cdev = AMI_INVALID_FD;
+	memset(rescan_path, 0x00, AMI_SYSFS_PATH_MAX);
+
+	/*
+	 * As for the happy path, except that the device state is missing the
+	 * first time round, so the secondary bus of the port is rescanned:
+	 * open+close for PCI config
+	 * open+close for PCI remove
+	 * open for device state (fails)
+	 * open+close for the port rescan, 1 write
+	 * open+close for device state
+	 */
+	WRAPPER_ACTION_C(CMOCKA, open, 5);
+	will_return(__wrap_open, OK);
+	will_return(__wrap_open, OK);
+	will_return(__wrap_open, FAIL);
+	will_return(__wrap_open, OK);
+	will_return(__wrap_open, OK);
+	WRAPPER_ACTION_C(OK, close, 4);
+	WRAPPER_ACTION_C(OK, read, 5);
+	will_return(__wrap_read, "\x01\x01");
+	will_return(__wrap_read, "\x40");
+	will_return(__wrap_read, "\x10\x01");
+	will_return(__wrap_read, "\x01\x01\x01\x01");
+	will_return(__wrap_read, "READY");
 	WRAPPER_ACTION_C(OK, write, 4);
-	will_return_count(__wrap_lseek, 0, 3);
+	will_return_count(__wrap_lseek, 0, 6);
 	will_return(__wrap_readlink, 0);
 	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
 	/* Set values for ami_dev_find_next */
@@ -757,6 +860,12 @@ void test_happy_ami_dev_hot_reset(void **state)
 		AMI_STATUS_OK
 	);
 
+	/* The port's secondary bus is walked, not the bus the port sits on */
+	assert_string_equal(
+		rescan_path,
+		"/sys/bus/pci/devices/" TEST_PCI_PORT "/pci_bus/0000:c1/rescan"
+	);
+
 	free(dev);
 }
 
@@ -860,12 +969,32 @@ void test_fail_ami_dev_hot_reset(void **state)
 	dev->bdf = AMI_MK_BDF(0xC1, 0x00, 0x00);
 	dev->cdev = AMI_INVALID_FD;
 
+	/* short read */
+	WRAPPER_ACTION_C(OK, open, 2);
+	WRAPPER_ACTION_C(OK, close, 2);
+	WRAPPER_ACTION(OK, write);
+	WRAPPER_ACTION(OK, read);
+	will_return(__wrap_read, "\x01");
+	will_return(__wrap_readlink, 0);
+	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
+	will_return(__wrap_lseek, AMI_LINUX_STATUS_OK);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_dev_hot_reset(&dev),
+		AMI_STATUS_ERROR
+	);
+	assert_null(dev);
+	dev = calloc(1, sizeof(ami_device));
+	dev->bdf = AMI_MK_BDF(0xC1, 0x00, 0x00);
+	dev->cdev = AMI_INVALID_FD;
+
 	/* second lseek fails */
 	WRAPPER_ACTION_C(OK, open, 2);
 	WRAPPER_ACTION_C(OK, close, 2);
 	WRAPPER_ACTION(OK, write);
 	WRAPPER_ACTION(OK, read);
-	will_return(__wrap_read, "");
+	will_return(__wrap_read, "\x01\x01");
 	will_return(__wrap_readlink, 0);
 	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
 	will_return(__wrap_lseek, AMI_LINUX_STATUS_OK);
@@ -888,7 +1017,7 @@ void test_fail_ami_dev_hot_reset(void **state)
 	will_return(__wrap_write, OK);
 	will_return(__wrap_write, FAIL);
 	WRAPPER_ACTION(OK, read);
-	will_return(__wrap_read, "");
+	will_return(__wrap_read, "\x01\x01");
 	will_return(__wrap_readlink, 0);
 	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
 	will_return_count(__wrap_lseek, AMI_LINUX_STATUS_OK, 2);
@@ -908,7 +1037,7 @@ void test_fail_ami_dev_hot_reset(void **state)
 	WRAPPER_ACTION_C(OK, close, 2);
 	WRAPPER_ACTION_C(OK, write, 2);
 	WRAPPER_ACTION(OK, read);
-	will_return(__wrap_read, "");
+	will_return(__wrap_read, "\x01\x01");
 	will_return(__wrap_readlink, 0);
 	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
 	will_return_count(__wrap_lseek, AMI_LINUX_STATUS_OK, 2);
@@ -931,7 +1060,7 @@ void test_fail_ami_dev_hot_reset(void **state)
 	will_return_count(__wrap_write, OK, 2);
 	will_return(__wrap_write, FAIL);
 	WRAPPER_ACTION(OK, read);
-	will_return(__wrap_read, "");
+	will_return(__wrap_read, "\x01\x01");
 	will_return(__wrap_readlink, 0);
 	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
 	will_return_count(__wrap_lseek, AMI_LINUX_STATUS_OK, 3);
@@ -949,6 +1078,97 @@ void test_fail_ami_dev_hot_reset(void **state)
 	free(dev);
 }
 
+void test_fail_ami_dev_hot_reset_batch(void **state)
+{
+	ami_device *devs[2] = { NULL, NULL };
+
+	/* Invalid `devs` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_hot_reset_batch(NULL, 1),
+		AMI_STATUS_ERROR
+	);
+
+	/* Invalid `num_devs` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_hot_reset_batch(devs, 0),
+		AMI_STATUS_ERROR
+	);
+
+	/* NULL handle in batch */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_hot_reset_batch(devs, 2),
+		AMI_STATUS_ERROR
+	);
+
+	/* Same device given twice */
+	devs[0] = calloc(1, sizeof(ami_device));
+	assert_non_null(devs[0]);
+	devs[0]->bdf = AMI_MK_BDF(0xC1, 0x00, 0x00);
+	devs[0]->cdev = AMI_INVALID_FD;
+	devs[1] = devs[0];
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_readlink, 0);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_hot_reset_batch(devs, 2),
+		AMI_STATUS_ERROR
+	);
+	assert_non_null(devs[0]);
+
+	/*
+	 * GPIO set fails on the second device - the first one must be cleared
+	 * again (the third queued return value is consumed by the rollback).
+	 */
+	devs[1] = calloc(1, sizeof(ami_device));
+	assert_non_null(devs[1]);
+	devs[1]->bdf = AMI_MK_BDF(0xC2, 0x00, 0x00);
+	devs[1]->cdev = AMI_INVALID_FD;
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	will_return_count(__wrap_readlink, 0, 2);
+	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
+	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_ERROR);
+	will_return(__wrap_ami_mem_bar_write, AMI_STATUS_OK);
+	assert_int_equal(
+		ami_dev_hot_reset_batch(devs, 2),
+		AMI_STATUS_ERROR
+	);
+	assert_non_null(devs[0]);
+	assert_non_null(devs[1]);
+
+	free(devs[0]);
+	free(devs[1]);
+}
+
+void test_fail_ami_dev_pci_reload_batch(void **state)
+{
+	ami_device *devs[1] = { NULL };
+
+	/* Invalid `devs` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_pci_reload_batch(NULL, 1),
+		AMI_STATUS_ERROR
+	);
+
+	/* NULL handle in batch */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_pci_reload_batch(devs, 1),
+		AMI_STATUS_ERROR
+	);
+}
+
 void test_happy_ami_dev_read_uuid(void **state)
 {
 	ami_device dev = { 0 };
@@ -1182,6 +1402,73 @@ void test_fail_ami_dev_get_pci_link_width(void **state)
 	);
 }
 
+void test_happy_ami_dev_get_pcie_health(void **state)
+{
+	ami_device dev = { 0 };
+	struct ami_pcie_health health = { 0 };
+
+	/* Happy path - return status ok and values match */
+	WRAPPER_ACTION(OK, read);
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_read,
+		"flags=0x1 speed=3/5 width=16/16 downgrades=2 events=3 "
+		"cor_errors=12 rx_errors=4 bad_tlp=3 bad_dllp=2 replays=3 "
+		"samples=100 interval_ms=5000\n");
+	assert_int_equal(
+		ami_dev_get_pcie_health(&dev, &health),
+		AMI_STATUS_OK
+	);
+	assert_int_equal(health.flags, AMI_PCIE_HEALTH_SPEED_DOWN);
+	assert_int_equal(health.speed_current, 3);
+	assert_int_equal(health.speed_max, 5);
+	assert_int_equal(health.width_current, 16);
+	assert_int_equal(health.width_max, 16);
+	assert_int_equal(health.downgrades, 2);
+	assert_int_equal(health.events, 3);
+	assert_int_equal(health.cor_errors, 12);
+	assert_int_equal(health.rx_errors, 4);
+	assert_int_equal(health.bad_tlp, 3);
+	assert_int_equal(health.bad_dllp, 2);
+	assert_int_equal(health.replays, 3);
+	assert_int_equal(health.samples, 100);
+	assert_int_equal(health.interval_ms, 5000);
+}
+
+void test_fail_ami_dev_get_pcie_health(void **state)
+{
+	ami_device dev = { 0 };
+	struct ami_pcie_health health = { 0 };
+
+	/* Failure path - invalid device pointer */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_get_pcie_health(NULL, &health),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - invalid `health` argument */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_get_pcie_health(&dev, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - truncated attribute */
+	WRAPPER_ACTION(OK, read);
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_read, "flags=0x0 speed=5/5 width=16/16");
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ERET);
+	assert_int_equal(
+		ami_dev_get_pcie_health(&dev, &health),
+		AMI_STATUS_ERROR
+	);
+}
+
 void test_happy_ami_dev_get_pci_vendor(void **state)
 {
 	ami_device dev = { 0 };
@@ -1413,6 +1700,141 @@ void test_fail_ami_dev_get_state(void **state)
 	);
 }
 
+void test_happy_ami_dev_wait_state(void **state)
+{
+	ami_device dev = { 0 };
+	char buf[AMI_DEV_STATE_SIZE] = { 0 };
+
+	/* Happy path - state already reached, no poll */
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	WRAPPER_ACTION(OK, read);
+	will_return(__wrap_lseek, 0);
+	will_return(__wrap_read, "READY");
+	assert_int_equal(
+		ami_dev_wait_state(&dev, AMI_DEV_READY_STR, 0, buf),
+		AMI_STATUS_OK
+	);
+	assert_string_equal(AMI_DEV_READY_STR, buf);
+
+	/* Happy path - state reached after a notification */
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	WRAPPER_ACTION_C(OK, read, 2);
+	will_return_count(__wrap_lseek, 0, 2);
+	will_return(__wrap_read, "INIT");
+	will_return(__wrap_read, "READY");
+	will_return(__wrap_poll, 1);
+	assert_int_equal(
+		ami_dev_wait_state(&dev, AMI_DEV_READY_STR, -1, NULL),
+		AMI_STATUS_OK
+	);
+
+	/* Happy path - wait for any transition */
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	WRAPPER_ACTION_C(OK, read, 2);
+	will_return_count(__wrap_lseek, 0, 2);
+	will_return(__wrap_read, "READY");
+	will_return(__wrap_read, "NO_AMC");
+	will_return(__wrap_poll, 1);
+	assert_int_equal(
+		ami_dev_wait_state(&dev, NULL, -1, buf),
+		AMI_STATUS_OK
+	);
+	assert_string_equal("NO_AMC", buf);
+}
+
+void test_fail_ami_dev_wait_state(void **state)
+{
+	ami_device dev = { 0 };
+
+	/* Failure path - invalid device pointer */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_wait_state(NULL, AMI_DEV_READY_STR, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - attribute cannot be opened */
+	WRAPPER_ACTION(FAIL, open);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EBADF);
+	assert_int_equal(
+		ami_dev_wait_state(&dev, AMI_DEV_READY_STR, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - attribute cannot be read */
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	will_return(__wrap_lseek, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ENODEV);
+	assert_int_equal(
+		ami_dev_wait_state(&dev, AMI_DEV_READY_STR, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - state not reached before the timeout */
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	WRAPPER_ACTION(OK, read);
+	will_return(__wrap_lseek, 0);
+	will_return(__wrap_read, "NO_AMC");
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_ETIMEDOUT);
+	assert_int_equal(
+		ami_dev_wait_state(&dev, AMI_DEV_READY_STR, 0, NULL),
+		AMI_STATUS_ERROR
+	);
+}
+
+void test_happy_ami_dev_echo(void **state)
+{
+	ami_device dev = { 0 };
+	struct ami_echo_stats stats = { 0 };
+
+	/* Happy path - ioctl succeeds */
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	assert_int_equal(
+		ami_dev_echo(&dev, 64, 10, &stats),
+		AMI_STATUS_OK
+	);
+}
+
+void test_fail_ami_dev_echo(void **state)
+{
+	ami_device dev = { 0 };
+	struct ami_echo_stats stats = { 0 };
+
+	/* Failure path - invalid device pointer */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_echo(NULL, 64, 10, &stats),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - zero count */
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EINVAL);
+	assert_int_equal(
+		ami_dev_echo(&dev, 64, 0, &stats),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - ioctl fails */
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_dev_echo(&dev, 64, 10, &stats),
+		AMI_STATUS_ERROR
+	);
+}
+
 void test_happy_ami_dev_get_name(void **state)
 {
 	ami_device dev = { 0 };
@@ -1793,6 +2215,7 @@ void test_fail_pci_remove(void **state)
 	/* open fails */
 	WRAPPER_ACTION(FAIL, open);
 	will_return(__wrap_ami_parse_bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	will_return(__wrap_readlink, 0);
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EBADF);
 	assert_int_equal(
@@ -1805,6 +2228,7 @@ void test_fail_pci_remove(void **state)
 	WRAPPER_ACTION(FAIL, write);
 	WRAPPER_ACTION(OK, close);
 	will_return(__wrap_ami_parse_bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	will_return(__wrap_readlink, 0);
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
 	assert_int_equal(
@@ -1813,7 +2237,7 @@ void test_fail_pci_remove(void **state)
 	);
 }
 
-/* Using `ami_dev_pci_reload` to test `pci_rescan` */
+/* Using `ami_dev_pci_reload` to test `pci_rescan_port` */
 void test_fail_pci_rescan(void **state)
 {
 	/* open fails */
@@ -1822,6 +2246,7 @@ void test_fail_pci_rescan(void **state)
 	will_return(__wrap_open, FAIL);
 	WRAPPER_ACTION(OK, write);
 	will_return(__wrap_ami_parse_bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	will_return(__wrap_readlink, 0);
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EBADF);
 	assert_int_equal(
@@ -1836,6 +2261,7 @@ void test_fail_pci_rescan(void **state)
 	will_return(__wrap_write, OK);
 	will_return(__wrap_write, FAIL);
 	will_return(__wrap_ami_parse_bdf, AMI_MK_BDF(0xC1, 0x00, 0x00));
+	will_return(__wrap_readlink, 0);
 	expect_function_call(__wrap_ami_set_last_error);
 	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
 	assert_int_equal(
@@ -1860,7 +2286,10 @@ int main(void)
 		cmocka_unit_test(test_happy_ami_dev_pci_reload),
 		cmocka_unit_test(test_fail_ami_dev_pci_reload),
 		cmocka_unit_test(test_happy_ami_dev_hot_reset),
+		cmocka_unit_test(test_happy_ami_dev_hot_reset_rescan),
 		cmocka_unit_test(test_fail_ami_dev_hot_reset),
+		cmocka_unit_test(test_fail_ami_dev_hot_reset_batch),
+		cmocka_unit_test(test_fail_ami_dev_pci_reload_batch),
 		cmocka_unit_test(test_happy_ami_dev_read_uuid),
 		cmocka_unit_test(test_fail_ami_dev_read_uuid),
 		cmocka_unit_test(test_happy_ami_dev_get_num_devices),
@@ -1869,6 +2298,8 @@ int main(void)
 		cmocka_unit_test(test_fail_ami_dev_get_pci_link_speed),
 		cmocka_unit_test(test_happy_ami_dev_get_pci_link_width),
 		cmocka_unit_test(test_fail_ami_dev_get_pci_link_width),
+		cmocka_unit_test(test_happy_ami_dev_get_pcie_health),
+		cmocka_unit_test(test_fail_ami_dev_get_pcie_health),
 		cmocka_unit_test(test_happy_ami_dev_get_pci_vendor),
 		cmocka_unit_test(test_fail_ami_dev_get_pci_vendor),
 		cmocka_unit_test(test_happy_ami_dev_get_pci_device),
@@ -1879,6 +2310,10 @@ int main(void)
 		cmocka_unit_test(test_fail_ami_dev_get_pci_cpulist),
 		cmocka_unit_test(test_happy_ami_dev_get_state),
 		cmocka_unit_test(test_fail_ami_dev_get_state),
+		cmocka_unit_test(test_happy_ami_dev_wait_state),
+		cmocka_unit_test(test_fail_ami_dev_wait_state),
+		cmocka_unit_test(test_happy_ami_dev_echo),
+		cmocka_unit_test(test_fail_ami_dev_echo),
 		cmocka_unit_test(test_happy_ami_dev_get_name),
 		cmocka_unit_test(test_fail_ami_dev_get_name),
 		cmocka_unit_test(test_happy_ami_dev_get_amc_version),
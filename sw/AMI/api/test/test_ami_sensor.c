@@ -722,6 +722,7 @@ void test_happy_ami_sensor_set_refresh(void **state)
 		ami_sensor_set_refresh(&dev, 0),
 		AMI_STATUS_OK
 	);
+	assert_true(dev.sensor_refresh_set);
 }
 
 void test_fail_ami_sensor_set_refresh(void **state)
@@ -759,14 +760,13 @@ void test_happy_ami_sensor_get_refresh(void **state)
 	ami_device dev = { 0 };
 	uint16_t refresh = 0;
 
+	uint16_t expected = 1000;
+
 	/* Happy path - sensor refresh read OK */
-	WRAPPER_ACTION(OK, open);
-	WRAPPER_ACTION(OK, close);
-	WRAPPER_ACTION(OK, read);
-	will_return(__wrap_read, "1000");
-	expect_string(__wrap_ami_convert_num, buf, "1000");
-	will_return(__wrap_ami_convert_num, 1000);
-	will_return(__wrap_ami_convert_num, AMI_STATUS_OK);
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_OK);
+	will_return(__wrap_ioctl, &expected);
+	will_return(__wrap_ioctl, sizeof(expected));
 	assert_int_equal(
 		ami_sensor_get_refresh(&dev, &refresh),
 		AMI_STATUS_OK
@@ -794,6 +794,23 @@ void test_fail_ami_sensor_get_refresh(void **state)
 		ami_sensor_get_refresh(&dev, NULL),
 		AMI_STATUS_ERROR
 	);
+
+	/* Failure path - ioctl fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_OK);
+	will_return(__wrap_ioctl, AMI_LINUX_STATUS_ERROR);
+	expect_function_call(__wrap_ami_set_last_error);
+	expect_value(__wrap_ami_set_last_error, err, AMI_ERROR_EIO);
+	assert_int_equal(
+		ami_sensor_get_refresh(&dev, &refresh),
+		AMI_STATUS_ERROR
+	);
+
+	/* Failure path - ami_open_cdev fails */
+	will_return(__wrap_ami_open_cdev, AMI_STATUS_ERROR);
+	assert_int_equal(
+		ami_sensor_get_refresh(&dev, &refresh),
+		AMI_STATUS_ERROR
+	);
 }
 
 void test_happy_ami_sensor_get_type(void **state)
@@ -2371,6 +2388,17 @@ void test_happy_parse_sensor_status(void **state)
 	);
 	assert_int_equal(val, AMI_SENSOR_STATUS_NO_DATA);
 
+	/* Happy path - quarantined */
+	WRAPPER_ACTION(OK, open);
+	WRAPPER_ACTION(OK, close);
+	WRAPPER_ACTION(OK, read);
+	will_return(__wrap_read, "Sensor Quarantined");
+	assert_int_equal(
+		ami_sensor_get_temp_status(&dev, "foo", &val),
+		AMI_STATUS_OK
+	);
+	assert_int_equal(val, AMI_SENSOR_STATUS_QUARANTINED);
+
 	/* Happy path - N/A */
 	WRAPPER_ACTION(OK, open);
 	WRAPPER_ACTION(OK, close);
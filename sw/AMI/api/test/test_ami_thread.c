@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * test_ami_thread.c - Multi-threaded stress test for the AMI API
+ *
+ * Every worker thread drives its own mock device while raising and checking
+ * errors and looking up sensors, to verify that concurrent callers never see
+ * each other's error state, device data or sensors.
+ *
+ * Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+/* Standard includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+/* External includes */
+#include "cmocka.h"
+
+/* AMI API includes */
+#include "ami_internal.h"
+#include "ami_ioctl.h"
+#include "ami_device_internal.h"
+#include "ami_mem_access.h"
+#include "ami_sensor_internal.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define NUM_THREADS		(16)
+#define NUM_ITERATIONS		(2000)
+#define NUM_MOCK_REGS		(64)
+#define NUM_MOCK_SENSORS	(4)
+
+/* Devices with an odd cdev number fail every BAR access */
+#define MOCK_DEV_FAILS(fd)	((fd) & 1)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct worker - State of a single stress test thread.
+ * @id: Thread index (also used as the mock device cdev).
+ * @dev: Device handle owned by this thread.
+ * @sensors: Mock sensors of `dev` - every device has the same sensor names.
+ * @sensor_data: Private data of `sensors`.
+ * @failures: Number of checks which failed.
+ * @thread: Thread reference.
+ */
+struct worker {
+	int                         id;
+	ami_device                  dev;
+	struct ami_sensor           sensors[NUM_MOCK_SENSORS];
+	struct ami_sensor_internal  sensor_data[NUM_MOCK_SENSORS];
+	int                         failures;
+	pthread_t                   thread;
+};
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+/* Mock BAR registers, one bank per device - only ever touched by its owner */
+static uint32_t mock_regs[NUM_THREADS][NUM_MOCK_REGS] = { 0 };
+
+/* Only the address matters - marks a sensor type as supported */
+static struct ami_sensor_data mock_sensor_data = { 0 };
+
+/*****************************************************************************/
+/* Redefinitions/Wrapping                                                    */
+/*****************************************************************************/
+
+/*
+ * The mock backend must not use the cmocka queues, which are not thread safe.
+ */
+int __wrap_ami_open_cdev(ami_device *dev)
+{
+	return AMI_STATUS_OK;
+}
+
+int __wrap_ioctl(int fd, unsigned long request, ...)
+{
+	va_list args;
+	struct ami_ioc_bar_data *data = NULL;
+	uint32_t *val = NULL;
+
+	va_start(args, request);
+	data = va_arg(args, struct ami_ioc_bar_data*);
+	va_end(args);
+
+	if (MOCK_DEV_FAILS(fd) || (fd >= NUM_THREADS) || (data->offset >= NUM_MOCK_REGS)) {
+		errno = EIO;
+		return AMI_LINUX_STATUS_ERROR;
+	}
+
+	val = (uint32_t*)data->addr;
+
+	if (request == AMI_IOC_WRITE_BAR)
+		mock_regs[fd][data->offset] = *val;
+	else
+		*val = mock_regs[fd][data->offset];
+
+	return AMI_LINUX_STATUS_OK;
+}
+
+/*****************************************************************************/
+/* Helpers                                                                   */
+/*****************************************************************************/
+
+/*
+ * Check the calling thread's error state.
+ */
+static int check_error(enum ami_error err, const char *prefix, const char *ctxt)
+{
+	const char *str = ami_get_last_error();
+
+	if (ami_last_error != err)
+		return 1;
+
+	if (strncmp(str, prefix, strlen(prefix)) != 0)
+		return 1;
+
+	if (ctxt && !strstr(str, ctxt))
+		return 1;
+
+	return 0;
+}
+
+/*
+ * The type of a mock sensor differs between devices with the same sensor name.
+ */
+static uint32_t mock_sensor_type(int id, int sensor)
+{
+	return (uint32_t)1 << ((id + sensor) % NUM_MOCK_SENSORS);
+}
+
+/*
+ * Build the sensor list of a worker's mock device.
+ */
+static void init_mock_sensors(struct worker *w)
+{
+	int i = 0;
+
+	for (i = 0; i < NUM_MOCK_SENSORS; i++) {
+		struct ami_sensor_internal *data = &w->sensor_data[i];
+		uint32_t type = mock_sensor_type(w->id, i);
+
+		snprintf(w->sensors[i].name, AMI_SENSOR_MAX_STR, "sensor%d", i);
+		w->sensors[i].sensor_data = data;
+		w->sensors[i].next = (i + 1 < NUM_MOCK_SENSORS) ? &w->sensors[i + 1] : NULL;
+
+		data->temp = (type & AMI_SENSOR_TYPE_TEMP) ? &mock_sensor_data : NULL;
+		data->current = (type & AMI_SENSOR_TYPE_CURRENT) ? &mock_sensor_data : NULL;
+		data->voltage = (type & AMI_SENSOR_TYPE_VOLTAGE) ? &mock_sensor_data : NULL;
+		data->power = (type & AMI_SENSOR_TYPE_POWER) ? &mock_sensor_data : NULL;
+	}
+
+	w->dev.sensors = &w->sensors[0];
+	w->dev.num_sensors = NUM_MOCK_SENSORS;
+	w->dev.num_total_sensors = NUM_MOCK_SENSORS;
+}
+
+static void *stress_worker(void *data)
+{
+	struct worker *w = (struct worker*)data;
+	char expected[AMI_ERROR_CTXT_STR_MAX] = { 0 };
+	char sensor_name[AMI_SENSOR_MAX_STR] = { 0 };
+	uint32_t val = 0;
+	uint32_t type = 0;
+	int i = 0;
+
+	for (i = 0; i < NUM_ITERATIONS; i++) {
+		uint64_t offset = i % NUM_MOCK_REGS;
+		uint32_t pattern = ((uint32_t)w->id << 24) | (uint32_t)i;
+
+		/* Device access - only the owner's data must ever come back */
+		if (MOCK_DEV_FAILS(w->id)) {
+			if (ami_mem_bar_write(&w->dev, 0, offset, pattern) != AMI_STATUS_ERROR)
+				w->failures++;
+
+			w->failures += check_error(AMI_ERROR_EIO, "EIO:", "do_bar_transaction");
+		} else {
+			if (ami_mem_bar_write(&w->dev, 0, offset, pattern) != AMI_STATUS_OK)
+				w->failures++;
+
+			if (ami_mem_bar_read(&w->dev, 0, offset, &val) != AMI_STATUS_OK)
+				w->failures++;
+
+			if (val != pattern)
+				w->failures++;
+		}
+
+		/* Sensor lookup - same names on every device, different types */
+		snprintf(sensor_name, sizeof(sensor_name), "sensor%d", i % NUM_MOCK_SENSORS);
+
+		if (ami_sensor_get_type(&w->dev, sensor_name, &type) != AMI_STATUS_OK)
+			w->failures++;
+
+		if (type != mock_sensor_type(w->id, i % NUM_MOCK_SENSORS))
+			w->failures++;
+
+		/* Argument error raised by the library */
+		if (ami_mem_bar_read(NULL, 0, offset, &val) != AMI_STATUS_ERROR)
+			w->failures++;
+
+		w->failures += check_error(AMI_ERROR_EINVAL, "EINVAL:", "ami_mem_bar_read");
+
+		/* Error with a context unique to this thread and iteration */
+		snprintf(expected, sizeof(expected), "thread %d iteration %d", w->id, i);
+		ami_set_last_error(AMI_ERROR_ETIMEDOUT, "%s", expected);
+		w->failures += check_error(AMI_ERROR_ETIMEDOUT, "ETIMEDOUT:", expected);
+	}
+
+	return NULL;
+}
+
+static void *new_thread_worker(void *data)
+{
+	struct worker *w = (struct worker*)data;
+
+	if (ami_last_error != AMI_ERROR_NONE)
+		w->failures++;
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/* Tests                                                                     */
+/*****************************************************************************/
+
+void test_stress_concurrent_devices(void **state)
+{
+	struct worker workers[NUM_THREADS] = { 0 };
+	int i = 0;
+
+	/* Error raised on this thread must survive the workers */
+	ami_set_last_error(AMI_ERROR_EVER, "%s", "main thread");
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		workers[i].id = i;
+		workers[i].dev.cdev = i;
+		workers[i].dev.bdf = AMI_MK_BDF(i, 0, 0);
+		init_mock_sensors(&workers[i]);
+
+		assert_int_equal(
+			pthread_create(&workers[i].thread, NULL, stress_worker, &workers[i]),
+			0
+		);
+	}
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		assert_int_equal(pthread_join(workers[i].thread, NULL), 0);
+		assert_int_equal(workers[i].failures, 0);
+	}
+
+	assert_int_equal(ami_last_error, AMI_ERROR_EVER);
+	assert_string_equal(
+		ami_get_last_error(),
+		"EVER: Version does not match expected value [main thread].\r\n"
+	);
+}
+
+void test_happy_new_thread_has_no_error(void **state)
+{
+	pthread_t thread;
+	struct worker w = { 0 };
+
+	ami_set_last_error(AMI_ERROR_EIO, "%s", "main thread");
+
+	/* A fresh thread starts with a clean error state */
+	assert_int_equal(
+		pthread_create(&thread, NULL, new_thread_worker, &w),
+		0
+	);
+	assert_int_equal(pthread_join(thread, NULL), 0);
+	assert_int_equal(w.failures, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_stress_concurrent_devices),
+		cmocka_unit_test(test_happy_new_thread_has_no_error),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -84,6 +84,8 @@ static const char help_msg[] = \
 	"\tmodule_byte_rd     Read data from a QSFP module\r\n"
 	"\tmodule_byte_wr     Write data to a QSFP module\r\n"
 	"\tdebug_verbosity    Set the AMC debug level\r\n"
+	"\techo               Measure the AMC command round trip\r\n"
+	"\texporter           Serve sensor telemetry over a Unix socket\r\n"
 ;
 
 /*
@@ -151,6 +153,8 @@ static const struct app_cmd_map commands[] = {
 	{ "module_byte_rd",  &cmd_module_byte_rd  },
 	{ "module_byte_wr",  &cmd_module_byte_wr  },
 	{ "debug_verbosity", &cmd_debug_verbosity },
+	{ "echo",            &cmd_echo            },
+	{ "exporter",        &cmd_exporter        },
 };
 
 /*****************************************************************************/
@@ -70,8 +70,9 @@ static void progress_handler(enum ami_event_status status, uint64_t ctr, void *d
  * p: Partition number
  * y: Skip user confirmation
  * q: Quit after programming
+ * z: Compress the image for transfer
  */
-static const char short_options[] = "hd:t:i:p:yq";
+static const char short_options[] = "hd:t:i:p:yqz";
 
 static const struct option long_options[] = {
 	{ "help", no_argument, NULL, 'h' },  /* help screen */
@@ -91,6 +92,7 @@ static const char help_msg[] = \
 	"\t-p <partition>        Partition to flash\r\n"
 	"\t-y                    Skip confirmation\r\n"
 	"\t-q                    Quit after programming\r\n"
+	"\t-z                    Compress the image for transfer (expanded on the device)\r\n"
 ;
 
 struct app_cmd cmd_cfgmem_program = {
@@ -150,6 +152,8 @@ static int do_cmd_cfgmem_program(struct app_option *options, int num_args, char
 	ami_device *dev = NULL;
 	int selected_boot_device = 0;
 	uint32_t partition_number = 0;
+	enum ami_pdi_codec codec = AMI_PDI_CODEC_NONE;
+	struct ami_pdi_transfer transfer = { 0 };
 
 	/* For UUID checks */
 	int found_current_uuid = AMI_STATUS_ERROR;
@@ -205,6 +209,9 @@ static int do_cmd_cfgmem_program(struct app_option *options, int num_args, char
 	found_new_uuid = find_logic_uuid(image->arg, new_uuid);
 	partition_number = (uint32_t)strtoul(partition->arg, NULL, 0);
 
+	if (NULL != find_app_option('z', options))
+		codec = AMI_PDI_CODEC_RLE;
+
 	printf(
 		"----------------------------------------------\r\n"
 		"Device | %02x:%02x.%01x\r\n"
@@ -231,13 +238,24 @@ static int do_cmd_cfgmem_program(struct app_option *options, int num_args, char
 	if ((NULL != find_app_option('y', options)) || confirm_action(APP_CONFIRM_PROMPT, 'Y', 3)) {
 		printf("\r\nUpdating base flash image...\r\n");
 
-		if (ami_prog_download_pdi(dev,
-					  image->arg,
-					  selected_boot_device,
-					  partition_number,
-					  progress_handler) == AMI_STATUS_OK) {
+		if (ami_prog_download_pdi_codec(dev,
+						image->arg,
+						selected_boot_device,
+						partition_number,
+						codec,
+						progress_handler,
+						&transfer) == AMI_STATUS_OK) {
 			printf("\r\nImage programming complete.\r\n");
 
+			if ((codec != AMI_PDI_CODEC_NONE) && transfer.image_size)
+				printf(
+					"Transfer codec %s - sent %u of %u bytes (%.1f%%)\r\n",
+					((transfer.codec == AMI_PDI_CODEC_RLE) ? ("rle") : ("none")),
+					transfer.transfer_size,
+					transfer.image_size,
+					(100.0 * transfer.transfer_size) / transfer.image_size
+				);
+
 			if ((NULL == find_app_option('q', options)) &&
 			    (AMI_BOOT_DEVICES_PRIMARY == selected_boot_device)) {
 				/* If we're not quitting, set the device boot partition */
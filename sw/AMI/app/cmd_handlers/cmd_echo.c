@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * cmd_echo.c - This file contains the implementation for the command "echo"
+ *
+ * Copyright (c) 2023-present Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+/* Standard includes */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <getopt.h>
+#include <string.h>
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+
+/* App includes */
+#include "commands.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define DEFAULT_ECHO_COUNT	(100)
+#define NS_PER_US		(1000.0)
+#define NS_PER_S		(1000000000.0)
+#define BYTES_PER_MB		(1000000.0)
+
+/*****************************************************************************/
+/* Function declarations                                                     */
+/*****************************************************************************/
+
+/**
+ * do_cmd_echo() - "echo" command callback.
+ * @options:  Ordered list of options passed in at the command line
+ * @num_args:  Number of non-option arguments (excluding command)
+ * @args:  List of non-option arguments (excluding command)
+ *
+ * `args` may be an invalid pointer. It is the function's responsibility
+ * to validate the `num_args` parameter.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int do_cmd_echo(struct app_option *options, int num_args, char **args);
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+/*
+ * h: Help
+ * d: Device
+ * s: Payload size
+ * n: Number of echoes
+*/
+static const char short_options[] = "hd:s:n:";
+
+static const struct option long_options[] = {
+	{ "help", no_argument, NULL, 'h' },  /* help screen */
+	{ },
+};
+
+static const char help_msg[] = \
+	"echo - measure the host to AMC command round trip\r\n"
+	"\r\nUsage:\r\n"
+	"\t" APP_NAME " echo -d <bdf> [-s <bytes> -n <count>]\r\n"
+	"\r\nOptions:\r\n"
+	"\t-h --help             Show this screen\r\n"
+	"\t-d <b>:[d].[f]        Specify the device BDF\r\n"
+	"\t-s <bytes>            Payload size carried by each echo (default 0, max 1048576)\r\n"
+	"\t-n <count>            Number of echoes to run (default 100, max 10000)\r\n"
+	"\r\nThroughput counts the payload in both directions.\r\n"
+;
+
+struct app_cmd cmd_echo = {
+	.callback      = &do_cmd_echo,
+	.short_options = short_options,
+	.long_options  = long_options,
+	.root_required = false,
+	.help_msg      = help_msg
+};
+
+/*****************************************************************************/
+/* Function implementations                                                  */
+/*****************************************************************************/
+
+/*
+ * "echo" command callback.
+ */
+static int do_cmd_echo(struct app_option *options, int num_args, char **args)
+{
+	int ret = EXIT_FAILURE;
+	struct app_option *device = NULL;
+	struct app_option *opt = NULL;
+	ami_device *dev = NULL;
+	struct ami_echo_stats stats = { 0 };
+	uint32_t size = 0;
+	uint32_t count = DEFAULT_ECHO_COUNT;
+
+	/* Must have at least a device. */
+	if (!options) {
+		APP_USER_ERROR("not enough options", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	if (NULL != (opt = find_app_option('s', options)))
+		size = (uint32_t)strtoul(opt->arg, NULL, 0);
+
+	if (NULL != (opt = find_app_option('n', options))) {
+		count = (uint32_t)strtoul(opt->arg, NULL, 0);
+
+		if (count == 0) {
+			APP_USER_ERROR("count must be at least 1", help_msg);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* device option is required */
+	device = find_app_option('d', options);
+
+	if (!device) {
+		APP_USER_ERROR("device not specified", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	/* Find device */
+	if (ami_dev_find(device->arg, &dev) != AMI_STATUS_OK) {
+		APP_API_ERROR("could not find the requested device");
+		return EXIT_FAILURE;
+	}
+
+	printf("Running %u echoes with a %u byte payload...\r\n", count, size);
+
+	if (ami_dev_echo(dev, size, count, &stats) == AMI_STATUS_OK) {
+		double secs = (double)stats.total_ns / NS_PER_S;
+
+		printf("\r\n");
+		printf("Latency min     |  %.1f us\r\n", (double)stats.min_ns / NS_PER_US);
+		printf("Latency p50     |  %.1f us\r\n", (double)stats.p50_ns / NS_PER_US);
+		printf("Latency p99     |  %.1f us\r\n", (double)stats.p99_ns / NS_PER_US);
+		printf("Latency max     |  %.1f us\r\n", (double)stats.max_ns / NS_PER_US);
+
+		if (secs > 0) {
+			printf("Commands/s      |  %.1f\r\n", (double)count / secs);
+			printf("Throughput      |  %.3f MB/s\r\n",
+				(2.0 * size * count) / BYTES_PER_MB / secs);
+		}
+
+		ret = EXIT_SUCCESS;
+	} else {
+		APP_API_ERROR("echo failed");
+	}
+
+	ami_dev_delete(&dev);
+	return ret;
+}
@@ -0,0 +1,765 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * cmd_exporter.c - This file contains the implementation for the command "exporter"
+ *
+ * The exporter samples every sensor of every selected device once per interval
+ * and serves the latest sample set to any number of clients over a Unix socket,
+ * so the load on the AMC does not depend on how many collectors are scraping.
+ *
+ * A client connects, writes one request line and reads until EOF:
+ *
+ *   "text\n"    - OpenMetrics text exposition
+ *   "binary\n"  - struct exporter_bin_hdr followed by `num_records` records
+ *                 of struct exporter_bin_rec (native byte order)
+ *
+ * An empty request (or none within the receive timeout) returns text.
+ *
+ * Copyright (c) 2023-present Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+/*****************************************************************************/
+/* Includes                                                                  */
+/*****************************************************************************/
+
+/* Standard includes */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <getopt.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <poll.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* API includes */
+#include "ami.h"
+#include "ami_device.h"
+#include "ami_sensor.h"
+
+/* App includes */
+#include "commands.h"
+
+/*****************************************************************************/
+/* Defines                                                                   */
+/*****************************************************************************/
+
+#define DEFAULT_SOCKET_PATH	"/run/ami_exporter.sock"
+#define DEFAULT_INTERVAL_MS	(1000)
+#define MIN_INTERVAL_MS		(100)
+#define LISTEN_BACKLOG		(64)
+#define POLL_INTERVAL_MS	(200)
+#define CLIENT_TIMEOUT_MS	(1000)
+#define REQUEST_MAX_LEN		(16)
+
+#define EXPORTER_BIN_MAGIC	(0x54494D41)  /* "AMIT" */
+#define EXPORTER_BIN_VERSION	(1)
+
+#define UNIT_MOD_BASE		(10)
+#define MS_PER_S		(1000)
+#define NS_PER_MS		(1000000)
+
+/*****************************************************************************/
+/* Structs                                                                   */
+/*****************************************************************************/
+
+/**
+ * struct exporter_bin_hdr - Binary response header.
+ * @magic: EXPORTER_BIN_MAGIC.
+ * @version: EXPORTER_BIN_VERSION.
+ * @rec_size: Size of each record in bytes.
+ * @timestamp_ms: Wall clock time the sample set was taken (ms since epoch).
+ * @interval_ms: Sampling interval.
+ * @num_records: Number of records which follow.
+ */
+struct exporter_bin_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t rec_size;
+	uint64_t timestamp_ms;
+	uint32_t interval_ms;
+	uint32_t num_records;
+};
+
+/**
+ * struct exporter_bin_rec - Binary response record, one per sensor reading.
+ * @bdf: Device BDF string.
+ * @name: Sensor name.
+ * @type: Single `enum ami_sensor_type` bit.
+ * @status: `enum ami_sensor_status` of the reading.
+ * @value: Reading in base units (C, V, A or W).
+ */
+struct exporter_bin_rec {
+	char     bdf[AMI_BDF_STR_LEN];
+	char     name[AMI_SENSOR_MAX_STR];
+	uint32_t type;
+	int32_t  status;
+	double   value;
+};
+
+/**
+ * struct exporter_dev - A device being sampled.
+ * @dev: Device handle.
+ * @bdf: Device BDF string.
+ */
+struct exporter_dev {
+	ami_device *dev;
+	char        bdf[AMI_BDF_STR_LEN];
+};
+
+/**
+ * struct exporter_buf - Growable output buffer.
+ * @data: Buffer contents.
+ * @len: Bytes used.
+ * @cap: Bytes allocated.
+ */
+struct exporter_buf {
+	char   *data;
+	size_t  len;
+	size_t  cap;
+};
+
+/**
+ * struct exporter_ctxt - Exporter state shared by the sampler and the server.
+ * @devs: Devices being sampled.
+ * @num_devs: Number of devices.
+ * @interval_ms: Sampling interval.
+ * @lock: Protects `text` and `bin`.
+ * @text: Latest OpenMetrics snapshot.
+ * @bin: Latest binary snapshot.
+ */
+struct exporter_ctxt {
+	struct exporter_dev *devs;
+	int                  num_devs;
+	uint32_t             interval_ms;
+	pthread_mutex_t      lock;
+	struct exporter_buf  text;
+	struct exporter_buf  bin;
+};
+
+/**
+ * struct exporter_family - OpenMetrics family for a sensor type.
+ * @type: Sensor type bit.
+ * @name: Metric family name.
+ * @unit: Metric unit.
+ * @help: Family description.
+ */
+struct exporter_family {
+	uint32_t    type;
+	const char *name;
+	const char *unit;
+	const char *help;
+};
+
+/*****************************************************************************/
+/* Function declarations                                                     */
+/*****************************************************************************/
+
+/**
+ * do_cmd_exporter() - "exporter" command callback.
+ * @options:  Ordered list of options passed in at the command line
+ * @num_args:  Number of non-option arguments (excluding command)
+ * @args:  List of non-option arguments (excluding command)
+ *
+ * `args` may be an invalid pointer. It is the function's responsibility
+ * to validate the `num_args` parameter.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int do_cmd_exporter(struct app_option *options, int num_args, char **args);
+
+/*****************************************************************************/
+/* Global variables                                                          */
+/*****************************************************************************/
+
+/*
+ * h: Help
+ * d: Device
+ * i: Sampling interval
+ * s: Socket path
+*/
+static const char short_options[] = "hd:i:s:";
+
+static const struct option long_options[] = {
+	{ "help", no_argument, NULL, 'h' },  /* help screen */
+	{ },
+};
+
+static const char help_msg[] = \
+	"exporter - serve sensor telemetry to many clients from one sampling loop\r\n"
+	"\r\nUsage:\r\n"
+	"\t" APP_NAME " exporter [-d <bdf> -i <ms> -s <path>]\r\n"
+	"\r\nOptions:\r\n"
+	"\t-h --help             Show this screen\r\n"
+	"\t-d <b>:[d].[f]        Only sample this device (default all)\r\n"
+	"\t-i <ms>               Sampling interval (default 1000)\r\n"
+	"\t-s <path>             Unix socket to serve on (default " DEFAULT_SOCKET_PATH ")\r\n"
+	"\r\nClients write \"text\" or \"binary\" followed by a newline and read\r\n"
+	"until EOF. Runs until interrupted.\r\n"
+;
+
+struct app_cmd cmd_exporter = {
+	.callback      = &do_cmd_exporter,
+	.short_options = short_options,
+	.long_options  = long_options,
+	.root_required = false,
+	.help_msg      = help_msg
+};
+
+static const struct exporter_family families[AMI_SENSOR_TYPE_MAX] = {
+	{ AMI_SENSOR_TYPE_TEMP,    "ami_temperature_celsius", "celsius", "Sensor temperature" },
+	{ AMI_SENSOR_TYPE_VOLTAGE, "ami_voltage_volts",       "volts",   "Sensor voltage"     },
+	{ AMI_SENSOR_TYPE_CURRENT, "ami_current_amperes",     "amperes", "Sensor current"     },
+	{ AMI_SENSOR_TYPE_POWER,   "ami_power_watts",         "watts",   "Sensor power"       },
+};
+
+static volatile sig_atomic_t stop_requested = 0;
+
+/*****************************************************************************/
+/* Function implementations                                                  */
+/*****************************************************************************/
+
+/**
+ * handle_stop() - SIGINT/SIGTERM handler.
+ * @sig: Signal number.
+ *
+ * Return: None.
+ */
+static void handle_stop(int sig)
+{
+	stop_requested = 1;
+}
+
+/**
+ * buf_reserve() - Make room in an output buffer.
+ * @buf: Buffer.
+ * @extra: Number of additional bytes required.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int buf_reserve(struct exporter_buf *buf, size_t extra)
+{
+	size_t cap = (buf->cap) ? (buf->cap) : (BUFSIZ);
+	char *data = NULL;
+
+	if ((buf->len + extra) <= buf->cap)
+		return EXIT_SUCCESS;
+
+	while (cap < (buf->len + extra))
+		cap *= 2;
+
+	data = realloc(buf->data, cap);
+	if (!data)
+		return EXIT_FAILURE;
+
+	buf->data = data;
+	buf->cap = cap;
+	return EXIT_SUCCESS;
+}
+
+/**
+ * buf_append() - Append raw bytes to an output buffer.
+ * @buf: Buffer.
+ * @data: Bytes to append.
+ * @len: Number of bytes.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int buf_append(struct exporter_buf *buf, const void *data, size_t len)
+{
+	if (buf_reserve(buf, len) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	memcpy(buf->data + buf->len, data, len);
+	buf->len += len;
+	return EXIT_SUCCESS;
+}
+
+/**
+ * buf_printf() - Append formatted text to an output buffer.
+ * @buf: Buffer.
+ * @fmt: Format string.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int buf_printf(struct exporter_buf *buf, const char *fmt, ...)
+{
+	va_list args;
+	int n = 0;
+
+	va_start(args, fmt);
+	n = vsnprintf(NULL, 0, fmt, args);
+	va_end(args);
+
+	if ((n < 0) || (buf_reserve(buf, n + 1) != EXIT_SUCCESS))
+		return EXIT_FAILURE;
+
+	va_start(args, fmt);
+	vsnprintf(buf->data + buf->len, n + 1, fmt, args);
+	va_end(args);
+
+	buf->len += n;
+	return EXIT_SUCCESS;
+}
+
+/**
+ * buf_label() - Append an escaped OpenMetrics label value.
+ * @buf: Buffer.
+ * @s: Label value.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int buf_label(struct exporter_buf *buf, const char *s)
+{
+	int ret = EXIT_SUCCESS;
+
+	for (; *s && (ret == EXIT_SUCCESS); s++) {
+		switch (*s) {
+		case '\\':
+			ret = buf_append(buf, "\\\\", 2);
+			break;
+
+		case '"':
+			ret = buf_append(buf, "\\\"", 2);
+			break;
+
+		case '\n':
+			ret = buf_append(buf, "\\n", 2);
+			break;
+
+		default:
+			ret = buf_append(buf, s, 1);
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * read_sensor() - Read one sensor value in base units.
+ * @dev: Device handle.
+ * @sensor: Sensor name.
+ * @type: Single sensor type bit.
+ * @value: Converted reading.
+ * @status: Reading status.
+ *
+ * Return: AMI_STATUS_OK or AMI_STATUS_ERROR.
+ */
+static int read_sensor(ami_device *dev, const char *sensor, uint32_t type,
+	double *value, enum ami_sensor_status *status)
+{
+	int ret = AMI_STATUS_ERROR;
+	long v = 0;
+	enum ami_sensor_unit_mod mod = AMI_SENSOR_UNIT_MOD_NONE;
+
+	switch (type) {
+	case AMI_SENSOR_TYPE_TEMP:
+		if ((ret = ami_sensor_get_temp_value(dev, sensor, &v, status)) == AMI_STATUS_OK)
+			ret = ami_sensor_get_temp_unit_mod(dev, sensor, &mod);
+		break;
+
+	case AMI_SENSOR_TYPE_VOLTAGE:
+		if ((ret = ami_sensor_get_voltage_value(dev, sensor, &v, status)) == AMI_STATUS_OK)
+			ret = ami_sensor_get_voltage_unit_mod(dev, sensor, &mod);
+		break;
+
+	case AMI_SENSOR_TYPE_CURRENT:
+		if ((ret = ami_sensor_get_current_value(dev, sensor, &v, status)) == AMI_STATUS_OK)
+			ret = ami_sensor_get_current_unit_mod(dev, sensor, &mod);
+		break;
+
+	case AMI_SENSOR_TYPE_POWER:
+		if ((ret = ami_sensor_get_power_value(dev, sensor, &v, status)) == AMI_STATUS_OK)
+			ret = ami_sensor_get_power_unit_mod(dev, sensor, &mod);
+		break;
+
+	default:
+		break;
+	}
+
+	if (ret == AMI_STATUS_OK)
+		*value = (double)v * pow(UNIT_MOD_BASE, (double)mod);
+
+	return ret;
+}
+
+/**
+ * take_sample() - Sample every sensor once and render both snapshots.
+ * @ctxt: Exporter context.
+ * @text: Buffer to render the OpenMetrics snapshot into (reset first).
+ * @bin: Buffer to render the binary snapshot into (reset first).
+ *
+ * Each reading is taken once and written to both outputs so that clients
+ * never trigger sensor reads of their own.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int take_sample(struct exporter_ctxt *ctxt, struct exporter_buf *text,
+	struct exporter_buf *bin)
+{
+	int ret = EXIT_SUCCESS;
+	int i = 0, f = 0, num = 0;
+	struct exporter_bin_hdr hdr = { 0 };
+	struct timespec start = { 0 }, end = { 0 }, now = { 0 };
+
+	text->len = 0;
+	bin->len = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	hdr.magic = EXPORTER_BIN_MAGIC;
+	hdr.version = EXPORTER_BIN_VERSION;
+	hdr.rec_size = sizeof(struct exporter_bin_rec);
+	hdr.timestamp_ms = ((uint64_t)now.tv_sec * MS_PER_S) + (now.tv_nsec / NS_PER_MS);
+	hdr.interval_ms = ctxt->interval_ms;
+
+	/* Header is rewritten with the final record count below */
+	ret = buf_append(bin, &hdr, sizeof(hdr));
+
+	/* OpenMetrics requires all samples of a family to be contiguous */
+	for (f = 0; (f < AMI_SENSOR_TYPE_MAX) && (ret == EXIT_SUCCESS); f++) {
+		ret = buf_printf(text,
+			"# TYPE %s gauge\n# UNIT %s %s\n# HELP %s %s\n",
+			families[f].name,
+			families[f].name, families[f].unit,
+			families[f].name, families[f].help);
+
+		for (i = 0; (i < ctxt->num_devs) && (ret == EXIT_SUCCESS); i++) {
+			struct ami_sensor *sensors = NULL;
+			struct ami_sensor *s = NULL;
+
+			if (ami_sensor_get_sensors(ctxt->devs[i].dev, &sensors, &num) != AMI_STATUS_OK)
+				continue;
+
+			for (s = sensors; s && (ret == EXIT_SUCCESS); s = s->next) {
+				struct exporter_bin_rec rec = { 0 };
+				enum ami_sensor_status status = AMI_SENSOR_STATUS_INVALID;
+				uint32_t type = 0;
+				double value = 0;
+
+				if ((ami_sensor_get_type(ctxt->devs[i].dev, s->name, &type) != AMI_STATUS_OK) ||
+						!(type & families[f].type))
+					continue;
+
+				if (read_sensor(ctxt->devs[i].dev, s->name, families[f].type,
+						&value, &status) != AMI_STATUS_OK)
+					continue;
+
+				strncpy(rec.bdf, ctxt->devs[i].bdf, AMI_BDF_STR_LEN - 1);
+				strncpy(rec.name, s->name, AMI_SENSOR_MAX_STR - 1);
+				rec.type = families[f].type;
+				rec.status = status;
+				rec.value = value;
+				ret = buf_append(bin, &rec, sizeof(rec));
+				hdr.num_records++;
+
+				if ((ret == EXIT_SUCCESS) &&
+						((status == AMI_SENSOR_STATUS_OK) ||
+						 (status == AMI_SENSOR_STATUS_OK_CACHED))) {
+					ret = buf_printf(text, "%s{device=\"", families[f].name);
+					if (ret == EXIT_SUCCESS)
+						ret = buf_label(text, ctxt->devs[i].bdf);
+					if (ret == EXIT_SUCCESS)
+						ret = buf_printf(text, "\",sensor=\"");
+					if (ret == EXIT_SUCCESS)
+						ret = buf_label(text, s->name);
+					if (ret == EXIT_SUCCESS)
+						ret = buf_printf(text, "\"} %g\n", value);
+				}
+			}
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	if (ret == EXIT_SUCCESS)
+		ret = buf_printf(text,
+			"# TYPE ami_exporter_sample_duration_seconds gauge\n"
+			"# UNIT ami_exporter_sample_duration_seconds seconds\n"
+			"ami_exporter_sample_duration_seconds %.6f\n"
+			"# TYPE ami_exporter_last_sample_timestamp_seconds gauge\n"
+			"# UNIT ami_exporter_last_sample_timestamp_seconds seconds\n"
+			"ami_exporter_last_sample_timestamp_seconds %.3f\n"
+			"# EOF\n",
+			(double)(end.tv_sec - start.tv_sec) +
+				((double)(end.tv_nsec - start.tv_nsec) / (NS_PER_MS * MS_PER_S)),
+			(double)hdr.timestamp_ms / MS_PER_S);
+
+	if (ret == EXIT_SUCCESS)
+		memcpy(bin->data, &hdr, sizeof(hdr));
+
+	return ret;
+}
+
+/**
+ * sampler_thread() - Sample all devices once per interval.
+ * @arg: Exporter context.
+ *
+ * Snapshots are rendered outside the lock and swapped in, so clients are
+ * only ever blocked for a pointer exchange.
+ *
+ * Return: NULL.
+ */
+static void *sampler_thread(void *arg)
+{
+	struct exporter_ctxt *ctxt = (struct exporter_ctxt *)arg;
+	struct exporter_buf text = { 0 }, bin = { 0 };
+	struct timespec next = { 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &next);
+
+	while (!stop_requested) {
+		if (take_sample(ctxt, &text, &bin) == EXIT_SUCCESS) {
+			struct exporter_buf tmp = { 0 };
+
+			pthread_mutex_lock(&ctxt->lock);
+			tmp = ctxt->text; ctxt->text = text; text = tmp;
+			tmp = ctxt->bin; ctxt->bin = bin; bin = tmp;
+			pthread_mutex_unlock(&ctxt->lock);
+		} else {
+			APP_WARN("failed to render sensor snapshot");
+		}
+
+		/* Fixed rate rather than fixed delay so the interval does not drift */
+		next.tv_nsec += (long)(ctxt->interval_ms % MS_PER_S) * NS_PER_MS;
+		next.tv_sec += ctxt->interval_ms / MS_PER_S + next.tv_nsec / (NS_PER_MS * MS_PER_S);
+		next.tv_nsec %= (NS_PER_MS * MS_PER_S);
+
+		while (!stop_requested &&
+				(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR))
+			;
+	}
+
+	free(text.data);
+	free(bin.data);
+	return NULL;
+}
+
+/**
+ * serve_client() - Answer a single client request.
+ * @ctxt: Exporter context.
+ * @fd: Connected client socket.
+ *
+ * Return: None.
+ */
+static void serve_client(struct exporter_ctxt *ctxt, int fd)
+{
+	char req[REQUEST_MAX_LEN] = { 0 };
+	struct timeval tv = { 0 };
+	struct exporter_buf out = { 0 };
+	bool binary = false;
+	ssize_t n = 0;
+
+	/* A stalled client must not hold up everybody else */
+	tv.tv_sec = CLIENT_TIMEOUT_MS / MS_PER_S;
+	tv.tv_usec = (CLIENT_TIMEOUT_MS % MS_PER_S) * MS_PER_S;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+	n = recv(fd, req, sizeof(req) - 1, 0);
+	if ((n > 0) && (strncmp(req, "binary", strlen("binary")) == 0))
+		binary = true;
+
+	/* Copy under the lock, send without it */
+	pthread_mutex_lock(&ctxt->lock);
+	if (binary)
+		buf_append(&out, ctxt->bin.data, ctxt->bin.len);
+	else
+		buf_append(&out, ctxt->text.data, ctxt->text.len);
+	pthread_mutex_unlock(&ctxt->lock);
+
+	for (size_t sent = 0; sent < out.len; sent += n) {
+		n = send(fd, out.data + sent, out.len - sent, MSG_NOSIGNAL);
+		if (n <= 0)
+			break;
+	}
+
+	free(out.data);
+}
+
+/**
+ * open_devices() - Open and discover the devices to sample.
+ * @bdf: Only open this device (may be NULL for all devices).
+ * @ctxt: Exporter context to populate.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int open_devices(const char *bdf, struct exporter_ctxt *ctxt)
+{
+	ami_device *dev = NULL;
+	ami_device *prev = NULL;
+
+	while (true) {
+		struct exporter_dev *devs = NULL;
+		uint16_t pci_bdf = 0;
+
+		if (bdf) {
+			if (prev || (ami_dev_find(bdf, &dev) != AMI_STATUS_OK))
+				break;
+		} else if (ami_dev_find_next(&dev, AMI_ANY_DEV, AMI_ANY_DEV, 0, prev) != AMI_STATUS_OK) {
+			break;
+		}
+
+		/* Handles are kept for the lifetime of the exporter */
+		prev = dev;
+
+		if (ami_sensor_discover(dev) != AMI_STATUS_OK) {
+			APP_API_ERROR("device has no sensor data");
+			ami_dev_delete(&dev);
+			return EXIT_FAILURE;
+		}
+
+		/* Sample at our own interval, independently of other readers */
+		ami_sensor_set_refresh(dev, ctxt->interval_ms);
+
+		devs = realloc(ctxt->devs, (ctxt->num_devs + 1) * sizeof(*devs));
+		if (!devs) {
+			ami_dev_delete(&dev);
+			return EXIT_FAILURE;
+		}
+
+		ctxt->devs = devs;
+		devs[ctxt->num_devs].dev = dev;
+		ami_dev_get_pci_bdf(dev, &pci_bdf);
+		snprintf(
+			devs[ctxt->num_devs].bdf,
+			AMI_BDF_STR_LEN,
+			"%02x:%02x.%01x",
+			AMI_PCI_BUS(pci_bdf),
+			AMI_PCI_DEV(pci_bdf),
+			AMI_PCI_FUNC(pci_bdf)
+		);
+		ctxt->num_devs++;
+		dev = NULL;
+	}
+
+	return (ctxt->num_devs > 0) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
+
+/*
+ * "exporter" command callback.
+ */
+static int do_cmd_exporter(struct app_option *options, int num_args, char **args)
+{
+	int ret = EXIT_FAILURE;
+	int i = 0;
+	int sock = -1;
+	struct app_option *opt = NULL;
+	const char *bdf = NULL;
+	const char *path = DEFAULT_SOCKET_PATH;
+	struct exporter_ctxt ctxt = { 0 };
+	struct sockaddr_un addr = { 0 };
+	struct sigaction sa = { 0 };
+	pthread_t sampler = { 0 };
+	bool sampler_started = false;
+
+	ctxt.interval_ms = DEFAULT_INTERVAL_MS;
+	pthread_mutex_init(&ctxt.lock, NULL);
+
+	/* options may be NULL */
+
+	if (NULL != (opt = find_app_option('d', options)))
+		bdf = opt->arg;
+
+	if (NULL != (opt = find_app_option('s', options)))
+		path = opt->arg;
+
+	if (NULL != (opt = find_app_option('i', options))) {
+		ctxt.interval_ms = (uint32_t)strtoul(opt->arg, NULL, 0);
+
+		if ((ctxt.interval_ms < MIN_INTERVAL_MS) || (ctxt.interval_ms > UINT16_MAX)) {
+			APP_USER_ERROR("interval must be between 100 and 65535 ms", help_msg);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		APP_USER_ERROR("socket path is too long", help_msg);
+		return EXIT_FAILURE;
+	}
+
+	if (open_devices(bdf, &ctxt) != EXIT_SUCCESS) {
+		APP_API_ERROR("could not find any devices to sample");
+		goto done;
+	}
+
+	sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sock < 0) {
+		APP_ERROR("could not create socket");
+		goto done;
+	}
+
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	unlink(path);  /* Remove a stale socket from a previous run */
+
+	if ((bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+			(listen(sock, LISTEN_BACKLOG) != 0)) {
+		APP_ERROR("could not listen on socket");
+		goto done;
+	}
+
+	sa.sa_handler = handle_stop;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	/* First sample before accepting clients so nobody sees an empty snapshot */
+	if (take_sample(&ctxt, &ctxt.text, &ctxt.bin) != EXIT_SUCCESS) {
+		APP_ERROR("could not sample sensors");
+		goto done;
+	}
+
+	if (pthread_create(&sampler, NULL, sampler_thread, &ctxt) != 0) {
+		APP_ERROR("could not start sampling thread");
+		goto done;
+	}
+
+	sampler_started = true;
+	printf("Sampling %d device(s) every %u ms, serving on %s\r\n",
+		ctxt.num_devs, ctxt.interval_ms, path);
+
+	while (!stop_requested) {
+		struct pollfd pfd = { .fd = sock, .events = POLLIN };
+
+		if (poll(&pfd, 1, POLL_INTERVAL_MS) > 0) {
+			int client = accept(sock, NULL, NULL);
+
+			if (client >= 0) {
+				serve_client(&ctxt, client);
+				close(client);
+			}
+		}
+	}
+
+	ret = EXIT_SUCCESS;
+
+done:
+	stop_requested = 1;
+
+	if (sampler_started)
+		pthread_join(sampler, NULL);
+
+	if (sock >= 0) {
+		close(sock);
+		unlink(path);
+	}
+
+	for (i = 0; i < ctxt.num_devs; i++)
+		ami_dev_delete(&ctxt.devs[i].dev);
+
+	free(ctxt.devs);
+	free(ctxt.text.data);
+	free(ctxt.bin.data);
+	pthread_mutex_destroy(&ctxt.lock);
+	return ret;
+}
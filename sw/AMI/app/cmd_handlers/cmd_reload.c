@@ -75,6 +75,16 @@ static int do_cmd_reload(struct app_option *options, int num_args, char **args);
  */
 static enum reload_type parse_reload_type(const char *reload_type);
 
+/**
+ * do_batch_reload() - Reload several devices concurrently.
+ * @type: Reload type (must be RELOAD_TYPE_PCI or RELOAD_TYPE_SBR).
+ * @options: Ordered list of options passed in at the command line.
+ * @num_devs: Number of device options in `options`.
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int do_batch_reload(enum reload_type type, struct app_option *options, int num_devs);
+
 /*****************************************************************************/
 /* Global variables                                                          */
 /*****************************************************************************/
@@ -95,14 +105,18 @@ static const char help_msg[] = \
 	"reload - reload a device/devices\r\n"
 	"\r\nThis command requires root/sudo permissions.\r\n"
 	"\r\nUsage:\r\n"
-	"\t" APP_NAME " reload -t <type> [-d <bdf>]\r\n"
+	"\t" APP_NAME " reload -t <type> [-d <bdf>]...\r\n"
 	"\r\nOptions:\r\n"
 	"\t-h --help            Show this screen\r\n"
 	"\t-d <b>:[d].[f]       Specify the device BDF\r\n"
+	"\t                     May be repeated to reload several devices\r\n"
+	"\t                     in parallel (pci/sbr only); every device must\r\n"
+	"\t                     then be attached to the AMI driver\r\n"
 	"\t-t <type>            Specify reload type\r\n"
 	"\t                     Possible values are:\r\n"
 	"\t                       driver=reload the entire driver\r\n"
 	"\t                       pci=force a pci removal and bus rescan\r\n"
+	"\t                           (any PCI device when only one is given)\r\n"
 	"\t                       sbr=trigger a secondary bus reset\r\n"
 ;
 
@@ -133,6 +147,83 @@ static enum reload_type parse_reload_type(const char *reload_type)
 	return RELOAD_TYPE_INVALID;
 }
 
+/*
+ * Reload several devices.
+ */
+static int do_batch_reload(enum reload_type type, struct app_option *options, int num_devs)
+{
+	int ret = EXIT_FAILURE;
+	int i = 0;
+	uint16_t bdf = 0;
+	ami_device **devs = NULL;
+	struct app_option *opt = options;
+
+	devs = (ami_device**)calloc(num_devs, sizeof(ami_device*));
+
+	if (!devs) {
+		APP_ERROR("could not allocate memory");
+		return EXIT_FAILURE;
+	}
+
+	/*
+	 * Find all devices before touching any of them. Batch reloads need
+	 * device handles, so unlike a single PCI reload, devices which are
+	 * not attached to the AMI driver cannot be given here.
+	 */
+	while ((opt = find_app_option('d', opt)) && (i < num_devs)) {
+		if (ami_dev_find(opt->arg, &devs[i]) != AMI_STATUS_OK) {
+			APP_API_ERROR(
+				"could not find the requested device "
+				"(only AMI devices can be reloaded together)"
+			);
+			goto free_devs;
+		}
+
+		opt = opt->next;
+		i++;
+	}
+
+	if (type == RELOAD_TYPE_SBR) {
+		printf("Will trigger a secondary bus reset on %d devices. This may take a minute...\r\n", num_devs);
+		ret = ami_dev_hot_reset_batch(devs, num_devs);
+	} else {
+		printf("Removing %d PCI devices and rescanning...\r\n", num_devs);
+		ret = ami_dev_pci_reload_batch(devs, num_devs);
+	}
+
+	if (ret == AMI_STATUS_OK) {
+		printf("Done.\r\n");
+		ret = EXIT_SUCCESS;
+	} else {
+		APP_API_ERROR("could not reload all devices");
+		ret = EXIT_FAILURE;
+	}
+
+	/* Report devices which did not come back */
+	opt = options;
+	for (i = 0; (i < num_devs) && (opt = find_app_option('d', opt)); i++) {
+		if (!devs[i]) {
+			bdf = ami_parse_bdf(opt->arg);
+			fprintf(
+				stderr,
+				"Device " AMI_BDF_FORMAT " is not available\r\n",
+				AMI_PCI_BUS(bdf),
+				AMI_PCI_DEV(bdf),
+				AMI_PCI_FUNC(bdf)
+			);
+		}
+
+		opt = opt->next;
+	}
+
+free_devs:
+	for (i = 0; i < num_devs; i++)
+		ami_dev_delete(&devs[i]);
+
+	free(devs);
+	return ret;
+}
+
 /*
  * "reload" command callback.
  */
@@ -171,6 +262,18 @@ static int do_cmd_reload(struct app_option *options, int num_args, char **args)
 			return EXIT_FAILURE;
 		}
 
+		/* Several devices are reloaded together */
+		if (find_app_option('d', opt->next)) {
+			int num_devs = 0;
+
+			while (opt) {
+				num_devs++;
+				opt = find_app_option('d', opt->next);
+			}
+
+			return do_batch_reload(type, options, num_devs);
+		}
+
 		bdf_string = opt->arg;
 
 		/*
@@ -69,4 +69,10 @@ extern struct app_cmd cmd_module_byte_wr;
 /* "debug_verbosity" handler */
 extern struct app_cmd cmd_debug_verbosity;
 
+/* "echo" handler */
+extern struct app_cmd cmd_echo;
+
+/* "exporter" handler */
+extern struct app_cmd cmd_exporter;
+
 #endif
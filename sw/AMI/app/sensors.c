@@ -459,7 +459,7 @@ static int mk_sensor_row(ami_device *dev, const char *sensor,
 		"%s",
 		(((values.status == AMI_SENSOR_STATUS_OK) || (values.status == AMI_SENSOR_STATUS_OK_CACHED)) ?
 			((values.status == AMI_SENSOR_STATUS_OK_CACHED) ? ("valid*") : ("valid")) :
-			("invalid"))
+			((values.status == AMI_SENSOR_STATUS_QUARANTINED) ? ("quarantined") : ("invalid")))
 	);
 
 	/* Extra attributes. */
@@ -16,6 +16,7 @@
 
 #include "amc_proxy.h"
 #include "ami_program.h"  /* Need some #defines from here */
+#include "ami_utils.h"
 
 
 /*****************************************************************************/
@@ -43,6 +44,7 @@
  * @AMC_PROXY_CMD_OPCODE_EEPROM_READ_WRITE: eeprom read/write request
  * @AMC_PROXY_CMD_OPCODE_MODULE_READ_WRITE: module read/write request
  * @AMC_PROXY_CMD_OPCODE_DEBUG_VERBOSITY: debug verbosity set request
+ * @AMC_PROXY_CMD_OPCODE_ECHO: echo a shared memory payload back to the host
  * @AMC_PROXY_CMD_OPCODE_PDI_DOWNLOAD: pdi download
  * @AMC_PROXY_CMD_OPCODE_SENSOR: sensor request
  * @AMC_PROXY_CMD_OPCODE_PARTITION_COPY: partition copy request
@@ -54,6 +56,7 @@ enum amc_proxy_cmd_opcode {
     AMC_PROXY_CMD_OPCODE_EEPROM_READ_WRITE = 0x3,
     AMC_PROXY_CMD_OPCODE_MODULE_READ_WRITE = 0x4,
     AMC_PROXY_CMD_OPCODE_DEBUG_VERBOSITY   = 0x5,
+    AMC_PROXY_CMD_OPCODE_ECHO              = 0x6,
     AMC_PROXY_CMD_OPCODE_PDI_DOWNLOAD      = 0xA,
     AMC_PROXY_CMD_OPCODE_SENSOR            = 0xC,
     AMC_PROXY_CMD_OPCODE_PARTITION_COPY    = 0xD,
@@ -240,6 +243,7 @@ struct amc_proxy_cmd_req_sensor_payload {
  * @boot_device: target boot device (used for fpt and download operation)
  * @src_device: boot device to copy from (applicable only to copy operation)
  * @dest_device: boot device to copy to (applicable only to copy operation)
+ * @codec: transfer codec of the chunk data (used for download operation)
  * @partition_resvd: reserved for future use
  * @last_chunk: 1 to indicate that this is the last data chunk
  * @chunk: current chunk (used only for download operation)
@@ -256,7 +260,8 @@ struct amc_proxy_cmd_data_payload {
         uint32_t boot_device:1;
         uint32_t src_device:1;
         uint32_t dest_device:1;
-	uint32_t partition_resvd:16;
+	uint32_t codec:4;
+	uint32_t partition_resvd:12;
 	uint16_t last_chunk:1;
 	uint16_t chunk:15;
 	uint16_t chunk_size;
@@ -300,6 +305,19 @@ struct amc_proxy_cmd_module_payload {
         uint32_t resvd:31;
 };
 
+/**
+ * struct amc_proxy_cmd_echo_payload: echo request payload command
+ *
+ * @address: address in shared memory of the payload
+ * @size: number of payload bytes
+ * @cookie: value returned unchanged in the response
+ */
+struct amc_proxy_cmd_echo_payload {
+        uint64_t address;
+        uint32_t size;
+        uint32_t cookie;
+};
+
 /**
  * struct amc_proxy_cmd_heartbeat_payload: heartbeat request payload command
  *
@@ -318,6 +336,7 @@ struct amc_proxy_cmd_heartbeat_payload {
  * @heartbeat_payload: the heartbeat request payload
  * @eeprom_payload: the eeprom read/write request payload
  * @module_payload: the module read/write request payload
+ * @echo_payload: the echo request payload
  * @debug_verbosity_payload: the debug verbosity request payload
  */
 struct amc_proxy_cmd_request {
@@ -328,6 +347,7 @@ struct amc_proxy_cmd_request {
                 struct amc_proxy_cmd_heartbeat_payload heartbeat_payload;
                 struct amc_proxy_cmd_eeprom_payload eeprom_payload;
                 struct amc_proxy_cmd_module_payload module_payload;
+                struct amc_proxy_cmd_echo_payload echo_payload;
                 uint8_t debug_verbosity_payload;
 	};
 };
@@ -391,11 +411,22 @@ struct amc_proxy_cmd_resp_data_payload {
  * struct amc_proxy_cmd_resp_heartbeat_payload: heartbeat response payload
  *
  * @request_id: the request id
- * @resvd: reserved
+ * @progress: long running request progress counter (0 on older firmware)
  */
 struct amc_proxy_cmd_resp_heartbeat_payload {
 	uint32_t request_id;
-        uint32_t resvd;
+        uint32_t progress;
+};
+
+/**
+ * struct amc_proxy_cmd_resp_echo_payload: echo response payload
+ *
+ * @cookie: the cookie sent in the request
+ * @checksum: byte sum of the payload as seen by the AMC
+ */
+struct amc_proxy_cmd_resp_echo_payload {
+        uint32_t cookie;
+        uint32_t checksum;
 };
 
 /**
@@ -683,6 +714,39 @@ static void amc_proxy_remove_submitted_cmd(struct amc_proxy_instance *inst,
 	mutex_unlock(&(inst->lock));
 }
 
+/**
+ * amc_proxy_set_submitted_cmd_timeout() - move the deadline of a submitted command
+ *
+ * @inst: the proxy instance
+ * @ccmd: the submitted command
+ * @timeout_jiffies: the new deadline
+ *
+ * Return: 0 if updated or -ENOENT if the command is no longer outstanding
+ */
+static int amc_proxy_set_submitted_cmd_timeout(struct amc_proxy_instance *inst,
+                                               struct amc_proxy_cmd_struct *ccmd,
+                                               uintptr_t timeout_jiffies)
+{
+	struct amc_proxy_cmd_struct *cmd = NULL;
+	int ret = -ENOENT;
+
+	if (!inst || !ccmd) {
+		return -EINVAL;
+        }
+
+	mutex_lock(&(inst->lock));
+	list_for_each_entry(cmd, &(inst->submitted_cmds), cmd_list) {
+		if (cmd == ccmd) {
+			cmd->cmd_timeout_jiffies = timeout_jiffies;
+			ret = 0;
+			break;
+		}
+	}
+	mutex_unlock(&(inst->lock));
+
+	return ret;
+}
+
 /**
  * amc_proxy_submitted_cmd_check_timeout() - check for any timed out requests
  *
@@ -813,7 +877,7 @@ static struct amc_proxy_list_entry * amc_proxy_find_matching_proxy_instance(cons
  * Initialise the AMC proxy layer, creating resources and opening
  * a handle to the FW_IF abstraction
  */
-int amc_proxy_init(uint8_t proxy_id, FW_IF_CFG *fw_if_handle)
+int amc_proxy_init(uint8_t proxy_id, FW_IF_CFG *fw_if_handle, int node)
 {
         int ret = 0;
 
@@ -826,7 +890,7 @@ int amc_proxy_init(uint8_t proxy_id, FW_IF_CFG *fw_if_handle)
 
                 const char *ap_thread_name = "amc proxy";
                 struct amc_proxy_list_entry *amc_proxy_entry = NULL;
-                amc_proxy_entry = kzalloc(sizeof(struct amc_proxy_list_entry), GFP_KERNEL);
+                amc_proxy_entry = kzalloc_node(sizeof(struct amc_proxy_list_entry), GFP_KERNEL, node);
 
                 if (!amc_proxy_entry) {
                         PR_ERR("Unable to allocate memory for amc context");
@@ -841,9 +905,10 @@ int amc_proxy_init(uint8_t proxy_id, FW_IF_CFG *fw_if_handle)
                 INIT_LIST_HEAD(&(amc_proxy_entry->inst.submitted_cmds));
 
                 /* Create thread to handle command responses */
-                amc_proxy_entry->inst.response_thread = kthread_create(complete_response_thread,
-                                                                       &amc_proxy_entry->inst,
-                                                                       ap_thread_name);
+                amc_proxy_entry->inst.response_thread = kthread_create_local(complete_response_thread,
+                                                                             &amc_proxy_entry->inst,
+                                                                             node,
+                                                                             ap_thread_name);
 	        if (IS_ERR(amc_proxy_entry->inst.response_thread)) {
 		        PR_ERR("Unable to create the %s thread", ap_thread_name);
 		        ret = PTR_ERR(amc_proxy_entry->inst.response_thread);
@@ -969,6 +1034,26 @@ int amc_proxy_request_abort(struct amc_proxy_cmd_struct *cmd)
         return ret;
 }
 
+/*
+ * Move the deadline of an in progress request
+ */
+int amc_proxy_request_set_timeout(struct amc_proxy_cmd_struct *cmd,
+                                  uintptr_t timeout_jiffies)
+{
+        struct amc_proxy_list_entry *amc_ctxt = NULL;
+        int ret = -EPERM;
+
+        if (!cmd) {
+               return(-EINVAL);
+        }
+
+        amc_ctxt = amc_proxy_find_matching_proxy_instance(cmd->cmd_fw_if_gcq);
+        if (amc_ctxt && amc_ctxt->inst.initialised)
+                ret = amc_proxy_set_submitted_cmd_timeout(&amc_ctxt->inst, cmd, timeout_jiffies);
+
+        return ret;
+}
+
 /*
  * Generate an identity request
  */
@@ -1087,6 +1172,7 @@ int amc_proxy_request_pdi_download(struct amc_proxy_cmd_struct *cmd,
                 request_cmd_entry.pdi_payload.last_chunk = pdi_download->last_chunk;
                 request_cmd_entry.pdi_payload.chunk = pdi_download->chunk;
                 request_cmd_entry.pdi_payload.chunk_size = pdi_download->chunk_size;
+                request_cmd_entry.pdi_payload.codec = pdi_download->codec;
 
                 if (pdi_download->partition == FPT_UPDATE_MAGIC) {
                         request_cmd_entry.pdi_payload.update_fpt = 1;
@@ -1368,6 +1454,48 @@ int amc_proxy_request_debug_verbosity(struct amc_proxy_cmd_struct *cmd, uint8_t
         return ret;
 }
 
+/*
+ * Generate an echo request
+ */
+int amc_proxy_request_echo(struct amc_proxy_cmd_struct *cmd,
+                           struct amc_proxy_echo_request *echo)
+{
+        struct amc_proxy_list_entry *amc_ctxt = NULL;
+        int ret = -EPERM;
+
+        if (!cmd || !echo)
+                return -EINVAL;
+
+        amc_ctxt = amc_proxy_find_matching_proxy_instance(cmd->cmd_fw_if_gcq);
+        if (amc_ctxt && amc_ctxt->inst.initialised) {
+
+                struct amc_proxy_cmd_request request_cmd_entry = {{{{0}}}};
+                struct amc_proxy_cmd_request_hdr *request_hdr = NULL;
+                request_hdr = &(request_cmd_entry.hdr);
+                request_hdr->state = AMC_PROXY_REQUEST_CMD_NEW;
+                request_hdr->opcode = AMC_PROXY_CMD_OPCODE_ECHO;
+                request_hdr->count = sizeof(request_cmd_entry.echo_payload);
+                request_hdr->cid = cmd->cmd_cid;
+                request_cmd_entry.echo_payload.address = echo->address;
+                request_cmd_entry.echo_payload.size = echo->length;
+                request_cmd_entry.echo_payload.cookie = echo->cookie;
+
+                ret = amc_ctxt->inst.fw_if_handle->write(amc_ctxt->inst.fw_if_handle, 0,
+                                                         (uint8_t*)&(request_cmd_entry),
+                                                         sizeof(request_cmd_entry), 0);
+                if (ret == FW_IF_ERRORS_NONE) {
+                        mutex_lock(&(amc_ctxt->inst.lock));
+                        list_add_tail(&(cmd->cmd_list), &(amc_ctxt->inst.submitted_cmds));
+                        mutex_unlock(&(amc_ctxt->inst.lock));
+                } else {
+                        PR_ERR("FW_IF write request failed; %d", ret);
+                        ret = -EIO;
+                }
+        }
+
+        return ret;
+}
+
 /*
  * Read back the identity response
  */
@@ -1510,6 +1638,7 @@ int amc_proxy_get_response_heartbeat(struct amc_proxy_cmd_struct *cmd,
                         (struct amc_proxy_cmd_resp_heartbeat_payload *)&cmd->cmd_response;
 
                 heartbeat->request_id = heartbeat_payload->request_id;
+                heartbeat->progress = heartbeat_payload->progress;
                 ret = amc_result_to_linux_errno(cmd->cmd_response_code);
         }
 
@@ -1572,3 +1701,30 @@ int amc_proxy_get_response_debug_verbosity(struct amc_proxy_cmd_struct *cmd)
         
         return ret;
 }
+
+/*
+ * Read back the echo response
+ */
+int amc_proxy_get_response_echo(struct amc_proxy_cmd_struct *cmd,
+                                struct amc_proxy_echo_response *echo)
+{
+        struct amc_proxy_list_entry *amc_ctxt = NULL;
+        int ret = -EPERM;
+
+        if (!cmd || !echo) {
+                return(-EINVAL);
+        }
+
+        amc_ctxt = amc_proxy_find_matching_proxy_instance(cmd->cmd_fw_if_gcq);
+        if (amc_ctxt && amc_ctxt->inst.initialised)
+        {
+                struct amc_proxy_cmd_resp_echo_payload *echo_payload =
+                        (struct amc_proxy_cmd_resp_echo_payload *)&cmd->cmd_response;
+
+                echo->cookie = echo_payload->cookie;
+                echo->checksum = echo_payload->checksum;
+                ret = amc_result_to_linux_errno(cmd->cmd_response_code);
+        }
+
+        return ret;
+}
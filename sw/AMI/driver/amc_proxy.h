@@ -145,6 +145,7 @@ struct amc_proxy_sensor_request {
  * @last_chunk: 1 to indicate that this is the last chunk
  * @chunk: current chunk number
  * @chunk_size: chunk size in KB
+ * @codec: transfer codec of the chunk data (0 if uncompressed)
  *
  * If partition is equal to `FPT_UPDATE_MAGIC`, will update the FPT.
  */
@@ -156,6 +157,7 @@ struct amc_proxy_pdi_download_request {
         uint16_t last_chunk;
         uint16_t chunk;
         uint16_t chunk_size;
+        uint16_t codec;
 };
 
 /**
@@ -224,6 +226,19 @@ struct amc_proxy_module_rw_request {
         uint8_t length;
 };
 
+/**
+ * struct amc_proxy_echo_request: the echo request data
+ *
+ * @address: the address of the payload in shared memory
+ * @length: the number of payload bytes
+ * @cookie: value returned unchanged in the response
+ */
+struct amc_proxy_echo_request {
+        uint64_t address;
+        uint32_t length;
+        uint32_t cookie;
+};
+
 /**
  * struct amc_proxy_identify_response: AMC/GCQ version data
  *
@@ -249,9 +264,23 @@ struct amc_proxy_identify_response {
  * struct amc_proxy_heartbeat_response: the heartbeat response data
  *
  * @request_id: the id associated with the request/response
+ * @progress: progress counter of any long running request; bit 31 is set
+ *   by firmware which reports progress
  */
 struct amc_proxy_heartbeat_response {
         uint8_t request_id;
+        uint32_t progress;
+};
+
+/**
+ * struct amc_proxy_echo_response: the echo response data
+ *
+ * @cookie: the cookie sent in the request
+ * @checksum: byte sum of the payload as seen by the AMC
+ */
+struct amc_proxy_echo_response {
+        uint32_t cookie;
+        uint32_t checksum;
 };
 
 /**
@@ -297,10 +326,11 @@ struct amc_proxy_cmd_struct{
  *
  * @proxy_id: unique id to the proxy layer
  * @fw_if_handle: handle to the fw interface
+ * @node: NUMA node of the device - the response thread and instance data are kept local to it
  *
  * Return: The errno return code
  */
-int amc_proxy_init(uint8_t proxy_id, FW_IF_CFG *fw_if_handle);
+int amc_proxy_init(uint8_t proxy_id, FW_IF_CFG *fw_if_handle, int node);
 
 /**
  * amc_proxy_bind_callback() - Bind in the an event callback
@@ -330,6 +360,19 @@ int amc_proxy_close(const FW_IF_CFG *fw_if_handle);
  */
 int amc_proxy_request_abort(struct amc_proxy_cmd_struct *cmd);
 
+/**
+ * amc_proxy_request_set_timeout() - Move the deadline of a request already in progress
+ *
+ * @cmd: the proxy command structure
+ * @timeout_jiffies: the new deadline
+ *
+ * Has no effect once the request has completed or timed out.
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_request_set_timeout(struct amc_proxy_cmd_struct *cmd,
+                                  uintptr_t timeout_jiffies);
+
 /**
  * amc_proxy_request_identity() - Request the identify
  *
@@ -429,6 +472,20 @@ int amc_proxy_request_module_read_write(struct amc_proxy_cmd_struct *cmd,
  */
 int amc_proxy_request_debug_verbosity(struct amc_proxy_cmd_struct *cmd, uint8_t verbosity);
 
+/**
+ * amc_proxy_request_echo() - echo request
+ *
+ * @cmd: the proxy command structure
+ * @echo: a structure populated with the echo request
+ *
+ * The AMC sums the payload at `address`, inverts it in place and returns the
+ * cookie and sum in the response.
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_request_echo(struct amc_proxy_cmd_struct *cmd,
+                           struct amc_proxy_echo_request *echo);
+
 /**
  * amc_proxy_get_response_identity() - retrieve the identity response
  *
@@ -521,4 +578,15 @@ int amc_proxy_get_response_module_read_write(struct amc_proxy_cmd_struct *cmd);
  */
 int amc_proxy_get_response_debug_verbosity(struct amc_proxy_cmd_struct *cmd);
 
+/**
+ * amc_proxy_get_response_echo() - retrieve the echo response
+ *
+ * @cmd: the proxy command structure
+ * @echo: the structure to be populated with the response
+ *
+ * Return: The errno return code
+ */
+int amc_proxy_get_response_echo(struct amc_proxy_cmd_struct *cmd,
+                                struct amc_proxy_echo_response *echo);
+
 #endif /* _AMC_PROXY_H_ */
@@ -9,6 +9,7 @@
 #include <linux/delay.h>
 #include <linux/device.h>
 #include <linux/types.h>
+#include <linux/math64.h>
 
 #include "gcq.h"
 #include "ami_top.h"
@@ -19,6 +20,7 @@
 #include "ami_log.h"
 #include "ami_module.h"
 #include "ami_driver_version.h"
+#include "ami_utils.h"
 
 /*****************************************************************************/
 /* Local Varaiables                                                          */
@@ -26,6 +28,12 @@
 
 static DEFINE_XARRAY_ALLOC(cid_xarray);
 
+/*
+ * Devices are probed and brought up in parallel; the GCQ FAL profiles and
+ * the proxy instance list are global so opening/closing them is serialised.
+ */
+static DEFINE_MUTEX(amc_proxy_setup_lock);
+
 
 /*****************************************************************************/
 /* Defines                                                                   */
@@ -33,8 +41,6 @@ static DEFINE_XARRAY_ALLOC(cid_xarray);
 
 #define MAX_COMMAND_IDS             (255)
 
-#define DEVICE_READY_SLEEP_INTERVAL (100)
-#define DEVICE_READY_RETRY_COUNT    (5)
 #define REQUEST_MSQ_TIMEOUT         (msecs_to_jiffies(30000))       /* 30 seconds */
 /*
  * Timeout for the PDI download can be small as we are packetising the
@@ -42,20 +48,37 @@ static DEFINE_XARRAY_ALLOC(cid_xarray);
  */
 #define REQUEST_DOWNLOAD_TIMEOUT    (msecs_to_jiffies(30000))       /* 30 seconds */
 #define REQUEST_COPY_TIMEOUT        (msecs_to_jiffies(3600000))     /* 60 minutes - based on example max parition size of 128MB */
+/*
+ * The two timeouts above are only used when the AMC does not report progress.
+ * Otherwise a download or copy fails once the heartbeat progress counter has
+ * not moved for REQUEST_PROGRESS_WINDOW, and in any case once it has run for
+ * longer than the transfer size at REQUEST_MIN_BYTES_PER_SEC.
+ */
+#define REQUEST_PROGRESS_WINDOW     (msecs_to_jiffies(10000))       /* 10 seconds */
+#define REQUEST_MIN_BYTES_PER_SEC   (64 * 1024)
 #define REQUEST_HEARTBEAT_TIMEOUT   (msecs_to_jiffies(500))         /* 0.5 seconds */
+#define REQUEST_ECHO_TIMEOUT        (msecs_to_jiffies(5000))        /* 5 seconds */
 #define HEARTBEAT_REQUEST_INTERVAL  (500)
 #define LOGGING_SLEEP_INTERVAL      (500)
+#define BULK_QUEUE_WAIT_MS          (5000)
+#define BULK_QUEUE_POLL_MS          (100)
 
 
 /* AMC Identify Command Version Major and Minor Numbers */
 #define AMC_GCQ_IDENTIFY_CMD_MAJOR  (1)
 #define AMC_GCQ_IDENTIFY_CMD_MINOR  (0)
 #define AMC_GCQ_MAGIC_NO            (0x564D5230)
+#define AMC_GCQ_QUEUE_MAGIC_NO      (0x47435132)
+#define AMC_GCQ_NUM_QUEUES_BULK     (2)
 #define VERSION_BUF_SIZE            (8)
 
 /* Number of permitted failures before raising a fatal event */
 #define HEARTBEAT_FAIL_THRESHOLD    (3)
 
+/* Heartbeat progress word - bit 31 is set by firmware which reports progress */
+#define HEARTBEAT_PROGRESS_VALID    (0x80000000)
+#define HEARTBEAT_PROGRESS_MASK     (0x7FFFFFFF)
+
 
 /*****************************************************************************/
 /* Private functions                                                         */
@@ -199,90 +222,96 @@ static int get_aid(int cmd_req, int flags)
  * gcq_device_is_ready() - check that the GCQ is ready.
  * @amc_ctrl_ctxt: AMC data struct instance.
  *
- * Wait for gcq service is fully ready after a reset.
+ * Check (without blocking) whether the gcq service is fully ready after a
+ * reset. Retrying is left to the caller.
  *
- * Return: None.
+ * Return: true if ready, false otherwise.
  */
 static bool gcq_device_is_ready(struct amc_control_ctxt *amc_ctrl_ctxt)
 {
-	int i = 0, retry = DEVICE_READY_RETRY_COUNT, interval = DEVICE_READY_SLEEP_INTERVAL;
-
 	if (!amc_ctrl_ctxt)
-		return -EINVAL;
+		return false;
 
-	for (i = 0; i < retry; i++) {
-		msleep(interval);
-		memcpy_fromio(&(amc_ctrl_ctxt->amc_shared_mem),
-			      amc_ctrl_ctxt->gcq_payload_base_virt_addr,
-			      sizeof(amc_ctrl_ctxt->amc_shared_mem));
+	memcpy_fromio(&(amc_ctrl_ctxt->amc_shared_mem),
+		      amc_ctrl_ctxt->gcq_payload_base_virt_addr,
+		      sizeof(amc_ctrl_ctxt->amc_shared_mem));
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "************ AMC Shared Memory ***************, virt_addr : %p",
-			 amc_ctrl_ctxt->gcq_payload_base_virt_addr);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "************ AMC Shared Memory ***************, virt_addr : %p",
+		 amc_ctrl_ctxt->gcq_payload_base_virt_addr);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Magic number                                   : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.amc_magic_no);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Magic number                                   : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.amc_magic_no);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Offset of gcq ring buffer inited by gcq server : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.ring_buffer.ring_buffer_off);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Offset of gcq ring buffer inited by gcq server : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.ring_buffer.ring_buffer_off);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Length of gcq ring buffer inited by gcq server : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.ring_buffer.ring_buffer_len);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Length of gcq ring buffer inited by gcq server : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.ring_buffer.ring_buffer_len);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Offset of amc device status                    : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.status.amc_status_off);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Offset of amc device status                    : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.status.amc_status_off);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Length of amc device status                    : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.status.amc_status_len);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Length of amc device status                    : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.status.amc_status_len);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Current index of ring buffer log               : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.log_msg.log_msg_index);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Current index of ring buffer log               : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.log_msg.log_msg_index);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Offset of dbg log                              : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.log_msg.log_msg_buf_off);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Offset of dbg log                              : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.log_msg.log_msg_buf_off);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Length of dbg log                              : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.log_msg.log_msg_buf_len);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Length of dbg log                              : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.log_msg.log_msg_buf_len);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Offset of data buffer started                  : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.data.amc_data_start);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Offset of data buffer started                  : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.data.amc_data_start);
 
-		AMI_VDBG(amc_ctrl_ctxt,
-			 "Offset of data buffer ended                    : 0x%x",
-			 amc_ctrl_ctxt->amc_shared_mem.data.amc_data_end);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Offset of data buffer ended                    : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.data.amc_data_end);
 
-		if (amc_ctrl_ctxt->amc_shared_mem.amc_magic_no == AMC_GCQ_MAGIC_NO) {
-			uint32_t amc_status = 0;
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Queue magic number                             : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.queues.queue_magic_no);
 
-			AMI_VDBG(amc_ctrl_ctxt, "AMC Magic Number found");
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Number of queue pairs                          : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.queues.num_queues);
 
-			/* Read the device status (amc_status_off from payload) */
-			amc_status = ioread32(amc_ctrl_ctxt->gcq_payload_base_virt_addr +
-					      amc_ctrl_ctxt->amc_shared_mem.status.amc_status_off);
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Offset of bulk gcq ring buffer                 : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.queues.bulk_ring_buffer_off);
 
-			AMI_VDBG(amc_ctrl_ctxt, "Device status value : %x", amc_status);
-			if (amc_status) {
-				AMI_VDBG(amc_ctrl_ctxt,
-					 "AMC GCQ service ready after %d ms",
-					 interval * i);
-				return true;
-			}
+	AMI_VDBG(amc_ctrl_ctxt,
+		 "Length of bulk gcq ring buffer                 : 0x%x",
+		 amc_ctrl_ctxt->amc_shared_mem.queues.bulk_ring_buffer_len);
+
+	if (amc_ctrl_ctxt->amc_shared_mem.amc_magic_no == AMC_GCQ_MAGIC_NO) {
+		uint32_t amc_status = 0;
+
+		AMI_VDBG(amc_ctrl_ctxt, "AMC Magic Number found");
+
+		/* Read the device status (amc_status_off from payload) */
+		amc_status = ioread32(amc_ctrl_ctxt->gcq_payload_base_virt_addr +
+				      amc_ctrl_ctxt->amc_shared_mem.status.amc_status_off);
+
+		AMI_VDBG(amc_ctrl_ctxt, "Device status value : %x", amc_status);
+		if (amc_status) {
+			AMI_VDBG(amc_ctrl_ctxt, "AMC GCQ service ready");
+			return true;
 		}
 	}
 
-	AMI_ERR(amc_ctrl_ctxt,
-		"AMC GCQ service not ready after %d ms",
-		interval * retry);
-
 	return false;
 }
 
@@ -292,25 +321,18 @@ static bool gcq_device_is_ready(struct amc_control_ctxt *amc_ctrl_ctxt)
  *
  * Start service to allow incoming requests to be handled
  *
- * Return: None.
+ * Return: 0, -EAGAIN if the GCQ is not ready yet or negative error code.
  */
 static int start_gcq_services(struct amc_control_ctxt *amc_ctrl_ctxt)
 {
-	int ret = 0;
-	bool dev_rdy = false;
-
 	if (!amc_ctrl_ctxt)
 		return -EINVAL;
 
-	AMI_VDBG(amc_ctrl_ctxt, "Starting AMC services");
-
 	/* Check if device is ready */
-	dev_rdy = gcq_device_is_ready(amc_ctrl_ctxt);
-	if (!dev_rdy) {
-		AMI_ERR(amc_ctrl_ctxt, "Device not ready, reboot required!");
-		ret = -ENODEV;
-		goto fail;
-	}
+	if (!gcq_device_is_ready(amc_ctrl_ctxt))
+		return -EAGAIN;
+
+	AMI_VDBG(amc_ctrl_ctxt, "Starting AMC services");
 
 	amc_ctrl_ctxt->gcq_ring_buf_base_virt_addr = amc_ctrl_ctxt->gcq_payload_base_virt_addr +
 						     amc_ctrl_ctxt->amc_shared_mem.ring_buffer.ring_buffer_off;
@@ -326,10 +348,6 @@ static int start_gcq_services(struct amc_control_ctxt *amc_ctrl_ctxt)
 
 	AMI_VDBG(amc_ctrl_ctxt, "Successfully started AMC service");
 	return SUCCESS;
-
-fail:
-	AMI_ERR(amc_ctrl_ctxt, "Failed to start AMC service");
-	return ret;
 }
 
 /**
@@ -795,6 +813,10 @@ static enum amc_cmd_id get_cmd_command_id(enum gcq_submit_cmd_req cmd_req)
 		id = AMC_CMD_ID_DEBUG_VERBOSITY;
 		break;
 
+	case GCQ_SUBMIT_CMD_ECHO:
+		id = AMC_CMD_ID_ECHO;
+		break;
+
 	default:
 		id = AMC_CMD_ID_UNKNOWN;
 		break;
@@ -937,6 +959,78 @@ static void release_amc(struct amc_control_ctxt **amc_ctrl_ctxt)
 	}
 }
 
+/**
+ * track_request_progress() - time a long running request on its progress
+ *
+ * @amc_ctrl_ctxt: the amc control context
+ * @cmd: the request, not yet submitted
+ * @size: number of bytes the request transfers
+ */
+static void track_request_progress(struct amc_control_ctxt *amc_ctrl_ctxt,
+				   struct amc_proxy_cmd_struct *cmd,
+				   uint32_t size)
+{
+	unsigned long ceiling = REQUEST_PROGRESS_WINDOW + msecs_to_jiffies(
+		div_u64((uint64_t)size * MSEC_PER_SEC, REQUEST_MIN_BYTES_PER_SEC));
+
+	mutex_lock(&amc_ctrl_ctxt->progress_lock);
+	amc_ctrl_ctxt->progress_cmd = cmd;
+	amc_ctrl_ctxt->progress_deadline = jiffies + ceiling;
+	cmd->cmd_timeout_jiffies = jiffies + REQUEST_PROGRESS_WINDOW;
+	mutex_unlock(&amc_ctrl_ctxt->progress_lock);
+}
+
+/**
+ * untrack_request_progress() - stop extending the deadline of a request
+ *
+ * @amc_ctrl_ctxt: the amc control context
+ * @cmd: the request passed to `track_request_progress`
+ */
+static void untrack_request_progress(struct amc_control_ctxt *amc_ctrl_ctxt,
+				     struct amc_proxy_cmd_struct *cmd)
+{
+	mutex_lock(&amc_ctrl_ctxt->progress_lock);
+	if (amc_ctrl_ctxt->progress_cmd == cmd)
+		amc_ctrl_ctxt->progress_cmd = NULL;
+	mutex_unlock(&amc_ctrl_ctxt->progress_lock);
+}
+
+/**
+ * update_request_progress() - handle the progress word of a heartbeat
+ *
+ * @amc_ctrl_ctxt: the amc control context
+ * @progress: progress word returned by the AMC
+ *
+ * If the counter moved, the tracked request gets another progress window
+ * (capped at its size based ceiling).
+ */
+static void update_request_progress(struct amc_control_ctxt *amc_ctrl_ctxt,
+				    uint32_t progress)
+{
+	unsigned long deadline = 0;
+
+	if (!(progress & HEARTBEAT_PROGRESS_VALID))
+		return;
+
+	progress &= HEARTBEAT_PROGRESS_MASK;
+
+	mutex_lock(&amc_ctrl_ctxt->progress_lock);
+	WRITE_ONCE(amc_ctrl_ctxt->progress_supported, true);
+
+	if (progress != amc_ctrl_ctxt->last_progress) {
+		amc_ctrl_ctxt->last_progress = progress;
+
+		if (amc_ctrl_ctxt->progress_cmd) {
+			deadline = jiffies + REQUEST_PROGRESS_WINDOW;
+			if (time_after(deadline, amc_ctrl_ctxt->progress_deadline))
+				deadline = amc_ctrl_ctxt->progress_deadline;
+
+			amc_proxy_request_set_timeout(amc_ctrl_ctxt->progress_cmd, deadline);
+		}
+	}
+	mutex_unlock(&amc_ctrl_ctxt->progress_lock);
+}
+
 /**
  * heartbeat_health_thread() - the heartbeat health thread
  *
@@ -1176,6 +1270,36 @@ int get_rid(int repo_type)
 	return id;
 }
 
+/**
+ * select_gcq_queue() - pick the queue pair a request is submitted on.
+ * @amc_ctrl_ctxt: AMC data struct instance.
+ * @cmd_id: the AMC command being submitted.
+ *
+ * Long running transfers are routed to the bulk queue pair (if the AMC offers
+ * one) so that they do not hold up sensor, heartbeat and other short requests.
+ *
+ * Return: the FAL handle of the selected queue pair.
+ */
+static FW_IF_CFG *select_gcq_queue(struct amc_control_ctxt *amc_ctrl_ctxt,
+				   enum amc_cmd_id cmd_id)
+{
+	if (!amc_ctrl_ctxt->bulk_queue_enabled)
+		return &amc_ctrl_ctxt->fw_if_cfg;
+
+	switch (cmd_id) {
+	case AMC_CMD_ID_DOWNLOAD_PDI:
+	case AMC_CMD_ID_COPY_PARTITION:
+	case AMC_CMD_ID_EEPROM_READ_WRITE:
+	case AMC_CMD_ID_MODULE_READ_WRITE:
+		return &amc_ctrl_ctxt->fw_if_bulk_cfg;
+
+	default:
+		break;
+	}
+
+	return &amc_ctrl_ctxt->fw_if_cfg;
+}
+
 /*
  * Top level function to submit a request and wait on response
  */
@@ -1195,6 +1319,7 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	struct amc_proxy_cmd_struct *amc_proxy_cmd = NULL;
 	uint32_t payload_size = 0;
 	uint64_t payload_address = 0;
+	uint32_t echo_checksum = 0;
 	uint16_t cid = 0;
 	struct completion *req_complete = NULL;
 
@@ -1216,7 +1341,7 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		goto done;
 	}
 
-	if (cmd_id != AMC_CMD_ID_HEARTBEAT)
+	if ((cmd_id != AMC_CMD_ID_HEARTBEAT) && (cmd_id != AMC_CMD_ID_ECHO))
 		AMI_DBG(amc_ctrl_ctxt, "Submitting command [%d] with resp len %d", cmd_id, data_size);
 
 	switch (cmd_id) {
@@ -1227,6 +1352,7 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	case AMC_CMD_ID_HEARTBEAT:
 	case AMC_CMD_ID_EEPROM_READ_WRITE:
 	case AMC_CMD_ID_MODULE_READ_WRITE:
+	case AMC_CMD_ID_ECHO:
 		if (!data_buf) {
 			ret = -EINVAL;
 			goto done;
@@ -1252,7 +1378,8 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		goto done;
 	}
 
-	amc_proxy_cmd = kzalloc(sizeof(struct amc_proxy_cmd_struct), GFP_KERNEL);
+	amc_proxy_cmd = kzalloc_node(sizeof(struct amc_proxy_cmd_struct), GFP_KERNEL,
+				     AMI_NODE(amc_ctrl_ctxt));
 	if (!amc_proxy_cmd) {
 		AMI_ERR(amc_ctrl_ctxt, "Failed to allocate kernel memory for amc_proxy_cmd");
 		ret = -ENOMEM;
@@ -1422,6 +1549,35 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	}
 	break;
 
+	case AMC_CMD_ID_ECHO:
+	{
+		uint32_t i = 0;
+
+		if (acquire_gcq_data(amc_ctrl_ctxt, (uint32_t *)&(payload_address), &length)) {
+			ret = -EIO;
+			goto done;
+		}
+
+		data_page_acquired = true;
+
+		/* Truncating would skew the measurement, so reject oversized payloads */
+		if (length < data_size) {
+			AMI_ERR(amc_ctrl_ctxt,
+				"Echo payload size is %d but allocated length is %d",
+				data_size,
+				length);
+			ret = -EINVAL;
+			goto done;
+		}
+
+		payload_size = data_size;
+		for (i = 0; i < data_size; i++)
+			echo_checksum += data_buf[i];
+
+		memcpy_gcq_payload_to_device(amc_ctrl_ctxt, payload_address, data_buf, data_size);
+	}
+	break;
+
 	default:
 		break;
 	}
@@ -1444,7 +1600,7 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	/* Set timeout in ms */
 	amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_MSQ_TIMEOUT;
 	amc_proxy_cmd->cmd_arg = amc_ctrl_ctxt;
-	amc_proxy_cmd->cmd_fw_if_gcq = &amc_ctrl_ctxt->fw_if_cfg;
+	amc_proxy_cmd->cmd_fw_if_gcq = select_gcq_queue(amc_ctrl_ctxt, cmd_id);
 	amc_proxy_cmd->cmd_rcode = 0;
 	amc_proxy_cmd->cmd_suppress_dbg = false;
 	amc_proxy_cmd->cmd_opcode = cmd_id;
@@ -1485,8 +1641,17 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		pdi_download_request.last_chunk = PDI_CHUNK_IS_LAST(flags);
 		pdi_download_request.chunk = PDI_CHUNK(flags);
 		pdi_download_request.chunk_size = PDI_CHUNK_SIZE;
-		/* Set longer timeout for the PDI download */
-		amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_DOWNLOAD_TIMEOUT;
+		pdi_download_request.codec = PDI_CODEC(flags);
+		/*
+		 * Set longer timeout for the PDI download - a compressed chunk
+		 * still costs the AMC a full chunk of flash writes.
+		 */
+		if (READ_ONCE(amc_ctrl_ctxt->progress_supported))
+			track_request_progress(amc_ctrl_ctxt, amc_proxy_cmd,
+				(pdi_download_request.codec) ?
+				(PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER) : (payload_size));
+		else
+			amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_DOWNLOAD_TIMEOUT;
 		ret = amc_proxy_request_pdi_download(amc_proxy_cmd, &pdi_download_request);
 	}
 	break;
@@ -1512,7 +1677,10 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		partition_copy_request.length = payload_size;
 		partition_copy_request.address = payload_address;
 		/* Set longer timeout for partition copy request. */
-		amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_COPY_TIMEOUT;
+		if (READ_ONCE(amc_ctrl_ctxt->progress_supported))
+			track_request_progress(amc_ctrl_ctxt, amc_proxy_cmd, payload_size);
+		else
+			amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_COPY_TIMEOUT;
 		ret = amc_proxy_request_partition_copy(amc_proxy_cmd, &partition_copy_request);
 	}
 	break;
@@ -1559,6 +1727,19 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		break;
 	}
 
+	case AMC_CMD_ID_ECHO:
+	{
+		struct amc_proxy_echo_request echo_req = { 0 };
+		/* Using the `flags` argument as the cookie. */
+		echo_req.address = payload_address;
+		echo_req.length = payload_size;
+		echo_req.cookie = flags;
+		amc_proxy_cmd->cmd_suppress_dbg = true;
+		amc_proxy_cmd->cmd_timeout_jiffies = jiffies + REQUEST_ECHO_TIMEOUT;
+		ret = amc_proxy_request_echo(amc_proxy_cmd, &echo_req);
+		break;
+	}
+
 	default:
 		ret = -EINVAL;
 		AMI_ERR(amc_ctrl_ctxt, "Unsupported request %d", cmd_id);
@@ -1590,7 +1771,7 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		goto done;
 	}
 
-	if (cmd_id != AMC_CMD_ID_HEARTBEAT) {
+	if ((cmd_id != AMC_CMD_ID_HEARTBEAT) && (cmd_id != AMC_CMD_ID_ECHO)) {
 		if (cmd_id == AMC_CMD_ID_SENSOR) {
 			AMI_DBG(amc_ctrl_ctxt,
 				"Command processed successfully, rcode: %d cmd_id: %d sensor_id: %d api: %d sid: %d",
@@ -1649,6 +1830,8 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		struct amc_proxy_heartbeat_response heartbeat = { 0 };
 		ret = amc_proxy_get_response_heartbeat(amc_proxy_cmd, &heartbeat);
 		memcpy(&data_buf[0], &(heartbeat.request_id), sizeof(uint8_t));
+		if (!ret)
+			update_request_progress(amc_ctrl_ctxt, heartbeat.progress);
 		break;
 	}
 
@@ -1674,6 +1857,25 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 		ret = amc_proxy_get_response_debug_verbosity(amc_proxy_cmd);
 		break;
 
+	case AMC_CMD_ID_ECHO:
+	{
+		struct amc_proxy_echo_response echo = { 0 };
+		ret = amc_proxy_get_response_echo(amc_proxy_cmd, &echo);
+		if (ret)
+			break;
+
+		if ((echo.cookie != flags) || (echo.checksum != echo_checksum)) {
+			AMI_ERR(amc_ctrl_ctxt,
+				"Echo mismatch, cookie 0x%X/0x%X checksum 0x%X/0x%X",
+				echo.cookie, flags, echo.checksum, echo_checksum);
+			ret = -EIO;
+			break;
+		}
+
+		memcpy_gcq_payload_from_device(amc_ctrl_ctxt, payload_address, data_buf, data_size);
+		break;
+	}
+
 	default:
 		AMI_ERR(amc_ctrl_ctxt, "Unsupported response %d", cmd_id);
 		break;
@@ -1681,6 +1883,10 @@ int submit_gcq_command(struct amc_control_ctxt	*amc_ctrl_ctxt,
 
 done:
 
+	if (amc_proxy_cmd &&
+	    ((cmd_id == AMC_CMD_ID_DOWNLOAD_PDI) || (cmd_id == AMC_CMD_ID_COPY_PARTITION)))
+		untrack_request_progress(amc_ctrl_ctxt, amc_proxy_cmd);
+
 	if (amc_proxy_cmd)
 		remove_gcq_cid(amc_ctrl_ctxt, amc_proxy_cmd->cmd_cid);
 
@@ -1729,16 +1935,14 @@ int setup_amc(struct pci_dev		*dev,
 	      void			*event_cb_data)
 {
 	int ret = 0;
-	char *version_buf = NULL;
-	const char *amc_hb_thread_name = "amc heartbeat";
-	const char *amc_log_thread_name = "amc logging";
 
 	if (!dev || !amc_ctrl_ctxt)
 		return -EINVAL;
 
 	DEV_VDBG(dev, "Setting up AMC GCQ");
 
-	*amc_ctrl_ctxt = kzalloc(sizeof(struct amc_control_ctxt), GFP_KERNEL);
+	*amc_ctrl_ctxt = kzalloc_node(sizeof(struct amc_control_ctxt), GFP_KERNEL,
+				      dev_to_node(&dev->dev));
 	if (!(*amc_ctrl_ctxt)) {
 		DEV_ERR(dev, "Failed to allocate kernel memory for amc_ctrl_ctxt");
 		ret = -ENOMEM;
@@ -1751,9 +1955,12 @@ int setup_amc(struct pci_dev		*dev,
 	(*amc_ctrl_ctxt)->gcq_payload_base_virt_addr = NULL;
 	(*amc_ctrl_ctxt)->heartbeat_thread_created = false;
 	(*amc_ctrl_ctxt)->logging_thread_created = false;
+	(*amc_ctrl_ctxt)->event_cb = event_cb;
+	(*amc_ctrl_ctxt)->event_cb_data = event_cb_data;
 
 	mutex_init(&((*amc_ctrl_ctxt)->lock));
 	mutex_init(&((*amc_ctrl_ctxt)->gcq_cmd_lock));
+	mutex_init(&((*amc_ctrl_ctxt)->progress_lock));
 	sema_init(&((*amc_ctrl_ctxt)->gcq_log_page_sema), 1);
 	sema_init(&((*amc_ctrl_ctxt)->gcq_data_sema), 1);
 
@@ -1762,97 +1969,193 @@ int setup_amc(struct pci_dev		*dev,
 	if (ret)
 		goto fail;
 
-	/* Start Service */
-	ret = start_gcq_services(*amc_ctrl_ctxt);
+	return SUCCESS;
+
+fail:
+	unset_amc(dev, amc_ctrl_ctxt);
+	release_amc_mem(amc_ctrl_ctxt);
+	DEV_ERR(dev, "Failed to setup AMC GCQ");
+
+	return ret;
+}
+
+/**
+ * start_bulk_queue() - set up the bulk queue pair, if the AMC offers one.
+ * @amc_ctrl_ctxt: AMC data struct instance.
+ *
+ * The bulk pair shares the GCQ IP with the primary pair and is only advertised
+ * once the AMC is servicing it. The AMC attaches it after the partition table
+ * is published, so the queue count is polled for up to BULK_QUEUE_WAIT_MS
+ * before giving up. Any failure here leaves the driver running on the primary
+ * pair alone.
+ */
+static void start_bulk_queue(struct amc_control_ctxt *amc_ctrl_ctxt)
+{
+	struct amc_queues *queues = &amc_ctrl_ctxt->amc_shared_mem.queues;
+	struct pci_dev *dev = amc_ctrl_ctxt->pcie_dev;
+	unsigned long deadline = jiffies + msecs_to_jiffies(BULK_QUEUE_WAIT_MS);
+	int ret = 0;
+
+	amc_ctrl_ctxt->bulk_queue_enabled = false;
+
+	if ((queues->queue_magic_no != AMC_GCQ_QUEUE_MAGIC_NO) || !queues->bulk_ring_buffer_len)
+		return;
+
+	/* The AMC bumps the queue count once the bulk pair is attached */
+	for (;;) {
+		queues->num_queues = ioread32(amc_ctrl_ctxt->gcq_payload_base_virt_addr +
+					      offsetof(struct amc_shared_mem, queues.num_queues));
+		if (queues->num_queues >= AMC_GCQ_NUM_QUEUES_BULK)
+			break;
+
+		if (time_after(jiffies, deadline)) {
+			DEV_WARN(dev, "Bulk queue pair not offered, using primary pair only");
+			return;
+		}
+
+		msleep(BULK_QUEUE_POLL_MS);
+	}
+
+	mutex_lock(&amc_proxy_setup_lock);
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.ullBaseAddress = (uint64_t)amc_ctrl_ctxt->gcq_base_virt_addr;
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.xInterruptMode = FW_IF_GCQ_INTERRUPT_MODE_NONE;
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.xMode = FW_IF_GCQ_MODE_CONSUMER;
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.ullRingAddress =
+		(uint64_t)(amc_ctrl_ctxt->gcq_payload_base_virt_addr + queues->bulk_ring_buffer_off);
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.ulRingLength = queues->bulk_ring_buffer_len;
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.ulSubmissionQueueSlotSize = AMC_PROXY_REQUEST_SIZE;
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.ulCompletionQueueSlotSize = AMC_PROXY_RESPONSE_SIZE;
+	amc_ctrl_ctxt->fw_if_gcq_bulk_consumer.xQueueType = FW_IF_GCQ_QUEUE_SECONDARY;
+	ret = ulFW_IF_GCQ_Create(&amc_ctrl_ctxt->fw_if_bulk_cfg, &amc_ctrl_ctxt->fw_if_gcq_bulk_consumer);
+	if (ret == FW_IF_ERRORS_NONE) {
+		ret = amc_proxy_init(1, &amc_ctrl_ctxt->fw_if_bulk_cfg, AMI_NODE(amc_ctrl_ctxt));
+		if (!ret)
+			ret = amc_proxy_bind_callback(&amc_ctrl_ctxt->fw_if_bulk_cfg, amc_proxy_callback);
+		if (ret)
+			amc_proxy_close(&amc_ctrl_ctxt->fw_if_bulk_cfg);
+	}
+	amc_ctrl_ctxt->bulk_queue_enabled = (ret == 0);
+	mutex_unlock(&amc_proxy_setup_lock);
+
 	if (ret)
-		goto fail;
+		DEV_WARN(dev, "Failed to set up the bulk queue pair %d, using primary pair only", ret);
+	else
+		AMI_VDBG(amc_ctrl_ctxt, "Bulk queue pair enabled");
+}
+
+/*
+ * Start the AMC services once the GCQ is ready.
+ */
+int start_amc(struct amc_control_ctxt *amc_ctrl_ctxt)
+{
+	int ret = 0;
+	struct pci_dev *dev = NULL;
+	char *version_buf = NULL;
+	const char *amc_hb_thread_name = "amc heartbeat";
+	const char *amc_log_thread_name = "amc logging";
+
+	if (!amc_ctrl_ctxt)
+		return -EINVAL;
+
+	dev = amc_ctrl_ctxt->pcie_dev;
+
+	/* Start Service - this is the only step that may be retried. */
+	ret = start_gcq_services(amc_ctrl_ctxt);
+	if (ret)
+		return ret;
 
 	/* Create GCQ instance */
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.ullBaseAddress = (uint64_t)(*amc_ctrl_ctxt)->gcq_base_virt_addr;
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.xInterruptMode = FW_IF_GCQ_INTERRUPT_MODE_NONE;
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.xMode = FW_IF_GCQ_MODE_CONSUMER;
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.ullRingAddress = (uint64_t)(*amc_ctrl_ctxt)->gcq_ring_buf_base_virt_addr;
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.ulRingLength =
-		(uint64_t)(*amc_ctrl_ctxt)->amc_shared_mem.ring_buffer.ring_buffer_len;
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.ulSubmissionQueueSlotSize = AMC_PROXY_REQUEST_SIZE;
-	(*amc_ctrl_ctxt)->fw_if_gcq_consumer.ulCompletionQueueSlotSize = AMC_PROXY_RESPONSE_SIZE;
-	ret = ulFW_IF_GCQ_Create(&(*amc_ctrl_ctxt)->fw_if_cfg, &(*amc_ctrl_ctxt)->fw_if_gcq_consumer);
+	mutex_lock(&amc_proxy_setup_lock);
+	amc_ctrl_ctxt->fw_if_gcq_consumer.ullBaseAddress = (uint64_t)amc_ctrl_ctxt->gcq_base_virt_addr;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.xInterruptMode = FW_IF_GCQ_INTERRUPT_MODE_NONE;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.xMode = FW_IF_GCQ_MODE_CONSUMER;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.ullRingAddress = (uint64_t)amc_ctrl_ctxt->gcq_ring_buf_base_virt_addr;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.ulRingLength =
+		(uint64_t)amc_ctrl_ctxt->amc_shared_mem.ring_buffer.ring_buffer_len;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.ulSubmissionQueueSlotSize = AMC_PROXY_REQUEST_SIZE;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.ulCompletionQueueSlotSize = AMC_PROXY_RESPONSE_SIZE;
+	amc_ctrl_ctxt->fw_if_gcq_consumer.xQueueType = FW_IF_GCQ_QUEUE_PRIMARY;
+	ret = ulFW_IF_GCQ_Create(&amc_ctrl_ctxt->fw_if_cfg, &amc_ctrl_ctxt->fw_if_gcq_consumer);
 	if (ret != FW_IF_ERRORS_NONE) {
+		mutex_unlock(&amc_proxy_setup_lock);
 		DEV_ERR(dev, "FW_IF_GCQ_create() failed %d", ret);
+		ret = -EIO;
 		goto fail;
 	}
 
 	/* Init proxy and bind in callback */
-	ret = amc_proxy_init(0, &(*amc_ctrl_ctxt)->fw_if_cfg);
-	if (ret) {
-		DEV_ERR(dev, "amc_proxy_init() failed %d", ret);
-		goto fail;
-	}
+	ret = amc_proxy_init(0, &amc_ctrl_ctxt->fw_if_cfg, AMI_NODE(amc_ctrl_ctxt));
+	if (!ret)
+		ret = amc_proxy_bind_callback(&amc_ctrl_ctxt->fw_if_cfg, amc_proxy_callback);
+	mutex_unlock(&amc_proxy_setup_lock);
 
-	ret = amc_proxy_bind_callback(&(*amc_ctrl_ctxt)->fw_if_cfg, amc_proxy_callback);
 	if (ret) {
-		DEV_ERR(dev, "amc_proxy_bind_callback() failed %d", ret);
+		DEV_ERR(dev, "Failed to initialise the amc proxy %d", ret);
 		goto fail;
 	}
 
+	/* Bulk queue pair is optional - fall back to the primary pair if it's unavailable */
+	start_bulk_queue(amc_ctrl_ctxt);
+
 	/* Spawn logging thread. */
-	(*amc_ctrl_ctxt)->logging_thread = kthread_create(
+	amc_ctrl_ctxt->logging_thread = kthread_create_local(
 		logging_thread,
-		*amc_ctrl_ctxt,
+		amc_ctrl_ctxt,
+		AMI_NODE(amc_ctrl_ctxt),
 		amc_log_thread_name
 	);
 
-	if (IS_ERR((*amc_ctrl_ctxt)->logging_thread)) {
+	if (IS_ERR(amc_ctrl_ctxt->logging_thread)) {
 		DEV_ERR(dev, "Unable to create the %s thread", amc_log_thread_name);
-		ret = PTR_ERR((*amc_ctrl_ctxt)->logging_thread);
+		ret = PTR_ERR(amc_ctrl_ctxt->logging_thread);
 		goto fail;
 	} else {
 		DEV_VDBG(dev, "Successfully created %s thread", amc_log_thread_name);
-		(*amc_ctrl_ctxt)->logging_thread_created = true;
-		wake_up_process((*amc_ctrl_ctxt)->logging_thread);
+		amc_ctrl_ctxt->logging_thread_created = true;
+		wake_up_process(amc_ctrl_ctxt->logging_thread);
 	}
 
 	/* Getting GCQ Version, Check the GCQ Version so that we don't
 	 * send unsupported commands to AMC firmware */
-	version_buf = vzalloc(sizeof(char) * VERSION_BUF_SIZE);
+	version_buf = vzalloc_node(sizeof(char) * VERSION_BUF_SIZE, AMI_NODE(amc_ctrl_ctxt));
 	if (!version_buf) {
 		DEV_ERR(dev, "Failed to allocate memory for GCQ version buffer");
 		ret = -ENOMEM;
 		goto fail;
 	}
 
-	ret = get_gcq_version(*amc_ctrl_ctxt, version_buf);
+	ret = get_gcq_version(amc_ctrl_ctxt, version_buf);
 	if (ret) {
 		ret = -EIO;
 		goto fail;
 	}
 
-	(*amc_ctrl_ctxt)->version.ver_major = (uint8_t)version_buf[0];
-	(*amc_ctrl_ctxt)->version.ver_minor = (uint8_t)version_buf[1];
-	(*amc_ctrl_ctxt)->version.ver_patch = (uint8_t)version_buf[2];
-	(*amc_ctrl_ctxt)->version.local_changes = (uint8_t)version_buf[3];
-	(*amc_ctrl_ctxt)->version.dev_commits = (uint16_t)(version_buf[4] & 0x00FF) |
-						(uint16_t)((version_buf[5] << 8) & 0xFF00);
+	amc_ctrl_ctxt->version.ver_major = (uint8_t)version_buf[0];
+	amc_ctrl_ctxt->version.ver_minor = (uint8_t)version_buf[1];
+	amc_ctrl_ctxt->version.ver_patch = (uint8_t)version_buf[2];
+	amc_ctrl_ctxt->version.local_changes = (uint8_t)version_buf[3];
+	amc_ctrl_ctxt->version.dev_commits = (uint16_t)(version_buf[4] & 0x00FF) |
+					     (uint16_t)((version_buf[5] << 8) & 0xFF00);
 
 	DEV_VDBG(dev,
 		 "amc version = %d.%d.%d-%d gcq version = %d.%d",
-		 (*amc_ctrl_ctxt)->version.ver_major,
-		 (*amc_ctrl_ctxt)->version.ver_minor,
-		 (*amc_ctrl_ctxt)->version.ver_patch,
-		 (*amc_ctrl_ctxt)->version.dev_commits,
+		 amc_ctrl_ctxt->version.ver_major,
+		 amc_ctrl_ctxt->version.ver_minor,
+		 amc_ctrl_ctxt->version.ver_patch,
+		 amc_ctrl_ctxt->version.dev_commits,
 		 (uint8_t)version_buf[6],
 		 (uint8_t)version_buf[7]
 	);
 
-	ret = check_gcq_supported_version(*amc_ctrl_ctxt, version_buf[6], version_buf[7]);
+	ret = check_gcq_supported_version(amc_ctrl_ctxt, version_buf[6], version_buf[7]);
 	if (ret)
 		goto fail;
 
 	/* Check AMC version */
-	if (check_amc_supported_version(*amc_ctrl_ctxt,
-					(*amc_ctrl_ctxt)->version.ver_major,
-					(*amc_ctrl_ctxt)->version.ver_minor)) {
-		(*amc_ctrl_ctxt)->compat_mode = true;
+	if (check_amc_supported_version(amc_ctrl_ctxt,
+					amc_ctrl_ctxt->version.ver_major,
+					amc_ctrl_ctxt->version.ver_minor)) {
+		amc_ctrl_ctxt->compat_mode = true;
 		DEV_WARN(
 			dev,
 			"Running in compatibility mode - most features will be unavailable!"
@@ -1862,13 +2165,13 @@ int setup_amc(struct pci_dev		*dev,
 		);
 
 		/* Stop the logging thread if it's been created */
-		if ((*amc_ctrl_ctxt)->logging_thread_created == true) {
-			ret = kthread_stop((*amc_ctrl_ctxt)->logging_thread);
+		if (amc_ctrl_ctxt->logging_thread_created == true) {
+			ret = kthread_stop(amc_ctrl_ctxt->logging_thread);
 			if (ret)
 				DEV_ERR(dev, "kthread_stop() failed for logging thread: %d", ret);
 			else
 				/* Prevents thread being stopped again via unset_amc */
-				(*amc_ctrl_ctxt)->logging_thread_created = false;
+				amc_ctrl_ctxt->logging_thread_created = false;
 		}
 	}
 
@@ -1878,24 +2181,23 @@ int setup_amc(struct pci_dev		*dev,
 	 * in compatibility mode - this disables most driver features,
 	 * including the heartbeat and logging threads.
 	 */
-	if (!(*amc_ctrl_ctxt)->compat_mode) {
+	if (!amc_ctrl_ctxt->compat_mode) {
 		/* Spawn the heartbeat thread once version is verified */
-		(*amc_ctrl_ctxt)->event_cb = event_cb;
-		(*amc_ctrl_ctxt)->event_cb_data = event_cb_data;
-		(*amc_ctrl_ctxt)->heartbeat_thread = kthread_create(
+		amc_ctrl_ctxt->heartbeat_thread = kthread_create_local(
 			heartbeat_health_thread,
-			*amc_ctrl_ctxt,
+			amc_ctrl_ctxt,
+			AMI_NODE(amc_ctrl_ctxt),
 			amc_hb_thread_name
 		);
 
-		if (IS_ERR((*amc_ctrl_ctxt)->heartbeat_thread)) {
+		if (IS_ERR(amc_ctrl_ctxt->heartbeat_thread)) {
 			DEV_ERR(dev, "Unable to create the %s thread", amc_hb_thread_name);
-			ret = PTR_ERR((*amc_ctrl_ctxt)->heartbeat_thread);
+			ret = PTR_ERR(amc_ctrl_ctxt->heartbeat_thread);
 			goto fail;
 		} else {
 			DEV_VDBG(dev, "Successfully created %s hearbeat thread", amc_hb_thread_name);
-			(*amc_ctrl_ctxt)->heartbeat_thread_created = true;
-			wake_up_process((*amc_ctrl_ctxt)->heartbeat_thread);
+			amc_ctrl_ctxt->heartbeat_thread_created = true;
+			wake_up_process(amc_ctrl_ctxt->heartbeat_thread);
 		}
 	}
 
@@ -1909,10 +2211,7 @@ int setup_amc(struct pci_dev		*dev,
 	if (version_buf)
 		vfree(version_buf);
 
-	unset_amc(dev, amc_ctrl_ctxt);
-	release_amc_mem(amc_ctrl_ctxt);
-	DEV_ERR(dev, "Failed to setup AMC GCQ");
-
+	DEV_ERR(dev, "Failed to start AMC services");
 	return ret;
 }
 
@@ -1951,7 +2250,15 @@ int unset_amc(struct pci_dev *dev, struct amc_control_ctxt **amc_ctrl_ctxt)
 		stop_gcq_services(*amc_ctrl_ctxt);
 
 		/* Close the proxy */
+		mutex_lock(&amc_proxy_setup_lock);
+		if ((*amc_ctrl_ctxt)->bulk_queue_enabled) {
+			(*amc_ctrl_ctxt)->bulk_queue_enabled = false;
+			ret = amc_proxy_close(&((*amc_ctrl_ctxt)->fw_if_bulk_cfg));
+			if (ret)
+				DEV_ERR(dev, "Failed to close the bulk amc proxy %d", ret);
+		}
 		ret = amc_proxy_close(&((*amc_ctrl_ctxt)->fw_if_cfg));
+		mutex_unlock(&amc_proxy_setup_lock);
 		if (ret)
 			DEV_ERR(dev, "Failed to close the amc proxy %d", ret);
 
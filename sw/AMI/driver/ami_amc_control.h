@@ -28,6 +28,9 @@
 #define AMI_VDBG(amc_ctrl_ctxt, fmt, arg ...)     DEV_VDBG(amc_ctrl_ctxt->pcie_dev, fmt, ## arg)
 #define AMI_AMC_LOG(amc_ctrl_ctxt, fmt, arg ...)  DEV_AMC_LOG(amc_ctrl_ctxt->pcie_dev, fmt, ## arg)
 
+/* NUMA node of the card - used for thread placement and buffer allocations */
+#define AMI_NODE(amc_ctrl_ctxt)                  dev_to_node(&(amc_ctrl_ctxt)->pcie_dev->dev)
+
 #define AMC_LOG_PAGE_SIZE                        (1024 * 1024)
 #define AMC_LOG_PAGE_NUM                         (1)
 #define AMC_LOG_ADDR_OFF                         (0)
@@ -131,6 +134,7 @@ enum gcq_submit_cmd_flags {
  * @GCQ_SUBMIT_CMD_EEPROM_READ_WRITE: Read/write EEPROM
  * @GCQ_SUBMIT_CMD_MODULE_READ_WRITE: Read/write a QSFP module
  * @GCQ_SUBMIT_CMD_DEBUG_VERBOSITY: Debug verbosity
+ * @GCQ_SUBMIT_CMD_ECHO: Echo a payload through the AMC
  */
 enum gcq_submit_cmd_req {
 	GCQ_SUBMIT_CMD_RSVD                         = 0x00,
@@ -160,6 +164,7 @@ enum gcq_submit_cmd_req {
 	GCQ_SUBMIT_CMD_EEPROM_READ_WRITE            = 0x80,
 	GCQ_SUBMIT_CMD_MODULE_READ_WRITE            = 0x90,
 	GCQ_SUBMIT_CMD_DEBUG_VERBOSITY              = 0x91,
+	GCQ_SUBMIT_CMD_ECHO                         = 0xA0,
 };
 
 /**
@@ -219,12 +224,14 @@ enum gcq_sdr_completion_code {
  * SENSOR_NOT_PRESENT: Not present
  * SENSOR_PRESENT_AND_VALID: Present and valid
  * DATA_NOT_AVAILABLE: No data
+ * SENSOR_QUARANTINED: Failing repeatedly, retried on a backoff
  * SENSOR_STATUS_NOT_AVAILABLE: Status not available
  */
 enum sensor_status {
 	SENSOR_NOT_PRESENT          = 0x00,
 	SENSOR_PRESENT_AND_VALID    = 0x01,
 	DATA_NOT_AVAILABLE          = 0x02,
+	SENSOR_QUARANTINED          = 0x04,
 	SENSOR_STATUS_NOT_AVAILABLE = 0x7F,
 };
 
@@ -347,6 +354,7 @@ enum sdr_buf_index {
  * @AMC_CMD_ID_EEPROM_READ_WRITE: eeprom read/write command
  * @AMC_CMD_ID_MODULE_READ_WRITE: module read/write command
  * @AMC_CMD_ID_DEBUG_VERBOSITY: debug verbosity command
+ * @AMC_CMD_ID_ECHO: echo command
  */
 enum amc_cmd_id {
 	AMC_CMD_ID_UNKNOWN = -EINVAL,
@@ -359,6 +367,7 @@ enum amc_cmd_id {
 	AMC_CMD_ID_EEPROM_READ_WRITE,
 	AMC_CMD_ID_MODULE_READ_WRITE,
     AMC_CMD_ID_DEBUG_VERBOSITY,
+	AMC_CMD_ID_ECHO,
 
 	AMC_CMD_ID_MAX
 };
@@ -601,6 +610,20 @@ struct amc_data {
 	uint32_t amc_data_end;
 };
 
+/**
+ * struct amc_queues - Stores the GCQ queue pairs on offer - part of the partition table.
+ * @queue_magic_no:       magic number, only present on AMC versions with more than one pair
+ * @num_queues:           number of queue pairs the AMC is servicing
+ * @bulk_ring_buffer_off: the offset of the bulk gcq ring buffer
+ * @bulk_ring_buffer_len: the length of the bulk gcq ring buffer
+ */
+struct amc_queues {
+	uint32_t queue_magic_no;
+	uint32_t num_queues;
+	uint32_t bulk_ring_buffer_off;
+	uint32_t bulk_ring_buffer_len;
+};
+
 /**
  * struct amc_shared_mem - GCQ memory partition table, should be positioned at shared memory offset 0,
  *     and initialized by AMC software on RPU device.
@@ -611,6 +634,7 @@ struct amc_data {
  * @amc_status:         amc status struct.
  * @amc_log_msg:        amc log struct.
  * @amc_data:           amc data struct.
+ * @amc_queues:         queue pairs struct (appended, not written by older AMC versions).
  */
 struct amc_shared_mem {
 	uint32_t               amc_magic_no;
@@ -618,6 +642,7 @@ struct amc_shared_mem {
 	struct amc_status      status;
 	struct amc_log_msg     log_msg;
 	struct amc_data        data;
+	struct amc_queues      queues;
 };
 
 /**
@@ -645,6 +670,9 @@ struct amc_version {
  * @gcq_ring_buf_base_virt_addr: the ring buffer virtual address
  * @fw_if_cfg: fal configuration
  * @fw_if_gcq_consumer: handle to the GCQ consumer
+ * @fw_if_bulk_cfg: fal configuration of the bulk queue pair
+ * @fw_if_gcq_bulk_consumer: handle to the bulk GCQ consumer
+ * @bulk_queue_enabled: flag set when bulk requests are routed to their own queue pair
  * @lock: lock to protect cid creation
  * @gcq_cmd_lock: protect concurrent gcq commands
  * @gcq_halted: block/allow request messages
@@ -661,6 +689,11 @@ struct amc_version {
  * @compat_mode: flag used to determine if this AMC instance is running in
  *   compatibility mode - this provides minimum functionality when an AMC
  *   version is deemed to be incompatible with the current AMI version
+ * @progress_lock: protects the progress tracking fields below
+ * @progress_cmd: download or copy request whose deadline follows AMC progress
+ * @progress_deadline: size based ceiling for `progress_cmd`
+ * @last_progress: last progress counter returned with a heartbeat
+ * @progress_supported: flag set once the AMC has reported progress
  */
 struct amc_control_ctxt {
 	struct pci_dev        *pcie_dev;
@@ -670,6 +703,9 @@ struct amc_control_ctxt {
 	void __iomem          *gcq_ring_buf_base_virt_addr;
 	FW_IF_CFG             fw_if_cfg;
 	FW_IF_GCQ_CFG         fw_if_gcq_consumer;
+	FW_IF_CFG             fw_if_bulk_cfg;
+	FW_IF_GCQ_CFG         fw_if_gcq_bulk_consumer;
+	bool                  bulk_queue_enabled;
 	struct mutex          lock;
 	struct mutex          gcq_cmd_lock;
 	bool                  gcq_halted;
@@ -684,6 +720,11 @@ struct amc_control_ctxt {
 	bool                  logging_thread_created;
 	int                   last_printed_msg_index;
 	bool                  compat_mode;
+	struct mutex          progress_lock;
+	struct amc_proxy_cmd_struct *progress_cmd;
+	unsigned long         progress_deadline;
+	uint32_t              last_progress;
+	bool                  progress_supported;
 };
 
 
@@ -716,6 +757,9 @@ int get_rid(int repo_type);
  * @data_buf: Data buffer to either store payload data or response data.
  * @data_size: Data buffer size.
  *
+ * For GCQ_SUBMIT_CMD_ECHO, `flags` is the cookie and `data_buf` is sent to the
+ * AMC and overwritten with the payload the AMC sends back.
+ *
  * Return: 0 or negative error code.
  */
 int submit_gcq_command(struct amc_control_ctxt *amc_ctrl_ctxt, enum gcq_submit_cmd_req cmd_req, uint32_t flags,
@@ -740,11 +784,27 @@ void stop_gcq_services(struct amc_control_ctxt *amc_ctrl_ctxt);
  * @event_cb: Callback to be invoked when event occurs.
  * @event_cb_data: Private data to be passed into the event callback.
  *
+ * This only allocates the context and maps the endpoints - it does not wait
+ * for the AMC. Call `start_amc` to bring up the services.
+ *
  * Return: 0 or negative error code.
  */
 int setup_amc(struct pci_dev *dev, struct amc_control_ctxt **amc_ctrl_ctxt, endpoint_info_struct ep_gcq,
 	      endpoint_info_struct ep_gcq_payload, amc_event_callback event_cb, void *event_cb_data);
 
+/**
+ * start_amc() - Start the GCQ, proxy and AMC threads.
+ * @amc_ctrl_ctxt: AMC data struct returned by `setup_amc`.
+ *
+ * This function does not block waiting for the AMC. If the GCQ service
+ * has not come up yet it returns -EAGAIN without side effects and the caller
+ * is expected to try again later. On any other error, the caller must
+ * tear down the context with `unset_amc` and `release_amc_mem`.
+ *
+ * Return: 0, -EAGAIN or negative error code.
+ */
+int start_amc(struct amc_control_ctxt *amc_ctrl_ctxt);
+
 /**
  * unset_amc() - Stop the service, close proxy and tidy up PCI
  * @dev: the pci device.
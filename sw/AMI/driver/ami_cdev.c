@@ -26,6 +26,7 @@
 #include "ami_eeprom.h"
 #include "ami_utils.h"
 #include "ami_module.h"
+#include "ami_echo.h"
 
 #define ROOT_USER                (0)
 #define READ_WRITE               (0666)
@@ -56,20 +57,50 @@ static int dev_major = 0;  /* This will be overriden. */
 	return NULL;
 }
 
+/**
+ * client_sensor_refresh() - Sensor staleness tolerance of a file descriptor.
+ * @client: Per descriptor data.
+ *
+ * Return: The descriptor's own tolerance (ms) or, if it never set one,
+ *   the device wide hwmon `update_interval`.
+ */
+static uint16_t client_sensor_refresh(struct ami_cdev_client *client)
+{
+	if (client->sensor_refresh == CDEV_SENSOR_REFRESH_DEFAULT)
+		return client->pf_dev->sensor_refresh;
+
+	return (uint16_t)client->sensor_refresh;
+}
+
 /*
  * Open a device file - this increments the pf_dev refcount.
  */
 int dev_open(struct inode *inode, struct file *filp)
 {
+	struct pf_dev_struct *pf_dev = NULL;
+	struct ami_cdev_client *client = NULL;
+
 	if (!inode || !filp)
 		return -EINVAL;
 	
 	/* This already checks the minor number */
-	filp->private_data = get_pf_dev_entry((void*)inode, PF_DEV_CACHE_INODE);
+	pf_dev = get_pf_dev_entry((void*)inode, PF_DEV_CACHE_INODE);
 
-	if (!filp->private_data)
+	if (!pf_dev)
 		return -ENODEV;
 
+	client = kzalloc_node(sizeof(struct ami_cdev_client), GFP_KERNEL,
+		PF_DEV_NODE(pf_dev));
+
+	if (!client) {
+		put_pf_dev_entry(pf_dev);
+		return -ENOMEM;
+	}
+
+	client->pf_dev = pf_dev;
+	client->sensor_refresh = CDEV_SENSOR_REFRESH_DEFAULT;
+	filp->private_data = client;
+
 	return 0;
 }
 
@@ -81,8 +112,13 @@ int dev_close(struct inode *inode, struct file *filp)
 	if (!inode || !filp)
 		return -EINVAL;
 
-	if (filp->private_data)
-		put_pf_dev_entry((struct pf_dev_struct*)filp->private_data);
+	if (filp->private_data) {
+		struct ami_cdev_client *client = filp->private_data;
+
+		put_pf_dev_entry(client->pf_dev);
+		kfree(client);
+		filp->private_data = NULL;
+	}
 
 	return 0;
 }
@@ -93,6 +129,7 @@ int dev_close(struct inode *inode, struct file *filp)
 long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 {
 	int ret = 0;
+	struct ami_cdev_client *client = NULL;
 	struct pf_dev_struct *pf_dev = NULL;
 	/* eventfd is used for sending notifications to the user */
 	struct eventfd_ctx *efd_ctx = NULL;
@@ -111,7 +148,8 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		return -ENOTTY;
 	
 	/* This is is already reference counted  */
-	pf_dev = filp->private_data;
+	client = filp->private_data;
+	pf_dev = client ? client->pf_dev : NULL;
 
 	/* Check device data */
 	if (!pf_dev) {
@@ -123,6 +161,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 	switch (cmd) {
 	/* READY, MISSING_INFO or COMPAT only */
 	case AMI_IOC_DOWNLOAD_PDI:
+	case AMI_IOC_DOWNLOAD_PDI_CODEC:
 	case AMI_IOC_DEVICE_BOOT:
 		switch (pf_dev->state) {
 		case PF_DEV_STATE_COMPAT:
@@ -153,6 +192,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 	case AMI_IOC_GET_SENSOR_VALUE:
 	case AMI_IOC_COPY_PARTITION:
 	case AMI_IOC_SET_SENSOR_REFRESH:
+	case AMI_IOC_GET_SENSOR_REFRESH:
 	case AMI_IOC_GET_FPT_HDR:
 	case AMI_IOC_GET_FPT_PARTITION:
 	case AMI_IOC_READ_EEPROM:
@@ -160,6 +200,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 	case AMI_IOC_READ_MODULE:
 	case AMI_IOC_WRITE_MODULE:
 	case AMI_IOC_DEBUG_VERBOSITY:
+	case AMI_IOC_ECHO:
 		switch (pf_dev->state) {
 		case PF_DEV_STATE_READY:
 		case PF_DEV_STATE_MISSING_INFO:
@@ -186,20 +227,32 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 	case AMI_IOC_SET_SENSOR_REFRESH:
 	{
 		/*
-		 * This does the same thing as writing to the `update_interval`
-		 * hwmon file, but we do not require any sudo permissions here.
+		 * Unlike writing to the `update_interval` hwmon file, this only
+		 * affects reads made through this file descriptor, so no sudo
+		 * permissions are required.
 		 */
-		pf_dev->sensor_refresh = (uint16_t)arg;
+		client->sensor_refresh = (uint16_t)arg;
+		break;
+	}
+
+	case AMI_IOC_GET_SENSOR_REFRESH:
+	{
+		/* `arg` is a pointer to a uint16_t */
+		ret = put_user(client_sensor_refresh(client), (uint16_t __user*)arg);
 		break;
 	}
 
 	case AMI_IOC_DOWNLOAD_PDI:
+	case AMI_IOC_DOWNLOAD_PDI_CODEC:
 	{
 		/*
 		 * `arg` is a pointer to the `ami_ioc_data_payload` struct
+		 * (or `ami_ioc_pdi_codec_payload` for an encoded download).
 		 * This struct contains the address of the actual data buffer.
 		 */
 		struct ami_ioc_data_payload data = { 0 };
+		uint8_t codec = AMI_IOC_PDI_CODEC_NONE;
+		uint32_t raw_size = 0;
 		uint8_t *buf = NULL;
 
 		/* Check PF - currently only PF0 supported for this command. */
@@ -209,7 +262,26 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 
 		/* Read data payload from user. */
-		if (copy_from_user(&data, (struct ami_ioc_data_payload*)arg, sizeof(data))) {
+		if (cmd == AMI_IOC_DOWNLOAD_PDI_CODEC) {
+			struct ami_ioc_pdi_codec_payload codec_data = { 0 };
+
+			if (copy_from_user(&codec_data, (struct ami_ioc_pdi_codec_payload*)arg,
+					   sizeof(codec_data))) {
+				ret = -EFAULT; /* Bad address */
+				goto done;
+			}
+
+			data = codec_data.data;
+			codec = codec_data.codec;
+			raw_size = codec_data.raw_size;
+
+			/* Only accept codecs this driver knows how to split */
+			if ((codec == AMI_IOC_PDI_CODEC_NONE) ||
+			    (codec >= AMI_IOC_PDI_CODEC_MAX) || !raw_size) {
+				ret = -EINVAL;
+				goto done;
+			}
+		} else if (copy_from_user(&data, (struct ami_ioc_data_payload*)arg, sizeof(data))) {
 			ret = -EFAULT; /* Bad address */
 			goto done;
 		}
@@ -229,7 +301,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		 * Using vzalloc because the PDI buffer will be too large
 		 * for kzalloc (around 4-6MB)
 		 */
-		buf = vzalloc(data.size);
+		buf = vzalloc_node(data.size, PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -247,6 +319,8 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 					buf,
 					data.size,
 					data.boot_device,
+					codec,
+					raw_size,
 					efd_ctx
 				);
 			else
@@ -256,6 +330,8 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 					data.size,
 					data.boot_device,
 					data.partition,
+					codec,
+					raw_size,
 					efd_ctx
 				);
 		} else {
@@ -353,7 +429,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 
 		/* Allocate memory for response buffer. */
-		buf = vzalloc(data.num * sizeof(uint32_t));
+		buf = vzalloc_node(data.num * sizeof(uint32_t), PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -398,7 +474,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 		
 		/* Allocate memory for payload buffer. */
-		buf = vzalloc(data.num * sizeof(uint32_t));
+		buf = vzalloc_node(data.num * sizeof(uint32_t), PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -463,6 +539,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 			hwmon_type,
 			hwmon_attr,
 			data.hwmon_channel,
+			client_sensor_refresh(client),
 			&data.val,
 			data.status,
 			&data.fresh
@@ -541,7 +618,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 
                 /* Allocate memory for response buffer. */
-		buf = vzalloc(data.len * sizeof(uint8_t));
+		buf = vzalloc_node(data.len * sizeof(uint8_t), PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -574,7 +651,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 
 		/* Allocate memory for payload buffer. */
-		buf = vzalloc(data.len * sizeof(uint8_t));
+		buf = vzalloc_node(data.len * sizeof(uint8_t), PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -624,7 +701,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 
 		/* Allocate memory for response buffer. */
-		buf = vzalloc(data.len * sizeof(uint8_t));
+		buf = vzalloc_node(data.len * sizeof(uint8_t), PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -665,7 +742,7 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		}
 
 		/* Allocate memory for payload buffer. */
-		buf = vzalloc(data.len * sizeof(uint8_t));
+		buf = vzalloc_node(data.len * sizeof(uint8_t), PF_DEV_NODE(pf_dev));
 
 		if (!buf) {
 			ret = -ENOMEM;
@@ -699,6 +776,30 @@ long dev_unlocked_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 		);
 		break;
 
+	case AMI_IOC_ECHO:
+	{
+		struct ami_ioc_echo_payload data = { 0 };
+		struct echo_stats stats = { 0 };
+
+		if (copy_from_user(&data, (struct ami_ioc_echo_payload*)arg, sizeof(data))) {
+			ret = -EFAULT;
+			goto done;
+		}
+
+		ret = echo_benchmark(pf_dev->amc_ctrl_ctxt, data.size, data.count, &stats);
+		if (!ret) {
+			data.min_ns = stats.min_ns;
+			data.p50_ns = stats.p50_ns;
+			data.p99_ns = stats.p99_ns;
+			data.max_ns = stats.max_ns;
+			data.total_ns = stats.total_ns;
+
+			if (copy_to_user((struct ami_ioc_echo_payload*)arg, &data, sizeof(data)))
+				ret = -EFAULT;
+		}
+		break;
+	}
+
 	default:
 		PR_ERR("Unknown command, do nothing");
 		ret = -ENOTTY;
@@ -28,6 +28,18 @@
 /* IOCTL data. Shared with userspace code. */
 
 #define AMI_IOC_FPT_UPDATE_MAGIC	(0xAAAAAAAA)
+
+/*
+ * PDI transfer codecs. With a codec other than NONE the download buffer is a
+ * sequence of records, one per PDI chunk, each a 32-bit header followed by the
+ * chunk data. The header holds the record length; the top bit is set if the
+ * data is encoded and clear if the chunk was stored as-is.
+ */
+#define AMI_IOC_PDI_CODEC_NONE		(0)
+#define AMI_IOC_PDI_CODEC_RLE		(1)
+#define AMI_IOC_PDI_CODEC_MAX		(2)
+#define AMI_IOC_PDI_RECORD_PACKED	(0x80000000)
+#define AMI_IOC_PDI_RECORD_LEN(hdr)	((hdr) & ~AMI_IOC_PDI_RECORD_PACKED)
 #define AMI_IOC_SENSOR_STATUS_LEN	(40)
 
 /**
@@ -65,6 +77,22 @@ struct ami_ioc_data_payload {
 	int            efd;
 };
 
+/**
+ * struct ami_ioc_pdi_codec_payload - payload struct for encoded PDI downloads
+ * @data: Download request as for AMI_IOC_DOWNLOAD_PDI; `size` is the size of
+ *     the encoded buffer.
+ * @codec: Transfer codec of the download buffer (`AMI_IOC_PDI_CODEC_*`).
+ * @raw_size: Size of the image once decoded.
+ *
+ * This is a separate IOCTL so that the layout of `ami_ioc_data_payload`, and
+ * with it the ABI of the existing IOCTL's, stays unchanged.
+ */
+struct ami_ioc_pdi_codec_payload {
+	struct ami_ioc_data_payload  data;
+	uint8_t                      codec;
+	uint32_t                     raw_size;
+};
+
 /**
  * struct ami_ioc_bar_data - payload struct for PCI BAR-related IOCTL calls
  * @num: Number of BAR registers (to read or write).
@@ -189,6 +217,26 @@ struct ami_ioc_module_payload {
 	uint8_t       offset;
 };
 
+/**
+ * struct ami_ioc_echo_payload - payload struct for the GCQ echo benchmark
+ * @size: Number of payload bytes carried per echo.
+ * @count: Number of echoes to run.
+ * @min_ns: Fastest round trip. Populated by the driver.
+ * @p50_ns: Median round trip. Populated by the driver.
+ * @p99_ns: 99th percentile round trip. Populated by the driver.
+ * @max_ns: Slowest round trip. Populated by the driver.
+ * @total_ns: Sum of all round trips. Populated by the driver.
+ */
+struct ami_ioc_echo_payload {
+	uint32_t size;
+	uint32_t count;
+	uint64_t min_ns;
+	uint64_t p50_ns;
+	uint64_t p99_ns;
+	uint64_t max_ns;
+	uint64_t total_ns;
+};
+
 /**
  * enum ami_ioc_app_setup - accepted values for the AMI_IOC_APP_SETUP IOCTL
  * @IOC_APP_SETUP_REGISTER: Register a process with a device.
@@ -215,7 +263,10 @@ enum ami_ioc_app_setup {
 #define AMI_IOC_READ_MODULE		_IOW(AMI_IOC_MAGIC, 12, struct ami_ioc_module_payload*)
 #define AMI_IOC_WRITE_MODULE		_IOW(AMI_IOC_MAGIC, 13, struct ami_ioc_module_payload*)
 #define AMI_IOC_DEBUG_VERBOSITY		_IOW(AMI_IOC_MAGIC, 14, uint8_t)
-#define AMI_IOC_MAX			(15)
+#define AMI_IOC_ECHO			_IOWR(AMI_IOC_MAGIC, 15, struct ami_ioc_echo_payload*)
+#define AMI_IOC_DOWNLOAD_PDI_CODEC	_IOW(AMI_IOC_MAGIC, 16, struct ami_ioc_pdi_codec_payload*)
+#define AMI_IOC_GET_SENSOR_REFRESH	_IOR(AMI_IOC_MAGIC, 17, uint16_t*)
+#define AMI_IOC_MAX			(18)
 
 /* End shared data. */
 
@@ -240,6 +291,25 @@ struct drv_cdev_struct {
 	struct device	*device;
 };
 
+#define CDEV_SENSOR_REFRESH_DEFAULT	(-1)
+
+/**
+ * struct ami_cdev_client - per open file descriptor data.
+ *
+ * @pf_dev: Reference counted device this descriptor was opened against.
+ * @sensor_refresh: Oldest cached sensor reading (in ms) this descriptor will
+ *   accept, or CDEV_SENSOR_REFRESH_DEFAULT to follow the device wide hwmon
+ *   `update_interval`.
+ *
+ * Sensor reads are served from the shared cache unless it is older than the
+ * reader's own tolerance, so the cache is refreshed at the rate of the tightest
+ * active reader and laxer readers get those values for free.
+ */
+struct ami_cdev_client {
+	struct pf_dev_struct	*pf_dev;
+	int			sensor_refresh;
+};
+
 /* Standard Linux callbacks */
 int dev_open(struct inode *inode, struct file *filp);
 int dev_close(struct inode *inode, struct file *filp);
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * ami_echo.c - This file contains functions to benchmark the GCQ round trip.
+ *
+ * Copyright (c) 2023-present Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#include <linux/types.h>
+#include <linux/ktime.h>
+#include <linux/sort.h>
+#include <linux/vmalloc.h>
+#include <linux/pci.h>
+#include <linux/jiffies.h>
+#include <linux/sched/signal.h>
+
+#include "ami_top.h"
+#include "ami_echo.h"
+#include "ami_amc_control.h"
+
+/**
+ * cmp_u64() - sort() comparator for round trip times.
+ * @a: First value.
+ * @b: Second value.
+ *
+ * Return: <0, 0 or >0.
+ */
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	if (x < y)
+		return -1;
+
+	return (x > y);
+}
+
+/*
+ * Send a payload to the AMC and back a number of times.
+ */
+int echo_benchmark(struct amc_control_ctxt *amc_ctrl_ctxt, uint32_t size,
+	uint32_t count, struct echo_stats *stats)
+{
+	int ret = SUCCESS;
+	uint64_t *lat = NULL;
+	uint8_t *buf = NULL;
+	uint32_t n = 0, i = 0;
+	unsigned long deadline = jiffies + msecs_to_jiffies(ECHO_MAX_TIME_MS);
+
+	if (!amc_ctrl_ctxt || !stats || (count == 0) || (count > ECHO_MAX_COUNT) ||
+	    (size > ECHO_MAX_SIZE))
+		return -EINVAL;
+
+	lat = vzalloc_node(count * sizeof(uint64_t), AMI_NODE(amc_ctrl_ctxt));
+	/* A header-only echo still needs a valid buffer */
+	buf = vzalloc_node(max_t(uint32_t, size, 1), AMI_NODE(amc_ctrl_ctxt));
+	if (!lat || !buf) {
+		ret = -ENOMEM;
+		goto done;
+	}
+
+	AMI_VDBG(amc_ctrl_ctxt, "Running %d echoes of %d bytes", count, size);
+
+	for (n = 0; n < count; n++) {
+		ktime_t start = 0;
+
+		if (fatal_signal_pending(current)) {
+			ret = -EINTR;
+			goto done;
+		}
+
+		if (time_after(jiffies, deadline)) {
+			AMI_ERR(amc_ctrl_ctxt,
+				"Echo time budget of %d ms ran out after %d of %d echoes",
+				ECHO_MAX_TIME_MS,
+				n,
+				count);
+			ret = -ETIMEDOUT;
+			goto done;
+		}
+
+		for (i = 0; i < size; i++)
+			buf[i] = (uint8_t)(n + i);
+
+		start = ktime_get();
+		ret = submit_gcq_command(amc_ctrl_ctxt, GCQ_SUBMIT_CMD_ECHO, n, buf, size);
+		lat[n] = ktime_to_ns(ktime_sub(ktime_get(), start));
+
+		if (ret) {
+			AMI_ERR(amc_ctrl_ctxt, "Echo %d failed", n);
+			goto done;
+		}
+
+		for (i = 0; i < size; i++) {
+			if (buf[i] != (uint8_t)~(n + i)) {
+				AMI_ERR(amc_ctrl_ctxt, "Echo %d payload mismatch at byte %d", n, i);
+				ret = -EIO;
+				goto done;
+			}
+		}
+
+		stats->total_ns += lat[n];
+	}
+
+	sort(lat, count, sizeof(uint64_t), cmp_u64, NULL);
+	stats->min_ns = lat[0];
+	stats->p50_ns = lat[((count - 1) * 50) / 100];
+	stats->p99_ns = lat[((count - 1) * 99) / 100];
+	stats->max_ns = lat[count - 1];
+
+done:
+	vfree(buf);
+	vfree(lat);
+	return ret;
+}
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * ami_echo.h - This file contains functions to benchmark the GCQ round trip.
+ *
+ * Copyright (c) 2023-present Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+#ifndef AMI_ECHO_H
+#define AMI_ECHO_H
+
+#include <linux/types.h>
+
+#include "ami_top.h"
+#include "ami_amc_control.h"
+
+/*
+ * The benchmark runs with the device ioctl lock held, so both the work per
+ * request and its overall duration are bounded.
+ */
+#define ECHO_MAX_COUNT		(10000)
+#define ECHO_MAX_SIZE		(1024 * 1024)
+#define ECHO_MAX_TIME_MS	(10000)
+
+/**
+ * struct echo_stats - round trip latency summary
+ * @min_ns: Fastest round trip.
+ * @p50_ns: Median round trip.
+ * @p99_ns: 99th percentile round trip.
+ * @max_ns: Slowest round trip.
+ * @total_ns: Sum of all round trips.
+ */
+struct echo_stats {
+	uint64_t min_ns;
+	uint64_t p50_ns;
+	uint64_t p99_ns;
+	uint64_t max_ns;
+	uint64_t total_ns;
+};
+
+/**
+ * echo_benchmark() - Send a payload to the AMC and back a number of times.
+ * @amc_ctrl_ctxt: Pointer to top level AMC data struct.
+ * @size: Number of payload bytes per echo (0 for header only).
+ * @count: Number of echoes to run.
+ * @stats: Latency summary to populate.
+ *
+ * Each echo carries a fresh pattern which the AMC inverts in shared memory;
+ * the returned payload is checked before the next echo is sent. The run is
+ * abandoned if it exceeds ECHO_MAX_TIME_MS or the caller is being killed.
+ *
+ * Return: 0, -EINVAL if `size` or `count` is out of range, -ETIMEDOUT if the
+ *   time budget ran out or another negative error code.
+ */
+int echo_benchmark(struct amc_control_ctxt *amc_ctrl_ctxt, uint32_t size,
+	uint32_t count, struct echo_stats *stats);
+
+#endif  /* AMI_ECHO_H */
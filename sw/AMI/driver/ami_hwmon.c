@@ -724,6 +724,7 @@ int alveo_read(struct device *dev, enum hwmon_sensor_types type,
 			type,
 			attr,
 			channel,
+			pf_dev->sensor_refresh,
 			val,
 			NULL,
 			NULL
@@ -1201,7 +1202,7 @@ static const struct attribute_group *extra_groups[] = {
  * Read a sensor value.
  */
 int read_sensor_val(struct pf_dev_struct *pf_dev, enum hwmon_sensor_types type,
-	u32 attr, int channel, long *val, char *status, bool *fresh)
+	u32 attr, int channel, uint16_t max_age, long *val, char *status, bool *fresh)
 {
 	int ret = 0;
 	long value = 0;
@@ -1229,19 +1230,19 @@ int read_sensor_val(struct pf_dev_struct *pf_dev, enum hwmon_sensor_types type,
 	 */
 	switch (type) {
 	case hwmon_temp:
-		ret = read_thermal_sensors(pf_dev, fresh);
+		ret = read_thermal_sensors(pf_dev, max_age, fresh);
 		break;
 
 	case hwmon_curr:
-		ret = read_current_sensors(pf_dev, fresh);
+		ret = read_current_sensors(pf_dev, max_age, fresh);
 		break;
 
 	case hwmon_in:
-		ret = read_voltage_sensors(pf_dev, fresh);
+		ret = read_voltage_sensors(pf_dev, max_age, fresh);
 		break;
 
 	case hwmon_power:
-		ret = read_power_sensors(pf_dev, fresh);
+		ret = read_power_sensors(pf_dev, max_age, fresh);
 		break;
 
 	default:
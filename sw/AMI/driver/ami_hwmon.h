@@ -43,6 +43,7 @@ void remove_hwmon(struct device *dev);
  * @type: Hwmon sensor type.
  * @attr: Hwmon attribute type.
  * @channel: Hwmon channel.
+ * @max_age: Oldest cached value (ms) the caller accepts; 0 always refreshes.
  * @val: Variable to store sensor value.
  * @status: Variable to store sensor status (optional).
  * @fresh: Variable to store cache status for this value (optional).
@@ -50,6 +51,6 @@ void remove_hwmon(struct device *dev);
  * Return: 0 or negative error code.
  */
 int read_sensor_val(struct pf_dev_struct *pf_dev, enum hwmon_sensor_types type,
-	u32 attr, int channel, long *val, char *status, bool *fresh);
+	u32 attr, int channel, uint16_t max_age, long *val, char *status, bool *fresh);
 
 #endif /* AMI_HWMON_H */
@@ -6,6 +6,7 @@
  */
 
 #include <linux/device.h>
+#include <linux/fs.h>
 
 #include "ami_top.h"
 #include "ami_pcie.h"
@@ -1120,6 +1121,295 @@ bool is_supported_pcie_device_id(uint16_t pcie_device_id)
 	return false;
 }
 
+/**
+ * pcie_aer_is_os_owned() - Check if the OS AER core handles a device's errors.
+ * @dev: PCI device.
+ *
+ * Mirrors pcie_aer_is_native(), which is not available to modules on every
+ * supported kernel. The `pcie_ports=native` override is not visible here.
+ *
+ * Return: true if the AER core owns the AER registers of `dev`.
+ */
+static bool pcie_aer_is_os_owned(struct pci_dev *dev)
+{
+#ifdef CONFIG_PCIEAER
+	struct pci_host_bridge *host = pci_find_host_bridge(dev->bus);
+
+	return dev->aer_cap && host && host->native_aer;
+#else
+	return false;
+#endif
+}
+
+/**
+ * read_aer_core_cor_counts() - Read the AER core's correctable error counters.
+ * @dev: PCI device.
+ * @counts: Filled in with the cumulative counts.
+ *
+ * The AER core has no in-kernel accessor for its per-device statistics, so
+ * they are read from the `aer_dev_correctable` sysfs attribute.
+ *
+ * Return: 0 or a negative error code.
+ */
+static int read_aer_core_cor_counts(struct pci_dev *dev, struct pcie_aer_cor_counts *counts)
+{
+	char path[64] = { 0 };
+	struct file *file = NULL;
+	char *buf = NULL, *cur = NULL, *line = NULL;
+	loff_t pos = 0;
+	ssize_t len = 0;
+
+	snprintf(path, sizeof(path), PCIE_AER_COR_STATS_PATH, pci_name(dev));
+	file = filp_open(path, O_RDONLY, 0);
+	if (IS_ERR(file))
+		return PTR_ERR(file);
+
+	buf = kzalloc(PCIE_AER_COR_STATS_LEN, GFP_KERNEL);
+	if (!buf) {
+		filp_close(file, NULL);
+		return -ENOMEM;
+	}
+
+	len = kernel_read(file, buf, PCIE_AER_COR_STATS_LEN - 1, &pos);
+	filp_close(file, NULL);
+	if (len < 0) {
+		kfree(buf);
+		return len;
+	}
+
+	/* One "<name> <count>" line per error type, then the total */
+	memset(counts, 0, sizeof(*counts));
+	cur = buf;
+	while ((line = strsep(&cur, "\n"))) {
+		char name[16] = { 0 };
+		unsigned long long val = 0;
+
+		if (sscanf(line, "%15s %llu", name, &val) != 2)
+			continue;
+
+		if (!strcmp(name, "TOTAL_ERR_COR"))
+			counts->total = val;
+		else if (!strcmp(name, "RxErr"))
+			counts->rx = val;
+		else if (!strcmp(name, "BadTLP"))
+			counts->bad_tlp = val;
+		else if (!strcmp(name, "BadDLLP"))
+			counts->bad_dllp = val;
+		else if (!strcmp(name, "Rollover") || !strcmp(name, "Timeout"))
+			counts->replays += val;
+	}
+
+	kfree(buf);
+	return SUCCESS;
+}
+
+/**
+ * sample_pcie_link_health() - Take one link health sample.
+ * @health: Link health monitor.
+ *
+ * Compares the negotiated link against the link capabilities, collects
+ * the correctable error counts and raises an event when a new condition appears.
+ *
+ * When the OS owns AER the counts come from the AER core, which clears the
+ * status register as it handles each error. Otherwise nothing else touches
+ * the register, so it is read and write-1-cleared here.
+ *
+ * Return: None.
+ */
+static void sample_pcie_link_health(struct pcie_link_health *health)
+{
+	struct pci_dev *dev = health->dev;
+	struct pcie_aer_cor_counts counts = { 0 };
+	uint16_t link_status = 0;
+	uint32_t cor_status = 0;
+	bool have_counts = false;
+	uint32_t flags = 0;
+	uint32_t raised = 0;
+	uint64_t window_errors = 0;
+	uint8_t speed = 0, width = 0;
+
+	if (pcie_capability_read_word(dev, PCI_EXP_LNKSTA, &link_status))
+		return;
+
+	speed = get_pcie_cap_link_status_cur_link_speed(link_status);
+	width = get_pcie_cap_link_status_neg_pcie_cap_link_width(link_status);
+
+	if (health->aer_native) {
+		have_counts = !read_aer_core_cor_counts(dev, &counts);
+	} else if (health->aer_cap &&
+		   !pci_read_config_dword(dev, health->aer_cap + PCI_ERR_COR_STATUS, &cor_status)) {
+		if (cor_status == (uint32_t)~0)
+			cor_status = 0;  /* Device not responding */
+		else if (cor_status)
+			pci_write_config_dword(dev, health->aer_cap + PCI_ERR_COR_STATUS, cor_status);
+	}
+
+	mutex_lock(&health->lock);
+
+	health->cap->current_pcie_link_speed = speed;
+	health->cap->current_pcie_link_width = width;
+	health->samples++;
+
+	if (speed < health->cap->expected_pcie_link_speed)
+		flags |= PCIE_HEALTH_FLAG_SPEED_DOWN;
+
+	if (width < health->cap->expected_pcie_link_width)
+		flags |= PCIE_HEALTH_FLAG_WIDTH_DOWN;
+
+	if (time_after(jiffies, health->window_start + msecs_to_jiffies(PCIE_HEALTH_ERR_WINDOW_MS))) {
+		health->window_start = jiffies;
+		health->window_errors = 0;
+	}
+
+	if (have_counts) {
+		/* The AER core counters are cumulative - count the increase */
+		health->cor_errors += counts.total - health->aer_last.total;
+		health->window_errors += counts.total - health->aer_last.total;
+		health->rx_errors += counts.rx - health->aer_last.rx;
+		health->bad_tlp += counts.bad_tlp - health->aer_last.bad_tlp;
+		health->bad_dllp += counts.bad_dllp - health->aer_last.bad_dllp;
+		health->replays += counts.replays - health->aer_last.replays;
+		health->aer_last = counts;
+	} else if (cor_status) {
+		health->cor_errors += hweight32(cor_status);
+		health->window_errors += hweight32(cor_status);
+		health->rx_errors += !!(cor_status & PCI_ERR_COR_RCVR);
+		health->bad_tlp += !!(cor_status & PCI_ERR_COR_BAD_TLP);
+		health->bad_dllp += !!(cor_status & PCI_ERR_COR_BAD_DLLP);
+		health->replays += hweight32(cor_status & (PCI_ERR_COR_REP_ROLL | PCI_ERR_COR_REP_TIMER));
+	}
+
+	if (health->window_errors > PCIE_HEALTH_ERR_THRESHOLD)
+		flags |= PCIE_HEALTH_FLAG_ERR_RATE;
+
+	raised = flags & ~health->flags;
+	health->flags = flags;
+
+	if (raised & (PCIE_HEALTH_FLAG_SPEED_DOWN | PCIE_HEALTH_FLAG_WIDTH_DOWN))
+		health->downgrades++;
+
+	if (raised)
+		health->events++;
+
+	window_errors = health->window_errors;
+	mutex_unlock(&health->lock);
+
+	if (raised) {
+		DEV_WARN(dev,
+			 "PCIe link degraded: Gen%d x%d (capable of Gen%d x%d), %llu correctable errors in the last %d s",
+			 speed,
+			 width,
+			 health->cap->expected_pcie_link_speed,
+			 health->cap->expected_pcie_link_width,
+			 window_errors,
+			 PCIE_HEALTH_ERR_WINDOW_MS / 1000);
+
+		sysfs_notify(&dev->dev.kobj, NULL, "pcie_health");
+	}
+}
+
+/**
+ * pcie_link_health_work_fn() - Periodic link health sampling.
+ * @work: The `work` member of a pcie_link_health struct.
+ *
+ * Return: None.
+ */
+static void pcie_link_health_work_fn(struct work_struct *work)
+{
+	struct pcie_link_health *health = NULL;
+	unsigned int interval_ms = 0;
+
+	health = container_of(to_delayed_work(work), struct pcie_link_health, work);
+
+	sample_pcie_link_health(health);
+
+	mutex_lock(&health->lock);
+	interval_ms = health->interval_ms;
+	mutex_unlock(&health->lock);
+
+	if (interval_ms)
+		schedule_delayed_work(&health->work, msecs_to_jiffies(interval_ms));
+}
+
+void init_pcie_link_health(struct pci_dev *dev, pcie_cap_struct *cap,
+			   struct pcie_link_health *health)
+{
+	if (!dev || !cap || !health)
+		return;
+
+	memset(health, 0, sizeof(*health));
+	health->dev = dev;
+	health->cap = cap;
+	health->aer_cap = pci_find_ext_capability(dev, PCI_EXT_CAP_ID_ERR);
+	health->aer_native = pcie_aer_is_os_owned(dev);
+	health->window_start = jiffies;
+
+	/* Errors logged before the monitor started are not counted */
+	if (health->aer_native && read_aer_core_cor_counts(dev, &health->aer_last))
+		DEV_WARN(dev, "AER core error counters unavailable, correctable errors will not be counted");
+	mutex_init(&health->lock);
+	INIT_DELAYED_WORK(&health->work, pcie_link_health_work_fn);
+}
+
+int set_pcie_link_health_interval(struct pcie_link_health *health,
+				  unsigned int interval_ms)
+{
+	if (!health || !health->dev)
+		return -EINVAL;
+
+	if (interval_ms && ((interval_ms < PCIE_HEALTH_INTERVAL_MIN_MS) ||
+			    (interval_ms > PCIE_HEALTH_INTERVAL_MAX_MS)))
+		return -EINVAL;
+
+	mutex_lock(&health->lock);
+	health->interval_ms = interval_ms;
+	mutex_unlock(&health->lock);
+
+	/* Sample straight away so the new rate takes effect immediately */
+	if (interval_ms)
+		mod_delayed_work(system_wq, &health->work, 0);
+	else
+		cancel_delayed_work_sync(&health->work);
+
+	return SUCCESS;
+}
+
+void stop_pcie_link_health(struct pcie_link_health *health)
+{
+	set_pcie_link_health_interval(health, 0);
+}
+
+ssize_t show_pcie_link_health(struct pcie_link_health *health, char *buf)
+{
+	ssize_t ret = 0;
+
+	if (!health || !health->cap || !buf)
+		return -EINVAL;
+
+	mutex_lock(&health->lock);
+	ret = sprintf(
+		buf,
+		PCIE_HEALTH_ATTR_FMT "\n",
+		health->flags,
+		health->cap->current_pcie_link_speed,
+		health->cap->expected_pcie_link_speed,
+		health->cap->current_pcie_link_width,
+		health->cap->expected_pcie_link_width,
+		health->downgrades,
+		health->events,
+		health->cor_errors,
+		health->rx_errors,
+		health->bad_tlp,
+		health->bad_dllp,
+		health->replays,
+		health->samples,
+		health->interval_ms
+	);
+	mutex_unlock(&health->lock);
+
+	return ret;
+}
+
 void release_pcie_ext_cap_secondary_pci(
 	pcie_ext_cap_secondary_pci_struct **secondary_pci)
 {
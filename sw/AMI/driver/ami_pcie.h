@@ -10,6 +10,8 @@
 
 #include <linux/types.h>
 #include <linux/pci.h>
+#include <linux/mutex.h>
+#include <linux/workqueue.h>
 #include <ami.h>
 
 #define DEV_ERR(pcie_dev, fmt, arg ...)       dev_err(&(pcie_dev->dev), "ERROR           : " fmt "\n", ## arg)
@@ -1463,6 +1465,135 @@ int read_pcie_configuration(struct pci_dev *dev, pcie_config_struct **pcie_confi
 int write_pcie_configuration(struct pci_dev *dev);
 bool is_supported_pcie_device_id(uint16_t pcie_device_id);
 
+/* PCIe link health */
+
+#define PCIE_HEALTH_INTERVAL_DEFAULT_MS	(5000)
+#define PCIE_HEALTH_INTERVAL_MIN_MS	(100)
+#define PCIE_HEALTH_INTERVAL_MAX_MS	(60000)
+#define PCIE_HEALTH_ERR_WINDOW_MS	(60000)
+#define PCIE_HEALTH_ERR_THRESHOLD	(10)	/* max correctable errors per window */
+
+/* Per-device correctable error counters kept by the AER core */
+#define PCIE_AER_COR_STATS_PATH		"/sys/bus/pci/devices/%s/aer_dev_correctable"
+#define PCIE_AER_COR_STATS_LEN		(512)
+
+#define PCIE_HEALTH_FLAG_SPEED_DOWN	BIT(0)
+#define PCIE_HEALTH_FLAG_WIDTH_DOWN	BIT(1)
+#define PCIE_HEALTH_FLAG_ERR_RATE	BIT(2)
+
+/* Format of the `pcie_health` sysfs attribute (parsed by libami) */
+#define PCIE_HEALTH_ATTR_FMT		"flags=0x%x speed=%hhu/%hhu width=%hhu/%hhu " \
+					"downgrades=%llu events=%llu cor_errors=%llu " \
+					"rx_errors=%llu bad_tlp=%llu bad_dllp=%llu " \
+					"replays=%llu samples=%llu interval_ms=%u"
+
+/**
+ * struct pcie_aer_cor_counts - Cumulative correctable error counts.
+ * @total: All correctable errors.
+ * @rx: Receiver errors.
+ * @bad_tlp: Bad TLPs.
+ * @bad_dllp: Bad DLLPs.
+ * @replays: Replay number rollovers and replay timer timeouts.
+ */
+struct pcie_aer_cor_counts {
+	uint64_t total;
+	uint64_t rx;
+	uint64_t bad_tlp;
+	uint64_t bad_dllp;
+	uint64_t replays;
+};
+
+/**
+ * struct pcie_link_health - PCIe link health monitor.
+ * @dev: PCI device being monitored.
+ * @cap: Decoded capabilities of `dev`; the current link speed/width are
+ *   refreshed on every sample.
+ * @work: Periodic sampling work.
+ * @lock: Protects all counters and flags.
+ * @interval_ms: Sampling interval (0 when stopped).
+ * @aer_cap: Config space offset of the AER capability (0 if not present).
+ * @aer_native: The OS AER core owns the AER registers of `dev`.
+ * @aer_last: AER core counts at the last sample (when `aer_native`).
+ * @flags: Current PCIE_HEALTH_FLAG_* conditions.
+ * @samples: Number of samples taken.
+ * @downgrades: Number of times the link was found newly downgraded.
+ * @events: Number of health events raised.
+ * @cor_errors: Total correctable errors.
+ * @rx_errors: Receiver errors.
+ * @bad_tlp: Bad TLPs.
+ * @bad_dllp: Bad DLLPs.
+ * @replays: Replay number rollovers and replay timer timeouts.
+ * @window_errors: Correctable errors in the current rate window.
+ * @window_start: Start of the current rate window (jiffies).
+ *
+ * When the OS AER core owns AER for the device, the counts are the increase
+ * in the core's per-device correctable counters since the previous sample
+ * and the status register is left alone. Otherwise nothing else clears the
+ * correctable AER status, so the monitor reads and write-1-clears it on every
+ * sample; errors of the same type within one interval are then counted as one.
+ * The error rate condition is raised once a window holds more than
+ * PCIE_HEALTH_ERR_THRESHOLD errors.
+ */
+struct pcie_link_health {
+	struct pci_dev		*dev;
+	pcie_cap_struct		*cap;
+	struct delayed_work	 work;
+	struct mutex		 lock;
+	unsigned int		 interval_ms;
+	int			 aer_cap;
+	bool			 aer_native;
+	struct pcie_aer_cor_counts aer_last;
+	uint32_t		 flags;
+	uint64_t		 samples;
+	uint64_t		 downgrades;
+	uint64_t		 events;
+	uint64_t		 cor_errors;
+	uint64_t		 rx_errors;
+	uint64_t		 bad_tlp;
+	uint64_t		 bad_dllp;
+	uint64_t		 replays;
+	uint64_t		 window_errors;
+	unsigned long		 window_start;
+};
+
+/**
+ * init_pcie_link_health() - Initialise the link health monitor.
+ * @dev: PCI device to monitor.
+ * @cap: Decoded capabilities of `dev` (must outlive the monitor).
+ * @health: Monitor to initialise.
+ *
+ * Return: None.
+ */
+void init_pcie_link_health(struct pci_dev *dev, pcie_cap_struct *cap,
+			   struct pcie_link_health *health);
+
+/**
+ * set_pcie_link_health_interval() - Start, restart or stop sampling.
+ * @health: Link health monitor.
+ * @interval_ms: Sampling interval in milliseconds, 0 to stop.
+ *
+ * Return: 0 or -EINVAL if the interval is out of range.
+ */
+int set_pcie_link_health_interval(struct pcie_link_health *health,
+				  unsigned int interval_ms);
+
+/**
+ * stop_pcie_link_health() - Stop sampling and wait for a running sample.
+ * @health: Link health monitor.
+ *
+ * Return: None.
+ */
+void stop_pcie_link_health(struct pcie_link_health *health);
+
+/**
+ * show_pcie_link_health() - Format a one line health summary.
+ * @health: Link health monitor.
+ * @buf: Output buffer (at least PAGE_SIZE bytes).
+ *
+ * Return: Number of bytes written.
+ */
+ssize_t show_pcie_link_health(struct pcie_link_health *health, char *buf);
+
 /* Release */
 void release_pcie_ext_cap_secondary_pci(pcie_ext_cap_secondary_pci_struct **secondary_pci);
 void release_pcie_ext_cap_phy_16_gts(pcie_ext_cap_phy_16_gts_struct **phy_16_gts);
@@ -8,6 +8,7 @@
 #include <linux/types.h>
 #include <linux/delay.h>
 #include <linux/pci.h>
+#include <linux/slab.h>
 #include <linux/eventfd.h>
 #include <linux/version.h>
 
@@ -21,6 +22,89 @@
 #define INVALID_BOOT_TAG	(0xFFFFFFFF)
 #define BOOT_TAG_CHUNK		(0)
 
+#define PDI_CHUNK_BYTES		(PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER)
+#define PDI_RECORD_HDR_SIZE	(sizeof(uint32_t))
+
+/**
+ * struct pdi_chunk - A single chunk of a PDI download.
+ * @data: Chunk data as it will be sent to the AMC.
+ * @len: Number of bytes to send.
+ * @raw_len: Number of image bytes the chunk expands to.
+ * @codec: Transfer codec of `data`.
+ */
+struct pdi_chunk {
+	uint8_t  *data;
+	uint32_t len;
+	uint32_t raw_len;
+	uint8_t  codec;
+};
+
+
+/**
+ * index_pdi_chunks() - Split a download buffer into its PDI chunks.
+ * @buf: Download buffer.
+ * @size: Size of the download buffer.
+ * @codec: Transfer codec of the buffer.
+ * @raw_size: Size of the decoded image.
+ * @chunks: Array to populate.
+ * @num_chunks: Number of entries in `chunks`.
+ *
+ * An uncompressed buffer is sliced into fixed size chunks. A compressed
+ * buffer is walked record by record; every record must cover exactly one
+ * chunk of the decoded image and the records must account for the whole
+ * buffer.
+ *
+ * Return: 0 or negative error code.
+ */
+static int index_pdi_chunks(uint8_t *buf, uint32_t size, uint8_t codec, uint32_t raw_size,
+	struct pdi_chunk *chunks, uint16_t num_chunks)
+{
+	uint32_t offset = 0;
+	uint16_t i = 0;
+
+	for (i = 0; i < num_chunks; i++) {
+		uint32_t hdr = 0;
+
+		chunks[i].raw_len = min_t(uint32_t, PDI_CHUNK_BYTES, raw_size - (i * PDI_CHUNK_BYTES));
+
+		if (codec == AMI_IOC_PDI_CODEC_NONE) {
+			chunks[i].data = &buf[offset];
+			chunks[i].len = chunks[i].raw_len;
+			chunks[i].codec = AMI_IOC_PDI_CODEC_NONE;
+			offset += chunks[i].len;
+			continue;
+		}
+
+		if ((size - offset) < PDI_RECORD_HDR_SIZE)
+			return -EINVAL;
+
+		memcpy(&hdr, &buf[offset], PDI_RECORD_HDR_SIZE);
+		offset += PDI_RECORD_HDR_SIZE;
+
+		chunks[i].data = &buf[offset];
+		chunks[i].len = AMI_IOC_PDI_RECORD_LEN(hdr);
+
+		if (hdr & AMI_IOC_PDI_RECORD_PACKED) {
+			/* Only worth sending if it is smaller than the chunk */
+			if (!chunks[i].len || (chunks[i].len >= chunks[i].raw_len))
+				return -EINVAL;
+
+			chunks[i].codec = codec;
+		} else {
+			if (chunks[i].len != chunks[i].raw_len)
+				return -EINVAL;
+
+			chunks[i].codec = AMI_IOC_PDI_CODEC_NONE;
+		}
+
+		if (chunks[i].len > (size - offset))
+			return -EINVAL;
+
+		offset += chunks[i].len;
+	}
+
+	return (offset == size) ? (0) : (-EINVAL);
+}
 
 /**
  * do_image_download() - Perform an image download operation.
@@ -29,28 +113,41 @@
  * @size: Size of bitstream buffer.
  * @boot_device: Target boot device.
  * @partition: Partition number to flash.
+ * @codec: Transfer codec of the buffer.
+ * @raw_size: Size of the decoded image (ignored if `codec` is NONE).
  * @efd_ctx: eventfd context for reporting progress (optional).
  *
  * If `partition` is equal to `FPT_UPDATE_MAGIC` will update the FPT.
  *
+ * Compressed chunks are forwarded as they are and expanded by the AMC, so
+ * progress is always reported in image (decoded) bytes.
+ *
  * Return: 0 or negative error code.
  */
 static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *buf, uint32_t size,
-	uint8_t boot_device, uint32_t partition, struct eventfd_ctx *efd_ctx)
+	uint8_t boot_device, uint32_t partition, uint8_t codec, uint32_t raw_size,
+	struct eventfd_ctx *efd_ctx)
 {
 	int ret = SUCCESS;
 	uint16_t chunk = 0;
 	uint8_t  part = 0;
-	uint32_t bytes_written = 0;
-	uint32_t bytes_to_write = 0;
+	uint32_t bytes_sent = 0;
 	bool rewrite_boot_tag = false;
-	/* Round up the total number of chunks */
-	uint16_t num_chunks = (size + ((PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER) - 1)) /
-		(PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER);
+	struct pdi_chunk *chunks = NULL;
+	uint16_t num_chunks = 0;
+
+	if (!size || !amc_ctrl_ctxt || !buf || (codec >= AMI_IOC_PDI_CODEC_MAX))
+		return -EINVAL;
+
+	if (codec == AMI_IOC_PDI_CODEC_NONE)
+		raw_size = size;
 
-	if (!size || !amc_ctrl_ctxt || !buf)
+	if (!raw_size)
 		return -EINVAL;
 
+	/* Round up the total number of chunks */
+	num_chunks = (raw_size + (PDI_CHUNK_BYTES - 1)) / PDI_CHUNK_BYTES;
+
 	if (partition == FPT_UPDATE_MAGIC) {
 		part = FPT_UPDATE_FLAG;
 	} else {
@@ -61,18 +158,23 @@ static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *bu
 		part = (uint8_t)partition;
 	}
 
+	chunks = kcalloc(num_chunks, sizeof(*chunks), GFP_KERNEL);
+	if (!chunks)
+		return -ENOMEM;
+
+	ret = index_pdi_chunks(buf, size, codec, raw_size, chunks, num_chunks);
+	if (ret) {
+		AMI_ERR(amc_ctrl_ctxt, "Malformed compressed PDI buffer");
+		goto free_chunks;
+	}
+
 	AMI_VDBG(
 		amc_ctrl_ctxt,
-		"Attempting to download PDI bitstream with image size %d to partition %d num_chunks = %d",
-		size, part, num_chunks
+		"Attempting to download PDI bitstream with image size %d (%d sent, codec %d) to partition %d num_chunks = %d",
+		raw_size, size, codec, part, num_chunks
 	);
 
-	while (bytes_written < size) {
-		if ((PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER) > (size - bytes_written))
-			bytes_to_write = (size - bytes_written);
-		else
-			bytes_to_write = (PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER);
-
+	for (chunk = 0; chunk < num_chunks; chunk++) {
 		/*
 		 * Don't invalidate the boot tag if we're updating the FPT
 		 * or if there is only a single chunk.
@@ -84,17 +186,20 @@ static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *bu
 			* the GCQ command. Using `flags` to pass in partition and chunk numbers.
 			*/
 			ret = submit_gcq_command(amc_ctrl_ctxt, GCQ_SUBMIT_CMD_DOWNLOAD_PDI,
-				MK_PDI_FLAGS(boot_device, part, chunk, (!rewrite_boot_tag && (chunk == (num_chunks - 1)))),
-				&buf[bytes_written], bytes_to_write);
+				MK_PDI_FLAGS(boot_device, part, chunk, (!rewrite_boot_tag && (chunk == (num_chunks - 1)))) |
+				PDI_CODEC_FLAG(chunks[chunk].codec),
+				chunks[chunk].data, chunks[chunk].len);
 
 			if (ret)
 				break;
 
+			bytes_sent += chunks[chunk].len;
+
 			if (efd_ctx) {
 				#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 8, 0)
 					eventfd_signal(efd_ctx);
 				#else
-					eventfd_signal(efd_ctx, bytes_to_write);
+					eventfd_signal(efd_ctx, chunks[chunk].raw_len);
 				#endif
 			}
 		} else {
@@ -114,9 +219,8 @@ static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *bu
 				(uint8_t*)&boot_tag, sizeof(uint32_t));
 
 			/*
-			 * Don't signal to the user here but we do increment
-			 * the chunk and number of bytes written so we can continue
-			 * with the loop as normal.
+			 * Don't signal to the user here but we do move on to
+			 * the next chunk so we can continue with the loop as normal.
 			 */
 			if (ret)
 				break;
@@ -129,9 +233,6 @@ static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *bu
 			"Done with chunk %d",
 			chunk
 		);
-
-		chunk++;
-		bytes_written += bytes_to_write;
 	}
 
 	/* Check if we need to re-write the first chunk */
@@ -146,20 +247,33 @@ static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *bu
 		 * to have the full chunk size.
 		 */
 		ret = submit_gcq_command(amc_ctrl_ctxt, GCQ_SUBMIT_CMD_DOWNLOAD_PDI,
-			MK_PDI_FLAGS(boot_device, partition, BOOT_TAG_CHUNK, true),
-			buf, (PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER));
-
-		if (!ret && efd_ctx)
-		#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 8, 0)
-			eventfd_signal(efd_ctx);
-		#else
-			eventfd_signal(efd_ctx, (PDI_CHUNK_SIZE * PDI_CHUNK_MULTIPLIER));
-		#endif
+			MK_PDI_FLAGS(boot_device, partition, BOOT_TAG_CHUNK, true) |
+			PDI_CODEC_FLAG(chunks[BOOT_TAG_CHUNK].codec),
+			chunks[BOOT_TAG_CHUNK].data, chunks[BOOT_TAG_CHUNK].len);
+
+		if (!ret) {
+			bytes_sent += chunks[BOOT_TAG_CHUNK].len;
+
+			if (efd_ctx)
+			#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 8, 0)
+				eventfd_signal(efd_ctx);
+			#else
+				eventfd_signal(efd_ctx, chunks[BOOT_TAG_CHUNK].raw_len);
+			#endif
+		}
 	}
 
 	if (ret)
 		AMI_ERR(amc_ctrl_ctxt, "Failed to download PDI");
+	else if (codec != AMI_IOC_PDI_CODEC_NONE)
+		AMI_VDBG(
+			amc_ctrl_ctxt,
+			"Sent %d bytes for a %d byte image (codec %d)",
+			bytes_sent, raw_size, codec
+		);
 
+free_chunks:
+	kfree(chunks);
 	return ret;
 }
 
@@ -167,7 +281,8 @@ static int do_image_download(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *bu
  * Download a PDI bitstream.
  */
 int download_pdi(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *buf, uint32_t size,
-	uint8_t boot_device, uint32_t partition, struct eventfd_ctx *efd_ctx)
+	uint8_t boot_device, uint32_t partition, uint8_t codec, uint32_t raw_size,
+	struct eventfd_ctx *efd_ctx)
 {
 	if (!amc_ctrl_ctxt || !size || !buf || (partition == FPT_UPDATE_MAGIC))
 		return -EINVAL;
@@ -178,6 +293,8 @@ int download_pdi(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *buf, uint32_t
 		size,
 		boot_device,
 		partition,
+		codec,
+		raw_size,
 		efd_ctx
 	);
 }
@@ -186,7 +303,7 @@ int download_pdi(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *buf, uint32_t
  * Update device FPT.
  */
 int update_fpt(struct pf_dev_struct *pf_dev, uint8_t *buf, uint32_t size,
-	uint8_t boot_device, struct eventfd_ctx *efd_ctx)
+	uint8_t boot_device, uint8_t codec, uint32_t raw_size, struct eventfd_ctx *efd_ctx)
 {
 	int ret = 0;
 
@@ -199,6 +316,8 @@ int update_fpt(struct pf_dev_struct *pf_dev, uint8_t *buf, uint32_t size,
 		size,
 		boot_device,
 		FPT_UPDATE_MAGIC,
+		codec,
+		raw_size,
 		efd_ctx
 	);
 
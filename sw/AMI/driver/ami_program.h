@@ -43,17 +43,20 @@
 
 /*
  * Format of flags:
- * 0xAABBCCCC where:
- *   0xAA is the boot device flag (8 bits)
- * 	 0xBB is the partition number (8 bits) - this is 0xAA when updating the FPT
- *   0xCCCC is the current chunk number (15 bits) with the MSB set to 1 if this is the last chunk (1 bit)
+ * 0xABCCDDDD where:
+ *   0xA is the transfer codec of the chunk (4 bits)
+ *   0xB is the boot device flag (4 bits)
+ * 	 0xCC is the partition number (8 bits) - this is 0xAA when updating the FPT
+ *   0xDDDD is the current chunk number (15 bits) with the MSB set to 1 if this is the last chunk (1 bit)
  *
- * `last` in this macro should be a bool.
+ * `last` in this macro should be a bool. The codec is OR'd in with `PDI_CODEC_FLAG`.
  */
-#define MK_PDI_FLAGS(boot, part, chunk, last)	(((uint8_t)boot << 24) | ((uint8_t)part << 16 ) | ((last) ? \
+#define MK_PDI_FLAGS(boot, part, chunk, last)	((((uint8_t)boot & 0x0F) << 24) | ((uint8_t)part << 16 ) | ((last) ? \
 							((uint16_t)chunk | ((uint16_t)1 << 15)) : \
 							((uint16_t)chunk & ~((uint16_t)1 << 15))))
-#define PDI_BOOT_DEVICE(flags)		((uint8_t)(flags >> 24))
+#define PDI_CODEC_FLAG(codec)		((uint32_t)((codec) & 0x0F) << 28)
+#define PDI_CODEC(flags)		((uint8_t)((flags >> 28) & 0x0F))
+#define PDI_BOOT_DEVICE(flags)		((uint8_t)((flags >> 24) & 0x0F))
 #define PDI_PARTITION(flags)		((uint8_t)(flags >> 16))
 #define PDI_CHUNK(flags)		(((uint16_t)(flags & 0x0000ffff)) & ~((uint16_t)1 << 15))
 #define PDI_CHUNK_IS_LAST(flags)	((uint16_t)(flags & 0x0000ffff) >> 15)  /* either 1 or 0 */
@@ -65,12 +68,15 @@
  * @size: Size of bitstream buffer.
  * @boot_device: Target boot device.
  * @partition: Partition number to flash.
+ * @codec: Transfer codec of the buffer (`AMI_IOC_PDI_CODEC_*`).
+ * @raw_size: Size of the decoded image (ignored if `codec` is NONE).
  * @efd_ctx: eventfd context for reporting progress (optional).
  * 
  * Return: 0 or negative error code.
  */
 int download_pdi(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *buf, uint32_t size,
-	uint8_t boot_device, uint32_t partition, struct eventfd_ctx *efd_ctx);
+	uint8_t boot_device, uint32_t partition, uint8_t codec, uint32_t raw_size,
+	struct eventfd_ctx *efd_ctx);
 
 /**
  * update_fpt() - Download a PDI containing an FPT onto a device.
@@ -78,12 +84,14 @@ int download_pdi(struct amc_control_ctxt *amc_ctrl_ctxt, uint8_t *buf, uint32_t
  * @buf: Bitstream byte buffer - must contain valid FPT.
  * @size: Size of bitstream buffer.
  * @boot_device: Target boot device.
+ * @codec: Transfer codec of the buffer (`AMI_IOC_PDI_CODEC_*`).
+ * @raw_size: Size of the decoded image (ignored if `codec` is NONE).
  * @efd_ctx: eventfd context for reporting progress (optional).
  * 
  * Return: 0 or negative error code.
  */
 int update_fpt(struct pf_dev_struct *pf_dev, uint8_t *buf, uint32_t size,
-	uint8_t boot_device, struct eventfd_ctx *efd_ctx);
+	uint8_t boot_device, uint8_t codec, uint32_t raw_size, struct eventfd_ctx *efd_ctx);
 
 /**
  * device_boot() - Set the device boot partition.
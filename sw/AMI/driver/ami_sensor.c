@@ -20,6 +20,7 @@ static struct sensor_status_name_map_t sensor_status_name_map[] = {
 	{ SENSOR_NOT_PRESENT,	       SENSOR_STATUS_NAME_NOT_PRESENT	       },
 	{ SENSOR_PRESENT_AND_VALID,    SENSOR_STATUS_NAME_PRESENT	       },
 	{ DATA_NOT_AVAILABLE,	       SENSOR_STATUS_NAME_UNAVAIL	       },
+	{ SENSOR_QUARANTINED,	       SENSOR_STATUS_NAME_QUARANTINED	       },
 	{ SENSOR_STATUS_NOT_AVAILABLE, SENSOR_STATUS_NAME_NA		       },
 };
 
@@ -501,7 +502,7 @@ static int get_sdr(struct amc_control_ctxt	*amc_ctrl_ctxt,
 
 	/* TODO: Get the SDR size. */
 
-	sdr_raw_buf = vzalloc(sizeof(char) * SDR_RESP_LEN);
+	sdr_raw_buf = vzalloc_node(sizeof(char) * SDR_RESP_LEN, AMI_NODE(amc_ctrl_ctxt));
 	if (!sdr_raw_buf) {
 		AMI_ERR(amc_ctrl_ctxt, "Failed to allocate memory buffer for sdr_raw_buf");
 		ret = -ENOMEM;
@@ -731,7 +732,7 @@ int update_sdr(struct pf_dev_struct *pf_dev, enum gcq_sdr_repo_type repo_type)
 	if (!repo)
 		return -ENODATA;
 
-	new_repo = kzalloc(sizeof(struct sdr_repo), GFP_KERNEL);
+	new_repo = kzalloc_node(sizeof(struct sdr_repo), GFP_KERNEL, PF_DEV_NODE(pf_dev));
 
 	if (!new_repo)
 		return -ENOMEM;
@@ -860,7 +861,7 @@ static int get_all_sensors(struct amc_control_ctxt	*amc_ctrl_ctxt,
 	if (!amc_ctrl_ctxt || !sensor_repo)
 		return -EINVAL;
 
-	sdr_raw_buf = vzalloc(sizeof(char) * SENSOR_RSP_LEN);
+	sdr_raw_buf = vzalloc_node(sizeof(char) * SENSOR_RSP_LEN, AMI_NODE(amc_ctrl_ctxt));
 	if (!sdr_raw_buf) {
 		AMI_ERR(amc_ctrl_ctxt, "Failed to allocate memory buffer for sdr_raw_buf");
 		ret = -ENOMEM;
@@ -967,12 +968,14 @@ static int get_all_sensors(struct amc_control_ctxt	*amc_ctrl_ctxt,
  *                   added option of not reading sensors unless they are "stale".
  * @pf_dev: Pointer to top level PCI data struct.
  * @gcq_cmd: The CMD code to submit; used to populate payload fields.
+ * @max_age: Oldest cached reading (ms) the caller accepts; 0 always refreshes.
  * @fresh: boolean indicating if the value came from the cache or over GCQ
  *
  * Return: 0 or negative error code.
  */
 static int read_sensors(struct pf_dev_struct	*pf_dev,
 			enum gcq_submit_cmd_req gcq_cmd,
+			uint16_t		max_age,
 			bool			*fresh)
 {
 	unsigned long stamp = 0;
@@ -1021,7 +1024,7 @@ static int read_sensors(struct pf_dev_struct	*pf_dev,
 	stamp = jiffies;
 	delta = (long)stamp - (long)repo->last_update;
 
-	if ((pf_dev->sensor_refresh == 0) || ((delta * 1000 / HZ) > pf_dev->sensor_refresh)) {
+	if ((max_age == 0) || ((delta * 1000 / HZ) > max_age)) {
 		if (fresh)
 			*fresh = true;
 
@@ -1041,6 +1044,7 @@ static int read_sensors(struct pf_dev_struct	*pf_dev,
 /**
  * read_thermal_sensors() - Retrieve all temperature sensor readings.
  * @pf_dev: Pointer to top level PCI data struct.
+ * @max_age: Oldest cached reading (ms) the caller accepts.
  * @fresh: boolean indicating if the value came from the cache or over GCQ
  *
  * Like the `get_all_sensors` function, this simply populates data for
@@ -1048,11 +1052,12 @@ static int read_sensors(struct pf_dev_struct	*pf_dev,
  *
  * Return: 0 on success or negative error code.
  */
-int read_thermal_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
+int read_thermal_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh)
 {
 	return read_sensors(
 		pf_dev,
 		GCQ_SUBMIT_CMD_GET_ALL_INST_TEMP_SENSOR,
+		max_age,
 		fresh
 	);
 }
@@ -1060,6 +1065,7 @@ int read_thermal_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
 /**
  * read_voltage_sensors() - Retrieve all voltage sensor readings.
  * @pf_dev: Pointer to top level PCI data struct.
+ * @max_age: Oldest cached reading (ms) the caller accepts.
  * @fresh: boolean indicating if the value came from the cache or over GCQ
  *
  * Like the `get_all_sensors` function, this simply populates data for
@@ -1067,11 +1073,12 @@ int read_thermal_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
  *
  * Return: 0 on success or negative error code.
  */
-int read_voltage_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
+int read_voltage_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh)
 {
 	return read_sensors(
 		pf_dev,
 		GCQ_SUBMIT_CMD_GET_ALL_INST_VOLTAGE_SENSOR,
+		max_age,
 		fresh
 	);
 }
@@ -1079,6 +1086,7 @@ int read_voltage_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
 /**
  * read_current_sensors() - Retrieve all current sensor readings.
  * @pf_dev: Pointer to top level PCI data struct.
+ * @max_age: Oldest cached reading (ms) the caller accepts.
  * @fresh: boolean indicating if the value came from the cache or over GCQ
  *
  * Like the `get_all_sensors` function, this simply populates data for
@@ -1086,11 +1094,12 @@ int read_voltage_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
  *
  * Return: 0 on success or negative error code.
  */
-int read_current_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
+int read_current_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh)
 {
 	return read_sensors(
 		pf_dev,
 		GCQ_SUBMIT_CMD_GET_ALL_INST_CURRENT_SENSOR,
+		max_age,
 		fresh
 	);
 }
@@ -1098,6 +1107,7 @@ int read_current_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
 /**
  * read_power_sensors() - Retrieve all power sensor readings.
  * @pf_dev: Pointer to top level PCI data struct.
+ * @max_age: Oldest cached reading (ms) the caller accepts.
  * @fresh: boolean indicating if the value came from the cache or over GCQ
  *
  * Like the `get_all_sensors` function, this simply populates data for
@@ -1105,11 +1115,12 @@ int read_current_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
  *
  * Return: 0 on success or negative error code.
  */
-int read_power_sensors(struct pf_dev_struct *pf_dev, bool *fresh)
+int read_power_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh)
 {
 	return read_sensors(
 		pf_dev,
 		GCQ_SUBMIT_CMD_GET_ALL_INST_POWER_SENSOR,
+		max_age,
 		fresh
 	);
 }
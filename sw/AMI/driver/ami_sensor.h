@@ -52,6 +52,7 @@ enum ami_amc_boot_devices {
 #define SENSOR_STATUS_NAME_NOT_PRESENT "Sensor Not Present"
 #define SENSOR_STATUS_NAME_PRESENT     "Sensor Present and Valid"
 #define SENSOR_STATUS_NAME_UNAVAIL     "Data Not Available"
+#define SENSOR_STATUS_NAME_QUARANTINED "Sensor Quarantined"
 #define SENSOR_STATUS_NAME_NA          "Not Applicable or Default Value"
 
 int discover_sensors(struct pf_dev_struct *pf_dev, int *empty_sdr_count);
@@ -67,10 +68,10 @@ long make_val(enum sdr_value_type type, uint8_t size, uint8_t *data);
 char *convert_sensor_status_name_map(int status);
 const char *sdr_repo_type_to_str(enum gcq_sdr_repo_type sdr);
 
-int read_thermal_sensors(struct pf_dev_struct *pf_dev, bool *fresh);
-int read_current_sensors(struct pf_dev_struct *pf_dev, bool *fresh);
-int read_voltage_sensors(struct pf_dev_struct *pf_dev, bool *fresh);
-int read_power_sensors(struct pf_dev_struct *pf_dev, bool *fresh);
+int read_thermal_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh);
+int read_current_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh);
+int read_voltage_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh);
+int read_power_sensors(struct pf_dev_struct *pf_dev, uint16_t max_age, bool *fresh);
 
 int read_fpt_hdr(struct pf_dev_struct *pf_dev, uint8_t boot_device, struct fpt_header *hdr);
 int read_fpt_partition(struct pf_dev_struct *pf_dev,
@@ -238,6 +238,112 @@ static ssize_t link_width_current_show(struct device		*dev,
 }
 static DEVICE_ATTR_RO(link_width_current);
 
+/**
+ * pcie_health_show() - Sysfs read callback for 'pcie_health' attribute.
+ * @dev: Device this attribute belongs to.
+ * @da: Pointer to device attribute struct.
+ * @buf: Output character buffer.
+ *
+ * This attribute can be polled for link health events.
+ *
+ * Return: Number of bytes written to output buffer.
+ */
+static ssize_t pcie_health_show(struct device		*dev,
+				struct device_attribute	*da,
+				char			*buf)
+{
+	int ret = 0;
+	struct pf_dev_struct *pf_dev = NULL;
+
+	if (!dev || !da || !buf)
+		return -EINVAL;
+
+	pf_dev = get_pf_dev_entry(dev, PF_DEV_CACHE_DEV);
+
+	if (pf_dev) {
+		ret = show_pcie_link_health(&pf_dev->link_health, buf);
+		put_pf_dev_entry(pf_dev);
+	} else {
+		ret = -ENODEV;
+	}
+
+	return ret;
+}
+static DEVICE_ATTR_RO(pcie_health);
+
+/**
+ * pcie_health_interval_show() - Sysfs read callback.
+ * @dev: Device this attribute belongs to.
+ * @da: Pointer to device attribute struct.
+ * @buf: Output character buffer.
+ *
+ * Return: Number of bytes written to output buffer.
+ */
+static ssize_t pcie_health_interval_show(struct device		*dev,
+					 struct device_attribute	*da,
+					 char				*buf)
+{
+	int ret = 0;
+	struct pf_dev_struct *pf_dev = NULL;
+
+	if (!dev || !da || !buf)
+		return -EINVAL;
+
+	pf_dev = get_pf_dev_entry(dev, PF_DEV_CACHE_DEV);
+
+	if (pf_dev) {
+		ret = sprintf(buf, "%u\n", READ_ONCE(pf_dev->link_health.interval_ms));
+		put_pf_dev_entry(pf_dev);
+	} else {
+		ret = -ENODEV;
+	}
+
+	return ret;
+}
+
+/**
+ * pcie_health_interval_store() - Sysfs write callback.
+ * @dev: Device this attribute belongs to.
+ * @da: Pointer to device attribute struct.
+ * @buf: Input character buffer - sampling interval in milliseconds (0 to stop).
+ * @count: Number of bytes in the input buffer.
+ *
+ * Return: Number of bytes consumed or negative error code.
+ */
+static ssize_t pcie_health_interval_store(struct device			*dev,
+					  struct device_attribute	*da,
+					  const char			*buf,
+					  size_t			count)
+{
+	int ret = 0;
+	unsigned int interval_ms = 0;
+	struct pf_dev_struct *pf_dev = NULL;
+
+	if (!dev || !da || !buf)
+		return -EINVAL;
+
+	ret = kstrtouint(buf, 0, &interval_ms);
+	if (ret)
+		return ret;
+
+	pf_dev = get_pf_dev_entry(dev, PF_DEV_CACHE_DEV);
+
+	if (pf_dev) {
+		/* Sampling must not be restarted once the device services are down. */
+		if (pf_dev->state == PF_DEV_STATE_SHUTDOWN)
+			ret = -ENODEV;
+		else
+			ret = set_pcie_link_health_interval(&pf_dev->link_health, interval_ms);
+
+		put_pf_dev_entry(pf_dev);
+	} else {
+		ret = -ENODEV;
+	}
+
+	return ret ? ret : count;
+}
+static DEVICE_ATTR_RW(pcie_health_interval);
+
 /**
  * dev_state_show() - Sysfs read callback for 'dev_state' attribute.
  * @dev: Device this attribute belongs to.
@@ -298,7 +404,7 @@ static ssize_t dev_name_show(struct device		*dev,
 		return -ENODEV;
 
 	/* Must use dynamically allocated memory here due to a large struct. */
-	bd_info_record = vzalloc(sizeof(struct bd_info_record));
+	bd_info_record = vzalloc_node(sizeof(struct bd_info_record), PF_DEV_NODE(pf_dev));
 
 	if (!bd_info_record) {
 		put_pf_dev_entry(pf_dev);
@@ -349,6 +455,12 @@ static ssize_t amc_version_show(struct device		*dev,
 	pf_dev = get_pf_dev_entry(dev, PF_DEV_CACHE_DEV);
 
 	if (pf_dev) {
+		/* The AMC context is freed under this lock if the bring-up fails */
+		if (down_interruptible(&pf_dev->ioctl_sema)) {
+			put_pf_dev_entry(pf_dev);
+			return -ERESTARTSYS;
+		}
+
 		if (pf_dev->amc_ctrl_ctxt) {
 			/* Format is MAJOR.MINOR.PATCH +COMMITS *CHANGES */
 			ret = sprintf(
@@ -361,6 +473,8 @@ static ssize_t amc_version_show(struct device		*dev,
 				pf_dev->amc_ctrl_ctxt->version.local_changes
 			);
 		}
+
+		up(&pf_dev->ioctl_sema);
 		put_pf_dev_entry(pf_dev);
 	} else {
 		ret = -ENODEV;
@@ -765,6 +879,8 @@ static const struct device_attribute *mgmt_attrs[] = {
 	&dev_attr_link_speed_current,
 	&dev_attr_link_width_max,
 	&dev_attr_link_width_current,
+	&dev_attr_pcie_health,
+	&dev_attr_pcie_health_interval,
 	&dev_attr_dev_state,
 	&dev_attr_dev_name,
 	&dev_attr_amc_version,
@@ -45,6 +45,10 @@
 /* Limits the length of the ami_debug_enabled input*/
 #define AMI_DEBUG_INPUT_LIMIT   (2)
 
+/* Polling of the AMC GCQ readiness from the deferred bring-up work */
+#define DEVICE_READY_SLEEP_INTERVAL (100)
+#define DEVICE_READY_RETRY_COUNT    (5)
+
 static struct drv_cdev_struct driver_dev = { { 0 } };  /* Global device */
 static unsigned pf_dev_index = DEFAULT_CDEV_BASEMINOR;
 static FW_IF_GCQ_INIT_CFG fw_if_gcq_init_cfg = { 0 };
@@ -137,7 +141,7 @@ static void amc_event_cb(enum amc_event_id id, void *data)
 			} else {
 				stop_gcq_services(pf_dev->amc_ctrl_ctxt);
 				/* Overwrite the device state */
-				pf_dev->state = PF_DEV_STATE_NO_AMC;
+				set_pf_dev_state(pf_dev, PF_DEV_STATE_NO_AMC);
 			}
 		}
 	}
@@ -173,8 +177,90 @@ static struct pci_driver pcie_driver_core = {
 	.id_table	= device_id,
 	.probe		= pcie_device_probe,    /* Kernel calls this when it thinks our device is being inserted */
 	.remove		= pcie_device_remove,
+	.driver		= {
+		/* Probe cards in parallel rather than one after the other. */
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
+	},
 };
 
+/**
+ * amc_ready_work_fn() - Deferred AMC bring-up.
+ * @work: The `amc_ready_work` member of a pf_dev_struct.
+ *
+ * The probe function only maps the AMC endpoints; this work item polls
+ * the GCQ until the AMC reports ready (requeueing itself instead of
+ * sleeping), then starts the AMC services, discovers sensors and moves
+ * the device out of PF_DEV_STATE_INIT.
+ *
+ * Return: None.
+ */
+static void amc_ready_work_fn(struct work_struct *work)
+{
+	int ret = 0;
+	int empty_sdr_count = 0;
+	struct pf_dev_struct *pf_dev = NULL;
+	struct pci_dev *dev = NULL;
+
+	pf_dev = container_of(to_delayed_work(work), struct pf_dev_struct, amc_ready_work);
+	dev = pf_dev->pci;
+
+	ret = start_amc(pf_dev->amc_ctrl_ctxt);
+
+	if ((ret == -EAGAIN) && (++pf_dev->amc_ready_retries <= DEVICE_READY_RETRY_COUNT)) {
+		schedule_delayed_work(&pf_dev->amc_ready_work,
+				      msecs_to_jiffies(DEVICE_READY_SLEEP_INTERVAL));
+		return;
+	}
+
+	if (ret) {
+		if (ret == -EAGAIN)
+			DEV_ERR(dev,
+				"AMC GCQ service not ready after %d ms, reboot required!",
+				DEVICE_READY_SLEEP_INTERVAL * DEVICE_READY_RETRY_COUNT);
+
+		/*
+		 * The cdev and sysfs attributes are already live - hold the ioctl
+		 * lock so no handler can be using the context while it is freed.
+		 */
+		down(&pf_dev->ioctl_sema);
+		unset_amc(dev, &pf_dev->amc_ctrl_ctxt);
+		release_amc_mem(&pf_dev->amc_ctrl_ctxt);  /* NOTE: This sets the pointer to NULL. */
+		set_pf_dev_state(pf_dev, PF_DEV_STATE_NO_AMC);
+		up(&pf_dev->ioctl_sema);
+		return;
+	}
+
+	/* COMPAT MODE: No sensor data and no hwmon entries. */
+	if (pf_dev->amc_ctrl_ctxt->compat_mode) {
+		set_pf_dev_state(pf_dev, PF_DEV_STATE_COMPAT);
+		return;
+	}
+
+	/*
+	 * Attempt sensor discovery only if AMC was initialised correctly.
+	 * We don't give up if the sensor discovery or hwmon init fails - the
+	 * user should still be able to access the device regardless. As this
+	 * runs after the probe has returned, a hwmon init failure can no longer
+	 * fail the probe; it is reported as PF_DEV_STATE_INIT_ERROR instead.
+	 * NOTE: Both, the sensor data and hwmon data use managed memory so no
+	 * cleanup is necessary.
+	 */
+	if (pf_dev->pcie_function_num == 0) {
+		if (discover_sensors(pf_dev, &empty_sdr_count) ||
+		    register_hwmon(&dev->dev, pf_dev)) {
+			set_pf_dev_state(pf_dev, PF_DEV_STATE_INIT_ERROR);
+			return;
+		}
+	}
+
+	if (empty_sdr_count)
+		set_pf_dev_state(pf_dev, PF_DEV_STATE_MISSING_INFO);
+	else
+		set_pf_dev_state(pf_dev, PF_DEV_STATE_READY);
+
+	DEV_VDBG(dev, "AMC ready after %d retries", pf_dev->amc_ready_retries);
+}
+
 /**
  * create_pf_dev_data() - Create a pf_dev struct and initialize all services.
  * @dev: Parent PCI device struct.
@@ -186,14 +272,14 @@ static struct pci_driver pcie_driver_core = {
 static int create_pf_dev_data(struct pci_dev *dev)
 {
 	int ret = SUCCESS;
-	int empty_sdr_count = 0;
+	unsigned cdev_index = 0;
 	struct pf_dev_struct *pf_dev = NULL;
 
 	if (!dev)
 		return -EINVAL;
 
 	/* Allocating and zeroing kernel memory */
-	pf_dev = kzalloc(sizeof(struct pf_dev_struct), GFP_KERNEL);
+	pf_dev = kzalloc_node(sizeof(struct pf_dev_struct), GFP_KERNEL, dev_to_node(&dev->dev));
 
 	if (!pf_dev) {
 		PR_ERR("Failed to allocate kernel memory for pf_dev_struct");
@@ -215,6 +301,7 @@ static int create_pf_dev_data(struct pci_dev *dev)
 	mutex_init(&pf_dev->app_lock);
 	kref_init(&pf_dev->refcount);
 	INIT_LIST_HEAD(&pf_dev->apps);
+	INIT_DELAYED_WORK(&pf_dev->amc_ready_work, amc_ready_work_fn);
 
 	sprintf(pf_dev->bdf_str,
 		"%02x:%02x.%1x",
@@ -231,6 +318,8 @@ static int create_pf_dev_data(struct pci_dev *dev)
 	if (ret)
 		goto delete_data;
 
+	init_pcie_link_health(dev, pf_dev->pcie_config->cap, &pf_dev->link_health);
+
 	/* Setting PCIE Config */
 	ret = write_pcie_configuration(dev);
 	if (ret)
@@ -251,7 +340,8 @@ static int create_pf_dev_data(struct pci_dev *dev)
 	/* AMC Setup */
 	/*
 	 * If this fails, simply set the context to NULL and try to
-	 * continue with the probe function as normal.
+	 * continue with the probe function as normal. The rest of the
+	 * AMC bring-up is deferred until the GCQ is ready.
 	 */
 	ret = setup_amc(dev,
 			&pf_dev->amc_ctrl_ctxt,
@@ -261,31 +351,7 @@ static int create_pf_dev_data(struct pci_dev *dev)
 			(void*)dev);
 	if (ret) {
 		pf_dev->amc_ctrl_ctxt = NULL;
-		pf_dev->state = PF_DEV_STATE_NO_AMC;
-	} else {
-		if (pf_dev->amc_ctrl_ctxt->compat_mode)
-			pf_dev->state = PF_DEV_STATE_COMPAT;
-	}
-
-	/*
-	 * Attempt sensor discovery only if AMC was initialised correctly.
-	 * COMPAT MODE: No sensor data and no hwmon entries.
-	 */
-	if ((pf_dev->pcie_function_num == 0) && pf_dev->amc_ctrl_ctxt &&
-	    !(pf_dev->amc_ctrl_ctxt->compat_mode)) {
-		/* We don't bail out if the sensor discover fails - the user
-		 * should still be able to access the device regardless. We do
-		 * bail out, however, if the hwmon init fails as this should not
-		 * happen. NOTE: Both, the sensor data and hwmon data use managed
-		 * memory so no cleanup is necessary.
-		 */
-		if (!discover_sensors(pf_dev, &empty_sdr_count)) {
-			ret = register_hwmon(&dev->dev, pf_dev);
-			if (ret)
-				goto remove_pf_dev;
-		} else {
-			pf_dev->state = PF_DEV_STATE_INIT_ERROR;
-		}
+		set_pf_dev_state(pf_dev, PF_DEV_STATE_NO_AMC);
 	}
 
 	/*
@@ -306,21 +372,24 @@ static int create_pf_dev_data(struct pci_dev *dev)
 		driver_dev.drv_cls_str,
 		strlen(driver_dev.drv_cls_str));
 
-	ret = create_cdev(pf_dev_index, &pf_dev->cdev, &dev->dev, &dev_fops);
+	/* Devices are probed asynchronously - reserve a unique minor number. */
+	mutex_lock(&pf_dev_lock);
+	cdev_index = pf_dev_index++;
+	mutex_unlock(&pf_dev_lock);
+
+	ret = create_cdev(cdev_index, &pf_dev->cdev, &dev->dev, &dev_fops);
 	if (ret)
 		goto delete_sysfs;
 
-	pf_dev_index++;
-
-	if (pf_dev->state == PF_DEV_STATE_INIT) {
-		if (empty_sdr_count)
-			pf_dev->state = PF_DEV_STATE_MISSING_INFO;
-		else
-			pf_dev->state = PF_DEV_STATE_READY;
-	}
-
 	DEV_VDBG(dev, "Successfully probed device: 0x%X", dev->device);
 	pf_dev->enabled = true;  /* This is safe if we are called from the probe callback. */
+
+	/* The device stays in the INIT state until the AMC is ready. */
+	if (pf_dev->amc_ctrl_ctxt)
+		schedule_delayed_work(&pf_dev->amc_ready_work, 0);
+
+	set_pcie_link_health_interval(&pf_dev->link_health, PCIE_HEALTH_INTERVAL_DEFAULT_MS);
+
 	return SUCCESS;
 
 delete_sysfs:
@@ -401,13 +470,33 @@ void shutdown_pf_dev_services(struct pf_dev_struct *pf_dev)
 	if (!pf_dev || (pf_dev->state == PF_DEV_STATE_SHUTDOWN))
 		return;
 
+	/* Stop (or wait for) a pending AMC bring-up. */
+	cancel_delayed_work_sync(&pf_dev->amc_ready_work);
+
+	/* Stop link health sampling - this must not outlive the PCIe config data. */
+	stop_pcie_link_health(&pf_dev->link_health);
+
 	/* Shutdown AMC. */
 	if (pf_dev->amc_ctrl_ctxt) {
 		unset_amc(pf_dev->pci, &pf_dev->amc_ctrl_ctxt);
 		release_amc_mem(&pf_dev->amc_ctrl_ctxt);  /* NOTE: This sets the pointer to NULL. */
 	}
 
-	pf_dev->state = PF_DEV_STATE_SHUTDOWN;
+	set_pf_dev_state(pf_dev, PF_DEV_STATE_SHUTDOWN);
+}
+
+/*
+ * Update the device state and wake up any pollers of the 'dev_state' attribute.
+ */
+void set_pf_dev_state(struct pf_dev_struct *pf_dev, enum pf_dev_state state)
+{
+	if (!pf_dev || (pf_dev->state == state))
+		return;
+
+	pf_dev->state = state;
+
+	/* This is a no-op if the attribute has not been created yet. */
+	sysfs_notify(&pf_dev->pci->dev.kobj, NULL, "dev_state");
 }
 
 /**
@@ -554,8 +643,8 @@ struct pf_dev_struct *get_pf_dev_entry(void *cache, enum pf_dev_cache_type cache
 	case PF_DEV_CACHE_FILP:
 	{
 		struct file *filp = (struct file*)cache;
-		if (iminor(filp->f_inode) != DEFAULT_CDEV_BASEMINOR)
-			entry = filp->private_data;
+		if ((iminor(filp->f_inode) != DEFAULT_CDEV_BASEMINOR) && filp->private_data)
+			entry = ((struct ami_cdev_client*)filp->private_data)->pf_dev;
 		break;
 	}
 
@@ -13,6 +13,7 @@
 #include <linux/list.h>
 #include <linux/kref.h>
 #include <linux/semaphore.h>
+#include <linux/workqueue.h>
 
 #include "ami.h"
 #include "ami_vsec.h"
@@ -31,6 +32,9 @@
 #define STATE_NAME_SHUTDOWN   	"SHUTDOWN"
 #define STATE_NAME_COMPAT     	"COMPAT"
 
+/* NUMA node of the card - used for buffer allocations */
+#define PF_DEV_NODE(pf_dev)	dev_to_node(&(pf_dev)->pci->dev)
+
 /**
  * enum pf_dev_state - List of possible device states.
  * @PF_DEV_STATE_INIT: Device is initialising.
@@ -41,8 +45,10 @@
  * @PF_DEV_STATE_SHUTDOWN: All services have been shutdown.
  * @PF_DEV_STATE_COMPAT: Compatibility mode - most functions unavailable.
  * 
- * Note that, currently, PF_DEV_STATE_INIT is only used temporarily within
- * the device probe function so a user is unlikely to ever see this state.
+ * A device stays in PF_DEV_STATE_INIT from the end of the probe function
+ * until the deferred AMC bring-up has completed (or given up).
+ * Every transition is signalled on the 'dev_state' sysfs attribute so that
+ * user space may wait for a state change with poll().
  */
 enum pf_dev_state {
 	PF_DEV_STATE_INIT = 0,
@@ -67,7 +73,7 @@ struct pf_dev_application {
 /**
  * enum pf_dev_cache_type() - List of possible pf_dev_struct cache locations
  * @PF_DEV_CACHE_PCI_DEV: pf_dev is stored inside struct pci_dev private data
- * @PF_DEV_CACHE_FILP: pf_dev_ is stored inside struct file private data
+ * @PF_DEV_CACHE_FILP: pf_dev is referenced by the ami_cdev_client in struct file private data
  * @PF_DEV_CACHE_INODE: pf_dev is stored inside cdev struct which is inside an inode
  * @PF_DEV_CACHE_DEV: pf_dev is stored inside a generic device struct
  *
@@ -92,8 +98,12 @@ enum pf_dev_cache_type {
  * @pcie_config: PCI specific data
  * @endpoints: PCI endpoints (UUID, GCQ, etc...)
  * @amc_ctrl_ctxt: AMC data struct.
+ * @amc_ready_work: Deferred work which brings up the AMC once its GCQ is ready.
+ * @amc_ready_retries: Number of times `amc_ready_work` has found the GCQ not ready.
+ * @link_health: PCIe link health monitor.
  * @ioctl_sema: Semaphore used by the IOCTL handler.
- * @sensor_refresh: Sensor update interval in milliseconds.
+ * @sensor_refresh: Sensor update interval in milliseconds for hwmon readers and
+ *   file descriptors which have not set their own.
  * @num_sensor_repos: Number of discovered sensor repos.
  * @sensor_repos: Discovered sensor repos.
  * @cdev: Character device data.
@@ -121,6 +131,9 @@ struct pf_dev_struct {
 	pcie_config_struct         *pcie_config;
 	endpoints_struct           *endpoints;
 	struct amc_control_ctxt    *amc_ctrl_ctxt;  /* Only applicable for PF0 */
+	struct delayed_work         amc_ready_work;
+	int                         amc_ready_retries;
+	struct pcie_link_health     link_health;
 	struct semaphore            ioctl_sema;
 	uint16_t                    sensor_refresh;
 	uint8_t                     num_sensor_repos;
@@ -151,6 +164,19 @@ struct pf_dev_struct {
  */
 void shutdown_pf_dev_services(struct pf_dev_struct *pf_dev);
 
+/**
+ * set_pf_dev_state() - Transition a device to a new state.
+ * @pf_dev: Device data struct.
+ * @state: The new device state.
+ *
+ * All state changes must go through this function so that user space
+ * applications polling the 'dev_state' sysfs attribute are woken up
+ * on every transition. Setting the current state again is a no-op.
+ *
+ * Return: None.
+ */
+void set_pf_dev_state(struct pf_dev_struct *pf_dev, enum pf_dev_state state);
+
 /**
  * kill_pf_dev_apps() - Attempt to stop all applications registered with a device.
  * @pf_dev: The device handle.
@@ -7,6 +7,8 @@
 
 #include <linux/slab.h>    /* kmalloc */
 #include <linux/string.h>  /* memcpy, strlen */
+#include <linux/sched.h>   /* set_cpus_allowed_ptr */
+#include <linux/topology.h>
 
 #include "ami.h"
 #include "ami_utils.h"
@@ -72,3 +74,17 @@ int strconcat(char **dst, char src[], int *size)
 	*size += strlen(src);
 	return SUCCESS;
 }
+
+struct task_struct *kthread_create_local(int (*threadfn)(void *data), void *data,
+					 int node, const char *name)
+{
+	struct task_struct *task = NULL;
+
+	task = kthread_create_on_node(threadfn, data, node, "%s", name);
+
+	if (!IS_ERR(task) && (node != NUMA_NO_NODE) &&
+	    cpumask_intersects(cpumask_of_node(node), cpu_online_mask))
+		set_cpus_allowed_ptr(task, cpumask_of_node(node));
+
+	return task;
+}
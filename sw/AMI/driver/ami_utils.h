@@ -9,9 +9,26 @@
 #define AMI_UTILS_H
 
 #include <linux/cred.h>
+#include <linux/kthread.h>
 #include "ami_top.h"
 
 int my_krealloc(void **buf, int old_size, int new_size, gfp_t flags);
 int strconcat(char **dst, char src[], int *size);
 
+/**
+ * kthread_create_local() - Create a kthread that runs close to a device.
+ * @threadfn: Thread function.
+ * @data: Data passed to `threadfn`.
+ * @node: NUMA node of the device (may be NUMA_NO_NODE).
+ * @name: Thread name.
+ *
+ * The thread stack is allocated on `node` and, if the node has online CPUs,
+ * the thread is restricted to them. As with `kthread_create`, the thread
+ * must be started with `wake_up_process`.
+ *
+ * Return: Task pointer or ERR_PTR.
+ */
+struct task_struct *kthread_create_local(int (*threadfn)(void *data), void *data,
+					 int node, const char *name);
+
 #endif  /* AMI_UTILS_H */
@@ -57,6 +57,19 @@ typedef enum _FW_IF_GCQ_INTERRUPT_MODE_TYPE
 
 } FW_IF_GCQ_INTERRUPT_MODE_TYPE;
 
+/**
+ * @enum FW_IF_GCQ_QUEUE_TYPE
+ * @brief Enumeration of the role of a queue pair on the GCQ IP block
+ */
+typedef enum _FW_IF_GCQ_QUEUE_TYPE
+{
+    FW_IF_GCQ_QUEUE_PRIMARY = 0,                            /* Queue pair owns and initialises the GCQ IP block */
+    FW_IF_GCQ_QUEUE_SECONDARY,                              /* Additional queue pair on the primary's IP block, polled via in memory doorbells */
+
+    MAX_FW_IF_GCQ_QUEUE
+
+} FW_IF_GCQ_QUEUE_TYPE;
+
 /**
  * @enum    FW_IF_GCQ_EVENTS
  * @brief   GCQ events raised in the callback (generic across all GCQ interface)
@@ -137,6 +150,7 @@ typedef struct _FW_IF_GCQ_CFG
     uint32_t                        ulCompletionQueueSlotSize;
     uint32_t                        ulSubmissionQueueSlotSize;
     uint8_t                         udid[ FW_IF_GCQ_UDID_LEN ];
+    FW_IF_GCQ_QUEUE_TYPE            xQueueType;
 
     void                            *pvProfile;      /* opaque handle to store internal context */
 
@@ -307,6 +307,11 @@ static uint32_t prvGCQOpen( void *pvFWIf )
 #ifndef __KERNEL__
         xFlags = GCQ_FLAGS_TYPE_IN_MEM_PTR_ENABLE;
 #endif
+        /* Secondary queue pairs leave the IP block to the primary */
+        if( FW_IF_GCQ_QUEUE_SECONDARY == pxCfg->xQueueType )
+        {
+            xFlags |= GCQ_FLAGS_TYPE_SHARED_IP_ENABLE;
+        }
         xIntMode = prvxMapInterruptMode( pxCfg->xInterruptMode );
         xMode = prvxMapMode( pxCfg->xMode );
 
@@ -626,7 +631,8 @@ uint32_t ulFW_IF_GCQ_Create( FW_IF_CFG *xFWIf, FW_IF_GCQ_CFG *xGCQCfg )
 
     /* Validate the configuration provided */
     if( ( MAX_FW_IF_GCQ_MODE > xGCQCfg->xMode ) &&
-        ( MAX_FW_IF_GCQ_INTERRUPT_MODE > xGCQCfg->xInterruptMode ) )
+        ( MAX_FW_IF_GCQ_INTERRUPT_MODE > xGCQCfg->xInterruptMode ) &&
+        ( MAX_FW_IF_GCQ_QUEUE > xGCQCfg->xQueueType ) )
     {
         FW_IF_CFG myLocalIf =
         {